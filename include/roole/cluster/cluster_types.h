@@ -43,6 +43,35 @@ typedef void (*member_event_cb)(
     void *user_data
 );
 
+// Compact load summary (piggybacked on gossip, saturating fields)
+typedef struct {
+    uint8_t cpu_pct;               // 1-min load average / CPUs, 0..100
+    uint16_t queue_depth;          // Pending events/work items
+    uint16_t rpc_inflight;         // RPC requests received but not answered
+    uint16_t active_executions;
+    uint32_t raft_apply_lag;       // commit_index - last_applied
+} member_load_t;
+
+// Local load provider (sampled at most once per report interval)
+typedef int (*member_load_provider_cb)(
+    member_load_t *out_load,
+    void *user_data
+);
+
+// Remote load summary received callback
+typedef void (*member_load_cb)(
+    node_id_t node_id,
+    const member_load_t *load,
+    void *user_data
+);
+
+// Peer round-trip sample callback (gossip PING/ACK, microseconds)
+typedef void (*member_rtt_cb)(
+    node_id_t node_id,
+    uint32_t rtt_us,
+    void *user_data
+);
+
 // Event types
 #define MEMBER_EVENT_JOIN "member-join"
 #define MEMBER_EVENT_LEAVE "member-leave"
@@ -2,14 +2,29 @@
 #define ROOLE_CLUSTER_VIEW_H
 
 #include "roole/cluster/cluster_types.h" 
+#include "roole/core/rcu.h"
 #include <pthread.h>
 
+// Immutable, refcounted copy of the member table.
+// Published by writers after every mutation; readers never see it change.
+typedef struct cluster_view_snapshot {
+    rcu_head_t rcu;                   // View holds one reference
+    uint64_t version;                 // Monotonic, bumped on every publish
+    size_t count;
+    cluster_member_t members[];
+} cluster_view_snapshot_t;
+
 // Cluster view (shared state)
+// Writers serialize on `lock`; readers should prefer snapshots, which
+// are acquired without taking the lock.
 typedef struct cluster_view {
     cluster_member_t *members;
     size_t count;
     size_t capacity;
     pthread_rwlock_t lock;
+
+    rcu_slot_t snapshot;              // Latest published cluster_view_snapshot_t
+    uint64_t version;                 // Guarded by write lock
 } cluster_view_t;
 
 /**
@@ -61,6 +76,7 @@ int cluster_view_remove(cluster_view_t *view, node_id_t node_id);
  * Get member by ID
  * Returns pointer to member (read lock held)
  * Caller MUST call cluster_view_release() when done
+ * Prefer cluster_view_lookup() or snapshots on hot paths
  * Thread-safe: acquires read lock
  * @param view View structure
  * @param node_id Node ID to find
@@ -75,6 +91,49 @@ cluster_member_t* cluster_view_get(cluster_view_t *view, node_id_t node_id);
  */
 void cluster_view_release(cluster_view_t *view);
 
+/**
+ * Acquire the latest published snapshot
+ * Lock-free: never blocks on writers. The snapshot is immutable and stays
+ * valid until cluster_view_snapshot_release() drops the last reference.
+ * @param view View structure
+ * @return Snapshot (refcount held), or NULL if view is not initialized
+ */
+cluster_view_snapshot_t* cluster_view_snapshot_acquire(cluster_view_t *view);
+
+/**
+ * Release a snapshot obtained from cluster_view_snapshot_acquire()
+ * @param snap Snapshot (may be NULL)
+ */
+void cluster_view_snapshot_release(cluster_view_snapshot_t *snap);
+
+/**
+ * Find member in snapshot
+ * @param snap Snapshot
+ * @param node_id Node ID to find
+ * @return Pointer into snapshot (valid while snapshot is held), or NULL
+ */
+const cluster_member_t* cluster_view_snapshot_find(const cluster_view_snapshot_t *snap,
+                                                   node_id_t node_id);
+
+/**
+ * Copy a member out of the current snapshot
+ * Lock-free replacement for cluster_view_get()/cluster_view_release()
+ * @param view View structure
+ * @param node_id Node ID to find
+ * @param out Output member copy
+ * @return 0 on success, RESULT_ERR_NOTFOUND if absent
+ */
+int cluster_view_lookup(cluster_view_t *view, node_id_t node_id,
+                        cluster_member_t *out);
+
+/**
+ * Get version of the latest published snapshot
+ * Cheap change detection: equal versions mean identical membership.
+ * @param view View structure
+ * @return Version number (0 before first publish)
+ */
+uint64_t cluster_view_version(cluster_view_t *view);
+
 /**
  * List all members of given type
  * Thread-safe: acquires read lock
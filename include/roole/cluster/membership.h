@@ -6,6 +6,7 @@
 
 // Forward declare gossip_engine (break the include cycle)
 typedef struct gossip_engine gossip_engine_t;
+typedef struct gossip_keyring gossip_keyring_t;
 
 // Opaque handle
 typedef struct membership_handle membership_handle_t;
@@ -63,6 +64,54 @@ int membership_join(membership_handle_t *handle, const char *seed_addr, uint16_t
  */
 int membership_set_callback(membership_handle_t *handle, member_event_cb callback, void *user_data);
 
+/**
+ * Set RTT sample callback (PING/ACK round trips, receiver thread)
+ * Returns once calls in progress have finished (see gossip_engine.h)
+ * @param handle Membership handle
+ * @param callback Callback function (NULL to disable)
+ * @param user_data User data for callback
+ * @return 0 on success
+ */
+int membership_set_rtt_callback(membership_handle_t *handle, member_rtt_cb callback, void *user_data);
+
+/**
+ * Set load summary hooks (local provider, remote summaries)
+ * Returns once calls in progress have finished (see gossip_engine.h)
+ * @param handle Membership handle
+ * @param provider Local load provider (NULL = don't advertise)
+ * @param callback Remote load callback (NULL = ignore)
+ * @param user_data User data for both hooks
+ * @return 0 on success
+ */
+int membership_set_load_callbacks(membership_handle_t *handle,
+                                  member_load_provider_cb provider,
+                                  member_load_cb callback,
+                                  void *user_data);
+
+/**
+ * Enable gossip packet encryption (call before membership_join)
+ * @param handle Membership handle
+ * @param keyring Keyring with a primary key (NULL = plaintext); must
+ *        outlive the membership handle
+ * @return 0 on success, error code if encryption is unavailable
+ */
+int membership_set_keyring(membership_handle_t *handle, gossip_keyring_t *keyring);
+
+/**
+ * Estimate RTT to a member (measured, or from network coordinates)
+ * @param handle Membership handle
+ * @param node_id Member ID
+ * @return Estimated RTT in microseconds, or 0 if unknown
+ */
+uint32_t membership_estimate_rtt_us(membership_handle_t *handle, node_id_t node_id);
+
+/**
+ * Get the gossip engine behind this membership (for statistics)
+ * @param handle Membership handle
+ * @return Engine handle, or NULL if not started; owned by the handle
+ */
+gossip_engine_t* membership_get_gossip_engine(membership_handle_t *handle);
+
 /**
  * Gracefully leave cluster
  * @param handle Membership handle
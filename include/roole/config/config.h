@@ -6,6 +6,7 @@
 #include "roole/core/common.h"
 #include "roole/logger/logger.h"
 #include "roole/cluster/cluster_view.h"
+#include "roole/core/event_bus.h"
 
 #define MAX_CONFIG_ROUTERS 16
 #define MAX_CONFIG_STRING 256
@@ -25,7 +26,14 @@ typedef struct roole_config {
     
     char routers[MAX_CONFIG_ROUTERS][MAX_CONFIG_STRING];
     log_level_t log_level;
+    int log_remote_control;             // PUT/DELETE /loglevel on the metrics port
     size_t router_count;
+    
+    // "id:hexkey[,id:hexkey...]"; first key seals, all keys open (empty = plaintext)
+    char gossip_keys[MAX_CONFIG_STRING];
+    
+    // Event bus dispatch lanes (shared | per_type | per_subscriber)
+    event_lane_mode_t event_lanes;
 } roole_config_t;
 
 // Load configuration from INI file
@@ -59,6 +59,12 @@ typedef uint32_t rule_id_t;
 // Timing utilities
 uint64_t time_now_ms(void);
 uint64_t time_now_us(void);
+
+// Replace the clock behind time_now_ms/us (e.g. virtual time in a
+// simulator). Returns microseconds; NULL restores CLOCK_MONOTONIC.
+// Set before starting threads that read the clock.
+typedef uint64_t (*time_source_fn)(void *ctx);
+void time_set_source(time_source_fn source, void *ctx);
 double time_diff_us(const struct timespec *start, const struct timespec *end);
 void timespec_now(struct timespec *ts);
 
@@ -76,6 +82,7 @@ int safe_strncpy(char *dst, const char *src, size_t dst_size);
 uint32_t hash_u32(uint32_t x);
 uint64_t hash_u64(uint64_t x);
 uint32_t hash_string(const char *str);
+uint64_t hash_bytes(const void *data, size_t len);
 
 // Result Checking and Logging
 int result_is_ok(const result_t *result);
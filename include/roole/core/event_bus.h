@@ -77,11 +77,31 @@ typedef struct {
 // Event handler callback
 typedef void (*event_handler_fn)(const event_t *event, void *user_data);
 
+// Batch handler: receives every queued event of its type in one call
+// (in publish order; the array is only valid during the call)
+typedef void (*event_batch_handler_fn)(const event_t *events, size_t count,
+                                       void *user_data);
+
 // Event bus
 typedef struct event_bus event_bus_t;
 
+// Dispatch lanes: each lane has its own queue and thread, so a slow
+// subscriber only delays events in its own lane. Order is preserved
+// within a lane.
+typedef enum {
+    EVENT_LANES_SHARED = 0,         // One lane for everything (default)
+    EVENT_LANES_PER_TYPE,           // One lane per event type with subscribers
+    EVENT_LANES_PER_SUBSCRIBER      // One lane per subscriber
+} event_lane_mode_t;
+
+typedef struct {
+    event_lane_mode_t lane_mode;
+    size_t queue_size;              // Per lane, rounded up to a power of two (0 = 1024)
+} event_bus_config_t;
+
 // Lifecycle
 event_bus_t* event_bus_create(void);
+event_bus_t* event_bus_create_with_config(const event_bus_config_t *config);
 void event_bus_destroy(event_bus_t *bus);
 
 // Subscription
@@ -89,8 +109,22 @@ int event_bus_subscribe(event_bus_t *bus, event_type_t type,
                         event_handler_fn handler, void *user_data);
 int event_bus_unsubscribe(event_bus_t *bus, event_type_t type,
                           event_handler_fn handler);
+int event_bus_subscribe_batch(event_bus_t *bus, event_type_t type,
+                              event_batch_handler_fn handler, void *user_data);
+int event_bus_unsubscribe_batch(event_bus_t *bus, event_type_t type,
+                                event_batch_handler_fn handler);
+
+// Coalescing: while an event for the same key (peer node_id, exec_id or
+// dag_id) is still pending, a newer one replaces it instead of queueing.
+// Coalesced events never drop (the pending set grows), but they may be
+// delivered after later events of other types. On by default for
+// PEER_UPDATED and PEER_SUSPECT.
+int event_bus_set_coalescing(event_bus_t *bus, event_type_t type, int enabled);
 
 // Publishing
+// event_bus_publish is lock-free and never blocks: it returns -1 (and counts
+// a drop) when the queue is full. event_bus_publish_sync runs the handlers
+// on the caller's thread.
 int event_bus_publish(event_bus_t *bus, const event_t *event);
 int event_bus_publish_sync(event_bus_t *bus, const event_t *event);
 
@@ -99,13 +133,33 @@ typedef struct {
     uint64_t events_published;
     uint64_t events_dispatched;
     uint64_t events_dropped;
-    uint64_t queue_size;
+    uint64_t events_coalesced;      // Superseded before delivery
+    uint64_t queue_size;            // Summed over lanes, incl. pending coalesced
     uint64_t subscribers_total;
+    uint64_t lanes;
+    uint64_t payload_pool_misses;   // Large payloads that fell back to malloc
 } event_bus_stats_t;
 
+#define EVENT_LANE_NAME_LEN 32
+
+typedef struct {
+    char name[EVENT_LANE_NAME_LEN];
+    uint64_t queue_depth;
+    uint64_t dispatched;            // Events taken off this lane
+    uint64_t dropped;
+    uint64_t coalesced;
+    uint64_t avg_latency_us;        // Publish to handlers done
+    uint64_t max_latency_us;
+} event_bus_lane_stats_t;
+
 void event_bus_get_stats(event_bus_t *bus, event_bus_stats_t *stats);
 
+// Fills up to max_lanes entries; returns the number written
+size_t event_bus_get_lane_stats(event_bus_t *bus, event_bus_lane_stats_t *out,
+                                size_t max_lanes);
+
 // Helpers
 const char* event_type_to_string(event_type_t type);
+const char* event_lane_mode_to_string(event_lane_mode_t mode);
 
 #endif // ROOLE_EVENT_BUS_H
\ No newline at end of file
@@ -0,0 +1,69 @@
+// include/roole/core/rcu.h
+// RCU-style publication of immutable, refcounted snapshots
+#ifndef ROOLE_RCU_H
+#define ROOLE_RCU_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Writers (serialized by the owner) build a fresh snapshot and publish it;
+// readers acquire the latest one without locks and keep it alive with a
+// reference. Snapshots are malloc() blocks that start with an rcu_head_t;
+// the last release frees them, or hands them to reclaim when it is set.
+
+typedef struct rcu_head {
+    uint32_t refcount;                  // Atomic: the slot holds one reference
+    void (*reclaim)(struct rcu_head *head);  // NULL = free()
+} rcu_head_t;
+
+typedef struct rcu_slot {
+    rcu_head_t *current;                // Atomic: latest published snapshot
+    uint32_t acquiring;                 // Atomic: readers between load and refcount++
+} rcu_slot_t;
+
+// Prepare a new snapshot (the reference handed to the slot on publish)
+static inline void rcu_head_init(rcu_head_t *head) {
+    head->refcount = 1;
+    head->reclaim = NULL;
+}
+
+// Swap in snap (NULL to retire the slot) and drop the slot's reference to
+// the previous snapshot once no reader can still be taking one
+void rcu_publish(rcu_slot_t *slot, rcu_head_t *snap);
+
+// Latest snapshot with a reference held, or NULL; never blocks on writers
+rcu_head_t* rcu_acquire(rcu_slot_t *slot);
+
+void rcu_release(rcu_head_t *snap);
+
+// Current snapshot without a reference; only for the (serialized) writer
+static inline rcu_head_t* rcu_peek(rcu_slot_t *slot) {
+    return __atomic_load_n(&slot->current, __ATOMIC_ACQUIRE);
+}
+
+// Grace period for state that readers use in place (no refcount): readers
+// bracket every use with rcu_read_enter/exit, and a writer that has
+// unpublished something calls rcu_synchronize before freeing it. Readers
+// are split by epoch parity, so a steady stream of new readers cannot
+// starve the writer. Zero-initialized is ready to use.
+typedef struct rcu_gate {
+    uint32_t epoch;                     // Atomic
+    uint32_t active[2];                 // Atomic: readers inside, by epoch parity
+    uint32_t syncing;                   // Atomic: serializes rcu_synchronize
+} rcu_gate_t;
+
+static inline uint32_t rcu_read_enter(rcu_gate_t *gate) {
+    uint32_t parity = __atomic_load_n(&gate->epoch, __ATOMIC_SEQ_CST) & 1;
+    __atomic_add_fetch(&gate->active[parity], 1, __ATOMIC_SEQ_CST);
+    return parity;
+}
+
+static inline void rcu_read_exit(rcu_gate_t *gate, uint32_t token) {
+    __atomic_sub_fetch(&gate->active[token], 1, __ATOMIC_RELEASE);
+}
+
+// Wait until every reader that may have seen state unpublished before this
+// call has exited. Loads of the published state must be seq_cst.
+void rcu_synchronize(rcu_gate_t *gate);
+
+#endif // ROOLE_RCU_H
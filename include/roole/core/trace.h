@@ -0,0 +1,117 @@
+// include/roole/core/trace.h
+// Request tracing: per-stage spans in a lock-free ring
+#ifndef ROOLE_TRACE_H
+#define ROOLE_TRACE_H
+
+#include "roole/core/common.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// A trace ID is minted when a request enters the cluster (ingress), rides
+// in the RPC header and in Raft log entries, and tags the spans every node
+// records for it. Spans go into a fixed process-wide ring that overwrites
+// the oldest entries; dumping never blocks writers.
+
+#define TRACE_DEFAULT_CAPACITY 16384    // Spans kept (rounded up to a power of 2)
+
+typedef uint64_t trace_id_t;            // 0 = not traced
+
+// ============================================================================
+// STAGES
+// ============================================================================
+
+typedef enum {
+    TRACE_STAGE_RPC = 0,                // Server side: request received to response sent
+    TRACE_STAGE_INGRESS_PARSE,          // Decoding the client request
+    TRACE_STAGE_RAFT_SUBMIT,            // Encoding and appending to the leader log
+    TRACE_STAGE_FOLLOWER_APPEND,        // Follower: storing the replicated entry
+    TRACE_STAGE_COMMIT_WAIT,            // Submitter waiting for the entry to commit
+    TRACE_STAGE_APPLY,                  // Applying the entry to the state machine
+    TRACE_STAGE_COUNT
+} trace_stage_t;
+
+typedef struct trace_span {
+    trace_id_t trace_id;
+    uint64_t start_us;                  // time_now_us() clock
+    uint64_t duration_us;
+    uint64_t arg;                       // Stage detail: log index, func_id, size
+    node_id_t node_id;                  // Node that recorded the span
+    uint8_t stage;                      // trace_stage_t
+} trace_span_t;
+
+// Called for every recorded span on the recording thread; must not block
+typedef struct trace_observer {
+    void (*on_span)(void *ctx, const trace_span_t *span);
+    void *ctx;
+} trace_observer_t;
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+// Allocate the span ring. Until this is called nothing is traced.
+// @param node_id Stamped on every span recorded by this process
+// @param capacity Spans kept (0 = TRACE_DEFAULT_CAPACITY)
+// @param sample_one_in Trace one in N new requests (0 = none, 1 = all)
+int trace_init(node_id_t node_id, size_t capacity, uint32_t sample_one_in);
+void trace_shutdown(void);
+
+void trace_set_sampling(uint32_t sample_one_in);
+
+// Observer for every span (e.g. per-stage histograms); NULL to disable.
+// Caller-owned, must stay valid while set; returns once no thread is still
+// calling the previous one. Must not be called from on_span.
+void trace_set_observer(const trace_observer_t *observer);
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+// Mint an ID for a new request, subject to sampling; 0 when not sampled
+trace_id_t trace_new_id(void);
+
+// Trace the calling thread is working for (set by the RPC server around
+// handlers, read when an RPC is sent or a log entry is created)
+trace_id_t trace_current(void);
+void trace_set_current(trace_id_t trace_id);
+
+void trace_record(trace_stage_t stage, trace_id_t trace_id, uint64_t start_us,
+                  uint64_t end_us, uint64_t arg);
+
+// Timing helpers for the current trace: begin returns 0 when the thread
+// has no trace, and end ignores a 0 start, so untraced paths skip the clock
+static inline uint64_t trace_begin(void) {
+    return trace_current() ? time_now_us() : 0;
+}
+
+static inline void trace_end(trace_stage_t stage, uint64_t start_us, uint64_t arg) {
+    if (start_us) {
+        trace_record(stage, trace_current(), start_us, time_now_us(), arg);
+    }
+}
+
+const char* trace_stage_name(trace_stage_t stage);
+
+// ============================================================================
+// EXPORT
+// ============================================================================
+
+// Copy out the spans still in the ring, oldest first
+// @return Number of spans written to out
+size_t trace_snapshot(trace_span_t *out, size_t max);
+
+// Render the ring as JSON, snprintf-style: returns the length needed even
+// when it exceeds cap (usable directly as a metrics server endpoint)
+int trace_render_chrome(void *ctx, char *buf, size_t cap);   // chrome://tracing, Perfetto
+int trace_render_otlp(void *ctx, char *buf, size_t cap);     // OTLP/JSON ExportTraceServiceRequest
+
+typedef enum {
+    TRACE_FORMAT_CHROME,
+    TRACE_FORMAT_OTLP
+} trace_format_t;
+
+// Write the ring to a file
+// @return 0 on success, -1 on error
+int trace_dump_file(const char *path, trace_format_t format);
+
+#endif // ROOLE_TRACE_H
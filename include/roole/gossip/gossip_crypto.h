@@ -0,0 +1,122 @@
+// include/roole/gossip/gossip_crypto.h
+// Authenticated encryption of gossip packets (AES-256-GCM, key rotation)
+
+#ifndef ROOLE_GOSSIP_CRYPTO_H
+#define ROOLE_GOSSIP_CRYPTO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#define GOSSIP_CRYPTO_KEY_SIZE    32
+#define GOSSIP_CRYPTO_NONCE_SIZE  12
+#define GOSSIP_CRYPTO_TAG_SIZE    16
+#define GOSSIP_CRYPTO_MAGIC       0xE5   // Never a valid plaintext version byte
+
+// Sealed packet: [magic][key_id][nonce][ciphertext][tag]
+// magic and key_id are authenticated as associated data.
+#define GOSSIP_CRYPTO_HEADER_SIZE (2 + GOSSIP_CRYPTO_NONCE_SIZE)
+#define GOSSIP_CRYPTO_OVERHEAD    (GOSSIP_CRYPTO_HEADER_SIZE + GOSSIP_CRYPTO_TAG_SIZE)
+
+#define GOSSIP_KEYRING_MAX_KEYS   4
+
+typedef struct gossip_keyring gossip_keyring_t;
+
+/**
+ * Check whether this build can seal/open packets
+ * @return 1 if AEAD support was compiled in, 0 otherwise
+ */
+int gossip_crypto_available(void);
+
+/**
+ * Create an empty keyring
+ * @return Keyring, or NULL on allocation failure
+ */
+gossip_keyring_t* gossip_keyring_create(void);
+
+/**
+ * Destroy keyring and wipe key material
+ * @param keyring Keyring (NULL ok)
+ */
+void gossip_keyring_destroy(gossip_keyring_t *keyring);
+
+/**
+ * Install a key (replaces an existing key with the same ID)
+ * The first key installed becomes the primary.
+ * @param keyring Keyring
+ * @param key_id Key ID carried in every sealed packet
+ * @param key Raw key (GOSSIP_CRYPTO_KEY_SIZE bytes)
+ * @return 0 on success, -1 if the ring is full
+ */
+int gossip_keyring_add(gossip_keyring_t *keyring, uint8_t key_id, const uint8_t *key);
+
+/**
+ * Make an installed key the primary (used for sealing)
+ * Other keys are still accepted when opening, so a rotation is:
+ * add the new key everywhere, switch primaries, then remove the old key.
+ * @param keyring Keyring
+ * @param key_id Key ID
+ * @return 0 on success, -1 if not installed
+ */
+int gossip_keyring_use(gossip_keyring_t *keyring, uint8_t key_id);
+
+/**
+ * Remove a key (the primary cannot be removed)
+ * @param keyring Keyring
+ * @param key_id Key ID
+ * @return 0 on success, -1 if not installed or primary
+ */
+int gossip_keyring_remove(gossip_keyring_t *keyring, uint8_t key_id);
+
+/**
+ * Load keys from a spec string "id:hexkey[,id:hexkey...]"
+ * The first key in the list becomes the primary.
+ * @param keyring Keyring
+ * @param spec Key spec (64 hex digits per key)
+ * @return Number of keys loaded, or -1 on parse error
+ */
+int gossip_keyring_load_spec(gossip_keyring_t *keyring, const char *spec);
+
+/**
+ * Number of installed keys
+ * @param keyring Keyring
+ * @return Key count
+ */
+size_t gossip_keyring_count(gossip_keyring_t *keyring);
+
+/**
+ * Encrypt and authenticate one serialized packet with the primary key
+ * Thread-safe; per-thread cipher contexts keep the hot path allocation-free.
+ * @param keyring Keyring
+ * @param plain Serialized gossip message
+ * @param len Plaintext length
+ * @param out Output buffer (may not alias plain)
+ * @param out_size Output capacity (>= len + GOSSIP_CRYPTO_OVERHEAD)
+ * @return Sealed length, or -1 on error
+ */
+ssize_t gossip_crypto_seal(gossip_keyring_t *keyring, const uint8_t *plain, size_t len,
+                           uint8_t *out, size_t out_size);
+
+/**
+ * Verify and decrypt one sealed packet
+ * @param keyring Keyring
+ * @param packet Sealed packet
+ * @param len Packet length
+ * @param out Output buffer (may not alias packet)
+ * @param out_size Output capacity (>= len - GOSSIP_CRYPTO_OVERHEAD)
+ * @return Plaintext length, or -1 if malformed, unknown key or forged
+ */
+ssize_t gossip_crypto_open(gossip_keyring_t *keyring, const uint8_t *packet, size_t len,
+                           uint8_t *out, size_t out_size);
+
+/**
+ * Check whether a packet looks sealed (cheap header test)
+ * @param packet Packet bytes
+ * @param len Packet length
+ * @return 1 if sealed, 0 otherwise
+ */
+static inline int gossip_crypto_is_sealed(const uint8_t *packet, size_t len) {
+    return len >= GOSSIP_CRYPTO_OVERHEAD && packet[0] == GOSSIP_CRYPTO_MAGIC;
+}
+
+#endif // ROOLE_GOSSIP_CRYPTO_H
@@ -5,12 +5,32 @@
 #define ROOLE_GOSSIP_ENGINE_H
 
 #include "roole/gossip/gossip_protocol.h"
+#include "roole/gossip/gossip_crypto.h"
 #include "roole/transport/udp_transport.h"
 #include "roole/cluster/cluster_types.h"   
 #include "roole/cluster/cluster_view.h"
 
 typedef struct gossip_engine gossip_engine_t;
 
+// Membership callback delivery statistics
+typedef struct {
+    uint64_t events_enqueued;
+    uint64_t events_coalesced;     // Superseded by a newer event for same node
+    uint64_t events_dropped;       // Queue full
+    uint64_t events_delivered;
+    uint64_t max_delivery_latency_us;
+    size_t queue_depth;
+} gossip_engine_event_stats_t;
+
+// Packet encryption statistics
+typedef struct {
+    uint64_t packets_sealed;
+    uint64_t packets_opened;
+    uint64_t seal_failures;
+    uint64_t open_failures;        // Forged, corrupt or unknown key ID
+    uint64_t plaintext_dropped;    // Unsealed packet while a keyring is set
+} gossip_engine_crypto_stats_t;
+
 /**
  * Create gossip engine
  * Initializes transport and protocol layers
@@ -21,7 +41,8 @@ typedef struct gossip_engine gossip_engine_t;
  * @param data_port TCP port for RPC (metadata only)
  * @param config Protocol configuration (NULL for defaults)
  * @param cluster_view Shared cluster view
- * @param event_callback Membership event callback (optional)
+ * @param event_callback Membership event callback (optional); invoked
+ *        asynchronously from a dedicated dispatcher thread
  * @param user_data User data for callback
  * @return Engine handle, or NULL on error
  */
@@ -77,6 +98,8 @@ void gossip_engine_shutdown(gossip_engine_t *engine);
 
 /**
  * Set event callback (can be changed after creation)
+ * Returns only once a delivery already in progress has finished, so the
+ * previous user_data may be freed afterwards.
  * @param engine Engine handle
  * @param callback New callback function
  * @param user_data New user data
@@ -85,4 +108,93 @@ void gossip_engine_set_callback(gossip_engine_t *engine,
                                 member_event_cb callback,
                                 void *user_data);
 
+/**
+ * Get membership callback delivery statistics
+ * @param engine Engine handle
+ * @param out_stats Output statistics
+ */
+void gossip_engine_get_event_stats(gossip_engine_t *engine,
+                                   gossip_engine_event_stats_t *out_stats);
+
+/**
+ * Get SWIM protocol statistics
+ * @param engine Engine handle
+ * @param out_stats Output statistics
+ */
+void gossip_engine_get_protocol_stats(gossip_engine_t *engine,
+                                      gossip_protocol_stats_t *out_stats);
+
+/**
+ * Get UDP transport statistics
+ * @param engine Engine handle
+ * @param out_stats Output statistics
+ */
+void gossip_engine_get_transport_stats(gossip_engine_t *engine,
+                                       udp_transport_stats_t *out_stats);
+
+/**
+ * Set RTT sample callback
+ * Invoked on the UDP receiver thread for every PING/ACK round trip;
+ * must not block. Returns only once calls already in progress have
+ * finished, so the previous user_data may be freed afterwards; must not be
+ * called from a gossip hook.
+ * @param engine Engine handle
+ * @param callback Callback function (NULL to disable)
+ * @param user_data User data for callback
+ */
+void gossip_engine_set_rtt_callback(gossip_engine_t *engine,
+                                    member_rtt_cb callback,
+                                    void *user_data);
+
+/**
+ * Set load summary hooks
+ * The provider is sampled at most once per config.load_report_interval_ms
+ * and its result piggybacked on PING/ACK. The callback runs on the UDP
+ * receiver thread for each summary received; neither may block. Returns
+ * only once hook calls already in progress have finished, so the previous
+ * user_data may be freed afterwards; must not be called from a gossip hook.
+ * @param engine Engine handle
+ * @param provider Local load provider (NULL = don't advertise)
+ * @param callback Remote load callback (NULL = ignore)
+ * @param user_data User data for both hooks
+ */
+void gossip_engine_set_load_callbacks(gossip_engine_t *engine,
+                                      member_load_provider_cb provider,
+                                      member_load_cb callback,
+                                      void *user_data);
+
+/**
+ * Estimate RTT to a peer (measured, or from network coordinates)
+ * @param engine Engine handle
+ * @param node_id Peer ID
+ * @return Estimated RTT in microseconds, or 0 if unknown
+ */
+uint32_t gossip_engine_estimate_rtt_us(gossip_engine_t *engine, node_id_t node_id);
+
+/**
+ * Get this node's network coordinate
+ * @param engine Engine handle
+ * @param out_coord Output coordinate
+ */
+void gossip_engine_get_coord(gossip_engine_t *engine, gossip_coord_t *out_coord);
+
+/**
+ * Enable packet encryption
+ * Once set, every outgoing packet is sealed with the keyring's primary
+ * key and unsealed or unauthenticated packets are dropped. Set it before
+ * joining; the keyring must outlive the engine.
+ * @param engine Engine handle
+ * @param keyring Keyring with a primary key (NULL = plaintext)
+ * @return 0 on success, -1 if this build has no AEAD support or no key
+ */
+int gossip_engine_set_keyring(gossip_engine_t *engine, gossip_keyring_t *keyring);
+
+/**
+ * Get packet encryption statistics
+ * @param engine Engine handle
+ * @param out_stats Output statistics
+ */
+void gossip_engine_get_crypto_stats(gossip_engine_t *engine,
+                                    gossip_engine_crypto_stats_t *out_stats);
+
 #endif // ROOLE_GOSSIP_ENGINE_H
\ No newline at end of file
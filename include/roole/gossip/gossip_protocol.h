@@ -6,6 +6,7 @@
 
 #include "roole/gossip/gossip_types.h"
 #include "roole/cluster/cluster_view.h"
+#include <pthread.h>
 
 // Protocol callbacks (invoked by state machine)
 typedef struct {
@@ -17,6 +18,16 @@ typedef struct {
     // Protocol wants to send message (implementation sends via transport)
     void (*on_send_message)(const gossip_message_t *msg, const char *dest_ip, 
                            uint16_t dest_port, void *ctx);
+    
+    // PING/ACK round trip measured (optional)
+    void (*on_rtt_sample)(node_id_t node_id, uint32_t rtt_us, void *ctx);
+    
+    // Local load summary to piggyback (optional, rate-limited by
+    // config.load_report_interval_ms); return 0 if out_load is valid
+    int (*get_local_load)(member_load_t *out_load, void *ctx);
+    
+    // Peer's load summary received (optional)
+    void (*on_peer_load)(node_id_t node_id, const member_load_t *load, void *ctx);
 } gossip_protocol_callbacks_t;
 
 typedef struct {
@@ -27,16 +38,68 @@ typedef struct {
     uint64_t dead_count;
     uint64_t updates_sent;
     uint64_t updates_received;
+    uint64_t gossip_sent;          // Extra dissemination messages (fanout > 1)
+    uint32_t current_period_ms;
+    uint32_t current_fanout;
+    uint64_t rtt_samples;
+    gossip_coord_t coord;          // Local Vivaldi coordinate
+    uint64_t load_samples;         // Local provider invocations
+    uint64_t load_received;        // Peer load summaries delivered
 } gossip_protocol_stats_t;
 
 #define MAX_PENDING_ACKS 64
+#define GOSSIP_MAX_FANOUT 8
+
+// Adaptive period / fanout controller state
+typedef struct {
+    uint32_t period_ms;            // Current protocol period
+    uint32_t fanout;               // Fanout used by the last round
+    uint32_t dissemination_rounds; // Rounds left at elevated fanout
+    uint64_t last_view_version;    // Cluster view version seen last round
+    uint64_t last_pings_sent;
+    uint64_t last_ack_timeouts;
+    double loss_ewma;              // Smoothed ACK timeout ratio
+    double churn_ewma;             // Smoothed view changes per round
+} gossip_adaptive_state_t;
 
 typedef struct pending_ack {
     node_id_t target_node;
-    uint64_t ping_sent_ms;
+    uint64_t ping_sent_us;
     int active;
 } pending_ack_t;
 
+// Per-peer latency state (RTT from PING/ACK, coordinate from gossip)
+#define GOSSIP_RTT_STALE_MS 60000   // Prefer coordinates over older samples
+
+typedef struct {
+    node_id_t node_id;
+    uint32_t srtt_us;              // Smoothed RTT (EWMA, gain 1/8)
+    uint32_t rttvar_us;            // Mean deviation (EWMA, gain 1/4)
+    uint32_t min_rtt_us;
+    uint32_t last_rtt_us;
+    uint64_t samples;
+    uint64_t last_sample_ms;
+    gossip_coord_t coord;          // Peer's last advertised coordinate
+    int has_coord;
+} gossip_peer_latency_t;
+
+typedef struct {
+    gossip_peer_latency_t *entries;
+    size_t count;
+    size_t capacity;
+    uint16_t *slot_of;             // node_id -> entry index + 1 (0 = none)
+    gossip_coord_t coord;          // Local coordinate
+    pthread_mutex_t lock;          // Written by receiver, read by routing
+} gossip_latency_table_t;
+
+// Last local load sample (shared by protocol and receiver threads)
+typedef struct {
+    member_load_t load;
+    uint64_t sampled_ms;
+    int valid;
+    pthread_mutex_t lock;
+} gossip_load_cache_t;
+
 typedef struct {
     node_id_t my_id;
     node_type_t my_type;
@@ -50,6 +113,10 @@ typedef struct {
     cluster_view_t *cluster_view;
     
     pending_ack_t pending_acks[MAX_PENDING_ACKS];
+    gossip_adaptive_state_t adaptive;
+    size_t anti_entropy_cursor;    // Start of next piggybacked view window
+    gossip_latency_table_t latency;
+    gossip_load_cache_t local_load;
     
     gossip_protocol_callbacks_t callbacks;
     void *callback_context;
@@ -103,10 +170,20 @@ int gossip_protocol_handle_message(
  * - Selects random peer
  * - Sends PING with piggybacked updates
  * - Tracks pending ACK
+ * - After membership churn, gossips the same updates to up to fanout-1
+ *   additional peers for ~log2(N) rounds
+ * - Retunes the protocol period from observed loss and churn
  * @param proto Protocol handle
  */
 void gossip_protocol_run_swim_round(gossip_protocol_t *proto);
 
+/**
+ * Get current protocol period (adaptive, or fixed config value)
+ * @param proto Protocol handle
+ * @return Milliseconds to wait before next round
+ */
+uint32_t gossip_protocol_get_period_ms(const gossip_protocol_t *proto);
+
 /**
  * Check for timeouts
  * - ACK timeouts → mark SUSPECT
@@ -151,10 +228,86 @@ void gossip_protocol_get_stats(gossip_protocol_t *proto, gossip_protocol_stats_t
  */
 void gossip_protocol_destroy(gossip_protocol_t *proto);
 
+/**
+ * Record a PING/ACK round trip for a peer
+ * Updates smoothed RTT and, if the peer's coordinate is known, the local
+ * Vivaldi coordinate. Thread-safe.
+ * @param proto Protocol handle
+ * @param node_id Peer that answered
+ * @param rtt_us Measured round trip in microseconds
+ */
+void gossip_protocol_record_rtt(gossip_protocol_t *proto, node_id_t node_id, uint32_t rtt_us);
+
+/**
+ * Remember a peer's advertised coordinate (from GOSSIP_FLAG_HAS_COORD)
+ * @param proto Protocol handle
+ * @param node_id Peer ID
+ * @param coord Advertised coordinate (ignored if invalid)
+ */
+void gossip_protocol_note_peer_coord(gossip_protocol_t *proto, node_id_t node_id,
+                                     const gossip_coord_t *coord);
+
+/**
+ * Drop latency state for a peer (on DEAD/LEAVE)
+ * @param proto Protocol handle
+ * @param node_id Peer ID
+ */
+void gossip_protocol_forget_peer(gossip_protocol_t *proto, node_id_t node_id);
+
+/**
+ * Estimate RTT to a peer
+ * Uses the smoothed measurement when fresh, otherwise the Vivaldi distance.
+ * Thread-safe.
+ * @param proto Protocol handle
+ * @param node_id Peer ID
+ * @return Estimated RTT in microseconds, or 0 if unknown
+ */
+uint32_t gossip_protocol_estimate_rtt_us(gossip_protocol_t *proto, node_id_t node_id);
+
+/**
+ * Copy per-peer latency state
+ * @param proto Protocol handle
+ * @param node_id Peer ID
+ * @param out Output latency state
+ * @return 0 on success, -1 if the peer has no latency data
+ */
+int gossip_protocol_get_peer_latency(gossip_protocol_t *proto, node_id_t node_id,
+                                     gossip_peer_latency_t *out);
+
+/**
+ * Copy local network coordinate
+ * @param proto Protocol handle
+ * @param out Output coordinate
+ */
+void gossip_protocol_get_coord(gossip_protocol_t *proto, gossip_coord_t *out);
+
+/**
+ * Attach the local load summary to an outgoing message
+ * Samples get_local_load at most once per load_report_interval_ms and
+ * reuses the cached summary in between. No-op without a provider.
+ * @param proto Protocol handle
+ * @param msg Outgoing message (flags/load updated)
+ */
+void gossip_protocol_attach_load(gossip_protocol_t *proto, gossip_message_t *msg);
+
+int gossip_latency_init(gossip_latency_table_t *table, size_t capacity);
+
+void gossip_latency_destroy(gossip_latency_table_t *table);
+
 int add_pending_ack(gossip_protocol_t *proto, node_id_t target_node);
 
 int remove_pending_ack(gossip_protocol_t *proto, node_id_t target_node);
 
+/**
+ * Clear pending ACK and report how long it was outstanding
+ * @param proto Protocol handle
+ * @param target_node Node that answered
+ * @param out_rtt_us Output round trip in microseconds (may be NULL)
+ * @return 0 if a pending ACK was cleared, -1 otherwise
+ */
+int complete_pending_ack(gossip_protocol_t *proto, node_id_t target_node,
+                         uint64_t *out_rtt_us);
+
 
 
 #endif // ROOLE_GOSSIP_PROTOCOL_H
\ No newline at end of file
@@ -19,7 +19,8 @@ typedef enum {
     GOSSIP_MSG_JOIN = 7,           // New member joining
     GOSSIP_MSG_LEAVE = 8,          // Graceful leave
     GOSSIP_MSG_WORKER_JOIN = 9,    // Worker-specific join
-    GOSSIP_MSG_JOIN_RESPONSE = 10  // Bootstrap response
+    GOSSIP_MSG_JOIN_RESPONSE = 10, // Bootstrap response
+    GOSSIP_MSG_GOSSIP = 11         // Update dissemination only (no ACK)
 } gossip_msg_type_t;
 
 // Protocol configuration
@@ -28,8 +29,17 @@ typedef struct {
     uint32_t ack_timeout_ms;       // PING → ACK timeout
     uint32_t suspect_timeout_ms;   // ALIVE → SUSPECT timeout (deprecated)
     uint32_t dead_timeout_ms;      // SUSPECT → DEAD timeout
-    uint32_t fanout;               // Number of peers to gossip to
+    uint32_t fanout;               // Max peers to gossip updates to per round
     uint32_t max_piggyback;        // Max updates per message
+    
+    // Adaptive period (protocol_period_ms is the starting point)
+    int adaptive_period;           // 0 = fixed protocol_period_ms
+    uint32_t min_protocol_period_ms;
+    uint32_t max_protocol_period_ms;  // 0 = protocol_period_ms: never slower than
+                                      // configured, so failure detection keeps its latency
+    
+    // Load summary piggyback (0 = never sample the local provider)
+    uint32_t load_report_interval_ms;
 } gossip_config_t;
 
 // Default configuration
@@ -40,7 +50,11 @@ static inline gossip_config_t gossip_default_config(void) {
         .suspect_timeout_ms = 5000,  // Unused
         .dead_timeout_ms = 5000,
         .fanout = 3,
-        .max_piggyback = 10
+        .max_piggyback = 10,
+        .adaptive_period = 1,
+        .min_protocol_period_ms = 250,
+        .max_protocol_period_ms = 0,
+        .load_report_interval_ms = 1000
     };
 }
 
@@ -59,13 +73,26 @@ typedef struct {
     uint64_t timestamp_ms;
 } gossip_member_update_t;
 
+// Network coordinate (Vivaldi, microseconds)
+#define GOSSIP_COORD_DIMS 3
+
+typedef struct {
+    float vec[GOSSIP_COORD_DIMS];  // Euclidean position
+    float height;                  // Access-link latency (non-negative)
+    float error;                   // Confidence, 0 (exact) .. 1.5 (unknown)
+} gossip_coord_t;
+
+// Message flags (optional trailers after the piggybacked updates)
+#define GOSSIP_FLAG_HAS_COORD 0x0001   // Sender's gossip_coord_t follows
+#define GOSSIP_FLAG_HAS_LOAD  0x0002   // Sender's member_load_t follows (after coord)
+
 // Gossip message
 #define GOSSIP_MAX_PAYLOAD_SIZE 1400
 
 typedef struct {
     uint8_t version;               // Protocol version (currently 1)
     uint8_t msg_type;              // gossip_msg_type_t
-    uint16_t flags;                // Reserved
+    uint16_t flags;                // GOSSIP_FLAG_* (unknown bits ignored)
     node_id_t sender_id;           // Who sent this
     node_type_t sender_type;     
     uint16_t sender_gossip_port; 
@@ -73,6 +100,8 @@ typedef struct {
     uint64_t sequence_num;         // Sender's sequence number
     uint8_t num_updates;           // Number of piggybacked updates
     gossip_member_update_t updates[GOSSIP_MAX_PIGGYBACK_UPDATES];
+    gossip_coord_t coord;          // Valid if GOSSIP_FLAG_HAS_COORD
+    member_load_t load;            // Valid if GOSSIP_FLAG_HAS_LOAD
 } gossip_message_t;
 
 // Bootstrap response (list of routers)
@@ -0,0 +1,45 @@
+// include/roole/gossip/vivaldi.h
+// Vivaldi network coordinates (height-vector model, microseconds)
+
+#ifndef ROOLE_GOSSIP_VIVALDI_H
+#define ROOLE_GOSSIP_VIVALDI_H
+
+#include "roole/gossip/gossip_types.h"
+
+#define VIVALDI_CE              0.25f    // Error adjustment gain
+#define VIVALDI_CC              0.25f    // Coordinate adjustment gain
+#define VIVALDI_INITIAL_ERROR   1.5f
+#define VIVALDI_MIN_HEIGHT_US   10.0f
+#define VIVALDI_MAX_RTT_US      10000000.0f  // Samples above 10s are discarded
+
+/**
+ * Initialize coordinate at the origin with maximum error
+ * @param coord Coordinate to initialize
+ */
+void vivaldi_init(gossip_coord_t *coord);
+
+/**
+ * Check that a (possibly remote) coordinate is finite and in range
+ * @param coord Coordinate to check
+ * @return 1 if usable, 0 otherwise
+ */
+int vivaldi_is_valid(const gossip_coord_t *coord);
+
+/**
+ * Predicted RTT between two coordinates
+ * @param a First coordinate
+ * @param b Second coordinate
+ * @return Estimated RTT in microseconds
+ */
+float vivaldi_distance_us(const gossip_coord_t *a, const gossip_coord_t *b);
+
+/**
+ * Move local coordinate towards agreement with a measured RTT
+ * @param local Local coordinate (updated in place)
+ * @param remote Remote node's advertised coordinate
+ * @param rtt_us Measured RTT in microseconds
+ * @return 0 on success, -1 if the sample was rejected
+ */
+int vivaldi_update(gossip_coord_t *local, const gossip_coord_t *remote, float rtt_us);
+
+#endif // ROOLE_GOSSIP_VIVALDI_H
@@ -0,0 +1,148 @@
+// include/roole/logger/log_binary.h
+// Binary log records: captured printf arguments, rendering and the
+// self-describing stream written by ROOLE_LOG_FORMAT=binary
+
+#ifndef ROOLE_LOG_BINARY_H
+#define ROOLE_LOG_BINARY_H
+
+#include "roole/logger/logger.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <time.h>
+
+// ============================================================================
+// ARGUMENT CAPTURE
+// ============================================================================
+
+// Argument types; each maps to one va_arg() type at capture time.
+// Integers are stored as 4 (INT) or 8 bytes, strings as u16 length + bytes.
+typedef enum {
+    LOG_ARG_INT = 1,        // int and everything promoted to it (%c, %hd)
+    LOG_ARG_LONG,           // %ld
+    LOG_ARG_LLONG,          // %lld
+    LOG_ARG_SIZE,           // %zu
+    LOG_ARG_INTMAX,         // %jd
+    LOG_ARG_PTRDIFF,        // %td
+    LOG_ARG_DOUBLE,         // %f %e %g %a
+    LOG_ARG_LONG_DOUBLE,    // %Lf
+    LOG_ARG_PTR,            // %p
+    LOG_ARG_STRING,         // %s
+    LOG_ARG_STRING_FIXED,   // %.Ns (at most spec.limit bytes read)
+    LOG_ARG_STRING_STAR     // %.*s (bounded by the preceding int)
+} log_arg_type_t;
+
+// Site states
+#define LOG_SITE_UNPARSED 0
+#define LOG_SITE_PARSING  1
+#define LOG_SITE_BINARY   2   // Arguments captured raw
+#define LOG_SITE_EAGER    3   // Format not capturable; message pre-rendered as one %s
+
+#define LOG_ARG_STRING_MAX 512      // Longer %s arguments are truncated
+#define LOG_ARGS_MAX 2048           // Encoded argument bytes per record
+
+/**
+ * Parse a printf format into argument specs
+ * @param fmt Format string
+ * @param specs Output specs
+ * @param max Capacity of specs
+ * @return Number of arguments, or -1 if the format uses something that
+ *         cannot be captured (%n, %m, %ls, too many arguments)
+ */
+int log_format_parse(const char *fmt, log_arg_spec_t *specs, int max);
+
+/**
+ * Capture arguments described by specs
+ * @param specs Argument specs from log_format_parse()
+ * @param nargs Number of specs
+ * @param args Arguments (advanced past the captured ones)
+ * @param out Output buffer
+ * @param cap Capacity of out (LOG_ARGS_MAX is always enough)
+ * @return Bytes written
+ */
+size_t log_args_encode(const log_arg_spec_t *specs, int nargs, va_list *args,
+                       uint8_t *out, size_t cap);
+
+/**
+ * Render a message from its format and captured arguments
+ * @return Length written (excluding NUL), truncated to cap - 1
+ */
+size_t log_args_render(const char *fmt, const log_arg_spec_t *specs, int nargs,
+                       const uint8_t *args, size_t args_len, char *out, size_t cap);
+
+// ============================================================================
+// LINE RENDERING
+// ============================================================================
+
+// Caches the date/time part between calls (one localtime_r per second)
+typedef struct {
+    time_t sec;
+    char text[32];
+    size_t len;
+} log_time_cache_t;
+
+// Everything needed to rebuild a text-format log line
+typedef struct {
+    uint64_t timestamp_ns;          // CLOCK_REALTIME
+    unsigned long thread_id;
+    log_level_t level;
+    const char *file;
+    int line;
+    const char *fmt;
+    const log_arg_spec_t *specs;
+    int nargs;
+    const char *context;            // "[node:N][cluster]", NULL if unset
+    size_t context_len;
+    const char *component;          // Component path, may be empty
+    size_t component_len;
+    const uint8_t *args;
+    size_t args_len;
+} log_line_t;
+
+/**
+ * Render a line exactly as the text format would have (with newline)
+ * @return Length written, truncated to cap
+ */
+size_t log_line_render(const log_line_t *line, log_time_cache_t *cache,
+                       char *out, size_t cap);
+
+// ============================================================================
+// BINARY STREAM
+// ============================================================================
+
+// Stream layout (native byte order, written by a single writer thread):
+//   header  "RLOG" u32 version
+//   SITE    u8 kind, u32 id, u8 level, u32 line, u8 nargs, specs[nargs]{u8,u16},
+//           u16 file_len, u16 fmt_len, file, fmt
+//   CONTEXT u8 kind, u16 len, "[node:N][cluster]"
+//   RECORD  u8 kind, u32 site_id, u64 timestamp_ns, u64 thread_id,
+//           u16 component_len, u16 args_len, component, args
+//   TEXT    u8 kind, u16 len, an already formatted line
+#define LOG_STREAM_MAGIC "RLOG"
+#define LOG_STREAM_VERSION 1
+
+#define LOG_STREAM_SITE    1
+#define LOG_STREAM_CONTEXT 2
+#define LOG_STREAM_RECORD  3
+#define LOG_STREAM_TEXT    4
+
+// Encoders return the bytes written, or 0 if out is too small
+
+size_t log_stream_encode_header(uint8_t *out, size_t cap);
+size_t log_stream_encode_site(uint32_t id, const log_site_t *site,
+                              uint8_t *out, size_t cap);
+size_t log_stream_encode_context(const char *text, size_t len, uint8_t *out, size_t cap);
+size_t log_stream_encode_record(uint32_t site_id, const log_line_t *line,
+                                uint8_t *out, size_t cap);
+size_t log_stream_encode_text(const char *text, size_t len, uint8_t *out, size_t cap);
+
+/**
+ * Decode a binary stream into text lines
+ * @param in Binary stream
+ * @param out Text output
+ * @return Number of records decoded, or -1 on a malformed stream
+ */
+long log_stream_decode(FILE *in, FILE *out);
+
+#endif // ROOLE_LOG_BINARY_H
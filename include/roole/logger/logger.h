@@ -3,6 +3,7 @@
 #define ROOLE_LOGGER_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include <stdarg.h>
 #include <pthread.h>
 
@@ -28,6 +29,80 @@ typedef struct log_context {
     int initialized;
 } log_context_t;
 
+// ============================================================================
+// LEVEL FILTERING
+// ============================================================================
+
+// Statements below this level are compiled out; their arguments are never
+// evaluated. Release builds default to INFO (see CMakeLists.txt).
+#ifndef ROOLE_LOG_MIN_LEVEL
+#define ROOLE_LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+#define LOG_COMPONENT_NAME_LEN 32
+#define LOG_MAX_COMPONENT_LEVELS 32
+
+// Runtime override for one component name. "raft" also covers
+// "raft:heartbeat"; the longest matching name wins.
+typedef struct {
+    char component[LOG_COMPONENT_NAME_LEN];
+    log_level_t level;
+} log_component_level_t;
+
+// Lowest level enabled anywhere (global level or any component override).
+// Checked inline so that disabled statements skip argument evaluation.
+extern int g_logger_threshold;
+
+// ============================================================================
+// CALL SITES (binary / deferred formatting)
+// ============================================================================
+
+#define LOG_SITE_MAX_ARGS 12
+
+// How one printf argument is captured (see log_binary.h)
+typedef struct {
+    uint8_t type;
+    uint16_t limit;         // Precision of a %.Ns argument
+} log_arg_spec_t;
+
+// One per LOG_* statement, static storage. The format string is parsed
+// once on first use; afterwards binary-mode calls only copy raw args.
+typedef struct log_site {
+    const char *file;
+    int line;
+    log_level_t level;
+    const char *fmt;
+    int state;              // LOG_SITE_* in log_binary.h
+    int nargs;
+    log_arg_spec_t args[LOG_SITE_MAX_ARGS];
+    uint32_t stream_id;     // Owned by the writer thread
+    uint32_t stream_epoch;
+} log_site_t;
+
+#define LOG_SITE_INIT(lvl) { .file = __FILE__, .line = __LINE__, .level = (lvl) }
+
+// ============================================================================
+// RATE LIMITING / SAMPLING
+// ============================================================================
+
+// Token bucket for one call site, kept as a single "theoretical arrival
+// time" so a check is one CAS: a message passes if now >= tat - tolerance.
+// Dropped messages are counted and reported with the next one that passes.
+typedef struct {
+    uint64_t interval_ns;   // 1s / rate
+    uint64_t tolerance_ns;  // interval * (burst - 1)
+    uint64_t tat_ns;
+    uint64_t suppressed;
+} log_ratelimit_t;
+
+#define LOG_RATELIMIT_INIT(per_sec, burst) { \
+        .interval_ns = 1000000000ULL / (per_sec), \
+        .tolerance_ns = (1000000000ULL / (per_sec)) * ((burst) - 1) }
+
+// Defaults for the LOG_*_RATELIMITED shorthands
+#define LOG_RATELIMIT_PER_SEC 10
+#define LOG_RATELIMIT_BURST 20
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
@@ -35,10 +110,19 @@ typedef struct log_context {
 void logger_init(void);
 void logger_shutdown(void);
 void logger_set_level(log_level_t level);
+log_level_t logger_get_level(void);
+int logger_parse_level(const char *name, log_level_t *level);  // 0 ok, -1 unknown
+int logger_set_component_level(const char *component, log_level_t level);  // -1 if full
+int logger_clear_component_level(const char *component);  // -1 if not set
+size_t logger_get_component_levels(log_component_level_t *out, size_t max);
 void logger_set_context(uint16_t node_id, const char *cluster_name, const char *node_type);
 void logger_log(log_level_t level, const char *file, int line, const char *fmt, ...) 
     __attribute__((format(printf, 4, 5)));
+void logger_log_site(log_site_t *site, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+int logger_ratelimit_allow(log_ratelimit_t *limit, const log_site_t *site);  // 1 = log it
 void logger_flush(void);
+const char* logger_level_to_string(log_level_t level);
 void logger_push_component(const char *component_name);  // e.g., "gossip", "rpc", "executor"
 void logger_pop_component(void);
 
@@ -46,9 +130,45 @@ void logger_pop_component(void);
 // MACROS (Replace existing LOG_* macros)
 // ============================================================================
 
-#define LOG_DEBUG(...) logger_log(LOG_LEVEL_DEBUG, __FILE__, __LINE__, __VA_ARGS__)
-#define LOG_INFO(...)  logger_log(LOG_LEVEL_INFO,  __FILE__, __LINE__, __VA_ARGS__)
-#define LOG_WARN(...)  logger_log(LOG_LEVEL_WARN,  __FILE__, __LINE__, __VA_ARGS__)
-#define LOG_ERROR(...) logger_log(LOG_LEVEL_ERROR, __FILE__, __LINE__, __VA_ARGS__)
+#define LOG_AT_SITE(lvl, ...) do { \
+        if ((lvl) >= ROOLE_LOG_MIN_LEVEL && \
+            (int)(lvl) >= __atomic_load_n(&g_logger_threshold, __ATOMIC_RELAXED)) { \
+            static log_site_t roole_log_site_ = LOG_SITE_INIT(lvl); \
+            logger_log_site(&roole_log_site_, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT_SITE(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT_SITE(LOG_LEVEL_INFO,  __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT_SITE(LOG_LEVEL_WARN,  __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT_SITE(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+// At most per_sec messages per second from this statement after an initial
+// burst; the next message that passes reports how many were dropped
+#define LOG_RATELIMITED(lvl, per_sec, burst, ...) do { \
+        if ((lvl) >= ROOLE_LOG_MIN_LEVEL && \
+            (int)(lvl) >= __atomic_load_n(&g_logger_threshold, __ATOMIC_RELAXED)) { \
+            static log_site_t roole_log_site_ = LOG_SITE_INIT(lvl); \
+            static log_ratelimit_t roole_log_limit_ = LOG_RATELIMIT_INIT(per_sec, burst); \
+            if (logger_ratelimit_allow(&roole_log_limit_, &roole_log_site_)) \
+                logger_log_site(&roole_log_site_, __VA_ARGS__); \
+        } \
+    } while (0)
+
+// Logs the 1st, (n+1)th, (2n+1)th... execution of this statement
+#define LOG_SAMPLED(lvl, n, ...) do { \
+        if ((lvl) >= ROOLE_LOG_MIN_LEVEL && \
+            (int)(lvl) >= __atomic_load_n(&g_logger_threshold, __ATOMIC_RELAXED)) { \
+            static log_site_t roole_log_site_ = LOG_SITE_INIT(lvl); \
+            static uint64_t roole_log_hits_ = 0; \
+            if (__atomic_fetch_add(&roole_log_hits_, 1, __ATOMIC_RELAXED) % (n) == 0) \
+                logger_log_site(&roole_log_site_, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_WARN_RATELIMITED(...) \
+    LOG_RATELIMITED(LOG_LEVEL_WARN, LOG_RATELIMIT_PER_SEC, LOG_RATELIMIT_BURST, __VA_ARGS__)
+#define LOG_ERROR_RATELIMITED(...) \
+    LOG_RATELIMITED(LOG_LEVEL_ERROR, LOG_RATELIMIT_PER_SEC, LOG_RATELIMIT_BURST, __VA_ARGS__)
 
 #endif // ROOLE_LOGGER_H
\ No newline at end of file
@@ -7,11 +7,25 @@
 
 #define MAX_METRIC_NAME_LEN 128
 #define MAX_METRIC_HELP_LEN 256
-#define MAX_METRICS_PER_REGISTRY 256
-#define HISTOGRAM_MAX_BUCKETS 16
+#define HISTOGRAM_MAX_BUCKETS 32          // Exported (le) buckets
 #define MAX_LABEL_NAME_LEN 64
 #define MAX_LABEL_VALUE_LEN 128
 #define MAX_LABELS_PER_METRIC 8
+#define METRICS_SHARDS 16              // Update slots per counter/gauge
+
+// Recorded histogram resolution: every power-of-two range is split into
+// 2^HISTOGRAM_SUB_BUCKET_BITS linear buckets (relative error <= 1/16).
+// Values above 2^HISTOGRAM_MAX_EXPONENT land in the last bucket.
+#define HISTOGRAM_SUB_BUCKET_BITS 4
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_MAX_EXPONENT 40
+#define HISTOGRAM_BUCKETS \
+    (1 + (HISTOGRAM_MAX_EXPONENT - HISTOGRAM_SUB_BUCKET_BITS + 1) * HISTOGRAM_SUB_BUCKETS)
+#define HISTOGRAM_SHARDS 8
+
+#define METRICS_RENDER_CHUNK_SIZE 16384
+#define METRICS_RENDER_CACHE_TTL_MS 1000    // Default; 0 renders every scrape
+#define METRICS_MAX_COLLECTORS 16
 
 // ============================================================================
 // METRIC TYPES
@@ -19,7 +33,8 @@
 
 typedef enum {
     METRIC_TYPE_COUNTER = 0,
-    METRIC_TYPE_GAUGE = 1
+    METRIC_TYPE_GAUGE = 1,
+    METRIC_TYPE_HISTOGRAM = 2
 } metric_type_t;
 
 typedef struct metric_label {
@@ -31,29 +46,46 @@ typedef struct metric_label {
 // INTERNAL STRUCTURES
 // ============================================================================
 
-typedef struct metrics {
-    char name[MAX_METRIC_NAME_LEN];
-    char help[MAX_METRIC_HELP_LEN];
-    metric_type_t type;
-    
+// One cache line per shard. Each thread is assigned a shard on its first
+// update, so increments are relaxed atomic adds on a line no other core is
+// writing (unless more than METRICS_SHARDS threads share the metric).
+typedef struct metric_shard {
+    int64_t steps;          // Whole-number inc/dec/add
+    double amount;          // Fractional adds
+} __attribute__((aligned(64))) metric_shard_t;
+
+struct metric_family;
+struct metric_index;
+
+// One labelled series of a family. Series are never removed, so pointers
+// handed out stay valid until the registry is destroyed.
+typedef struct metric_series {
+    struct metric_family *family;
     metric_label_t labels[MAX_LABELS_PER_METRIC];
     size_t num_labels;
+    uint64_t hash;                      // Of the labels
+    struct metric_series *next;         // Creation order within the family
+} metric_series_t;
+
+typedef struct metrics {
+    metric_series_t series;             // Must be first
     
-    double value;
-    pthread_mutex_t lock;
-    
-    int active;
+    // value = base + sum of all shards; gauge_set() rewrites base
+    double base;
+    metric_shard_t *shards;     // METRICS_SHARDS entries
 } metrics_t;
 
 // ============================================================================
 // HISTOGRAM CONFIGURATION
 // ============================================================================
 
-// Predefined bucket configurations
+// Exported bucket layouts. Recording always uses the fine log-linear
+// buckets; these only choose which cumulative "le" lines are rendered.
+// Powers of two are exact bucket edges, other bounds round down to one.
 typedef enum {
-    HISTOGRAM_BUCKETS_LATENCY_MS,     // 1, 5, 10, 50, 100, 500, 1000, 5000, +Inf
-    HISTOGRAM_BUCKETS_LATENCY_US,     // 100, 500, 1000, 5000, 10000, 50000, 100000, +Inf
-    HISTOGRAM_BUCKETS_SIZE_BYTES,     // 256, 1K, 4K, 16K, 64K, 256K, 1M, 4M, +Inf
+    HISTOGRAM_BUCKETS_LATENCY_MS,     // 1, 2, 4 ... 65536 (2^16), +Inf
+    HISTOGRAM_BUCKETS_LATENCY_US,     // 1, 2, 4 ... 67108864 (2^26), +Inf
+    HISTOGRAM_BUCKETS_SIZE_BYTES,     // 64, 128 ... 64M (2^26), +Inf
     HISTOGRAM_BUCKETS_CUSTOM
 } histogram_buckets_type_t;
 
@@ -66,34 +98,91 @@ typedef struct histogram_buckets {
 // HISTOGRAM STRUCTURE
 // ============================================================================
 
+// Bucket 0 holds 0; bucket i covers (upper(i-1), upper(i)], so every power
+// of two is the inclusive upper edge of a bucket, matching Prometheus "le".
+typedef struct histogram_shard {
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t count;
+    uint64_t sum;
+} __attribute__((aligned(64))) histogram_shard_t;
+
+// Point-in-time copy of a histogram; snapshots of the same layout merge
+// by adding them up (e.g. across nodes or labels)
+typedef struct histogram_snapshot {
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t count;
+    uint64_t sum;
+} histogram_snapshot_t;
+
 typedef struct histogram_metric {
+    metric_series_t series;             // Must be first
+    
+    histogram_buckets_t buckets;
+    
+    histogram_shard_t *shards;      // HISTOGRAM_SHARDS entries
+} histogram_metric_t;
+
+// ============================================================================
+// FAMILIES AND REGISTRY
+// ============================================================================
+
+// Every series sharing a name. Rendered with a single HELP/TYPE header.
+// A family created as a vector binds its label names up front.
+typedef struct metric_family {
     char name[MAX_METRIC_NAME_LEN];
     char help[MAX_METRIC_HELP_LEN];
+    metric_type_t type;
+    histogram_buckets_type_t buckets_type;
     
-    metric_label_t labels[MAX_LABELS_PER_METRIC];
-    size_t num_labels;
-    
-    histogram_buckets_t buckets;
+    char label_names[MAX_LABELS_PER_METRIC][MAX_LABEL_NAME_LEN];
+    size_t num_label_names;             // 0 unless created as a vector
     
-    // Bucket counters (atomic)
-    _Atomic uint64_t bucket_counts[HISTOGRAM_MAX_BUCKETS];
-    _Atomic uint64_t count;
-    _Atomic uint64_t sum;
+    uint64_t hash;                      // Of the name
+    struct metric_index *index;         // Series by label hash
+    metric_series_t *first;             // Creation order, walked by render
+    metric_series_t *last;
+    pthread_mutex_t lock;               // Serialises series creation
     
-    pthread_mutex_t lock;
-    int active;
-} histogram_metric_t;
+    struct metric_family *next;         // Creation order
+} metric_family_t;
 
-typedef struct metrics_registry {
-    metrics_t metrics[MAX_METRICS_PER_REGISTRY];
-    histogram_metric_t histograms[MAX_METRICS_PER_REGISTRY]; 
-    size_t count;
-    size_t histogram_count;
-    pthread_mutex_t lock;
-} metrics_registry_t;
+// Pre-bound labelled family: resolve label values to a series once, then
+// update the returned metric directly
+typedef metric_family_t metrics_vec_t;
+
+// Rendered Prometheus text: a reference-counted chain of chunks
+typedef struct metrics_text metrics_text_t;
 
+struct metrics_registry;
 
+// Scrape-time callback: copies a subsystem's own statistics into registry
+// metrics right before a render. Runs on the scraping thread with the
+// render lock held, so it must not render or (un)register collectors.
+typedef void (*metrics_collector_fn)(struct metrics_registry *reg, void *ctx);
 
+typedef struct metrics_collector {
+    metrics_collector_fn fn;
+    void *ctx;
+} metrics_collector_t;
+
+// Lookups by name and by labels are lock-free hash probes; the registry
+// lock is only taken to create a family, a family lock to create a series.
+// Both indexes grow as needed, so there is no fixed capacity.
+typedef struct metrics_registry {
+    struct metric_index *index;         // Families by name hash
+    metric_family_t *first;             // Creation order, walked by render
+    metric_family_t *last;
+    pthread_mutex_t lock;
+    
+    // Last rendered output, shared by scrapes within cache_ttl_ms
+    metrics_text_t *cached_text;
+    uint64_t cached_at_ms;
+    uint32_t cache_ttl_ms;
+    pthread_mutex_t render_lock;        // Also guards the collectors
+    
+    metrics_collector_t collectors[METRICS_MAX_COLLECTORS];
+    size_t num_collectors;
+} metrics_registry_t;
 
 // ============================================================================
 // HISTOGRAM API
@@ -112,11 +201,40 @@ histogram_metric_t* metrics_get_or_create_histogram(
 );
 
 /**
- * Observe a value in the histogram
+ * Observe a value in the histogram (negative values count as 0)
  * Thread-safe: uses atomic operations
  */
 void metrics_histogram_observe(histogram_metric_t *metric, int value);
 
+/**
+ * Record a value: O(1) bucket index, relaxed adds on the caller's shard
+ */
+void metrics_histogram_record(histogram_metric_t *metric, uint64_t value);
+
+/**
+ * Sum all shards into a snapshot
+ */
+void metrics_histogram_snapshot(const histogram_metric_t *metric,
+                                histogram_snapshot_t *out);
+
+/**
+ * Add src into dst
+ */
+void metrics_histogram_snapshot_merge(histogram_snapshot_t *dst,
+                                      const histogram_snapshot_t *src);
+
+/**
+ * Estimate a quantile (0..1) from a snapshot
+ * @return Midpoint of the bucket holding the quantile, 0 if empty
+ */
+double metrics_histogram_quantile(const histogram_snapshot_t *snap, double q);
+
+/**
+ * Bucket layout helpers
+ */
+size_t metrics_histogram_bucket_index(uint64_t value);
+uint64_t metrics_histogram_bucket_upper(size_t index);
+
 /**
  * Get predefined bucket configuration
  */
@@ -169,6 +287,40 @@ metrics_t* metrics_get_or_create_gauge(metrics_registry_t *reg,
                                         size_t num_labels,
                                         const metric_label_t *labels);
 
+// ============================================================================
+// METRIC VECTORS
+// ============================================================================
+
+/**
+ * Get or create a labelled family with fixed label names
+ * @param label_names num_labels names, e.g. {"peer", "func"}
+ * @return Vector handle, or NULL if the name exists with another type or
+ *         other label names
+ */
+metrics_vec_t* metrics_counter_vec(metrics_registry_t *reg, const char *name,
+                                   const char *help, size_t num_labels,
+                                   const char *const *label_names);
+metrics_vec_t* metrics_gauge_vec(metrics_registry_t *reg, const char *name,
+                                 const char *help, size_t num_labels,
+                                 const char *const *label_names);
+metrics_vec_t* metrics_histogram_vec(metrics_registry_t *reg, const char *name,
+                                     const char *help,
+                                     histogram_buckets_type_t buckets_type,
+                                     size_t num_labels,
+                                     const char *const *label_names);
+
+/**
+ * Series of a counter/gauge vector for the given label values (one per
+ * bound label name). Lock-free once the series exists.
+ */
+metrics_t* metrics_vec_with(metrics_vec_t *vec, const char *const *label_values);
+
+/**
+ * Series of a histogram vector for the given label values
+ */
+histogram_metric_t* metrics_vec_histogram_with(metrics_vec_t *vec,
+                                               const char *const *label_values);
+
 // ============================================================================
 // METRIC OPERATIONS (thread-safe)
 // ============================================================================
@@ -188,6 +340,12 @@ void metrics_counter_add(metrics_t *metric, double val);
  */
 void metrics_gauge_set(metrics_t *metric, double val);
 
+/**
+ * Set counter to an absolute value, for mirroring a cumulative count kept
+ * elsewhere (e.g. from a collector). Callers keep it monotonic.
+ */
+void metrics_counter_set(metrics_t *metric, double val);
+
 /**
  * Increment gauge by 1
  */
@@ -198,12 +356,71 @@ void metrics_gauge_inc(metrics_t *metric);
  */
 void metrics_gauge_dec(metrics_t *metric);
 
+/**
+ * Current value (sums the shards; meant for rendering, not hot paths)
+ */
+double metrics_get_value(const metrics_t *metric);
+
+// ============================================================================
+// COLLECTORS
+// ============================================================================
+
+/**
+ * Register a callback run before every render that is not served from the
+ * cache. Subsystems use this to export the stats they already keep,
+ * instead of a thread polling them into gauges.
+ * @return 0 on success, -1 if the collector table is full
+ */
+int metrics_registry_add_collector(metrics_registry_t *reg, metrics_collector_fn fn,
+                                   void *ctx);
+
+/**
+ * Unregister a collector. Once this returns the callback is not running
+ * and will not run again, so ctx may be freed.
+ */
+void metrics_registry_remove_collector(metrics_registry_t *reg, metrics_collector_fn fn,
+                                       void *ctx);
+
 // ============================================================================
 // PROMETHEUS TEXT FORMAT RENDERING
 // ============================================================================
 
 /**
  * Render all metrics in Prometheus text format
+ * Output is cached for the registry's TTL, so concurrent and back-to-back
+ * scrapes share one render (and one run of the collectors). Updates never
+ * wait on rendering.
+ * @param reg Registry
+ * @return Rendered text (release with metrics_text_release()), or NULL on error
+ */
+metrics_text_t* metrics_registry_render(metrics_registry_t *reg);
+
+/**
+ * Drop a reference obtained from metrics_registry_render()
+ */
+void metrics_text_release(metrics_text_t *text);
+
+/**
+ * Total rendered bytes
+ */
+size_t metrics_text_length(const metrics_text_t *text);
+
+/**
+ * Iterate over the rendered chunks
+ * @param cursor Set to NULL before the first call
+ * @param len Chunk length
+ * @return Chunk data, or NULL after the last chunk
+ */
+const char* metrics_text_next_chunk(const metrics_text_t *text, const void **cursor,
+                                    size_t *len);
+
+/**
+ * Set how long rendered output is reused (0 disables caching)
+ */
+void metrics_registry_set_cache_ttl(metrics_registry_t *reg, uint32_t ttl_ms);
+
+/**
+ * Render all metrics in Prometheus text format as one string
  * @param reg Registry
  * @return Dynamically allocated string (caller must free()), or NULL on error
  */
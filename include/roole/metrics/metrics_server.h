@@ -3,28 +3,62 @@
 
 #include "roole/metrics/metrics.h"
 #include <stdint.h>
+#include <stddef.h>
 #include <pthread.h>
 
+#define METRICS_SERVER_MAX_ENDPOINTS 8
+#define METRICS_SERVER_MAX_CONNECTIONS 64
+#define METRICS_SERVER_IDLE_TIMEOUT_MS 30000    // Keep-alive connections
+
 // ============================================================================
 // METRICS SERVER
 // ============================================================================
 
 typedef struct metrics_server metrics_server_t;
 
+/**
+ * Debug endpoint handler: write a JSON document into buf
+ * Runs on the server thread, so it should copy state out of snapshots or
+ * stats accessors rather than hold locks the hot paths need.
+ * @param ctx Context passed at registration
+ * @param buf Output buffer
+ * @param cap Capacity of buf
+ * @return Length of the full document (like snprintf; the server retries
+ *         with a larger buffer if it did not fit), or -1 on error
+ */
+typedef int (*metrics_endpoint_fn)(void *ctx, char *buf, size_t cap);
+
 /**
  * Initialize and start metrics HTTP server
+ * Serves HTTP/1.1 with keep-alive from a single epoll thread;
+ * /metrics is gzip-compressed when the client accepts it.
  * @param registry Metrics registry to expose
  * @param bind_addr IP address to bind (e.g., "0.0.0.0")
  * @param port Port to listen on
- * @return Server handle, or NULL on error
+ * @return Server handle, or NULL on error (including bind failure)
  */
 metrics_server_t* metrics_server_start(metrics_registry_t *registry,
                                         const char *bind_addr,
                                         uint16_t port);
 
+/**
+ * Expose a JSON endpoint (e.g. "/debug/raft") answered by handler
+ * @return 0 on success, -1 if the path is taken or the table is full
+ */
+int metrics_server_add_endpoint(metrics_server_t *server, const char *path,
+                                metrics_endpoint_fn handler, void *ctx);
+
+/**
+ * Allow or refuse log level changes over HTTP
+ * GET /loglevel always works; PUT/DELETE answer 403 unless enabled.
+ * Off by default: the endpoint has no authentication.
+ */
+void metrics_server_set_log_control(metrics_server_t *server, int enabled);
+
 /**
  * Shutdown metrics server
+ * Stops the server thread and closes every connection
  */
 void metrics_server_shutdown(metrics_server_t *server);
 
-#endif // ROOLE_METRICS_SERVER_H
\ No newline at end of file
+#endif // ROOLE_METRICS_SERVER_H
@@ -5,7 +5,6 @@
 #define ROOLE_NODE_CAPABILITIES_H
 
 #include "roole/config/config.h"
-#include "roole/node/node_state.h"
 
 typedef struct node_identity node_identity_t;
 
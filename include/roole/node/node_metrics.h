@@ -5,10 +5,13 @@
 #define ROOLE_NODE_METRICS_H
 
 #include "roole/node/node_state.h"
+#include "roole/rpc/rpc_server.h"
 
 /**
  * Initialize metrics system for node
- * Creates registry, registers metrics, starts HTTP server
+ * Creates registry, registers metrics and the scrape-time collectors that
+ * export raft, RPC, gossip, transport and event bus statistics, starts
+ * HTTP server
  * @param state Node state
  * @param metrics_addr Metrics address (ip:port), or NULL to disable
  * @return 0 on success, error code on failure
@@ -24,16 +27,26 @@ void node_metrics_shutdown(node_state_t *state);
 
 /**
  * Update cluster metrics
- * Updates cluster member counts
+ * Updates cluster member counts (also run by the node collector per scrape)
  * @param state Node state
  */
 void node_metrics_update_cluster(node_state_t *state);
 
 /**
- * Update periodic metrics
- * Called by metrics update thread
+ * Record per-func_id request latency of an RPC server
+ * No-op when metrics are disabled. Detached again by node_metrics_shutdown.
  * @param state Node state
+ * @param server RPC server
+ * @param name Value of the "server" label ("data", "ingress")
  */
-void node_metrics_update_periodic(node_state_t *state);
+void node_metrics_attach_rpc_server(node_state_t *state, rpc_server_t *server,
+                                    const char *name);
 
-#endif // ROOLE_NODE_METRICS_H
\ No newline at end of file
+/**
+ * Stop recording an RPC server's requests (before destroying it)
+ * @param state Node state
+ * @param server RPC server passed to node_metrics_attach_rpc_server
+ */
+void node_metrics_detach_rpc_server(node_state_t *state, rpc_server_t *server);
+
+#endif // ROOLE_NODE_METRICS_H
@@ -37,6 +37,7 @@ typedef struct node_state {
     // Cluster membership (owns the view)
     cluster_view_t *cluster_view;
     membership_handle_t *membership;
+    gossip_keyring_t *gossip_keyring;      // NULL = plaintext gossip
     
     // Peer tracking
     peer_pool_t *peer_pool;
@@ -49,7 +50,7 @@ typedef struct node_state {
     // Raft consensus 
     raft_state_t *raft_state;              // Raft state machine
     raft_datastore_t *raft_datastore;      // Strongly consistent KV store
-    pthread_t raft_peer_sync_thread;       // Peer discovery thread
+    struct raft_peer_sync *raft_peer_sync; // Event-driven peer discovery
     
     // Metrics references (for fast access)
     metrics_t *metric_cluster_members_total;
@@ -64,6 +65,7 @@ typedef struct node_state {
 
     histogram_metric_t *histogram_gossip_rtt;
     histogram_metric_t *histogram_datastore_op_duration;
+    struct node_rpc_metrics *rpc_metrics;  // Per-RPC-server latency observers
     
     // Lifecycle
     uint64_t start_time_ms;
@@ -71,7 +73,6 @@ typedef struct node_state {
     
     // Background threads
     pthread_t cleanup_thread;
-    pthread_t metrics_update_thread;
     
     // Statistics (atomic counters)
     _Atomic uint64_t datastore_ops_total;
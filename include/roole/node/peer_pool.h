@@ -8,10 +8,21 @@
 #include "roole/cluster/cluster_view.h"
 #include "roole/rpc/rpc_channel.h"
 #include "roole/node/node_capabilities.h"
+#include "roole/node/peer_ring.h"
 #include <pthread.h>
 
 #define MAX_PEERS 512
 
+// Live load and latency of one peer. Updated in place by gossip ACKs and
+// load summaries, and shared with every snapshot that lists the peer, so
+// those updates never republish the snapshot.
+typedef struct peer_stats {
+    uint32_t refcount;            // Atomic: pool entry + referencing snapshots
+    uint32_t active_executions;   // Atomic
+    float load_score;             // Atomic
+    uint32_t rtt_us;              // Atomic: estimated RTT (0 = unknown)
+} peer_stats_t;
+
 // Peer information
 typedef struct {
     node_id_t node_id;
@@ -21,20 +32,42 @@ typedef struct {
     uint16_t data_port;
     node_status_t status;
     
-    uint32_t active_executions;
-    float load_score;
+    peer_stats_t *stats;          // Load and RTT (see peer_pool_update_*)
     uint64_t last_seen_ms;
     
     rpc_channel_t *data_channel;  // RPC channel for peer communication
     node_capabilities_t capabilities;
 } peer_info_t;
 
+// Routing view of one dispatchable peer (ALIVE and can_execute)
+typedef struct {
+    node_id_t node_id;
+    peer_stats_t *stats;          // Live, not frozen with the snapshot
+} peer_choice_t;
+
+// Immutable, refcounted snapshot of dispatchable peers
+typedef struct {
+    rcu_head_t rcu;
+    uint64_t version;
+    size_t count;
+    peer_choice_t peers[];
+} peer_pool_snapshot_t;
+
 // Peer pool
 typedef struct {
     peer_info_t *peers;
     size_t count;
     size_t capacity;
     pthread_mutex_t lock;
+    
+    // Lock-free read side for selectors (republished on membership,
+    // status and capability changes; load and RTT live in peer_stats_t)
+    rcu_slot_t alive;             // peer_pool_snapshot_t
+    uint64_t version;
+    size_t rr_index;              // Round-robin cursor (atomic)
+    
+    // Consistent-hash ring over the same dispatchable set (key affinity)
+    peer_ring_t ring;
 } peer_pool_t;
 
 /**
@@ -83,6 +116,8 @@ int peer_pool_update_status(peer_pool_t *pool, node_id_t node_id, node_status_t
 /**
  * Get peer by ID
  * Returns pointer (lock held) - caller must call peer_pool_release()
+ * Writes through the pointer are not seen by selectors; use the
+ * peer_pool_update_* functions instead.
  * @param pool Pool structure
  * @param node_id Node ID
  * @return Peer pointer, or NULL if not found
@@ -95,13 +130,45 @@ peer_info_t* peer_pool_get(peer_pool_t *pool, node_id_t node_id);
  */
 void peer_pool_release(peer_pool_t *pool);
 
+/**
+ * Acquire current snapshot of dispatchable peers
+ * Lock-free; never blocks writers. Must be released.
+ * @param pool Pool structure
+ * @return Snapshot (possibly empty), or NULL if pool not initialized
+ */
+peer_pool_snapshot_t* peer_pool_snapshot_acquire(peer_pool_t *pool);
+
+/**
+ * Release snapshot reference
+ * @param snap Snapshot from peer_pool_snapshot_acquire() (NULL ok)
+ */
+void peer_pool_snapshot_release(peer_pool_snapshot_t *snap);
+
+/**
+ * Select peer by power-of-two-choices
+ * Picks two random dispatchable peers and returns the less loaded one.
+ * O(1) and lock-free; safe from any number of dispatching threads.
+ * @param pool Pool structure
+ * @return Node ID, or 0 if none available
+ */
+node_id_t peer_pool_select_p2c(peer_pool_t *pool);
+
 /**
  * Select least loaded peer
+ * O(N) scan of the dispatchable snapshot (lock-free)
  * @param pool Pool structure
  * @return Node ID of least loaded peer, or 0 if none available
  */
 node_id_t peer_pool_select_least_loaded(peer_pool_t *pool);
 
+/**
+ * Select nearest peer by estimated RTT
+ * Peers with unknown RTT are only chosen if no estimate exists at all.
+ * @param pool Pool structure
+ * @return Node ID of nearest peer, or 0 if none available
+ */
+node_id_t peer_pool_select_nearest(peer_pool_t *pool);
+
 /**
  * Select peer using round-robin
  * @param pool Pool structure
@@ -109,6 +176,18 @@ node_id_t peer_pool_select_least_loaded(peer_pool_t *pool);
  */
 node_id_t peer_pool_select_round_robin(peer_pool_t *pool);
 
+/**
+ * Select peer owning a routing key (consistent hashing)
+ * The same key maps to the same peer while it stays dispatchable; a
+ * membership change only moves the keys of the joining/leaving peer.
+ * O(log N) and lock-free.
+ * @param pool Pool structure
+ * @param key Routing key bytes
+ * @param key_len Key length
+ * @return Node ID, or 0 if none available
+ */
+node_id_t peer_pool_select_by_key(peer_pool_t *pool, const void *key, size_t key_len);
+
 /**
  * List alive peers
  * @param pool Pool structure
@@ -140,6 +219,15 @@ size_t peer_pool_list_by_capability(peer_pool_t *pool, int can_execute,
 int peer_pool_update_load(peer_pool_t *pool, node_id_t node_id,
                           uint32_t active_execs, float load_score);
 
+/**
+ * Update peer latency estimate
+ * @param pool Pool structure
+ * @param node_id Node ID
+ * @param rtt_us Estimated RTT in microseconds
+ * @return 0 on success
+ */
+int peer_pool_update_latency(peer_pool_t *pool, node_id_t node_id, uint32_t rtt_us);
+
 /**
  * Update peer capabilities
  * @param pool Pool structure
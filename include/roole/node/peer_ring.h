@@ -0,0 +1,91 @@
+// include/roole/node/peer_ring.h
+// Consistent-hash ring over dispatchable peers (key-affine routing)
+
+#ifndef ROOLE_NODE_PEER_RING_H
+#define ROOLE_NODE_PEER_RING_H
+
+#include "roole/core/common.h"
+#include "roole/core/rcu.h"
+
+#define PEER_RING_DEFAULT_VNODES 64
+#define PEER_RING_MAX_VNODES     1024
+
+// One virtual node on the ring
+typedef struct {
+    uint64_t hash;
+    node_id_t node_id;
+} peer_ring_point_t;
+
+// Immutable, refcounted ring (points sorted by hash, then node_id)
+typedef struct {
+    rcu_head_t rcu;
+    uint64_t version;
+    size_t member_count;
+    size_t point_count;
+    node_id_t *members;           // Sorted, points into this allocation
+    peer_ring_point_t points[];
+} peer_ring_snapshot_t;
+
+// Ring handle; writers must be serialized by the caller
+typedef struct {
+    uint32_t vnodes;
+    uint64_t version;
+    rcu_slot_t current;           // peer_ring_snapshot_t
+} peer_ring_t;
+
+/**
+ * Initialize an empty ring
+ * @param ring Ring structure
+ * @param vnodes Virtual nodes per member (0 = PEER_RING_DEFAULT_VNODES)
+ * @return 0 on success, error code on failure
+ */
+int peer_ring_init(peer_ring_t *ring, uint32_t vnodes);
+
+/**
+ * Destroy ring (held snapshots stay valid until released)
+ * @param ring Ring structure
+ */
+void peer_ring_destroy(peer_ring_t *ring);
+
+/**
+ * Replace the member set
+ * Only points of added/removed members are touched; the rest of the
+ * ring is merged over as-is. No-op if the set is unchanged.
+ * @param ring Ring structure
+ * @param members Member node IDs (any order)
+ * @param count Number of members
+ * @return 1 if a new ring was published, 0 if unchanged, <0 on error
+ */
+int peer_ring_update(peer_ring_t *ring, const node_id_t *members, size_t count);
+
+/**
+ * Acquire current ring snapshot (lock-free, must be released)
+ * @param ring Ring structure
+ * @return Snapshot, or NULL if ring not initialized
+ */
+peer_ring_snapshot_t* peer_ring_acquire(peer_ring_t *ring);
+
+/**
+ * Release ring snapshot
+ * @param snap Snapshot from peer_ring_acquire() (NULL ok)
+ */
+void peer_ring_release(peer_ring_snapshot_t *snap);
+
+/**
+ * Find owner of a key hash in a snapshot
+ * O(log N) binary search for the first point clockwise of key_hash.
+ * @param snap Ring snapshot
+ * @param key_hash Hash of the routing key (see hash_bytes())
+ * @return Owner node ID, or 0 if ring is empty
+ */
+node_id_t peer_ring_snapshot_lookup(const peer_ring_snapshot_t *snap, uint64_t key_hash);
+
+/**
+ * Find owner of a key hash
+ * @param ring Ring structure
+ * @param key_hash Hash of the routing key
+ * @return Owner node ID, or 0 if ring is empty
+ */
+node_id_t peer_ring_lookup(peer_ring_t *ring, uint64_t key_hash);
+
+#endif // ROOLE_NODE_PEER_RING_H
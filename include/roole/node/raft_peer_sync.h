@@ -0,0 +1,67 @@
+// include/roole/node/raft_peer_sync.h
+// Event-driven Raft peer membership (driven by gossip member events)
+
+#ifndef ROOLE_NODE_RAFT_PEER_SYNC_H
+#define ROOLE_NODE_RAFT_PEER_SYNC_H
+
+#include "roole/core/common.h"
+#include "roole/cluster/cluster_view.h"
+#include "roole/raft/raft_state.h"
+
+#define RAFT_PEER_SYNC_DEFAULT_DEBOUNCE_MS   200
+#define RAFT_PEER_SYNC_RECONCILE_INTERVAL_MS 30000
+
+typedef struct raft_peer_sync raft_peer_sync_t;
+
+/**
+ * Create Raft peer synchronizer
+ * Changes are debounced: a JOIN followed by FAILED within the window is a no-op.
+ * @param raft Raft state to add/remove peers on
+ * @param view Cluster view (used for initial and periodic reconcile)
+ * @param self_id This node's ID (never added as peer)
+ * @param debounce_ms Debounce window (0 = default)
+ * @return Synchronizer handle, or NULL on error
+ */
+raft_peer_sync_t* raft_peer_sync_create(raft_state_t *raft,
+                                        cluster_view_t *view,
+                                        node_id_t self_id,
+                                        uint32_t debounce_ms);
+
+/**
+ * Start apply thread
+ * Performs an initial reconcile against the cluster view.
+ * @param sync Synchronizer handle
+ * @return 0 on success, -1 on error
+ */
+int raft_peer_sync_start(raft_peer_sync_t *sync);
+
+/**
+ * Feed a membership event (member_event_cb compatible payload)
+ * O(1): records desired state for node_id and wakes the apply thread.
+ * @param sync Synchronizer handle
+ * @param node_id Node ID
+ * @param ip_address Node IP (used for JOIN)
+ * @param data_port Node data port (used for JOIN)
+ * @param event_type MEMBER_EVENT_* string
+ */
+void raft_peer_sync_notify(raft_peer_sync_t *sync,
+                           node_id_t node_id,
+                           const char *ip_address,
+                           uint16_t data_port,
+                           const char *event_type);
+
+/**
+ * Request a full diff against the cluster view now, instead of waiting for
+ * the periodic reconcile (e.g. after a backlog overflow or partition heal).
+ * Resulting changes go through the usual debounce.
+ * @param sync Synchronizer handle
+ */
+void raft_peer_sync_reconcile(raft_peer_sync_t *sync);
+
+/**
+ * Stop apply thread and free resources
+ * @param sync Synchronizer handle
+ */
+void raft_peer_sync_destroy(raft_peer_sync_t *sync);
+
+#endif // ROOLE_NODE_RAFT_PEER_SYNC_H
@@ -171,6 +171,17 @@ int raft_deserialize_install_snapshot_resp(const uint8_t *buffer,
                                             raft_install_snapshot_resp_t *resp);
 
 // Log entry serialization (for AppendEntries)
+// Untraced entries keep the original layout. A traced entry sets
+// RAFT_ENTRY_FLAG_TRACED in the type byte and appends its trace ID; nodes
+// that predate the flag cannot parse such entries, so tracing must stay off
+// (ROOLE_TRACE_SAMPLE unset or 0) until every node in the cluster is upgraded.
+#define RAFT_LOG_ENTRY_FIXED_SIZE 31    // Serialized entry size excluding data and extension
+#define RAFT_ENTRY_FLAG_TRACED 0x80     // Type byte flag: trace ID follows client_id
+#define RAFT_ENTRY_TRACE_EXT_SIZE 8
+
+// Serialized size of entry, including data and the trace extension
+size_t raft_log_entry_wire_size(const raft_log_entry_t *entry);
+
 size_t raft_serialize_log_entry(const raft_log_entry_t *entry,
                                  uint8_t *buffer,
                                  size_t buffer_size);
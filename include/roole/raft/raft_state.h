@@ -208,6 +208,15 @@ uint64_t raft_get_last_applied(raft_state_t *state);
  */
 void raft_get_stats(raft_state_t *state, raft_stats_t *out_stats);
 
+/**
+ * Get per-peer replication progress (leader only)
+ * @param state Raft state
+ * @param out Output array
+ * @param max Capacity of out
+ * @return Number of peers written; 0 when not leader
+ */
+size_t raft_get_peer_progress(raft_state_t *state, raft_peer_progress_t *out, size_t max);
+
 /**
  * Check if this node is leader
  * @param state Raft state
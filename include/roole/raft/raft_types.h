@@ -54,6 +54,7 @@ typedef struct raft_log_entry {
     // Metadata
     uint64_t timestamp_ms;       // When entry was created
     node_id_t client_id;         // Which client submitted (0 for internal)
+    uint64_t trace_id;           // Request trace (0 = untraced), see core/trace.h
 } raft_log_entry_t;
 
 // ============================================================================
@@ -248,6 +249,14 @@ typedef struct raft_stats {
     pthread_mutex_t lock;
 } raft_stats_t;
 
+// Leader's view of one follower's replication
+typedef struct raft_peer_progress {
+    node_id_t peer_id;
+    uint64_t next_index;
+    uint64_t match_index;
+    uint64_t lag;                     // Leader's last log index - match_index
+} raft_peer_progress_t;
+
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
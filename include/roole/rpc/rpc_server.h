@@ -18,6 +18,7 @@ typedef struct {
     size_t max_connections;
     size_t buffer_size;
     int recv_timeout_ms;
+    int trace_requests;           // Start a trace for untraced requests (cluster entry)
 } rpc_server_config_t;
 
 /**
@@ -70,4 +71,23 @@ typedef struct {
 
 void rpc_server_get_stats(rpc_server_t *server, rpc_server_stats_t *out_stats);
 
+/**
+ * Per-request hook, called on the server thread after each response is
+ * sent (handler time plus send). Must not block.
+ */
+typedef struct rpc_server_observer {
+    void (*on_request)(void *ctx, uint8_t func_id, uint8_t status, uint64_t duration_us);
+    void *ctx;
+} rpc_server_observer_t;
+
+/**
+ * Set the per-request observer
+ * Returns once no request is still calling the previous observer, so it
+ * may be freed afterwards. Must not be called from on_request.
+ * @param server Server handle
+ * @param observer Observer (NULL to disable); caller-owned, must stay valid
+ *        while set
+ */
+void rpc_server_set_observer(rpc_server_t *server, const rpc_server_observer_t *observer);
+
 #endif // ROOLE_RPC_SERVER_H
\ No newline at end of file
@@ -15,6 +15,13 @@
 #define RPC_TYPE_REQUEST 0x01
 #define RPC_TYPE_RESPONSE 0x02
 
+// Flag in the type nibble: an 8-byte trace ID follows the fixed header
+// (and is counted in total_len). Untraced messages are unchanged on the wire;
+// peers that predate the flag reject traced ones, so only enable tracing
+// once every node in the cluster understands it.
+#define RPC_TYPE_FLAG_TRACED 0x08
+#define RPC_TRACE_EXT_SIZE 8
+
 // Status codes
 typedef enum {
     RPC_STATUS_SUCCESS = 0x00,
@@ -74,6 +81,8 @@ typedef struct {
     node_id_t sender_id;          // Sender node ID
     rpc_type_status_t type_and_status;  // Combined type and status
     uint8_t func_id;              // Function ID
+    uint8_t flags;                // RPC_TYPE_FLAG_* found in the type nibble
+    uint64_t trace_id;            // 0 = untraced (see rpc_unpack_trace)
 } rpc_header_t;
 
 // Serialization functions
@@ -81,6 +90,20 @@ size_t rpc_pack_message(uint8_t *buffer, node_id_t node_id, uint32_t request_id,
                         uint8_t type, uint8_t status, uint8_t func_id,
                         const uint8_t *payload, size_t payload_len);
 
+// Same as rpc_pack_message, tagging the message with a trace ID (0 = none)
+size_t rpc_pack_message_traced(uint8_t *buffer, node_id_t node_id, uint32_t request_id,
+                               uint8_t type, uint8_t status, uint8_t func_id,
+                               uint64_t trace_id,
+                               const uint8_t *payload, size_t payload_len);
+
+// Parses the fixed RPC_HEADER_SIZE bytes; the traced flag is stripped from
+// the type and recorded so rpc_header_len() accounts for the extension
 int rpc_unpack_header(const uint8_t *buffer, rpc_header_t *header);
 
+// Header length including extensions; the payload starts here
+size_t rpc_header_len(const rpc_header_t *header);
+
+// Read the trace ID of a traced message (buffer holds rpc_header_len() bytes)
+void rpc_unpack_trace(const uint8_t *buffer, rpc_header_t *header);
+
 #endif // ROOLE_RPC_TYPES_H
\ No newline at end of file
@@ -4,7 +4,78 @@
 #include <stdlib.h>
 
 // ============================================================================
-// CLUSTER VIEW IMPLEMENTATION (Unchanged)
+// SNAPSHOT PUBLICATION (RCU-style)
+// ============================================================================
+
+// Copy the member table into a fresh snapshot and swap it in.
+// Caller must hold the write lock (or be the sole owner during init).
+static int publish_snapshot_locked(cluster_view_t *view) {
+    cluster_view_snapshot_t *snap = malloc(sizeof(cluster_view_snapshot_t) +
+                                           view->count * sizeof(cluster_member_t));
+    if (!snap) {
+        LOG_ERROR("Failed to allocate cluster view snapshot");
+        return RESULT_ERR_NOMEM;
+    }
+    
+    rcu_head_init(&snap->rcu);
+    snap->version = ++view->version;
+    snap->count = view->count;
+    if (view->count > 0) {
+        memcpy(snap->members, view->members, view->count * sizeof(cluster_member_t));
+    }
+    
+    rcu_publish(&view->snapshot, &snap->rcu);
+    return RESULT_OK;
+}
+
+cluster_view_snapshot_t* cluster_view_snapshot_acquire(cluster_view_t *view) {
+    if (!view) return NULL;
+    
+    return (cluster_view_snapshot_t*)rcu_acquire(&view->snapshot);
+}
+
+void cluster_view_snapshot_release(cluster_view_snapshot_t *snap) {
+    rcu_release(snap ? &snap->rcu : NULL);
+}
+
+const cluster_member_t* cluster_view_snapshot_find(const cluster_view_snapshot_t *snap,
+                                                   node_id_t node_id) {
+    if (!snap) return NULL;
+    
+    for (size_t i = 0; i < snap->count; i++) {
+        if (snap->members[i].node_id == node_id) {
+            return &snap->members[i];
+        }
+    }
+    return NULL;
+}
+
+int cluster_view_lookup(cluster_view_t *view, node_id_t node_id,
+                        cluster_member_t *out) {
+    if (!view || !out) return RESULT_ERR_INVALID;
+    
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(view);
+    const cluster_member_t *m = cluster_view_snapshot_find(snap, node_id);
+    if (m) {
+        *out = *m;
+    }
+    cluster_view_snapshot_release(snap);
+    
+    return m ? RESULT_OK : RESULT_ERR_NOTFOUND;
+}
+
+uint64_t cluster_view_version(cluster_view_t *view) {
+    if (!view) return 0;
+    
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(view);
+    uint64_t version = snap ? snap->version : 0;
+    cluster_view_snapshot_release(snap);
+    
+    return version;
+}
+
+// ============================================================================
+// CLUSTER VIEW IMPLEMENTATION
 // ============================================================================
 
 int cluster_view_init(cluster_view_t *view, size_t capacity) {
@@ -25,6 +96,12 @@ int cluster_view_init(cluster_view_t *view, size_t capacity) {
         return RESULT_ERR_INVALID;
     }
     
+    if (publish_snapshot_locked(view) != RESULT_OK) {
+        pthread_rwlock_destroy(&view->lock);
+        safe_free(view->members);
+        return RESULT_ERR_NOMEM;
+    }
+    
     LOG_INFO("Cluster view initialized (capacity: %zu)", capacity);
     return RESULT_OK;
 }
@@ -39,6 +116,9 @@ void cluster_view_destroy(cluster_view_t *view) {
     view->count = 0;
     view->capacity = 0;
     
+    // Outstanding reader references keep their snapshot alive
+    rcu_publish(&view->snapshot, NULL);
+    
     pthread_rwlock_unlock(&view->lock);
     pthread_rwlock_destroy(&view->lock);
     
@@ -60,6 +140,7 @@ int cluster_view_add(cluster_view_t *view, const cluster_member_t *member) {
                 view->members[i] = *member;
                 view->members[i].last_seen_ms = time_now_ms();
                 //view->members[i].incarnation = member->incarnation + 1;
+                publish_snapshot_locked(view);
                 pthread_rwlock_unlock(&view->lock);
                 LOG_INFO("Node %u rejoined cluster (was DEAD, now ALIVE, incarnation=%lu)", 
                          member->node_id, view->members[i].incarnation);
@@ -68,6 +149,7 @@ int cluster_view_add(cluster_view_t *view, const cluster_member_t *member) {
             else if (member->incarnation >= view->members[i].incarnation) {
                 view->members[i] = *member;
                 view->members[i].last_seen_ms = time_now_ms();
+                publish_snapshot_locked(view);
                 pthread_rwlock_unlock(&view->lock);
                 LOG_DEBUG("Updated existing member %u (incarnation=%lu)", 
                           member->node_id, member->incarnation);
@@ -96,6 +178,7 @@ int cluster_view_add(cluster_view_t *view, const cluster_member_t *member) {
     }
     view->count++;
     
+    publish_snapshot_locked(view);
     pthread_rwlock_unlock(&view->lock);
     
     LOG_INFO("Added member %u (%s:%u, type=%d)", 
@@ -123,6 +206,7 @@ int cluster_view_update_status(cluster_view_t *view, node_id_t node_id,
                     view->members[i].last_seen_ms = time_now_ms();
                 }
                 
+                publish_snapshot_locked(view);
                 pthread_rwlock_unlock(&view->lock);
                 LOG_DEBUG("Updated node %u status to %d (incarnation %lu)", 
                           node_id, status, incarnation);
@@ -150,6 +234,7 @@ int cluster_view_remove(cluster_view_t *view, node_id_t node_id) {
                        (view->count - i - 1) * sizeof(cluster_member_t));
             }
             view->count--;
+            publish_snapshot_locked(view);
             pthread_rwlock_unlock(&view->lock);
             LOG_INFO("Removed member %u", node_id);
             return RESULT_OK;
@@ -185,16 +270,17 @@ size_t cluster_view_list_by_type(cluster_view_t *view, node_type_t type,
                                  node_id_t *out_node_ids, size_t max_count) {
     if (!view || !out_node_ids || max_count == 0) return 0;
     
-    pthread_rwlock_rdlock(&view->lock);
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(view);
+    if (!snap) return 0;
     
     size_t found = 0;
-    for (size_t i = 0; i < view->count && found < max_count; i++) {
-        if (view->members[i].node_type == type) {
-            out_node_ids[found++] = view->members[i].node_id;
+    for (size_t i = 0; i < snap->count && found < max_count; i++) {
+        if (snap->members[i].node_type == type) {
+            out_node_ids[found++] = snap->members[i].node_id;
         }
     }
     
-    pthread_rwlock_unlock(&view->lock);
+    cluster_view_snapshot_release(snap);
     
     return found;
 }
@@ -203,17 +289,18 @@ size_t cluster_view_list_alive(cluster_view_t *view, node_type_t type,
                                node_id_t *out_node_ids, size_t max_count) {
     if (!view || !out_node_ids || max_count == 0) return 0;
     
-    pthread_rwlock_rdlock(&view->lock);
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(view);
+    if (!snap) return 0;
     
     size_t found = 0;
-    for (size_t i = 0; i < view->count && found < max_count; i++) {
-        if (view->members[i].node_type == type && 
-            view->members[i].status == NODE_STATUS_ALIVE) {
-            out_node_ids[found++] = view->members[i].node_id;
+    for (size_t i = 0; i < snap->count && found < max_count; i++) {
+        if (snap->members[i].node_type == type && 
+            snap->members[i].status == NODE_STATUS_ALIVE) {
+            out_node_ids[found++] = snap->members[i].node_id;
         }
     }
     
-    pthread_rwlock_unlock(&view->lock);
+    cluster_view_snapshot_release(snap);
     
     return found;
 }
@@ -221,18 +308,20 @@ size_t cluster_view_list_alive(cluster_view_t *view, node_type_t type,
 void cluster_view_dump(cluster_view_t *view, const char *label) {
     if (!view) return;
     
-    pthread_rwlock_rdlock(&view->lock);
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(view);
+    if (!snap) return;
     
     LOG_INFO("========================================");
     LOG_INFO("Cluster View Dump: %s", label ? label : "");
     LOG_INFO("========================================");
-    LOG_INFO("Total members: %zu (capacity: %zu)", view->count, view->capacity);
+    LOG_INFO("Total members: %zu (capacity: %zu, version: %lu)",
+             snap->count, view->capacity, snap->version);
     
-    if (view->count == 0) {
+    if (snap->count == 0) {
         LOG_INFO("  (empty)");
     } else {
-        for (size_t i = 0; i < view->count; i++) {
-            cluster_member_t *m = &view->members[i];
+        for (size_t i = 0; i < snap->count; i++) {
+            const cluster_member_t *m = &snap->members[i];
             const char *status_str = (m->status == NODE_STATUS_ALIVE) ? "ALIVE" :
                                     (m->status == NODE_STATUS_SUSPECT) ? "SUSPECT" : "DEAD";
             const char *type_str = (m->node_type == NODE_TYPE_ROUTER) ? "ROUTER" : "WORKER";
@@ -246,5 +335,5 @@ void cluster_view_dump(cluster_view_t *view, const char *label) {
     
     LOG_INFO("========================================");
     
-    pthread_rwlock_unlock(&view->lock);
+    cluster_view_snapshot_release(snap);
 }
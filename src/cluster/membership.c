@@ -138,6 +138,51 @@ int membership_set_callback(membership_handle_t *handle, member_event_cb callbac
     return RESULT_OK;
 }
 
+int membership_set_rtt_callback(membership_handle_t *handle, member_rtt_cb callback, void *user_data) {
+    if (!handle) return RESULT_ERR_INVALID;
+    
+    if (handle->gossip_engine) {
+        gossip_engine_set_rtt_callback(handle->gossip_engine, callback, user_data);
+    }
+    
+    return RESULT_OK;
+}
+
+int membership_set_load_callbacks(membership_handle_t *handle,
+                                  member_load_provider_cb provider,
+                                  member_load_cb callback,
+                                  void *user_data) {
+    if (!handle) return RESULT_ERR_INVALID;
+    
+    if (handle->gossip_engine) {
+        gossip_engine_set_load_callbacks(handle->gossip_engine, provider, callback, user_data);
+    }
+    
+    return RESULT_OK;
+}
+
+int membership_set_keyring(membership_handle_t *handle, gossip_keyring_t *keyring) {
+    if (!handle || !handle->gossip_engine) return RESULT_ERR_INVALID;
+    
+    if (gossip_engine_set_keyring(handle->gossip_engine, keyring) != 0) {
+        return RESULT_ERR_INVALID;
+    }
+    
+    return RESULT_OK;
+}
+
+uint32_t membership_estimate_rtt_us(membership_handle_t *handle, node_id_t node_id) {
+    if (!handle || !handle->gossip_engine) return 0;
+    
+    return gossip_engine_estimate_rtt_us(handle->gossip_engine, node_id);
+}
+
+gossip_engine_t* membership_get_gossip_engine(membership_handle_t *handle) {
+    if (!handle) return NULL;
+    
+    return handle->gossip_engine;
+}
+
 int membership_leave(membership_handle_t *handle) {
     if (!handle) return RESULT_ERR_INVALID;
     
@@ -178,14 +223,13 @@ size_t membership_get_members(membership_handle_t *handle,
                               size_t max_count) {
     if (!handle || !out_members || max_count == 0) return 0;
     
-    // ✅ CHANGED: Access shared_view
-    pthread_rwlock_rdlock(&handle->shared_view->lock);
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(handle->shared_view);
+    if (!snap) return 0;
     
-    size_t count = ROOLE_MIN(handle->shared_view->count, max_count);
-    memcpy(out_members, handle->shared_view->members, 
-           count * sizeof(cluster_member_t));
+    size_t count = ROOLE_MIN(snap->count, max_count);
+    memcpy(out_members, snap->members, count * sizeof(cluster_member_t));
     
-    pthread_rwlock_unlock(&handle->shared_view->lock);
+    cluster_view_snapshot_release(snap);
     
     return count;
 }
@@ -213,6 +213,25 @@ int config_load_from_file(const char *path, roole_config_t *config) {
                 safe_strncpy(config->ports.metrics_addr, value, MAX_CONFIG_STRING);
             }
         }        
+        else if (strcasecmp(current_section, "Security") == 0) {
+            if (strcasecmp(key, "gossip_keys") == 0) {
+                safe_strncpy(config->gossip_keys, value, MAX_CONFIG_STRING);
+            }
+        }
+        else if (strcasecmp(current_section, "Events") == 0) {
+            if (strcasecmp(key, "dispatch_lanes") == 0) {
+                if (strcasecmp(value, "shared") == 0) {
+                    config->event_lanes = EVENT_LANES_SHARED;
+                } else if (strcasecmp(value, "per_type") == 0) {
+                    config->event_lanes = EVENT_LANES_PER_TYPE;
+                } else if (strcasecmp(value, "per_subscriber") == 0) {
+                    config->event_lanes = EVENT_LANES_PER_SUBSCRIBER;
+                } else {
+                    LOG_WARN("Unknown dispatch_lanes mode: %s", value);
+                    config->event_lanes = EVENT_LANES_SHARED;
+                }
+            }
+        }
         else if (strcasecmp(current_section, "Logging") == 0) {
             if (strcasecmp(key, "level") == 0) {
                 if (strcasecmp(value, "DEBUG") == 0) {
@@ -228,6 +247,11 @@ int config_load_from_file(const char *path, roole_config_t *config) {
                     config->log_level = LOG_LEVEL_INFO;
                 }
             }
+            else if (strcasecmp(key, "remote_control") == 0) {
+                config->log_remote_control = strcasecmp(value, "on") == 0 ||
+                                             strcasecmp(value, "true") == 0 ||
+                                             strcmp(value, "1") == 0;
+            }
         }
     }
     
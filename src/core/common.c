@@ -14,13 +14,32 @@
 // TIMING UTILITIES
 // ============================================================================
 
+// Optional override (simulation); NULL = CLOCK_MONOTONIC
+static time_source_fn g_time_source = NULL;
+static void *g_time_source_ctx = NULL;
+
+void time_set_source(time_source_fn source, void *ctx) {
+    __atomic_store_n(&g_time_source_ctx, ctx, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_time_source, source, __ATOMIC_RELEASE);
+}
+
 uint64_t time_now_ms(void) {
+    time_source_fn source = __atomic_load_n(&g_time_source, __ATOMIC_ACQUIRE);
+    if (source) {
+        return source(g_time_source_ctx) / 1000;
+    }
+    
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
     return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
 }
 
 uint64_t time_now_us(void) {
+    time_source_fn source = __atomic_load_n(&g_time_source, __ATOMIC_ACQUIRE);
+    if (source) {
+        return source(g_time_source_ctx);
+    }
+    
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
     return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
@@ -134,6 +153,18 @@ uint32_t hash_string(const char *str) {
     return hash;
 }
 
+uint64_t hash_bytes(const void *data, size_t len) {
+    const uint8_t *bytes = (const uint8_t*)data;
+    
+    // FNV-1a 64, then finalize for avalanche (ring placement needs it)
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash_u64(hash);
+}
+
 // ============================================================================
 // RESULT CHECKING AND LOGGING
 // ============================================================================
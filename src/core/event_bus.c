@@ -4,72 +4,293 @@
 #include "roole/core/event_bus.h"
 #include "roole/logger/logger.h"
 #include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
 #include <pthread.h>
 #include <unistd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
 
 // ============================================================================
 // CONFIGURATION
 // ============================================================================
 
 #define MAX_SUBSCRIBERS_PER_TYPE 16
-#define EVENT_QUEUE_SIZE 1024
+#define EVENT_QUEUE_SIZE 1024          // Default per-lane capacity (power of two)
+#define EVENT_DISPATCH_BATCH 64        // Events drained per consumer pass
+#define EVENT_IDLE_WAIT_MS 100
+#define EVENT_STAT_STRIPES 16          // Power of two
+#define EVENT_CACHE_LINE 64
+#define EVENT_MAX_LANES (EVENT_TYPE_MAX * MAX_SUBSCRIBERS_PER_TYPE + 1)
+#define EVENT_COALESCE_INITIAL 64      // Pending keys per lane before growing
+#define EVENT_INLINE_PAYLOAD 40        // Payload bytes carried in the slot itself
+#define EVENT_PAYLOAD_POOL_SIZE 1024   // Pooled blocks for larger payloads, per bus
+#define EVENT_PAYLOAD_MAX sizeof(((event_t*)0)->data)
+
+_Static_assert(EVENT_TYPE_MAX <= 32, "dispatch_batch keeps event types in a 32-bit mask");
 
 // ============================================================================
 // INTERNAL STRUCTURES
 // ============================================================================
 
+typedef struct event_lane event_lane_t;
+
 typedef struct subscriber {
     event_handler_fn handler;
+    event_batch_handler_fn batch_handler;   // Set instead of handler
     void *user_data;
-    int active;
+    int active;             // Atomic: read without the lock when publishing
+    event_lane_t *lane;     // Per-subscriber mode: kept for the bus lifetime
 } subscriber_t;
 
+// Fixed-size blocks for payloads that don't fit inline. The free list is
+// a Treiber stack of block indices; head packs (tag << 32 | index + 1)
+// so a 64-bit CAS is ABA-safe. When empty, callers fall back to malloc.
+typedef struct event_pool {
+    uint64_t head __attribute__((aligned(EVENT_CACHE_LINE)));
+    uint32_t *next;
+    uint8_t *blocks;
+    size_t count;
+    uint64_t misses;
+} event_pool_t;
+
+// Bounded MPSC ring (Vyukov). Each slot carries a sequence number:
+// seq == pos      -> free for the producer claiming pos
+// seq == pos + 1  -> filled, readable by the consumer at pos
+//
+// Slots are one cache line: only the header and the member of the data
+// union that the type uses are stored, inline when they fit and in a
+// pooled block otherwise.
+typedef struct event_slot {
+    uint64_t seq;
+    union {
+        uint8_t bytes[EVENT_INLINE_PAYLOAD];
+        void *pooled;
+    } payload;
+    uint64_t timestamp_ms;
+    uint32_t enqueued_us;       // Low 32 bits; latencies are far below 71 min
+    uint8_t type;
+    uint8_t reserved;
+    node_id_t source_node_id;
+} event_slot_t;
+
+_Static_assert(sizeof(event_slot_t) == EVENT_CACHE_LINE, "event slot must fill one cache line");
+_Static_assert(EVENT_TYPE_MAX <= UINT8_MAX, "event type must fit the slot header");
+
 typedef struct event_queue {
+    event_slot_t *slots;
+    event_pool_t *pool;
+    size_t mask;
+    uint64_t tail __attribute__((aligned(EVENT_CACHE_LINE)));  // Producers (CAS)
+    uint64_t head __attribute__((aligned(EVENT_CACHE_LINE)));  // Consumer only
+    int idle __attribute__((aligned(EVENT_CACHE_LINE)));       // Consumer parked
+    int wake_fd;                                               // eventfd
+} event_queue_t;
+
+// Latest pending event per (type, key) for coalescible types. Producers
+// overwrite in place; the lane thread swaps the buffers out in one go.
+// Keys are kept in first-publish order and the table grows instead of
+// dropping.
+typedef struct coalesce_table {
+    pthread_mutex_t lock;
     event_t *events;
-    size_t head;
-    size_t tail;
+    uint64_t *enqueued_us;
     size_t count;
     size_t capacity;
-    pthread_mutex_t lock;
-    pthread_cond_t not_empty;
-    pthread_cond_t not_full;
-} event_queue_t;
+    uint32_t *index;            // Open addressing: events[] position + 1, 0 = empty
+    size_t index_mask;
+    
+    // Drain side, owned by the lane thread between swaps
+    event_t *spare_events;
+    uint64_t *spare_enqueued_us;
+    size_t spare_capacity;
+    
+    int pending;                // Atomic: count != 0
+} coalesce_table_t;
+
+// A lane is one queue plus one dispatch thread. Events in a lane are
+// delivered in publish order; lanes run independently of each other.
+struct event_lane {
+    event_queue_t queue;
+    coalesce_table_t coalesce;
+    event_bus_t *bus;
+    pthread_t thread;
+    char name[EVENT_LANE_NAME_LEN];
+    int type;               // Event type served, -1 = all
+    int slot;               // Subscriber slot served, -1 = all of the type
+    
+    // Written by the lane thread (dropped: by producers)
+    uint64_t dispatched;
+    uint64_t dropped;
+    uint64_t coalesced;
+    uint64_t latency_total_us;
+    uint64_t latency_max_us;
+};
+
+// Counters are striped per thread so publishers never share a cache line
+// in the common case; readers sum all stripes.
+typedef struct stat_stripe {
+    uint64_t published;
+    uint64_t dispatched;
+    uint64_t dropped;
+    uint64_t coalesced;
+} __attribute__((aligned(EVENT_CACHE_LINE))) stat_stripe_t;
 
 struct event_bus {
     subscriber_t subscribers[EVENT_TYPE_MAX][MAX_SUBSCRIBERS_PER_TYPE];
     pthread_rwlock_t subscriber_locks[EVENT_TYPE_MAX];
     
-    event_queue_t queue;
-    pthread_t dispatch_thread;
+    event_lane_mode_t lane_mode;
+    size_t queue_size;
+    
+    // Lanes only ever grow until destroy; lane_count is published with
+    // release so readers can walk lanes[] without the lock.
+    event_lane_t *lanes[EVENT_MAX_LANES];
+    size_t lane_count;
+    event_lane_t *type_lanes[EVENT_TYPE_MAX];    // Per-type mode
+    pthread_mutex_t lane_lock;
+    
+    int coalesce[EVENT_TYPE_MAX];                // Atomic flags
+    
+    event_pool_t payload_pool;
     
     // Statistics
-    uint64_t events_published;
-    uint64_t events_dispatched;
-    uint64_t events_dropped;
-    pthread_mutex_t stats_lock;
+    stat_stripe_t stats[EVENT_STAT_STRIPES];
     
-    volatile int shutdown;
+    int shutdown;
 };
 
+static stat_stripe_t* stat_stripe(event_bus_t *bus) {
+    static unsigned next_stripe = 0;
+    static __thread unsigned my_stripe = 0;   // 0 = unassigned
+    
+    if (my_stripe == 0) {
+        my_stripe = __atomic_add_fetch(&next_stripe, 1, __ATOMIC_RELAXED);
+        if (my_stripe == 0) my_stripe = 1;
+    }
+    return &bus->stats[(my_stripe - 1) & (EVENT_STAT_STRIPES - 1)];
+}
+
+#define STAT_ADD(bus, field, n) \
+    __atomic_fetch_add(&stat_stripe(bus)->field, (n), __ATOMIC_RELAXED)
+
+// ============================================================================
+// PAYLOAD POOL
+// ============================================================================
+
+static int event_pool_init(event_pool_t *pool, size_t count) {
+    memset(pool, 0, sizeof(event_pool_t));
+    
+    pool->blocks = calloc(count, EVENT_PAYLOAD_MAX);
+    pool->next = calloc(count, sizeof(uint32_t));
+    if (!pool->blocks || !pool->next) {
+        free(pool->blocks);
+        free(pool->next);
+        return -1;
+    }
+    
+    // Chain every block: i -> i + 1, last -> empty
+    for (size_t i = 0; i < count; i++) {
+        pool->next[i] = i + 1 < count ? (uint32_t)(i + 2) : 0;
+    }
+    pool->count = count;
+    pool->head = 1;
+    return 0;
+}
+
+static void event_pool_destroy(event_pool_t *pool) {
+    free(pool->blocks);
+    free(pool->next);
+}
+
+static void* event_pool_alloc(event_pool_t *pool) {
+    uint64_t head = __atomic_load_n(&pool->head, __ATOMIC_ACQUIRE);
+    
+    for (;;) {
+        uint32_t index = (uint32_t)head;
+        if (index == 0) {
+            __atomic_fetch_add(&pool->misses, 1, __ATOMIC_RELAXED);
+            return malloc(EVENT_PAYLOAD_MAX);
+        }
+        
+        uint32_t next = __atomic_load_n(&pool->next[index - 1], __ATOMIC_RELAXED);
+        uint64_t desired = ((head >> 32) + 1) << 32 | next;
+        if (__atomic_compare_exchange_n(&pool->head, &head, desired, 1,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            return pool->blocks + (size_t)(index - 1) * EVENT_PAYLOAD_MAX;
+        }
+    }
+}
+
+static void event_pool_free(event_pool_t *pool, void *block) {
+    uint8_t *p = block;
+    if (p < pool->blocks || p >= pool->blocks + pool->count * EVENT_PAYLOAD_MAX) {
+        free(block);   // malloc fallback
+        return;
+    }
+    
+    uint32_t index = (uint32_t)((size_t)(p - pool->blocks) / EVENT_PAYLOAD_MAX) + 1;
+    uint64_t head = __atomic_load_n(&pool->head, __ATOMIC_RELAXED);
+    
+    for (;;) {
+        __atomic_store_n(&pool->next[index - 1], (uint32_t)head, __ATOMIC_RELAXED);
+        uint64_t desired = ((head >> 32) + 1) << 32 | index;
+        if (__atomic_compare_exchange_n(&pool->head, &head, desired, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            return;
+        }
+    }
+}
+
+// Bytes of the data union that carry meaning for the type
+static size_t event_payload_size(uint8_t type) {
+    switch (type) {
+        case EVENT_TYPE_PEER_JOINED:
+        case EVENT_TYPE_PEER_LEFT:
+        case EVENT_TYPE_PEER_FAILED:
+        case EVENT_TYPE_PEER_UPDATED:
+        case EVENT_TYPE_PEER_SUSPECT:
+            return sizeof(event_peer_t);
+        case EVENT_TYPE_EXECUTION_STARTED:
+        case EVENT_TYPE_EXECUTION_COMPLETED:
+        case EVENT_TYPE_EXECUTION_FAILED:
+            return sizeof(event_execution_t);
+        case EVENT_TYPE_MESSAGE_RECEIVED:
+        case EVENT_TYPE_MESSAGE_ROUTED:
+            return sizeof(event_message_t);
+        case EVENT_TYPE_CATALOG_UPDATED:
+            return sizeof(event_catalog_t);
+        default:
+            return 0;
+    }
+}
+
 // ============================================================================
 // EVENT QUEUE IMPLEMENTATION
 // ============================================================================
 
-static int event_queue_init(event_queue_t *queue, size_t capacity) {
+static int event_queue_init(event_queue_t *queue, size_t capacity, event_pool_t *pool) {
     memset(queue, 0, sizeof(event_queue_t));
+    queue->pool = pool;
     
-    queue->events = calloc(capacity, sizeof(event_t));
-    if (!queue->events) return -1;
+    if (posix_memalign((void**)&queue->slots, EVENT_CACHE_LINE,
+                       capacity * sizeof(event_slot_t)) != 0) {
+        queue->slots = NULL;
+        return -1;
+    }
+    memset(queue->slots, 0, capacity * sizeof(event_slot_t));
     
-    queue->capacity = capacity;
-    queue->head = 0;
-    queue->tail = 0;
-    queue->count = 0;
+    for (size_t i = 0; i < capacity; i++) {
+        queue->slots[i].seq = i;
+    }
+    queue->mask = capacity - 1;
     
-    pthread_mutex_init(&queue->lock, NULL);
-    pthread_cond_init(&queue->not_empty, NULL);
-    pthread_cond_init(&queue->not_full, NULL);
+    queue->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (queue->wake_fd < 0) {
+        free(queue->slots);
+        queue->slots = NULL;
+        return -1;
+    }
     
     return 0;
 }
@@ -77,136 +298,611 @@ static int event_queue_init(event_queue_t *queue, size_t capacity) {
 static void event_queue_destroy(event_queue_t *queue) {
     if (!queue) return;
     
-    pthread_mutex_lock(&queue->lock);
-    free(queue->events);
-    queue->events = NULL;
-    pthread_mutex_unlock(&queue->lock);
+    // Undelivered events may still own payload blocks
+    for (uint64_t pos = queue->head; queue->slots; pos++) {
+        event_slot_t *slot = &queue->slots[pos & queue->mask];
+        if (slot->seq != pos + 1) break;
+        if (event_payload_size(slot->type) > EVENT_INLINE_PAYLOAD) {
+            event_pool_free(queue->pool, slot->payload.pooled);
+        }
+    }
+    
+    free(queue->slots);
+    queue->slots = NULL;
     
-    pthread_cond_destroy(&queue->not_full);
-    pthread_cond_destroy(&queue->not_empty);
-    pthread_mutex_destroy(&queue->lock);
+    if (queue->wake_fd >= 0) {
+        close(queue->wake_fd);
+        queue->wake_fd = -1;
+    }
+}
+
+static void event_queue_wake(event_queue_t *queue) {
+    uint64_t one = 1;
+    ssize_t n = write(queue->wake_fd, &one, sizeof(one));
+    (void)n;  // EAGAIN means a wakeup is already pending
 }
 
-static int event_queue_push(event_queue_t *queue, const event_t *event, int blocking) {
-    pthread_mutex_lock(&queue->lock);
+// Producer side of event_queue_wait(). Only pays for a syscall when the
+// consumer is parked; the fence pairs with the one in event_queue_wait()
+// so either we see idle or the consumer sees our work.
+static void event_queue_notify(event_queue_t *queue) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&queue->idle, __ATOMIC_RELAXED) &&
+        __atomic_exchange_n(&queue->idle, 0, __ATOMIC_RELAXED)) {
+        event_queue_wake(queue);
+    }
+}
+
+// Lock-free push from any thread. Returns -1 when full (never blocks).
+static int event_queue_push(event_queue_t *queue, const event_t *event,
+                            uint64_t enqueued_us) {
+    size_t payload_size = event_payload_size((uint8_t)event->type);
+    void *pooled = NULL;
+    
+    if (payload_size > EVENT_INLINE_PAYLOAD) {
+        pooled = event_pool_alloc(queue->pool);
+        if (!pooled) return -1;
+        memcpy(pooled, &event->data, payload_size);
+    }
+    
+    uint64_t pos = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    event_slot_t *slot;
     
-    while (queue->count >= queue->capacity) {
-        if (!blocking) {
-            pthread_mutex_unlock(&queue->lock);
+    for (;;) {
+        slot = &queue->slots[pos & queue->mask];
+        uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - pos);
+        
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->tail, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            if (pooled) event_pool_free(queue->pool, pooled);
             return -1;  // Queue full
+        } else {
+            pos = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
         }
-        pthread_cond_wait(&queue->not_full, &queue->lock);
     }
     
-    queue->events[queue->tail] = *event;
-    queue->tail = (queue->tail + 1) % queue->capacity;
-    queue->count++;
-    
-    pthread_mutex_unlock(&queue->lock);
-    pthread_cond_signal(&queue->not_empty);
+    slot->type = (uint8_t)event->type;
+    slot->source_node_id = event->source_node_id;
+    slot->timestamp_ms = event->timestamp_ms;
+    slot->enqueued_us = (uint32_t)enqueued_us;
+    if (pooled) {
+        slot->payload.pooled = pooled;
+    } else {
+        memcpy(slot->payload.bytes, &event->data, payload_size);
+    }
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
     
+    event_queue_notify(queue);
     return 0;
 }
 
-static int event_queue_pop(event_queue_t *queue, event_t *event, int timeout_ms) {
-    pthread_mutex_lock(&queue->lock);
+static int event_queue_ready(event_queue_t *queue) {
+    event_slot_t *slot = &queue->slots[queue->head & queue->mask];
+    return __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) == queue->head + 1;
+}
+
+// Consumer only: move up to max events out of the ring
+static size_t event_queue_pop_batch(event_queue_t *queue, event_t *events,
+                                    uint64_t *enqueued_us, size_t max) {
+    uint64_t pos = queue->head;
+    uint64_t now = time_now_us();
+    size_t n = 0;
     
-    if (timeout_ms < 0) {
-        // Block indefinitely
-        while (queue->count == 0) {
-            pthread_cond_wait(&queue->not_empty, &queue->lock);
-        }
-    } else if (timeout_ms > 0) {
-        // Timed wait
-        struct timespec ts;
-        clock_gettime(CLOCK_REALTIME, &ts);
-        ts.tv_sec += timeout_ms / 1000;
-        ts.tv_nsec += (timeout_ms % 1000) * 1000000;
-        if (ts.tv_nsec >= 1000000000) {
-            ts.tv_sec++;
-            ts.tv_nsec -= 1000000000;
-        }
+    while (n < max) {
+        event_slot_t *slot = &queue->slots[pos & queue->mask];
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos + 1) break;
         
-        while (queue->count == 0) {
-            int ret = pthread_cond_timedwait(&queue->not_empty, &queue->lock, &ts);
-            if (ret == ETIMEDOUT) {
-                pthread_mutex_unlock(&queue->lock);
-                return -1;
-            }
+        // Rebuild the public event; bytes of the union beyond the type's
+        // member are left as they were
+        event_t *event = &events[n];
+        size_t payload_size = event_payload_size(slot->type);
+        event->type = (event_type_t)slot->type;
+        event->source_node_id = slot->source_node_id;
+        event->timestamp_ms = slot->timestamp_ms;
+        if (payload_size > EVENT_INLINE_PAYLOAD) {
+            memcpy(&event->data, slot->payload.pooled, payload_size);
+            event_pool_free(queue->pool, slot->payload.pooled);
+        } else {
+            memcpy(&event->data, slot->payload.bytes, payload_size);
         }
+        enqueued_us[n] = now - (uint32_t)((uint32_t)now - slot->enqueued_us);
+        n++;
+        __atomic_store_n(&slot->seq, pos + queue->mask + 1, __ATOMIC_RELEASE);
+        pos++;
+    }
+    
+    __atomic_store_n(&queue->head, pos, __ATOMIC_RELEASE);
+    return n;
+}
+
+// Consumer only: park until a producer signals or timeout_ms elapses.
+// *extra_pending covers work queued outside the ring (coalesced events).
+static void event_queue_wait(event_queue_t *queue, const int *extra_pending,
+                             int timeout_ms) {
+    __atomic_store_n(&queue->idle, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    
+    if (!event_queue_ready(queue) && !__atomic_load_n(extra_pending, __ATOMIC_RELAXED)) {
+        struct pollfd pfd = { .fd = queue->wake_fd, .events = POLLIN };
+        poll(&pfd, 1, timeout_ms);
+    }
+    
+    __atomic_store_n(&queue->idle, 0, __ATOMIC_RELAXED);
+    
+    uint64_t drained;
+    ssize_t n = read(queue->wake_fd, &drained, sizeof(drained));
+    (void)n;
+}
+
+static size_t event_queue_depth(event_queue_t *queue) {
+    uint64_t tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    uint64_t head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+    return tail > head ? (size_t)(tail - head) : 0;
+}
+
+// ============================================================================
+// COALESCING
+// ============================================================================
+
+// Identity of the entity an event describes; later events for the same
+// key supersede earlier ones
+static uint64_t coalesce_key(const event_t *event) {
+    switch (event->type) {
+        case EVENT_TYPE_PEER_JOINED:
+        case EVENT_TYPE_PEER_LEFT:
+        case EVENT_TYPE_PEER_FAILED:
+        case EVENT_TYPE_PEER_UPDATED:
+        case EVENT_TYPE_PEER_SUSPECT:
+            return event->data.peer.node_id;
+        case EVENT_TYPE_EXECUTION_STARTED:
+        case EVENT_TYPE_EXECUTION_COMPLETED:
+        case EVENT_TYPE_EXECUTION_FAILED:
+            return event->data.execution.exec_id;
+        case EVENT_TYPE_MESSAGE_RECEIVED:
+        case EVENT_TYPE_MESSAGE_ROUTED:
+            return event->data.message.exec_id;
+        case EVENT_TYPE_CATALOG_UPDATED:
+            return event->data.catalog.dag_id;
+        default:
+            return 0;
+    }
+}
+
+static inline int event_is_peer(event_type_t type) {
+    return type == EVENT_TYPE_PEER_JOINED || type == EVENT_TYPE_PEER_LEFT ||
+           type == EVENT_TYPE_PEER_FAILED || type == EVENT_TYPE_PEER_UPDATED ||
+           type == EVENT_TYPE_PEER_SUSPECT;
+}
+
+// The node is gone; nothing pending about it may be delivered after this
+static inline int event_is_terminal(event_type_t type) {
+    return type == EVENT_TYPE_PEER_LEFT || type == EVENT_TYPE_PEER_FAILED;
+}
+
+static int coalesce_init(coalesce_table_t *table) {
+    memset(table, 0, sizeof(coalesce_table_t));
+    
+    table->capacity = EVENT_COALESCE_INITIAL;
+    table->spare_capacity = EVENT_COALESCE_INITIAL;
+    table->index_mask = EVENT_COALESCE_INITIAL * 2 - 1;
+    
+    table->events = calloc(table->capacity, sizeof(event_t));
+    table->enqueued_us = calloc(table->capacity, sizeof(uint64_t));
+    table->spare_events = calloc(table->spare_capacity, sizeof(event_t));
+    table->spare_enqueued_us = calloc(table->spare_capacity, sizeof(uint64_t));
+    table->index = calloc(table->index_mask + 1, sizeof(uint32_t));
+    
+    if (!table->events || !table->enqueued_us || !table->spare_events ||
+        !table->spare_enqueued_us || !table->index) {
+        free(table->events);
+        free(table->enqueued_us);
+        free(table->spare_events);
+        free(table->spare_enqueued_us);
+        free(table->index);
+        return -1;
+    }
+    
+    pthread_mutex_init(&table->lock, NULL);
+    return 0;
+}
+
+static void coalesce_destroy(coalesce_table_t *table) {
+    free(table->events);
+    free(table->enqueued_us);
+    free(table->spare_events);
+    free(table->spare_enqueued_us);
+    free(table->index);
+    pthread_mutex_destroy(&table->lock);
+}
+
+static size_t coalesce_probe(coalesce_table_t *table, event_type_t type, uint64_t key) {
+    size_t pos = hash_u64(key ^ ((uint64_t)type << 56)) & table->index_mask;
+    
+    while (table->index[pos]) {
+        const event_t *existing = &table->events[table->index[pos] - 1];
+        if (existing->type == type && coalesce_key(existing) == key) break;
+        pos = (pos + 1) & table->index_mask;
+    }
+    return pos;
+}
+
+static void coalesce_reindex_locked(coalesce_table_t *table) {
+    memset(table->index, 0, (table->index_mask + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < table->count; i++) {
+        size_t pos = coalesce_probe(table, table->events[i].type,
+                                    coalesce_key(&table->events[i]));
+        table->index[pos] = (uint32_t)(i + 1);
+    }
+}
+
+// Grow the active buffers (and the index if needed); caller holds the lock
+static int coalesce_grow_locked(coalesce_table_t *table) {
+    size_t capacity = table->capacity * 2;
+    
+    event_t *events = realloc(table->events, capacity * sizeof(event_t));
+    if (!events) return -1;
+    table->events = events;
+    
+    uint64_t *enqueued_us = realloc(table->enqueued_us, capacity * sizeof(uint64_t));
+    if (!enqueued_us) return -1;
+    table->enqueued_us = enqueued_us;
+    
+    table->capacity = capacity;
+    
+    if (capacity * 2 > table->index_mask + 1) {
+        uint32_t *index = calloc(capacity * 2, sizeof(uint32_t));
+        if (!index) return -1;
+        free(table->index);
+        table->index = index;
+        table->index_mask = capacity * 2 - 1;
+        coalesce_reindex_locked(table);
+    }
+    return 0;
+}
+
+// Insert or overwrite the pending event for its key.
+// Returns 1 if it superseded a pending event, 0 if new, -1 on OOM.
+static int coalesce_put(coalesce_table_t *table, const event_t *event, uint64_t now_us) {
+    uint64_t key = coalesce_key(event);
+    int result;
+    
+    pthread_mutex_lock(&table->lock);
+    
+    size_t pos = coalesce_probe(table, event->type, key);
+    if (table->index[pos]) {
+        // Latest state wins; latency still counts from the first publish
+        table->events[table->index[pos] - 1] = *event;
+        result = 1;
+    } else if (table->count == table->capacity && coalesce_grow_locked(table) != 0) {
+        result = -1;
     } else {
-        // Non-blocking
-        if (queue->count == 0) {
-            pthread_mutex_unlock(&queue->lock);
-            return -1;
+        pos = coalesce_probe(table, event->type, key);   // Index may have been rebuilt
+        table->events[table->count] = *event;
+        table->enqueued_us[table->count] = now_us;
+        table->index[pos] = (uint32_t)(++table->count);
+        __atomic_store_n(&table->pending, 1, __ATOMIC_RELAXED);
+        result = 0;
+    }
+    
+    pthread_mutex_unlock(&table->lock);
+    return result;
+}
+
+// Drop pending events about a node, keeping the others in order.
+// Returns how many were dropped.
+static size_t coalesce_forget_peer(coalesce_table_t *table, node_id_t node_id) {
+    if (!__atomic_load_n(&table->pending, __ATOMIC_ACQUIRE)) return 0;
+    
+    pthread_mutex_lock(&table->lock);
+    
+    size_t kept = 0;
+    for (size_t i = 0; i < table->count; i++) {
+        if (event_is_peer(table->events[i].type) &&
+            table->events[i].data.peer.node_id == node_id) {
+            continue;
+        }
+        if (kept != i) {
+            table->events[kept] = table->events[i];
+            table->enqueued_us[kept] = table->enqueued_us[i];
         }
+        kept++;
     }
     
-    *event = queue->events[queue->head];
-    queue->head = (queue->head + 1) % queue->capacity;
-    queue->count--;
+    size_t dropped = table->count - kept;
+    if (dropped > 0) {
+        table->count = kept;
+        coalesce_reindex_locked(table);
+        if (kept == 0) __atomic_store_n(&table->pending, 0, __ATOMIC_RELAXED);
+    }
     
-    pthread_mutex_unlock(&queue->lock);
-    pthread_cond_signal(&queue->not_full);
+    pthread_mutex_unlock(&table->lock);
+    return dropped;
+}
+
+// Lane thread only: take every pending event. The returned arrays stay
+// valid until the next drain.
+static size_t coalesce_drain(coalesce_table_t *table, const event_t **events,
+                             const uint64_t **enqueued_us) {
+    if (!__atomic_load_n(&table->pending, __ATOMIC_ACQUIRE)) return 0;
     
-    return 0;
+    pthread_mutex_lock(&table->lock);
+    
+    size_t count = table->count;
+    
+    event_t *drained = table->events;
+    uint64_t *drained_us = table->enqueued_us;
+    size_t drained_capacity = table->capacity;
+    
+    table->events = table->spare_events;
+    table->enqueued_us = table->spare_enqueued_us;
+    table->capacity = table->spare_capacity;
+    
+    table->spare_events = drained;
+    table->spare_enqueued_us = drained_us;
+    table->spare_capacity = drained_capacity;
+    
+    table->count = 0;
+    memset(table->index, 0, (table->index_mask + 1) * sizeof(uint32_t));
+    __atomic_store_n(&table->pending, 0, __ATOMIC_RELAXED);
+    
+    pthread_mutex_unlock(&table->lock);
+    
+    *events = drained;
+    *enqueued_us = drained_us;
+    return count;
 }
 
 // ============================================================================
-// EVENT DISPATCH THREAD
+// EVENT DISPATCH
 // ============================================================================
 
-static void dispatch_event_to_subscribers(event_bus_t *bus, const event_t *event) {
-    if (event->type >= EVENT_TYPE_MAX) return;
+// Deliver events of a single type to one subscriber slot, or to every
+// subscriber of the type (slot < 0). Batch subscribers get one call.
+static void dispatch_type(event_bus_t *bus, event_type_t type, int slot,
+                          const event_t *events, size_t count) {
+    uint64_t delivered = 0;
+    int first = slot < 0 ? 0 : slot;
+    int last = slot < 0 ? MAX_SUBSCRIBERS_PER_TYPE : slot + 1;
     
-    pthread_rwlock_rdlock(&bus->subscriber_locks[event->type]);
+    pthread_rwlock_rdlock(&bus->subscriber_locks[type]);
     
-    for (int i = 0; i < MAX_SUBSCRIBERS_PER_TYPE; i++) {
-        subscriber_t *sub = &bus->subscribers[event->type][i];
+    for (int i = first; i < last; i++) {
+        subscriber_t *sub = &bus->subscribers[type][i];
+        if (!sub->active) continue;
         
-        if (sub->active && sub->handler) {
-            // Call handler (note: handlers should be fast, non-blocking)
-            sub->handler(event, sub->user_data);
-            
-            pthread_mutex_lock(&bus->stats_lock);
-            bus->events_dispatched++;
-            pthread_mutex_unlock(&bus->stats_lock);
+        // Call handler (note: handlers should be fast, non-blocking)
+        if (sub->batch_handler) {
+            sub->batch_handler(events, count, sub->user_data);
+            delivered += count;
+        } else if (sub->handler) {
+            for (size_t j = 0; j < count; j++) {
+                sub->handler(&events[j], sub->user_data);
+            }
+            delivered += count;
         }
     }
     
-    pthread_rwlock_unlock(&bus->subscriber_locks[event->type]);
+    pthread_rwlock_unlock(&bus->subscriber_locks[type]);
+    
+    if (delivered) STAT_ADD(bus, dispatched, delivered);
 }
 
-static void* dispatch_thread_fn(void *arg) {
-    event_bus_t *bus = (event_bus_t*)arg;
+// Deliver a batch that may mix event types, keeping per-type order
+static void dispatch_batch(event_bus_t *bus, int slot, const event_t *events, size_t count) {
+    uint32_t types = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (events[i].type < EVENT_TYPE_MAX) types |= 1u << events[i].type;
+    }
+    
+    // Single type (the norm for per-type and per-subscriber lanes): no copy
+    if (types && (types & (types - 1)) == 0 && events[0].type < EVENT_TYPE_MAX) {
+        dispatch_type(bus, events[0].type, slot, events, count);
+        return;
+    }
+    
+    event_t group[EVENT_DISPATCH_BATCH];
+    for (int type = 0; type < EVENT_TYPE_MAX; type++) {
+        if (!(types & (1u << type))) continue;
+        
+        size_t n = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (events[i].type == (event_type_t)type) group[n++] = events[i];
+        }
+        dispatch_type(bus, (event_type_t)type, slot, group, n);
+    }
+}
+
+static void lane_dispatch(event_lane_t *lane, const event_t *events,
+                          const uint64_t *enqueued_us, size_t count) {
+    for (size_t done = 0; done < count; done += EVENT_DISPATCH_BATCH) {
+        size_t n = count - done < EVENT_DISPATCH_BATCH ? count - done : EVENT_DISPATCH_BATCH;
+        dispatch_batch(lane->bus, lane->slot, events + done, n);
+    }
+    
+    // Publish-to-handled latency, including time spent queued
+    uint64_t now = time_now_us();
+    uint64_t total = 0, max = lane->latency_max_us;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t latency = now > enqueued_us[i] ? now - enqueued_us[i] : 0;
+        total += latency;
+        if (latency > max) max = latency;
+    }
+    
+    __atomic_store_n(&lane->latency_total_us, lane->latency_total_us + total, __ATOMIC_RELAXED);
+    __atomic_store_n(&lane->latency_max_us, max, __ATOMIC_RELAXED);
+    __atomic_store_n(&lane->dispatched, lane->dispatched + count, __ATOMIC_RELAXED);
+}
+
+static void* lane_thread_fn(void *arg) {
+    event_lane_t *lane = (event_lane_t*)arg;
+    event_bus_t *bus = lane->bus;
+    event_t batch[EVENT_DISPATCH_BATCH];
+    uint64_t batch_us[EVENT_DISPATCH_BATCH];
     
     logger_push_component("event_bus");
-    LOG_INFO("Event bus dispatch thread started");
+    LOG_INFO("Event bus lane '%s' started", lane->name);
     
-    while (!bus->shutdown) {
-        event_t event;
+    while (!__atomic_load_n(&bus->shutdown, __ATOMIC_ACQUIRE)) {
+        size_t n = event_queue_pop_batch(&lane->queue, batch, batch_us, EVENT_DISPATCH_BATCH);
+        if (n > 0) {
+            lane_dispatch(lane, batch, batch_us, n);
+        }
         
-        if (event_queue_pop(&bus->queue, &event, 100) == 0) {
-            dispatch_event_to_subscribers(bus, &event);
+        const event_t *coalesced;
+        const uint64_t *coalesced_us;
+        size_t c = coalesce_drain(&lane->coalesce, &coalesced, &coalesced_us);
+        if (c > 0) {
+            lane_dispatch(lane, coalesced, coalesced_us, c);
+        }
+        
+        if (n == 0 && c == 0) {
+            event_queue_wait(&lane->queue, &lane->coalesce.pending, EVENT_IDLE_WAIT_MS);
         }
     }
     
-    LOG_INFO("Event bus dispatch thread stopped");
+    LOG_INFO("Event bus lane '%s' stopped", lane->name);
     logger_pop_component();
     return NULL;
 }
 
+// ============================================================================
+// LANES
+// ============================================================================
+
+// Create and start a lane; caller holds lane_lock
+static event_lane_t* lane_create_locked(event_bus_t *bus, int type, int slot) {
+    if (bus->lane_count >= EVENT_MAX_LANES) return NULL;
+    
+    event_lane_t *lane = NULL;
+    if (posix_memalign((void**)&lane, EVENT_CACHE_LINE, sizeof(event_lane_t)) != 0) {
+        return NULL;
+    }
+    memset(lane, 0, sizeof(event_lane_t));
+    lane->bus = bus;
+    lane->type = type;
+    lane->slot = slot;
+    
+    if (type < 0) {
+        snprintf(lane->name, sizeof(lane->name), "shared");
+    } else if (slot < 0) {
+        snprintf(lane->name, sizeof(lane->name), "%s",
+                 event_type_to_string((event_type_t)type));
+    } else {
+        snprintf(lane->name, sizeof(lane->name), "%s#%d",
+                 event_type_to_string((event_type_t)type), slot);
+    }
+    
+    if (event_queue_init(&lane->queue, bus->queue_size, &bus->payload_pool) != 0) {
+        LOG_ERROR("Failed to initialize event queue for lane '%s'", lane->name);
+        free(lane);
+        return NULL;
+    }
+    
+    if (coalesce_init(&lane->coalesce) != 0) {
+        LOG_ERROR("Failed to initialize coalescing table for lane '%s'", lane->name);
+        event_queue_destroy(&lane->queue);
+        free(lane);
+        return NULL;
+    }
+    
+    if (pthread_create(&lane->thread, NULL, lane_thread_fn, lane) != 0) {
+        LOG_ERROR("Failed to create dispatch thread for lane '%s'", lane->name);
+        coalesce_destroy(&lane->coalesce);
+        event_queue_destroy(&lane->queue);
+        free(lane);
+        return NULL;
+    }
+    
+    bus->lanes[bus->lane_count] = lane;
+    __atomic_store_n(&bus->lane_count, bus->lane_count + 1, __ATOMIC_RELEASE);
+    return lane;
+}
+
+// A LEFT/FAILED goes through the ring, which drains before the coalescing
+// table, so a pending UPDATED/SUSPECT for the node would otherwise be
+// delivered after it. Drop those first, on every lane: the terminal
+// event supersedes them.
+static void forget_superseded_peer(event_bus_t *bus, const event_t *event) {
+    size_t lane_count = __atomic_load_n(&bus->lane_count, __ATOMIC_ACQUIRE);
+    
+    for (size_t i = 0; i < lane_count; i++) {
+        event_lane_t *lane = bus->lanes[i];
+        size_t dropped = coalesce_forget_peer(&lane->coalesce, event->data.peer.node_id);
+        if (dropped > 0) {
+            __atomic_fetch_add(&lane->coalesced, dropped, __ATOMIC_RELAXED);
+            STAT_ADD(bus, coalesced, dropped);
+        }
+    }
+}
+
+static int lane_push(event_bus_t *bus, event_lane_t *lane, const event_t *event,
+                     uint64_t now_us) {
+    if (__atomic_load_n(&bus->coalesce[event->type], __ATOMIC_RELAXED)) {
+        int put = coalesce_put(&lane->coalesce, event, now_us);
+        if (put == 1) {
+            __atomic_fetch_add(&lane->coalesced, 1, __ATOMIC_RELAXED);
+            STAT_ADD(bus, coalesced, 1);
+            return 0;
+        }
+        if (put == 0) {
+            event_queue_notify(&lane->queue);
+            return 0;
+        }
+        // Out of memory: counted as a drop below
+    } else if (event_queue_push(&lane->queue, event, now_us) == 0) {
+        return 0;
+    }
+    
+    __atomic_fetch_add(&lane->dropped, 1, __ATOMIC_RELAXED);
+    uint64_t dropped = STAT_ADD(bus, dropped, 1) + 1;
+    
+    // Log on powers of two so a full queue doesn't also flood the log
+    if ((dropped & (dropped - 1)) == 0) {
+        LOG_WARN("Event dropped (lane '%s' full): type=%s (%lu on this stripe)",
+                lane->name, event_type_to_string(event->type), dropped);
+    }
+    return -1;
+}
+
 // ============================================================================
 // EVENT BUS LIFECYCLE
 // ============================================================================
 
+static size_t round_up_pow2(size_t n) {
+    size_t p = 2;
+    while (p < n) p <<= 1;
+    return p;
+}
+
 event_bus_t* event_bus_create(void) {
-    event_bus_t *bus = calloc(1, sizeof(event_bus_t));
+    return event_bus_create_with_config(NULL);
+}
+
+event_bus_t* event_bus_create_with_config(const event_bus_config_t *config) {
+    // Cache-line aligned so the stat stripes don't share lines
+    event_bus_t *bus = NULL;
+    if (posix_memalign((void**)&bus, EVENT_CACHE_LINE, sizeof(event_bus_t)) != 0) {
+        bus = NULL;
+    }
+    if (bus) memset(bus, 0, sizeof(event_bus_t));
     if (!bus) {
         LOG_ERROR("Failed to allocate event bus");
         return NULL;
     }
     
+    bus->lane_mode = config ? config->lane_mode : EVENT_LANES_SHARED;
+    
+    // State updates are superseded by the next one for the same peer
+    bus->coalesce[EVENT_TYPE_PEER_UPDATED] = 1;
+    bus->coalesce[EVENT_TYPE_PEER_SUSPECT] = 1;
+    bus->queue_size = round_up_pow2(config && config->queue_size ?
+                                    config->queue_size : EVENT_QUEUE_SIZE);
+    
     // Initialize subscriber locks
     for (int i = 0; i < EVENT_TYPE_MAX; i++) {
         if (pthread_rwlock_init(&bus->subscriber_locks[i], NULL) != 0) {
@@ -219,9 +915,8 @@ event_bus_t* event_bus_create(void) {
         }
     }
     
-    // Initialize event queue
-    if (event_queue_init(&bus->queue, EVENT_QUEUE_SIZE) != 0) {
-        LOG_ERROR("Failed to initialize event queue");
+    if (event_pool_init(&bus->payload_pool, EVENT_PAYLOAD_POOL_SIZE) != 0) {
+        LOG_ERROR("Failed to initialize event payload pool");
         for (int i = 0; i < EVENT_TYPE_MAX; i++) {
             pthread_rwlock_destroy(&bus->subscriber_locks[i]);
         }
@@ -229,22 +924,28 @@ event_bus_t* event_bus_create(void) {
         return NULL;
     }
     
-    pthread_mutex_init(&bus->stats_lock, NULL);
+    pthread_mutex_init(&bus->lane_lock, NULL);
     
-    // Start dispatch thread
-    bus->shutdown = 0;
-    if (pthread_create(&bus->dispatch_thread, NULL, dispatch_thread_fn, bus) != 0) {
-        LOG_ERROR("Failed to create dispatch thread");
-        event_queue_destroy(&bus->queue);
-        for (int i = 0; i < EVENT_TYPE_MAX; i++) {
-            pthread_rwlock_destroy(&bus->subscriber_locks[i]);
+    // Shared mode starts its single lane now; other modes add lanes as
+    // subscribers arrive.
+    if (bus->lane_mode == EVENT_LANES_SHARED) {
+        pthread_mutex_lock(&bus->lane_lock);
+        event_lane_t *lane = lane_create_locked(bus, -1, -1);
+        pthread_mutex_unlock(&bus->lane_lock);
+        
+        if (!lane) {
+            pthread_mutex_destroy(&bus->lane_lock);
+            event_pool_destroy(&bus->payload_pool);
+            for (int i = 0; i < EVENT_TYPE_MAX; i++) {
+                pthread_rwlock_destroy(&bus->subscriber_locks[i]);
+            }
+            free(bus);
+            return NULL;
         }
-        pthread_mutex_destroy(&bus->stats_lock);
-        free(bus);
-        return NULL;
     }
     
-    LOG_INFO("Event bus created");
+    LOG_INFO("Event bus created (lanes=%s, queue=%zu)",
+             event_lane_mode_to_string(bus->lane_mode), bus->queue_size);
     return bus;
 }
 
@@ -254,22 +955,25 @@ void event_bus_destroy(event_bus_t *bus) {
     LOG_INFO("Destroying event bus");
     
     // Signal shutdown
-    bus->shutdown = 1;
-    
-    // Wake up dispatch thread
-    pthread_cond_signal(&bus->queue.not_empty);
-    
-    // Wait for dispatch thread
-    pthread_join(bus->dispatch_thread, NULL);
+    __atomic_store_n(&bus->shutdown, 1, __ATOMIC_RELEASE);
     
-    // Cleanup
-    event_queue_destroy(&bus->queue);
+    // Wake up and wait for every lane
+    for (size_t i = 0; i < bus->lane_count; i++) {
+        event_queue_wake(&bus->lanes[i]->queue);
+    }
+    for (size_t i = 0; i < bus->lane_count; i++) {
+        pthread_join(bus->lanes[i]->thread, NULL);
+        event_queue_destroy(&bus->lanes[i]->queue);
+        coalesce_destroy(&bus->lanes[i]->coalesce);
+        free(bus->lanes[i]);
+    }
     
     for (int i = 0; i < EVENT_TYPE_MAX; i++) {
         pthread_rwlock_destroy(&bus->subscriber_locks[i]);
     }
     
-    pthread_mutex_destroy(&bus->stats_lock);
+    pthread_mutex_destroy(&bus->lane_lock);
+    event_pool_destroy(&bus->payload_pool);
     free(bus);
     
     LOG_INFO("Event bus destroyed");
@@ -279,11 +983,12 @@ void event_bus_destroy(event_bus_t *bus) {
 // SUBSCRIPTION MANAGEMENT
 // ============================================================================
 
-int event_bus_subscribe(event_bus_t *bus,
-                        event_type_t type,
-                        event_handler_fn handler,
-                        void *user_data) {
-    if (!bus || !handler || type >= EVENT_TYPE_MAX) {
+static int subscribe_common(event_bus_t *bus,
+                            event_type_t type,
+                            event_handler_fn handler,
+                            event_batch_handler_fn batch_handler,
+                            void *user_data) {
+    if (!bus || (!handler && !batch_handler) || type >= EVENT_TYPE_MAX) {
         return -1;
     }
     
@@ -304,9 +1009,33 @@ int event_bus_subscribe(event_bus_t *bus,
         return -1;
     }
     
-    bus->subscribers[type][slot].handler = handler;
-    bus->subscribers[type][slot].user_data = user_data;
-    bus->subscribers[type][slot].active = 1;
+    subscriber_t *sub = &bus->subscribers[type][slot];
+    
+    // Make sure a lane serves this subscriber before it goes live
+    int lane_ok = 1;
+    if (bus->lane_mode == EVENT_LANES_PER_TYPE && !bus->type_lanes[type]) {
+        pthread_mutex_lock(&bus->lane_lock);
+        event_lane_t *lane = lane_create_locked(bus, (int)type, -1);
+        pthread_mutex_unlock(&bus->lane_lock);
+        __atomic_store_n(&bus->type_lanes[type], lane, __ATOMIC_RELEASE);
+        lane_ok = lane != NULL;
+    } else if (bus->lane_mode == EVENT_LANES_PER_SUBSCRIBER && !sub->lane) {
+        pthread_mutex_lock(&bus->lane_lock);
+        event_lane_t *lane = lane_create_locked(bus, (int)type, slot);
+        pthread_mutex_unlock(&bus->lane_lock);
+        __atomic_store_n(&sub->lane, lane, __ATOMIC_RELEASE);
+        lane_ok = lane != NULL;
+    }
+    
+    if (!lane_ok) {
+        pthread_rwlock_unlock(&bus->subscriber_locks[type]);
+        return -1;
+    }
+    
+    sub->handler = handler;
+    sub->batch_handler = batch_handler;
+    sub->user_data = user_data;
+    __atomic_store_n(&sub->active, 1, __ATOMIC_RELEASE);
     
     pthread_rwlock_unlock(&bus->subscriber_locks[type]);
     
@@ -314,25 +1043,45 @@ int event_bus_subscribe(event_bus_t *bus,
     return 0;
 }
 
-int event_bus_unsubscribe(event_bus_t *bus,
-                          event_type_t type,
-                          event_handler_fn handler) {
-    if (!bus || !handler || type >= EVENT_TYPE_MAX) {
+int event_bus_subscribe(event_bus_t *bus,
+                        event_type_t type,
+                        event_handler_fn handler,
+                        void *user_data) {
+    return subscribe_common(bus, type, handler, NULL, user_data);
+}
+
+int event_bus_subscribe_batch(event_bus_t *bus,
+                              event_type_t type,
+                              event_batch_handler_fn handler,
+                              void *user_data) {
+    return subscribe_common(bus, type, NULL, handler, user_data);
+}
+
+static int unsubscribe_common(event_bus_t *bus,
+                              event_type_t type,
+                              event_handler_fn handler,
+                              event_batch_handler_fn batch_handler) {
+    if (!bus || (!handler && !batch_handler) || type >= EVENT_TYPE_MAX) {
         return -1;
     }
     
     pthread_rwlock_wrlock(&bus->subscriber_locks[type]);
     
     for (int i = 0; i < MAX_SUBSCRIBERS_PER_TYPE; i++) {
-        if (bus->subscribers[type][i].active &&
-            bus->subscribers[type][i].handler == handler) {
+        subscriber_t *sub = &bus->subscribers[type][i];
+        
+        if (sub->active && sub->handler == handler &&
+            sub->batch_handler == batch_handler) {
             
-            bus->subscribers[type][i].active = 0;
-            bus->subscribers[type][i].handler = NULL;
-            bus->subscribers[type][i].user_data = NULL;
+            // The slot's lane (if any) stays up for reuse; queued events
+            // for this slot are skipped once it is inactive.
+            __atomic_store_n(&sub->active, 0, __ATOMIC_RELEASE);
+            sub->handler = NULL;
+            sub->batch_handler = NULL;
+            sub->user_data = NULL;
             
             pthread_rwlock_unlock(&bus->subscriber_locks[type]);
-            LOG_INFO("Subscriber removed for event type: %s", 
+            LOG_INFO("Subscriber removed for event type: %s",
                     event_type_to_string(type));
             return 0;
         }
@@ -342,40 +1091,80 @@ int event_bus_unsubscribe(event_bus_t *bus,
     return -1;
 }
 
+int event_bus_unsubscribe(event_bus_t *bus,
+                          event_type_t type,
+                          event_handler_fn handler) {
+    return unsubscribe_common(bus, type, handler, NULL);
+}
+
+int event_bus_unsubscribe_batch(event_bus_t *bus,
+                                event_type_t type,
+                                event_batch_handler_fn handler) {
+    return unsubscribe_common(bus, type, NULL, handler);
+}
+
+int event_bus_set_coalescing(event_bus_t *bus, event_type_t type, int enabled) {
+    if (!bus || type >= EVENT_TYPE_MAX) return -1;
+    
+    // Events already queued on the other path are still delivered
+    __atomic_store_n(&bus->coalesce[type], enabled ? 1 : 0, __ATOMIC_RELAXED);
+    return 0;
+}
+
 // ============================================================================
 // EVENT PUBLISHING
 // ============================================================================
 
 int event_bus_publish(event_bus_t *bus, const event_t *event) {
-    if (!bus || !event) return -1;
+    if (!bus || !event || event->type >= EVENT_TYPE_MAX) return -1;
     
-    pthread_mutex_lock(&bus->stats_lock);
-    bus->events_published++;
-    pthread_mutex_unlock(&bus->stats_lock);
+    STAT_ADD(bus, published, 1);
+    
+    uint64_t now_us = time_now_us();
+    
+    if (event_is_terminal(event->type)) {
+        forget_superseded_peer(bus, event);
+    }
     
     // Non-blocking push (drop if queue full)
-    if (event_queue_push(&bus->queue, event, 0) != 0) {
-        pthread_mutex_lock(&bus->stats_lock);
-        bus->events_dropped++;
-        pthread_mutex_unlock(&bus->stats_lock);
+    switch (bus->lane_mode) {
+        case EVENT_LANES_PER_TYPE: {
+            event_lane_t *lane = __atomic_load_n(&bus->type_lanes[event->type],
+                                                 __ATOMIC_ACQUIRE);
+            return lane ? lane_push(bus, lane, event, now_us) : 0;
+        }
         
-        LOG_WARN("Event dropped (queue full): type=%s", 
-                event_type_to_string(event->type));
-        return -1;
+        case EVENT_LANES_PER_SUBSCRIBER: {
+            // Fails only if no lane took it; a retry would duplicate the
+            // event on lanes that did (partial drops are counted per lane)
+            int targeted = 0, accepted = 0;
+            for (int i = 0; i < MAX_SUBSCRIBERS_PER_TYPE; i++) {
+                subscriber_t *sub = &bus->subscribers[event->type][i];
+                if (!__atomic_load_n(&sub->active, __ATOMIC_ACQUIRE)) continue;
+                
+                event_lane_t *lane = __atomic_load_n(&sub->lane, __ATOMIC_ACQUIRE);
+                if (!lane) continue;
+                targeted++;
+                if (lane_push(bus, lane, event, now_us) == 0) accepted++;
+            }
+            return targeted && !accepted ? -1 : 0;
+        }
+        
+        case EVENT_LANES_SHARED:
+        default:
+            return lane_push(bus, bus->lanes[0], event, now_us);
     }
-    
-    return 0;
 }
 
 int event_bus_publish_sync(event_bus_t *bus, const event_t *event) {
     if (!bus || !event) return -1;
     
-    pthread_mutex_lock(&bus->stats_lock);
-    bus->events_published++;
-    pthread_mutex_unlock(&bus->stats_lock);
+    STAT_ADD(bus, published, 1);
     
     // Dispatch immediately (bypass queue)
-    dispatch_event_to_subscribers(bus, event);
+    if (event->type < EVENT_TYPE_MAX) {
+        dispatch_type(bus, event->type, -1, event, 1);
+    }
     
     return 0;
 }
@@ -384,18 +1173,35 @@ int event_bus_publish_sync(event_bus_t *bus, const event_t *event) {
 // STATISTICS
 // ============================================================================
 
+static size_t lane_coalesce_depth(event_lane_t *lane) {
+    pthread_mutex_lock(&lane->coalesce.lock);
+    size_t count = lane->coalesce.count;
+    pthread_mutex_unlock(&lane->coalesce.lock);
+    return count;
+}
+
 void event_bus_get_stats(event_bus_t *bus, event_bus_stats_t *stats) {
     if (!bus || !stats) return;
     
-    pthread_mutex_lock(&bus->stats_lock);
-    stats->events_published = bus->events_published;
-    stats->events_dispatched = bus->events_dispatched;
-    stats->events_dropped = bus->events_dropped;
-    pthread_mutex_unlock(&bus->stats_lock);
+    stats->events_published = 0;
+    stats->events_dispatched = 0;
+    stats->events_dropped = 0;
+    stats->events_coalesced = 0;
+    for (int i = 0; i < EVENT_STAT_STRIPES; i++) {
+        stats->events_published += __atomic_load_n(&bus->stats[i].published, __ATOMIC_RELAXED);
+        stats->events_dispatched += __atomic_load_n(&bus->stats[i].dispatched, __ATOMIC_RELAXED);
+        stats->events_dropped += __atomic_load_n(&bus->stats[i].dropped, __ATOMIC_RELAXED);
+        stats->events_coalesced += __atomic_load_n(&bus->stats[i].coalesced, __ATOMIC_RELAXED);
+    }
     
-    pthread_mutex_lock(&bus->queue.lock);
-    stats->queue_size = bus->queue.count;
-    pthread_mutex_unlock(&bus->queue.lock);
+    size_t lane_count = __atomic_load_n(&bus->lane_count, __ATOMIC_ACQUIRE);
+    stats->lanes = lane_count;
+    stats->payload_pool_misses = __atomic_load_n(&bus->payload_pool.misses, __ATOMIC_RELAXED);
+    stats->queue_size = 0;
+    for (size_t i = 0; i < lane_count; i++) {
+        stats->queue_size += event_queue_depth(&bus->lanes[i]->queue) +
+                             lane_coalesce_depth(bus->lanes[i]);
+    }
     
     stats->subscribers_total = 0;
     for (int i = 0; i < EVENT_TYPE_MAX; i++) {
@@ -409,6 +1215,31 @@ void event_bus_get_stats(event_bus_t *bus, event_bus_stats_t *stats) {
     }
 }
 
+size_t event_bus_get_lane_stats(event_bus_t *bus, event_bus_lane_stats_t *out,
+                                size_t max_lanes) {
+    if (!bus || !out) return 0;
+    
+    size_t lane_count = __atomic_load_n(&bus->lane_count, __ATOMIC_ACQUIRE);
+    size_t n = lane_count < max_lanes ? lane_count : max_lanes;
+    
+    for (size_t i = 0; i < n; i++) {
+        event_lane_t *lane = bus->lanes[i];
+        event_bus_lane_stats_t *st = &out[i];
+        
+        safe_strncpy(st->name, lane->name, sizeof(st->name));
+        st->queue_depth = event_queue_depth(&lane->queue) + lane_coalesce_depth(lane);
+        st->dispatched = __atomic_load_n(&lane->dispatched, __ATOMIC_RELAXED);
+        st->dropped = __atomic_load_n(&lane->dropped, __ATOMIC_RELAXED);
+        st->coalesced = __atomic_load_n(&lane->coalesced, __ATOMIC_RELAXED);
+        st->max_latency_us = __atomic_load_n(&lane->latency_max_us, __ATOMIC_RELAXED);
+        
+        uint64_t total = __atomic_load_n(&lane->latency_total_us, __ATOMIC_RELAXED);
+        st->avg_latency_us = st->dispatched ? total / st->dispatched : 0;
+    }
+    
+    return n;
+}
+
 // ============================================================================
 // HELPERS
 // ============================================================================
@@ -428,4 +1259,13 @@ const char* event_type_to_string(event_type_t type) {
         case EVENT_TYPE_CATALOG_UPDATED: return "CATALOG_UPDATED";
         default: return "UNKNOWN";
     }
-}
\ No newline at end of file
+}
+
+const char* event_lane_mode_to_string(event_lane_mode_t mode) {
+    switch (mode) {
+        case EVENT_LANES_SHARED: return "shared";
+        case EVENT_LANES_PER_TYPE: return "per_type";
+        case EVENT_LANES_PER_SUBSCRIBER: return "per_subscriber";
+        default: return "unknown";
+    }
+}
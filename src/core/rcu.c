@@ -0,0 +1,60 @@
+// src/core/rcu.c
+// RCU-style snapshot publication and grace periods
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "roole/core/rcu.h"
+#include <stdlib.h>
+#include <sched.h>
+
+void rcu_release(rcu_head_t *snap) {
+    if (snap && __atomic_sub_fetch(&snap->refcount, 1, __ATOMIC_ACQ_REL) == 0) {
+        if (snap->reclaim) {
+            snap->reclaim(snap);
+        } else {
+            free(snap);
+        }
+    }
+}
+
+void rcu_publish(rcu_slot_t *slot, rcu_head_t *snap) {
+    rcu_head_t *old = __atomic_exchange_n(&slot->current, snap, __ATOMIC_ACQ_REL);
+    
+    // Grace period: a reader that loaded `old` before the swap is still
+    // inside its acquire window until it has taken its reference. The
+    // window is a handful of instructions, so this rarely spins.
+    while (__atomic_load_n(&slot->acquiring, __ATOMIC_ACQUIRE) != 0) {
+        sched_yield();
+    }
+    
+    rcu_release(old);
+}
+
+rcu_head_t* rcu_acquire(rcu_slot_t *slot) {
+    __atomic_add_fetch(&slot->acquiring, 1, __ATOMIC_SEQ_CST);
+    rcu_head_t *snap = __atomic_load_n(&slot->current, __ATOMIC_SEQ_CST);
+    if (snap) {
+        __atomic_add_fetch(&snap->refcount, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_sub_fetch(&slot->acquiring, 1, __ATOMIC_RELEASE);
+    
+    return snap;
+}
+
+// Flip twice, draining the parity new readers just left each time: a
+// reader that loaded the epoch before a flip but counted itself after the
+// matching drain only ever sees the newly published state
+void rcu_synchronize(rcu_gate_t *gate) {
+    while (__atomic_exchange_n(&gate->syncing, 1, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+    
+    for (int flip = 0; flip < 2; flip++) {
+        uint32_t old = __atomic_fetch_add(&gate->epoch, 1, __ATOMIC_SEQ_CST) & 1;
+        while (__atomic_load_n(&gate->active[old], __ATOMIC_SEQ_CST) != 0) {
+            sched_yield();
+        }
+    }
+    
+    __atomic_store_n(&gate->syncing, 0, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,377 @@
+// src/core/trace.c
+// Request tracing: lock-free span ring with Chrome trace and OTLP export
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "roole/core/trace.h"
+#include "roole/core/rcu.h"
+#include "roole/logger/logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+// INTERNAL STRUCTURES
+// ============================================================================
+
+// Seqlock slot: seq is 2*pos+1 while the writer of ring position pos fills
+// it and 2*pos+2 once complete, so readers can tell a finished span from a
+// torn or recycled one without taking a lock
+typedef struct trace_slot {
+    uint64_t seq;
+    uint64_t trace_id;
+    uint64_t start_us;
+    uint64_t duration_us;
+    uint64_t arg;
+    uint64_t meta;                      // node_id | stage << 16
+} trace_slot_t;
+
+static struct {
+    trace_slot_t *slots;                // NULL = tracing off
+    size_t mask;
+    uint64_t head;                      // Next ring position
+    rcu_gate_t gate;                    // Held while slots/observer are in use
+    
+    node_id_t node_id;
+    uint32_t sample_one_in;
+    uint64_t sample_counter;
+    uint64_t id_seed;
+    uint64_t id_counter;
+    int64_t wall_offset_us;             // Realtime minus time_now_us() at init
+    
+    const trace_observer_t *observer;
+} g_trace;
+
+static __thread trace_id_t tls_current = 0;
+
+static const char *STAGE_NAMES[TRACE_STAGE_COUNT] = {
+    [TRACE_STAGE_RPC] = "rpc",
+    [TRACE_STAGE_INGRESS_PARSE] = "ingress_parse",
+    [TRACE_STAGE_RAFT_SUBMIT] = "raft_submit",
+    [TRACE_STAGE_FOLLOWER_APPEND] = "follower_append",
+    [TRACE_STAGE_COMMIT_WAIT] = "commit_wait",
+    [TRACE_STAGE_APPLY] = "apply",
+};
+
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+int trace_init(node_id_t node_id, size_t capacity, uint32_t sample_one_in) {
+    if (capacity == 0) capacity = TRACE_DEFAULT_CAPACITY;
+    
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    
+    trace_slot_t *slots = calloc(size, sizeof(trace_slot_t));
+    if (!slots) {
+        LOG_ERROR("Failed to allocate trace ring (%zu spans)", size);
+        return -1;
+    }
+    
+    struct timespec wall;
+    clock_gettime(CLOCK_REALTIME, &wall);
+    uint64_t wall_us = (uint64_t)wall.tv_sec * 1000000 + (uint64_t)wall.tv_nsec / 1000;
+    
+    trace_shutdown();
+    
+    g_trace.mask = size - 1;
+    g_trace.node_id = node_id;
+    g_trace.wall_offset_us = (int64_t)(wall_us - time_now_us());
+    g_trace.id_seed = splitmix64(wall_us ^ ((uint64_t)node_id << 48) ^ (uint64_t)getpid());
+    __atomic_store_n(&g_trace.head, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_trace.sample_one_in, sample_one_in, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_trace.slots, slots, __ATOMIC_RELEASE);
+    
+    if (sample_one_in) {
+        LOG_INFO("Tracing enabled: %zu spans, sampling 1/%u", size, sample_one_in);
+    } else {
+        LOG_INFO("Tracing ready: %zu spans, local sampling off", size);
+    }
+    return 0;
+}
+
+// Safe while other threads still record: they see tracing off from here
+// on, and the ring is freed once the ones already inside are done
+void trace_shutdown(void) {
+    trace_slot_t *slots = __atomic_exchange_n(&g_trace.slots, NULL, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&g_trace.observer, NULL, __ATOMIC_SEQ_CST);
+    rcu_synchronize(&g_trace.gate);
+    free(slots);
+}
+
+void trace_set_sampling(uint32_t sample_one_in) {
+    __atomic_store_n(&g_trace.sample_one_in, sample_one_in, __ATOMIC_RELAXED);
+}
+
+void trace_set_observer(const trace_observer_t *observer) {
+    __atomic_store_n(&g_trace.observer, observer, __ATOMIC_SEQ_CST);
+    rcu_synchronize(&g_trace.gate);
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+trace_id_t trace_new_id(void) {
+    if (!__atomic_load_n(&g_trace.slots, __ATOMIC_ACQUIRE)) return 0;
+    
+    uint32_t one_in = __atomic_load_n(&g_trace.sample_one_in, __ATOMIC_RELAXED);
+    if (one_in == 0) return 0;
+    if (one_in > 1 &&
+        __atomic_fetch_add(&g_trace.sample_counter, 1, __ATOMIC_RELAXED) % one_in != 0) {
+        return 0;
+    }
+    
+    uint64_t n = __atomic_add_fetch(&g_trace.id_counter, 1, __ATOMIC_RELAXED);
+    trace_id_t id = splitmix64(g_trace.id_seed + n);
+    return id ? id : 1;
+}
+
+trace_id_t trace_current(void) {
+    return tls_current;
+}
+
+void trace_set_current(trace_id_t trace_id) {
+    tls_current = trace_id;
+}
+
+void trace_record(trace_stage_t stage, trace_id_t trace_id, uint64_t start_us,
+                  uint64_t end_us, uint64_t arg) {
+    if (trace_id == 0 || stage >= TRACE_STAGE_COUNT) return;
+    
+    uint32_t token = rcu_read_enter(&g_trace.gate);
+    trace_slot_t *slots = __atomic_load_n(&g_trace.slots, __ATOMIC_SEQ_CST);
+    if (!slots) {
+        rcu_read_exit(&g_trace.gate, token);
+        return;
+    }
+    
+    trace_span_t span = {
+        .trace_id = trace_id,
+        .start_us = start_us,
+        .duration_us = end_us > start_us ? end_us - start_us : 0,
+        .arg = arg,
+        .node_id = g_trace.node_id,
+        .stage = (uint8_t)stage,
+    };
+    
+    uint64_t pos = __atomic_fetch_add(&g_trace.head, 1, __ATOMIC_RELAXED);
+    trace_slot_t *slot = &slots[pos & g_trace.mask];
+    
+    __atomic_store_n(&slot->seq, 2 * pos + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&slot->trace_id, span.trace_id, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->start_us, span.start_us, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->duration_us, span.duration_us, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->arg, span.arg, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->meta, (uint64_t)span.node_id | ((uint64_t)span.stage << 16),
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->seq, 2 * pos + 2, __ATOMIC_RELEASE);
+    
+    const trace_observer_t *observer = __atomic_load_n(&g_trace.observer, __ATOMIC_SEQ_CST);
+    if (observer) {
+        observer->on_span(observer->ctx, &span);
+    }
+    
+    rcu_read_exit(&g_trace.gate, token);
+}
+
+const char* trace_stage_name(trace_stage_t stage) {
+    return stage < TRACE_STAGE_COUNT ? STAGE_NAMES[stage] : "unknown";
+}
+
+// ============================================================================
+// EXPORT
+// ============================================================================
+
+size_t trace_snapshot(trace_span_t *out, size_t max) {
+    if (!out) return 0;
+    
+    uint32_t token = rcu_read_enter(&g_trace.gate);
+    trace_slot_t *slots = __atomic_load_n(&g_trace.slots, __ATOMIC_SEQ_CST);
+    if (!slots) {
+        rcu_read_exit(&g_trace.gate, token);
+        return 0;
+    }
+    
+    uint64_t head = __atomic_load_n(&g_trace.head, __ATOMIC_ACQUIRE);
+    uint64_t size = g_trace.mask + 1;
+    uint64_t first = head > size ? head - size : 0;
+    if (head - first > max) first = head - max;
+    
+    size_t count = 0;
+    for (uint64_t pos = first; pos < head; pos++) {
+        trace_slot_t *slot = &slots[pos & g_trace.mask];
+        
+        uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (seq != 2 * pos + 2) continue;     // Still being written, or reused
+        
+        trace_span_t span;
+        span.trace_id = __atomic_load_n(&slot->trace_id, __ATOMIC_RELAXED);
+        span.start_us = __atomic_load_n(&slot->start_us, __ATOMIC_RELAXED);
+        span.duration_us = __atomic_load_n(&slot->duration_us, __ATOMIC_RELAXED);
+        span.arg = __atomic_load_n(&slot->arg, __ATOMIC_RELAXED);
+        uint64_t meta = __atomic_load_n(&slot->meta, __ATOMIC_RELAXED);
+        
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq) continue;
+        
+        span.node_id = (node_id_t)(meta & 0xffff);
+        span.stage = (uint8_t)(meta >> 16);
+        out[count++] = span;
+    }
+    
+    rcu_read_exit(&g_trace.gate, token);
+    return count;
+}
+
+// snprintf-style append: keeps counting past cap so the caller learns the
+// size it needs
+static void json_append(char *buf, size_t cap, size_t *used, const char *fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static void json_append(char *buf, size_t cap, size_t *used, const char *fmt, ...) {
+    size_t offset = *used < cap ? *used : cap;
+    
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf + offset, cap - offset, fmt, args);
+    va_end(args);
+    
+    if (n > 0) *used += (size_t)n;
+}
+
+static uint64_t wall_us(uint64_t us) {
+    return (uint64_t)((int64_t)us + g_trace.wall_offset_us);
+}
+
+static void render_chrome_span(char *buf, size_t cap, size_t *used, const trace_span_t *s,
+                               const char *sep) {
+    // One row per request, so a trace reads left to right through its stages
+    json_append(buf, cap, used,
+                "%s{\"name\":\"%s\",\"cat\":\"roole\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,"
+                "\"pid\":%u,\"tid\":%u,\"args\":{\"trace_id\":\"%016lx\",\"arg\":%lu}}",
+                sep, trace_stage_name((trace_stage_t)s->stage), wall_us(s->start_us),
+                s->duration_us, (unsigned)s->node_id, (unsigned)(s->trace_id & 0x7fffffff),
+                s->trace_id, s->arg);
+}
+
+static void render_otlp_span(char *buf, size_t cap, size_t *used, const trace_span_t *s,
+                             const char *sep) {
+    uint64_t span_id = splitmix64(s->trace_id ^ (s->start_us << 8) ^ s->stage);
+    uint64_t start = wall_us(s->start_us);
+    
+    json_append(buf, cap, used,
+                "%s{\"traceId\":\"%016lx%016lx\",\"spanId\":\"%016lx\",\"name\":\"%s\","
+                "\"kind\":1,\"startTimeUnixNano\":\"%lu000\",\"endTimeUnixNano\":\"%lu000\","
+                "\"attributes\":[{\"key\":\"roole.node_id\",\"value\":{\"intValue\":\"%u\"}},"
+                "{\"key\":\"roole.arg\",\"value\":{\"intValue\":\"%lu\"}}]}",
+                sep, (uint64_t)0, s->trace_id, span_id ? span_id : 1,
+                trace_stage_name((trace_stage_t)s->stage), start, start + s->duration_us,
+                (unsigned)s->node_id, s->arg);
+}
+
+typedef void (*render_span_fn)(char *buf, size_t cap, size_t *used, const trace_span_t *s,
+                               const char *sep);
+
+static int render_spans(char *buf, size_t cap, const char *prefix, const char *suffix,
+                        render_span_fn render) {
+    size_t max = (size_t)g_trace.mask + 1;
+    trace_span_t *spans = malloc(max * sizeof(trace_span_t));
+    if (!spans) return -1;
+    
+    size_t count = trace_snapshot(spans, max);
+    
+    size_t used = 0;
+    json_append(buf, cap, &used, "%s", prefix);
+    for (size_t i = 0; i < count; i++) {
+        render(buf, cap, &used, &spans[i], i > 0 ? "," : "");
+    }
+    json_append(buf, cap, &used, "%s", suffix);
+    free(spans);
+    
+    // Spans keep arriving; ask for room to spare so a retry still fits
+    if (used >= cap) used += used / 2 + 4096;
+    return used > INT32_MAX ? -1 : (int)used;
+}
+
+int trace_render_chrome(void *ctx, char *buf, size_t cap) {
+    (void)ctx;
+    if (!__atomic_load_n(&g_trace.slots, __ATOMIC_ACQUIRE)) {
+        return snprintf(buf, cap, "{\"traceEvents\":[]}\n");
+    }
+    return render_spans(buf, cap, "{\"traceEvents\":[", "],\"displayTimeUnit\":\"ms\"}\n",
+                        render_chrome_span);
+}
+
+int trace_render_otlp(void *ctx, char *buf, size_t cap) {
+    (void)ctx;
+    if (!__atomic_load_n(&g_trace.slots, __ATOMIC_ACQUIRE)) {
+        return snprintf(buf, cap, "{\"resourceSpans\":[]}\n");
+    }
+    
+    char prefix[256];
+    snprintf(prefix, sizeof(prefix),
+             "{\"resourceSpans\":[{\"resource\":{\"attributes\":["
+             "{\"key\":\"service.name\",\"value\":{\"stringValue\":\"roole\"}},"
+             "{\"key\":\"roole.node_id\",\"value\":{\"intValue\":\"%u\"}}]},"
+             "\"scopeSpans\":[{\"scope\":{\"name\":\"roole.trace\"},\"spans\":[",
+             (unsigned)g_trace.node_id);
+    return render_spans(buf, cap, prefix, "]}]}]}\n", render_otlp_span);
+}
+
+int trace_dump_file(const char *path, trace_format_t format) {
+    if (!path) return -1;
+    
+    int (*render)(void*, char*, size_t) =
+        format == TRACE_FORMAT_OTLP ? trace_render_otlp : trace_render_chrome;
+    
+    size_t cap = 64 * 1024;
+    char *buf = NULL;
+    int len = -1;
+    for (int attempt = 0; attempt < 3; attempt++) {
+        char *grown = realloc(buf, cap);
+        if (!grown) break;
+        buf = grown;
+        
+        len = render(NULL, buf, cap);
+        if (len < 0 || (size_t)len < cap) break;
+        cap = (size_t)len + 1;
+        len = -1;
+    }
+    
+    if (len < 0) {
+        free(buf);
+        LOG_ERROR("Failed to render traces for %s", path);
+        return -1;
+    }
+    
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        free(buf);
+        LOG_ERROR("Failed to open trace dump %s", path);
+        return -1;
+    }
+    
+    size_t written = fwrite(buf, 1, (size_t)len, f);
+    int rc = (fclose(f) == 0 && written == (size_t)len) ? 0 : -1;
+    free(buf);
+    
+    if (rc == 0) {
+        LOG_INFO("Wrote %d bytes of traces to %s", len, path);
+    } else {
+        LOG_ERROR("Failed to write trace dump %s", path);
+    }
+    return rc;
+}
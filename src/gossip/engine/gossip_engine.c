@@ -2,11 +2,43 @@
 
 #include "roole/gossip/gossip_engine.h"
 #include "roole/transport/udp_transport.h"
+#include "roole/core/rcu.h"
 #include "roole/logger/logger.h"
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <errno.h>
+#include <time.h>
+
+#define NODE_ID_SPACE (UINT16_MAX + 1)
+
+// Pending membership notification (latest state per node_id wins)
+typedef struct {
+    node_id_t node_id;
+    node_type_t node_type;
+    char ip_address[MAX_IP_LEN];
+    uint16_t data_port;
+    const char *event_type;       // MEMBER_EVENT_* literal
+    uint64_t enqueued_us;
+} member_event_t;
+
+// Bounded FIFO of member events, coalesced per node_id.
+// Producers (UDP receiver, protocol thread) never block on consumers.
+typedef struct {
+    member_event_t *ring;
+    size_t capacity;
+    size_t head;
+    size_t count;
+    uint16_t *slot_of;            // node_id -> ring index + 1 (0 = not queued)
+    
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t idle;          // Signalled when a delivery finishes
+    int delivering;               // Dispatcher is inside the callback
+    
+    gossip_engine_event_stats_t stats;
+} member_event_queue_t;
 
 struct gossip_engine {
     node_id_t my_id;
@@ -25,11 +57,161 @@ struct gossip_engine {
     
     member_event_cb event_callback;
     void *event_callback_data;
+    
+    member_event_queue_t event_queue;
+    pthread_t dispatch_thread;
+    int dispatch_started;
+    
+    // Receiver-thread hooks (RTT samples, load summaries)
+    member_rtt_cb rtt_callback;
+    void *rtt_callback_data;
+    member_load_provider_cb load_provider;
+    member_load_cb load_callback;
+    void *load_callback_data;
+    pthread_mutex_t hooks_lock;
+    rcu_gate_t hooks_gate;        // Setters wait out hook calls in flight
+
+    // Packet encryption (NULL = plaintext); counters are atomic
+    gossip_keyring_t *keyring;
+    gossip_engine_crypto_stats_t crypto_stats;
 
     pthread_t protocol_thread;
     volatile int shutdown_flag;
 };
 
+// ============================================================================
+// MEMBER EVENT QUEUE (Async delivery of membership callbacks)
+// ============================================================================
+
+static int event_queue_init(member_event_queue_t *q, size_t capacity) {
+    memset(q, 0, sizeof(*q));
+    
+    q->ring = calloc(capacity, sizeof(member_event_t));
+    q->slot_of = calloc(NODE_ID_SPACE, sizeof(uint16_t));
+    if (!q->ring || !q->slot_of) {
+        free(q->ring);
+        free(q->slot_of);
+        return -1;
+    }
+    
+    q->capacity = capacity;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    pthread_cond_init(&q->idle, NULL);
+    return 0;
+}
+
+static void event_queue_destroy(member_event_queue_t *q) {
+    if (!q->ring) return;
+    
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->idle);
+    pthread_mutex_destroy(&q->lock);
+    free(q->ring);
+    free(q->slot_of);
+    q->ring = NULL;
+    q->slot_of = NULL;
+}
+
+static void event_queue_push(member_event_queue_t *q,
+                             node_id_t node_id,
+                             node_type_t node_type,
+                             const char *ip_address,
+                             uint16_t data_port,
+                             const char *event_type) {
+    pthread_mutex_lock(&q->lock);
+    
+    member_event_t *ev;
+    uint16_t slot = q->slot_of[node_id];
+    
+    if (slot) {
+        // Already queued: overwrite in place, keep original position/age
+        ev = &q->ring[slot - 1];
+        q->stats.events_coalesced++;
+    } else if (q->count < q->capacity) {
+        size_t idx = (q->head + q->count) % q->capacity;
+        ev = &q->ring[idx];
+        ev->enqueued_us = time_now_us();
+        q->slot_of[node_id] = (uint16_t)(idx + 1);
+        q->count++;
+        q->stats.events_enqueued++;
+    } else {
+        q->stats.events_dropped++;
+        pthread_mutex_unlock(&q->lock);
+        LOG_WARN_RATELIMITED("ENGINE: Member event queue full, dropping %s for node %u",
+                 event_type, node_id);
+        return;
+    }
+    
+    ev->node_id = node_id;
+    ev->node_type = node_type;
+    safe_strncpy(ev->ip_address, ip_address ? ip_address : "", MAX_IP_LEN);
+    ev->data_port = data_port;
+    ev->event_type = event_type;
+    
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+}
+
+static void* event_dispatch_thread(void *arg) {
+    gossip_engine_t *engine = (gossip_engine_t*)arg;
+    member_event_queue_t *q = &engine->event_queue;
+    
+    logger_push_component("gossip:events");
+    LOG_INFO("Member event dispatcher started");
+    
+    for (;;) {
+        pthread_mutex_lock(&q->lock);
+        
+        while (q->count == 0 && !engine->shutdown_flag) {
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_nsec += 100 * 1000000L;
+            if (ts.tv_nsec >= 1000000000L) {
+                ts.tv_sec++;
+                ts.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&q->not_empty, &q->lock, &ts);
+        }
+        
+        if (q->count == 0) {
+            pthread_mutex_unlock(&q->lock);
+            break;  // Shutdown with empty queue
+        }
+        
+        member_event_t ev = q->ring[q->head];
+        q->slot_of[ev.node_id] = 0;
+        q->head = (q->head + 1) % q->capacity;
+        q->count--;
+        
+        member_event_cb callback = engine->event_callback;
+        void *callback_data = engine->event_callback_data;
+        q->delivering = 1;
+        
+        pthread_mutex_unlock(&q->lock);
+        
+        if (callback) {
+            callback(ev.node_id, ev.node_type, ev.ip_address, ev.data_port,
+                     ev.event_type, callback_data);
+        }
+        
+        uint64_t latency_us = time_now_us() - ev.enqueued_us;
+        
+        pthread_mutex_lock(&q->lock);
+        q->delivering = 0;
+        pthread_cond_broadcast(&q->idle);
+        q->stats.events_delivered++;
+        if (latency_us > q->stats.max_delivery_latency_us) {
+            q->stats.max_delivery_latency_us = latency_us;
+        }
+        pthread_mutex_unlock(&q->lock);
+    }
+    
+    LOG_INFO("Member event dispatcher stopped");
+    logger_pop_component();
+    return NULL;
+}
+
 // ============================================================================
 // PROTOCOL CALLBACKS (Bridge between protocol and transport)
 // ============================================================================
@@ -42,11 +224,8 @@ static void on_member_alive_cb(node_id_t node_id,
     
     LOG_INFO("ENGINE: Node %u is ALIVE", node_id);
     
-    if (engine->event_callback) {
-        engine->event_callback(node_id, update->node_type,
-                             update->ip_address, update->data_port,
-                             MEMBER_EVENT_JOIN, engine->event_callback_data);
-    }
+    event_queue_push(&engine->event_queue, node_id, update->node_type,
+                     update->ip_address, update->data_port, MEMBER_EVENT_JOIN);
 }
 
 static void on_member_suspect_cb(node_id_t node_id,
@@ -57,14 +236,10 @@ static void on_member_suspect_cb(node_id_t node_id,
     
     LOG_INFO("ENGINE: Node %u is SUSPECT (inc=%lu)", node_id, incarnation);
     
-    if (engine->event_callback) {
-        cluster_member_t *member = cluster_view_get(engine->cluster_view, node_id);
-        if (member) {
-            engine->event_callback(node_id, member->node_type,
-                                 member->ip_address, member->data_port,
-                                 MEMBER_EVENT_FAILED, engine->event_callback_data);
-            cluster_view_release(engine->cluster_view);
-        }
+    cluster_member_t member;
+    if (cluster_view_lookup(engine->cluster_view, node_id, &member) == RESULT_OK) {
+        event_queue_push(&engine->event_queue, node_id, member.node_type,
+                         member.ip_address, member.data_port, MEMBER_EVENT_FAILED);
     }
 }
 
@@ -74,38 +249,100 @@ static void on_member_dead_cb(node_id_t node_id, void *ctx)
     
     LOG_INFO("ENGINE: Node %u is DEAD", node_id);
     
-    if (engine->event_callback) {
-        cluster_member_t *member = cluster_view_get(engine->cluster_view, node_id);
-        if (member) {
-            engine->event_callback(node_id, member->node_type,
-                                 member->ip_address, member->data_port,
-                                 MEMBER_EVENT_LEAVE, engine->event_callback_data);
-            cluster_view_release(engine->cluster_view);
-        }
+    cluster_member_t member;
+    if (cluster_view_lookup(engine->cluster_view, node_id, &member) == RESULT_OK) {
+        event_queue_push(&engine->event_queue, node_id, member.node_type,
+                         member.ip_address, member.data_port, MEMBER_EVENT_LEAVE);
     }
 }
 
+static void on_rtt_sample_cb(node_id_t node_id, uint32_t rtt_us, void *ctx)
+{
+    gossip_engine_t *engine = (gossip_engine_t*)ctx;
+    
+    uint32_t token = rcu_read_enter(&engine->hooks_gate);
+    pthread_mutex_lock(&engine->hooks_lock);
+    member_rtt_cb callback = engine->rtt_callback;
+    void *user_data = engine->rtt_callback_data;
+    pthread_mutex_unlock(&engine->hooks_lock);
+    
+    if (callback) {
+        callback(node_id, rtt_us, user_data);
+    }
+    rcu_read_exit(&engine->hooks_gate, token);
+}
+
+static int get_local_load_cb(member_load_t *out_load, void *ctx)
+{
+    gossip_engine_t *engine = (gossip_engine_t*)ctx;
+    
+    uint32_t token = rcu_read_enter(&engine->hooks_gate);
+    pthread_mutex_lock(&engine->hooks_lock);
+    member_load_provider_cb provider = engine->load_provider;
+    void *user_data = engine->load_callback_data;
+    pthread_mutex_unlock(&engine->hooks_lock);
+    
+    int result = provider ? provider(out_load, user_data) : -1;
+    rcu_read_exit(&engine->hooks_gate, token);
+    return result;
+}
+
+static void on_peer_load_cb(node_id_t node_id, const member_load_t *load, void *ctx)
+{
+    gossip_engine_t *engine = (gossip_engine_t*)ctx;
+    
+    uint32_t token = rcu_read_enter(&engine->hooks_gate);
+    pthread_mutex_lock(&engine->hooks_lock);
+    member_load_cb callback = engine->load_callback;
+    void *user_data = engine->load_callback_data;
+    pthread_mutex_unlock(&engine->hooks_lock);
+    
+    if (callback) {
+        callback(node_id, load, user_data);
+    }
+    rcu_read_exit(&engine->hooks_gate, token);
+}
+
 static void on_send_message_cb(const gossip_message_t *msg,
                               const char *dest_ip,
                               uint16_t dest_port,
                               void *ctx)
 {
     gossip_engine_t *engine = (gossip_engine_t*)ctx;
+    gossip_keyring_t *keyring = __atomic_load_n(&engine->keyring, __ATOMIC_ACQUIRE);
     
-    uint8_t buffer[GOSSIP_MAX_PAYLOAD_SIZE];
-    ssize_t msg_size = gossip_message_serialize(msg, buffer, sizeof(buffer));
+    // Sealed packets must still fit the payload limit, so leave room
+    uint8_t plain[GOSSIP_MAX_PAYLOAD_SIZE];
+    size_t plain_cap = keyring ? sizeof(plain) - GOSSIP_CRYPTO_OVERHEAD : sizeof(plain);
+    ssize_t msg_size = gossip_message_serialize(msg, plain, plain_cap);
     
     if (msg_size < 0) {
         LOG_ERROR("ENGINE: Failed to serialize message");
         return;
     }
     
+    // Seal once; a broadcast sends the same sealed bytes to every peer
+    uint8_t sealed[GOSSIP_MAX_PAYLOAD_SIZE];
+    const uint8_t *buffer = plain;
+    if (keyring) {
+        msg_size = gossip_crypto_seal(keyring, plain, (size_t)msg_size,
+                                      sealed, sizeof(sealed));
+        if (msg_size < 0) {
+            __atomic_add_fetch(&engine->crypto_stats.seal_failures, 1, __ATOMIC_RELAXED);
+            LOG_ERROR("ENGINE: Failed to seal message type %u", msg->msg_type);
+            return;
+        }
+        __atomic_add_fetch(&engine->crypto_stats.packets_sealed, 1, __ATOMIC_RELAXED);
+        buffer = sealed;
+    }
+    
     // Broadcast to all peers if dest_ip is NULL
     if (!dest_ip) {
-        pthread_rwlock_rdlock(&engine->cluster_view->lock);
+        cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(engine->cluster_view);
+        if (!snap) return;
         
-        for (size_t i = 0; i < engine->cluster_view->count; i++) {
-            cluster_member_t *m = &engine->cluster_view->members[i];
+        for (size_t i = 0; i < snap->count; i++) {
+            const cluster_member_t *m = &snap->members[i];
             
             if (m->node_id == engine->my_id || m->status == NODE_STATUS_DEAD) {
                 continue;
@@ -115,7 +352,7 @@ static void on_send_message_cb(const gossip_message_t *msg,
                              m->ip_address, m->gossip_port);
         }
         
-        pthread_rwlock_unlock(&engine->cluster_view->lock);
+        cluster_view_snapshot_release(snap);
         
         LOG_DEBUG("ENGINE: Broadcast message type %u to all peers", msg->msg_type);
     } else {
@@ -125,7 +362,7 @@ static void on_send_message_cb(const gossip_message_t *msg,
             LOG_DEBUG("ENGINE: Sent message type %u to %s:%u",
                      msg->msg_type, dest_ip, dest_port);
         } else {
-            LOG_WARN("ENGINE: Failed to send message to %s:%u", dest_ip, dest_port);
+            LOG_WARN_RATELIMITED("ENGINE: Failed to send message to %s:%u", dest_ip, dest_port);
         }
     }
 }
@@ -142,14 +379,42 @@ static void on_udp_receive(const uint8_t *data, size_t len,
     
     LOG_DEBUG("ENGINE: Received %zu bytes from %s:%u", len, src_ip, src_port);
     
+    gossip_keyring_t *keyring = __atomic_load_n(&engine->keyring, __ATOMIC_ACQUIRE);
+    uint8_t plain[GOSSIP_MAX_PAYLOAD_SIZE];
+    
+    if (keyring) {
+        if (!gossip_crypto_is_sealed(data, len)) {
+            __atomic_add_fetch(&engine->crypto_stats.plaintext_dropped, 1, __ATOMIC_RELAXED);
+            LOG_WARN_RATELIMITED("ENGINE: Dropping unencrypted gossip packet from %s:%u",
+                     src_ip, src_port);
+            return;
+        }
+        
+        ssize_t plain_len = gossip_crypto_open(keyring, data, len, plain, sizeof(plain));
+        if (plain_len < 0) {
+            __atomic_add_fetch(&engine->crypto_stats.open_failures, 1, __ATOMIC_RELAXED);
+            LOG_WARN_RATELIMITED("ENGINE: Dropping gossip packet from %s:%u (authentication failed)",
+                     src_ip, src_port);
+            return;
+        }
+        __atomic_add_fetch(&engine->crypto_stats.packets_opened, 1, __ATOMIC_RELAXED);
+        
+        data = plain;
+        len = (size_t)plain_len;
+    } else if (gossip_crypto_is_sealed(data, len)) {
+        LOG_WARN_RATELIMITED("ENGINE: Encrypted gossip packet from %s:%u but no keyring configured",
+                 src_ip, src_port);
+        return;
+    }
+    
     if (len < 16) {
-        LOG_WARN("ENGINE: Malformed gossip packet (too small: %zu bytes)", len);
+        LOG_WARN_RATELIMITED("ENGINE: Malformed gossip packet (too small: %zu bytes)", len);
         return;
     }
     
     gossip_message_t msg;
     if (gossip_message_deserialize(data, len, &msg) != 0) {
-        LOG_ERROR("ENGINE: Failed to deserialize gossip message");
+        LOG_ERROR_RATELIMITED("ENGINE: Failed to deserialize gossip message");
         return;
     }
     
@@ -169,8 +434,10 @@ static void* protocol_loop_thread(void *arg)
     gossip_engine_t *engine = (gossip_engine_t*)arg;
     
     logger_push_component("gossip:protocol");
-    LOG_INFO("Protocol loop thread started (period=%ums)", 
-             engine->config.protocol_period_ms);
+    LOG_INFO("Protocol loop thread started (period=%ums, adaptive=%s, fanout=%u)", 
+             engine->config.protocol_period_ms,
+             engine->config.adaptive_period ? "on" : "off",
+             engine->config.fanout);
     
     uint64_t round = 0;
     
@@ -187,30 +454,43 @@ static void* protocol_loop_thread(void *arg)
         
         // Periodic statistics
         if (round % 10 == 0) {
-            pthread_rwlock_rdlock(&engine->cluster_view->lock);
+            cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(engine->cluster_view);
             
             size_t alive = 0, suspect = 0, dead = 0;
-            for (size_t i = 0; i < engine->cluster_view->count; i++) {
-                switch (engine->cluster_view->members[i].status) {
+            for (size_t i = 0; snap && i < snap->count; i++) {
+                switch (snap->members[i].status) {
                     case NODE_STATUS_ALIVE: alive++; break;
                     case NODE_STATUS_SUSPECT: suspect++; break;
                     case NODE_STATUS_DEAD: dead++; break;
                 }
             }
             
-            LOG_INFO("Cluster: %zu members (%zu alive, %zu suspect, %zu dead)",
-                     engine->cluster_view->count, alive, suspect, dead);
+            LOG_INFO("Cluster: %zu members (%zu alive, %zu suspect, %zu dead, version=%lu)",
+                     snap ? snap->count : 0, alive, suspect, dead,
+                     snap ? snap->version : 0);
             
-            pthread_rwlock_unlock(&engine->cluster_view->lock);
+            cluster_view_snapshot_release(snap);
             
             gossip_protocol_stats_t stats;
             gossip_protocol_get_stats(engine->protocol, &stats);
-            LOG_INFO("Protocol: pings=%lu acks=%lu timeouts=%lu suspect=%lu dead=%lu",
+            LOG_INFO("Protocol: pings=%lu acks=%lu timeouts=%lu suspect=%lu dead=%lu "
+                     "gossip=%lu period=%ums fanout=%u rtt_samples=%lu coord_err=%.2f "
+                     "load_rx=%lu",
                      stats.pings_sent, stats.acks_received, stats.ack_timeouts,
-                     stats.suspect_count, stats.dead_count);
+                     stats.suspect_count, stats.dead_count, stats.gossip_sent,
+                     stats.current_period_ms, stats.current_fanout,
+                     stats.rtt_samples, stats.coord.error, stats.load_received);
+            
+            if (__atomic_load_n(&engine->keyring, __ATOMIC_ACQUIRE)) {
+                gossip_engine_crypto_stats_t crypto;
+                gossip_engine_get_crypto_stats(engine, &crypto);
+                LOG_INFO("Crypto: sealed=%lu opened=%lu auth_failures=%lu plaintext_dropped=%lu",
+                         crypto.packets_sealed, crypto.packets_opened,
+                         crypto.open_failures, crypto.plaintext_dropped);
+            }
         }
         
-        usleep(engine->config.protocol_period_ms * 1000);
+        usleep(gossip_protocol_get_period_ms(engine->protocol) * 1000);
     }
     
     LOG_INFO("Protocol loop thread stopped");
@@ -260,6 +540,13 @@ gossip_engine_t* gossip_engine_create(
         engine->config = gossip_default_config();
     }
     
+    if (event_queue_init(&engine->event_queue, MAX_CLUSTER_NODES) != 0) {
+        LOG_ERROR("Failed to allocate member event queue");
+        free(engine);
+        return NULL;
+    }
+    pthread_mutex_init(&engine->hooks_lock, NULL);
+    
     // Create UDP transport
     engine->transport = udp_transport_create(bind_addr, gossip_port);
     if (!engine->transport) {
@@ -273,7 +560,10 @@ gossip_engine_t* gossip_engine_create(
         .on_member_alive = on_member_alive_cb,
         .on_member_suspect = on_member_suspect_cb,
         .on_member_dead = on_member_dead_cb,
-        .on_send_message = on_send_message_cb
+        .on_send_message = on_send_message_cb,
+        .on_rtt_sample = on_rtt_sample_cb,
+        .get_local_load = get_local_load_cb,
+        .on_peer_load = on_peer_load_cb
     };
     
     engine->protocol = gossip_protocol_create(
@@ -299,6 +589,13 @@ int gossip_engine_start(gossip_engine_t *engine)
 {
     if (!engine) return -1;
     
+    // Start member event dispatcher before anything can produce events
+    if (pthread_create(&engine->dispatch_thread, NULL, event_dispatch_thread, engine) != 0) {
+        LOG_ERROR("Failed to start member event dispatcher");
+        return -1;
+    }
+    engine->dispatch_started = 1;
+    
     // Start UDP receiver
     if (udp_transport_start_receiver(engine->transport, on_udp_receive, engine) != 0) {
         LOG_ERROR("Failed to start UDP receiver");
@@ -372,6 +669,16 @@ void gossip_engine_shutdown(gossip_engine_t *engine)
     if (engine->transport) {
         udp_transport_destroy(engine->transport);
     }
+    
+    // No producers left: wake dispatcher, let it drain and exit
+    if (engine->dispatch_started) {
+        pthread_mutex_lock(&engine->event_queue.lock);
+        pthread_cond_broadcast(&engine->event_queue.not_empty);
+        pthread_mutex_unlock(&engine->event_queue.lock);
+        pthread_join(engine->dispatch_thread, NULL);
+    }
+    event_queue_destroy(&engine->event_queue);
+    pthread_mutex_destroy(&engine->hooks_lock);
 
     free(engine);
     
@@ -384,8 +691,128 @@ void gossip_engine_set_callback(gossip_engine_t *engine,
 {
     if (!engine) return;
     
+    member_event_queue_t *q = &engine->event_queue;
+    
+    // Dispatcher reads the pair under the queue lock. Wait out a delivery
+    // already in flight, so the old user_data is unused once we return
+    // (unless called from the callback itself).
+    pthread_mutex_lock(&q->lock);
     engine->event_callback = callback;
     engine->event_callback_data = user_data;
+    if (engine->dispatch_started && !pthread_equal(pthread_self(), engine->dispatch_thread)) {
+        while (q->delivering) {
+            pthread_cond_wait(&q->idle, &q->lock);
+        }
+    }
+    pthread_mutex_unlock(&q->lock);
     
     LOG_DEBUG("Gossip engine callback updated");
-}
\ No newline at end of file
+}
+
+void gossip_engine_get_event_stats(gossip_engine_t *engine,
+                                   gossip_engine_event_stats_t *out_stats)
+{
+    if (!engine || !out_stats) return;
+    
+    pthread_mutex_lock(&engine->event_queue.lock);
+    *out_stats = engine->event_queue.stats;
+    out_stats->queue_depth = engine->event_queue.count;
+    pthread_mutex_unlock(&engine->event_queue.lock);
+}
+
+void gossip_engine_set_rtt_callback(gossip_engine_t *engine,
+                                    member_rtt_cb callback,
+                                    void *user_data)
+{
+    if (!engine) return;
+    
+    pthread_mutex_lock(&engine->hooks_lock);
+    engine->rtt_callback = callback;
+    engine->rtt_callback_data = user_data;
+    pthread_mutex_unlock(&engine->hooks_lock);
+    
+    // A call that picked up the old pair may still be running
+    rcu_synchronize(&engine->hooks_gate);
+}
+
+void gossip_engine_set_load_callbacks(gossip_engine_t *engine,
+                                      member_load_provider_cb provider,
+                                      member_load_cb callback,
+                                      void *user_data)
+{
+    if (!engine) return;
+    
+    pthread_mutex_lock(&engine->hooks_lock);
+    engine->load_provider = provider;
+    engine->load_callback = callback;
+    engine->load_callback_data = user_data;
+    pthread_mutex_unlock(&engine->hooks_lock);
+    
+    // The provider (protocol thread) or callback (receiver thread) may
+    // still be running with the old user_data
+    rcu_synchronize(&engine->hooks_gate);
+}
+
+void gossip_engine_get_protocol_stats(gossip_engine_t *engine,
+                                      gossip_protocol_stats_t *out_stats)
+{
+    if (!engine || !out_stats) return;
+    
+    gossip_protocol_get_stats(engine->protocol, out_stats);
+}
+
+void gossip_engine_get_transport_stats(gossip_engine_t *engine,
+                                       udp_transport_stats_t *out_stats)
+{
+    if (!engine || !out_stats) return;
+    
+    udp_transport_get_stats(engine->transport, out_stats);
+}
+
+uint32_t gossip_engine_estimate_rtt_us(gossip_engine_t *engine, node_id_t node_id)
+{
+    if (!engine || !engine->protocol) return 0;
+    
+    return gossip_protocol_estimate_rtt_us(engine->protocol, node_id);
+}
+
+void gossip_engine_get_coord(gossip_engine_t *engine, gossip_coord_t *out_coord)
+{
+    if (!engine || !out_coord) return;
+    
+    gossip_protocol_get_coord(engine->protocol, out_coord);
+}
+
+int gossip_engine_set_keyring(gossip_engine_t *engine, gossip_keyring_t *keyring)
+{
+    if (!engine) return -1;
+    
+    if (keyring) {
+        if (!gossip_crypto_available()) {
+            LOG_ERROR("ENGINE: Gossip encryption requested but not compiled in");
+            return -1;
+        }
+        if (gossip_keyring_count(keyring) == 0) {
+            LOG_ERROR("ENGINE: Gossip keyring has no keys");
+            return -1;
+        }
+    }
+    
+    __atomic_store_n(&engine->keyring, keyring, __ATOMIC_RELEASE);
+    
+    LOG_INFO("ENGINE: Gossip encryption %s", keyring ? "enabled (AES-256-GCM)" : "disabled");
+    return 0;
+}
+
+void gossip_engine_get_crypto_stats(gossip_engine_t *engine,
+                                    gossip_engine_crypto_stats_t *out_stats)
+{
+    if (!engine || !out_stats) return;
+    
+    const gossip_engine_crypto_stats_t *s = &engine->crypto_stats;
+    out_stats->packets_sealed = __atomic_load_n(&s->packets_sealed, __ATOMIC_RELAXED);
+    out_stats->packets_opened = __atomic_load_n(&s->packets_opened, __ATOMIC_RELAXED);
+    out_stats->seal_failures = __atomic_load_n(&s->seal_failures, __ATOMIC_RELAXED);
+    out_stats->open_failures = __atomic_load_n(&s->open_failures, __ATOMIC_RELAXED);
+    out_stats->plaintext_dropped = __atomic_load_n(&s->plaintext_dropped, __ATOMIC_RELAXED);
+}
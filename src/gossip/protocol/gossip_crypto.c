@@ -0,0 +1,411 @@
+// src/gossip/protocol/gossip_crypto.c
+// AES-256-GCM sealing of gossip packets with a rotating keyring
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "roole/gossip/gossip_crypto.h"
+#include "roole/logger/logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <endian.h>
+
+#ifdef ROOLE_HAVE_OPENSSL
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/crypto.h>
+#endif
+
+typedef struct {
+    int in_use;
+    uint8_t id;
+    uint64_t serial;              // Unique per installed key (thread ctx cache tag)
+    uint8_t key[GOSSIP_CRYPTO_KEY_SIZE];
+} gossip_key_t;
+
+struct gossip_keyring {
+    pthread_rwlock_t lock;
+    gossip_key_t keys[GOSSIP_KEYRING_MAX_KEYS];
+    int primary;                  // Index into keys, -1 = none
+
+    // Nonce = salt || counter; both randomized at creation so nodes
+    // sharing a key do not walk the same nonce sequence
+    uint32_t nonce_salt;
+    uint64_t nonce_counter;       // Atomic
+};
+
+static uint64_t g_key_serial = 0;
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static void wipe(void *ptr, size_t len) {
+#ifdef ROOLE_HAVE_OPENSSL
+    OPENSSL_cleanse(ptr, len);
+#else
+    volatile uint8_t *p = (volatile uint8_t*)ptr;
+    while (len--) *p++ = 0;
+#endif
+}
+
+static int find_key_locked(const gossip_keyring_t *keyring, uint8_t key_id) {
+    for (int i = 0; i < GOSSIP_KEYRING_MAX_KEYS; i++) {
+        if (keyring->keys[i].in_use && keyring->keys[i].id == key_id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// ============================================================================
+// KEYRING
+// ============================================================================
+
+int gossip_crypto_available(void) {
+#ifdef ROOLE_HAVE_OPENSSL
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+gossip_keyring_t* gossip_keyring_create(void) {
+    gossip_keyring_t *keyring = calloc(1, sizeof(gossip_keyring_t));
+    if (!keyring) return NULL;
+
+    pthread_rwlock_init(&keyring->lock, NULL);
+    keyring->primary = -1;
+
+#ifdef ROOLE_HAVE_OPENSSL
+    if (RAND_bytes((unsigned char*)&keyring->nonce_salt, sizeof(keyring->nonce_salt)) != 1 ||
+        RAND_bytes((unsigned char*)&keyring->nonce_counter, sizeof(keyring->nonce_counter)) != 1) {
+        LOG_ERROR("CRYPTO: Failed to seed nonce generator");
+        pthread_rwlock_destroy(&keyring->lock);
+        free(keyring);
+        return NULL;
+    }
+#endif
+
+    return keyring;
+}
+
+void gossip_keyring_destroy(gossip_keyring_t *keyring) {
+    if (!keyring) return;
+
+    wipe(keyring->keys, sizeof(keyring->keys));
+    pthread_rwlock_destroy(&keyring->lock);
+    free(keyring);
+}
+
+int gossip_keyring_add(gossip_keyring_t *keyring, uint8_t key_id, const uint8_t *key) {
+    if (!keyring || !key) return -1;
+
+    pthread_rwlock_wrlock(&keyring->lock);
+
+    int idx = find_key_locked(keyring, key_id);
+    for (int i = 0; idx < 0 && i < GOSSIP_KEYRING_MAX_KEYS; i++) {
+        if (!keyring->keys[i].in_use) idx = i;
+    }
+
+    if (idx < 0) {
+        pthread_rwlock_unlock(&keyring->lock);
+        LOG_ERROR("CRYPTO: Keyring full (max %d keys)", GOSSIP_KEYRING_MAX_KEYS);
+        return -1;
+    }
+
+    gossip_key_t *slot = &keyring->keys[idx];
+    slot->in_use = 1;
+    slot->id = key_id;
+    slot->serial = __atomic_add_fetch(&g_key_serial, 1, __ATOMIC_RELAXED);
+    memcpy(slot->key, key, GOSSIP_CRYPTO_KEY_SIZE);
+
+    if (keyring->primary < 0) {
+        keyring->primary = idx;
+    }
+
+    pthread_rwlock_unlock(&keyring->lock);
+
+    LOG_INFO("CRYPTO: Installed gossip key %u", key_id);
+    return 0;
+}
+
+int gossip_keyring_use(gossip_keyring_t *keyring, uint8_t key_id) {
+    if (!keyring) return -1;
+
+    pthread_rwlock_wrlock(&keyring->lock);
+    int idx = find_key_locked(keyring, key_id);
+    if (idx >= 0) {
+        keyring->primary = idx;
+    }
+    pthread_rwlock_unlock(&keyring->lock);
+
+    if (idx < 0) return -1;
+
+    LOG_INFO("CRYPTO: Gossip key %u is now primary", key_id);
+    return 0;
+}
+
+int gossip_keyring_remove(gossip_keyring_t *keyring, uint8_t key_id) {
+    if (!keyring) return -1;
+
+    pthread_rwlock_wrlock(&keyring->lock);
+    int idx = find_key_locked(keyring, key_id);
+    if (idx >= 0 && idx != keyring->primary) {
+        wipe(&keyring->keys[idx], sizeof(gossip_key_t));
+    } else {
+        idx = -1;
+    }
+    pthread_rwlock_unlock(&keyring->lock);
+
+    return idx >= 0 ? 0 : -1;
+}
+
+int gossip_keyring_load_spec(gossip_keyring_t *keyring, const char *spec) {
+    if (!keyring || !spec) return -1;
+
+    int loaded = 0;
+    int first_id = -1;
+    const char *p = spec;
+
+    while (*p) {
+        while (*p == ' ' || *p == ',') p++;
+        if (!*p) break;
+
+        char *end;
+        long id = strtol(p, &end, 10);
+        if (end == p || *end != ':' || id < 0 || id > UINT8_MAX) {
+            LOG_ERROR("CRYPTO: Bad key spec near '%.16s'", p);
+            return -1;
+        }
+        p = end + 1;
+
+        uint8_t key[GOSSIP_CRYPTO_KEY_SIZE];
+        for (size_t i = 0; i < GOSSIP_CRYPTO_KEY_SIZE; i++) {
+            int hi = hex_value(p[0]);
+            int lo = hi < 0 ? -1 : hex_value(p[1]);
+            if (lo < 0) {
+                wipe(key, sizeof(key));
+                LOG_ERROR("CRYPTO: Key %ld must be %d hex digits",
+                          id, GOSSIP_CRYPTO_KEY_SIZE * 2);
+                return -1;
+            }
+            key[i] = (uint8_t)((hi << 4) | lo);
+            p += 2;
+        }
+
+        if (*p && *p != ',' && *p != ' ') {
+            wipe(key, sizeof(key));
+            LOG_ERROR("CRYPTO: Key %ld is longer than %d hex digits",
+                      id, GOSSIP_CRYPTO_KEY_SIZE * 2);
+            return -1;
+        }
+
+        int rc = gossip_keyring_add(keyring, (uint8_t)id, key);
+        wipe(key, sizeof(key));
+        if (rc != 0) return -1;
+
+        if (first_id < 0) first_id = (int)id;
+        loaded++;
+    }
+
+    if (first_id >= 0) {
+        gossip_keyring_use(keyring, (uint8_t)first_id);
+    }
+
+    return loaded;
+}
+
+size_t gossip_keyring_count(gossip_keyring_t *keyring) {
+    if (!keyring) return 0;
+
+    size_t count = 0;
+    pthread_rwlock_rdlock(&keyring->lock);
+    for (int i = 0; i < GOSSIP_KEYRING_MAX_KEYS; i++) {
+        if (keyring->keys[i].in_use) count++;
+    }
+    pthread_rwlock_unlock(&keyring->lock);
+
+    return count;
+}
+
+// ============================================================================
+// SEAL / OPEN
+// ============================================================================
+
+#ifdef ROOLE_HAVE_OPENSSL
+
+// Cipher contexts live per thread and keep their key schedule between
+// packets; a packet only re-keys when the key it needs has changed.
+typedef struct {
+    EVP_CIPHER_CTX *enc;
+    EVP_CIPHER_CTX *dec;
+    uint64_t enc_serial;
+    uint64_t dec_serial;
+} crypto_thread_ctx_t;
+
+static pthread_key_t g_thread_ctx_key;
+static pthread_once_t g_thread_ctx_once = PTHREAD_ONCE_INIT;
+
+static void thread_ctx_free(void *arg) {
+    crypto_thread_ctx_t *tc = (crypto_thread_ctx_t*)arg;
+    EVP_CIPHER_CTX_free(tc->enc);
+    EVP_CIPHER_CTX_free(tc->dec);
+    free(tc);
+}
+
+static void thread_ctx_key_init(void) {
+    pthread_key_create(&g_thread_ctx_key, thread_ctx_free);
+}
+
+static crypto_thread_ctx_t* thread_ctx(void) {
+    pthread_once(&g_thread_ctx_once, thread_ctx_key_init);
+
+    crypto_thread_ctx_t *tc = pthread_getspecific(g_thread_ctx_key);
+    if (tc) return tc;
+
+    tc = calloc(1, sizeof(crypto_thread_ctx_t));
+    if (!tc) return NULL;
+
+    tc->enc = EVP_CIPHER_CTX_new();
+    tc->dec = EVP_CIPHER_CTX_new();
+    if (!tc->enc || !tc->dec ||
+        EVP_EncryptInit_ex(tc->enc, EVP_aes_256_gcm(), NULL, NULL, NULL) != 1 ||
+        EVP_DecryptInit_ex(tc->dec, EVP_aes_256_gcm(), NULL, NULL, NULL) != 1) {
+        thread_ctx_free(tc);
+        return NULL;
+    }
+
+    pthread_setspecific(g_thread_ctx_key, tc);
+    return tc;
+}
+
+ssize_t gossip_crypto_seal(gossip_keyring_t *keyring, const uint8_t *plain, size_t len,
+                           uint8_t *out, size_t out_size) {
+    if (!keyring || !plain || !out || len > INT32_MAX) return -1;
+    if (out_size < len + GOSSIP_CRYPTO_OVERHEAD) return -1;
+
+    crypto_thread_ctx_t *tc = thread_ctx();
+    if (!tc) return -1;
+
+    uint8_t key[GOSSIP_CRYPTO_KEY_SIZE];
+    uint64_t serial = 0;
+    uint8_t key_id = 0;
+
+    pthread_rwlock_rdlock(&keyring->lock);
+    if (keyring->primary >= 0) {
+        const gossip_key_t *k = &keyring->keys[keyring->primary];
+        key_id = k->id;
+        serial = k->serial;
+        if (serial != tc->enc_serial) {
+            memcpy(key, k->key, sizeof(key));
+        }
+    }
+    pthread_rwlock_unlock(&keyring->lock);
+
+    if (serial == 0) return -1;  // No primary key
+
+    uint8_t *nonce = out + 2;
+    uint64_t counter = __atomic_fetch_add(&keyring->nonce_counter, 1, __ATOMIC_RELAXED);
+    uint64_t counter_be = htobe64(counter);
+    out[0] = GOSSIP_CRYPTO_MAGIC;
+    out[1] = key_id;
+    memcpy(nonce, &keyring->nonce_salt, sizeof(keyring->nonce_salt));
+    memcpy(nonce + sizeof(keyring->nonce_salt), &counter_be, sizeof(counter_be));
+
+    int rekey = serial != tc->enc_serial;
+    int outl = 0, finl = 0;
+    int ok = EVP_EncryptInit_ex(tc->enc, NULL, NULL, rekey ? key : NULL, nonce) == 1;
+    if (rekey) {
+        wipe(key, sizeof(key));
+        tc->enc_serial = ok ? serial : 0;
+    }
+
+    uint8_t *body = out + GOSSIP_CRYPTO_HEADER_SIZE;
+    ok = ok &&
+         EVP_EncryptUpdate(tc->enc, NULL, &outl, out, 2) == 1 &&
+         EVP_EncryptUpdate(tc->enc, body, &outl, plain, (int)len) == 1 &&
+         EVP_EncryptFinal_ex(tc->enc, body + outl, &finl) == 1 &&
+         EVP_CIPHER_CTX_ctrl(tc->enc, EVP_CTRL_GCM_GET_TAG, GOSSIP_CRYPTO_TAG_SIZE,
+                             body + outl + finl) == 1;
+
+    if (!ok) {
+        tc->enc_serial = 0;
+        return -1;
+    }
+
+    return (ssize_t)(GOSSIP_CRYPTO_HEADER_SIZE + (size_t)(outl + finl) + GOSSIP_CRYPTO_TAG_SIZE);
+}
+
+ssize_t gossip_crypto_open(gossip_keyring_t *keyring, const uint8_t *packet, size_t len,
+                           uint8_t *out, size_t out_size) {
+    if (!keyring || !packet || !out || !gossip_crypto_is_sealed(packet, len)) return -1;
+    if (len > INT32_MAX) return -1;
+
+    size_t body_len = len - GOSSIP_CRYPTO_OVERHEAD;
+    if (out_size < body_len) return -1;
+
+    crypto_thread_ctx_t *tc = thread_ctx();
+    if (!tc) return -1;
+
+    uint8_t key[GOSSIP_CRYPTO_KEY_SIZE];
+    uint64_t serial = 0;
+
+    pthread_rwlock_rdlock(&keyring->lock);
+    int idx = find_key_locked(keyring, packet[1]);
+    if (idx >= 0) {
+        serial = keyring->keys[idx].serial;
+        if (serial != tc->dec_serial) {
+            memcpy(key, keyring->keys[idx].key, sizeof(key));
+        }
+    }
+    pthread_rwlock_unlock(&keyring->lock);
+
+    if (serial == 0) return -1;  // Unknown key ID
+
+    int rekey = serial != tc->dec_serial;
+    int outl = 0, finl = 0;
+    int ok = EVP_DecryptInit_ex(tc->dec, NULL, NULL, rekey ? key : NULL, packet + 2) == 1;
+    if (rekey) {
+        wipe(key, sizeof(key));
+        tc->dec_serial = ok ? serial : 0;
+    }
+
+    const uint8_t *body = packet + GOSSIP_CRYPTO_HEADER_SIZE;
+    ok = ok &&
+         EVP_DecryptUpdate(tc->dec, NULL, &outl, packet, 2) == 1 &&
+         EVP_DecryptUpdate(tc->dec, out, &outl, body, (int)body_len) == 1 &&
+         EVP_CIPHER_CTX_ctrl(tc->dec, EVP_CTRL_GCM_SET_TAG, GOSSIP_CRYPTO_TAG_SIZE,
+                             (void*)(body + body_len)) == 1 &&
+         EVP_DecryptFinal_ex(tc->dec, out + outl, &finl) == 1;
+
+    if (!ok) {
+        wipe(out, body_len);
+        return -1;
+    }
+
+    return (ssize_t)(outl + finl);
+}
+
+#else // !ROOLE_HAVE_OPENSSL
+
+ssize_t gossip_crypto_seal(gossip_keyring_t *keyring, const uint8_t *plain, size_t len,
+                           uint8_t *out, size_t out_size) {
+    (void)keyring; (void)plain; (void)len; (void)out; (void)out_size;
+    return -1;
+}
+
+ssize_t gossip_crypto_open(gossip_keyring_t *keyring, const uint8_t *packet, size_t len,
+                           uint8_t *out, size_t out_size) {
+    (void)keyring; (void)packet; (void)len; (void)out; (void)out_size;
+    return -1;
+}
+
+#endif // ROOLE_HAVE_OPENSSL
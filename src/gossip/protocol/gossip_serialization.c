@@ -33,6 +33,33 @@ static inline uint64_t read_u64_net(const uint8_t *buffer) {
     return be64toh(net_value);
 }
 
+static inline void write_u32_net(uint8_t *buffer, uint32_t value) {
+    uint32_t net_value = htonl(value);
+    memcpy(buffer, &net_value, sizeof(uint32_t));
+}
+
+static inline uint32_t read_u32_net(const uint8_t *buffer) {
+    uint32_t net_value;
+    memcpy(&net_value, buffer, sizeof(uint32_t));
+    return ntohl(net_value);
+}
+
+static inline void write_f32_net(uint8_t *buffer, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits = htonl(bits);
+    memcpy(buffer, &bits, sizeof(bits));
+}
+
+static inline float read_f32_net(const uint8_t *buffer) {
+    uint32_t bits;
+    float value;
+    memcpy(&bits, buffer, sizeof(bits));
+    bits = ntohl(bits);
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
 // ============================================================================
 // HELPER: Member Update Serialization (DRY)
 // ============================================================================
@@ -123,6 +150,82 @@ static size_t gossip_deserialize_member_update(const uint8_t *buffer,
     return offset;  // Should always be MEMBER_UPDATE_SIZE
 }
 
+// ============================================================================
+// HELPER: Coordinate Trailer (GOSSIP_FLAG_HAS_COORD)
+// ============================================================================
+
+#define COORD_TRAILER_SIZE ((GOSSIP_COORD_DIMS + 2) * 4)
+
+static size_t gossip_serialize_coord(const gossip_coord_t *coord, uint8_t *buffer) {
+    size_t offset = 0;
+    
+    for (int d = 0; d < GOSSIP_COORD_DIMS; d++) {
+        write_f32_net(buffer + offset, coord->vec[d]);
+        offset += 4;
+    }
+    write_f32_net(buffer + offset, coord->height);
+    offset += 4;
+    write_f32_net(buffer + offset, coord->error);
+    offset += 4;
+    
+    return offset;
+}
+
+static size_t gossip_deserialize_coord(const uint8_t *buffer, gossip_coord_t *coord) {
+    size_t offset = 0;
+    
+    for (int d = 0; d < GOSSIP_COORD_DIMS; d++) {
+        coord->vec[d] = read_f32_net(buffer + offset);
+        offset += 4;
+    }
+    coord->height = read_f32_net(buffer + offset);
+    offset += 4;
+    coord->error = read_f32_net(buffer + offset);
+    offset += 4;
+    
+    return offset;
+}
+
+// ============================================================================
+// HELPER: Load Trailer (GOSSIP_FLAG_HAS_LOAD)
+// ============================================================================
+
+#define LOAD_TRAILER_SIZE 12  // 1+1(padding)+2+2+2+4
+
+static size_t gossip_serialize_load(const member_load_t *load, uint8_t *buffer) {
+    size_t offset = 0;
+    
+    buffer[offset++] = load->cpu_pct;
+    buffer[offset++] = 0;  // Padding
+    write_u16_net(buffer + offset, load->queue_depth);
+    offset += 2;
+    write_u16_net(buffer + offset, load->rpc_inflight);
+    offset += 2;
+    write_u16_net(buffer + offset, load->active_executions);
+    offset += 2;
+    write_u32_net(buffer + offset, load->raft_apply_lag);
+    offset += 4;
+    
+    return offset;
+}
+
+static size_t gossip_deserialize_load(const uint8_t *buffer, member_load_t *load) {
+    size_t offset = 0;
+    
+    load->cpu_pct = buffer[offset++];
+    offset++;  // Skip padding
+    load->queue_depth = read_u16_net(buffer + offset);
+    offset += 2;
+    load->rpc_inflight = read_u16_net(buffer + offset);
+    offset += 2;
+    load->active_executions = read_u16_net(buffer + offset);
+    offset += 2;
+    load->raft_apply_lag = read_u32_net(buffer + offset);
+    offset += 4;
+    
+    return offset;
+}
+
 // ============================================================================
 // MESSAGE SERIALIZATION (Refactored using helpers)
 // ============================================================================
@@ -168,6 +271,26 @@ ssize_t gossip_message_serialize(const gossip_message_t *msg,
         offset += written;
     }
     
+    // Optional trailers (old receivers stop after the updates)
+    uint16_t flags = msg->flags;
+    if (flags & GOSSIP_FLAG_HAS_COORD) {
+        if (offset + COORD_TRAILER_SIZE <= buffer_size) {
+            offset += gossip_serialize_coord(&msg->coord, buffer + offset);
+        } else {
+            flags &= (uint16_t)~GOSSIP_FLAG_HAS_COORD;
+        }
+    }
+    if (flags & GOSSIP_FLAG_HAS_LOAD) {
+        if (offset + LOAD_TRAILER_SIZE <= buffer_size) {
+            offset += gossip_serialize_load(&msg->load, buffer + offset);
+        } else {
+            flags &= (uint16_t)~GOSSIP_FLAG_HAS_LOAD;
+        }
+    }
+    if (flags != msg->flags) {
+        write_u16_net(buffer + 2, flags);
+    }
+    
     return (ssize_t)offset;
 }
 
@@ -224,6 +347,22 @@ int gossip_message_deserialize(const uint8_t *buffer,
         offset += read;
     }
     
+    // Optional trailers
+    if (msg->flags & GOSSIP_FLAG_HAS_COORD) {
+        if (offset + COORD_TRAILER_SIZE <= buffer_size) {
+            offset += gossip_deserialize_coord(buffer + offset, &msg->coord);
+        } else {
+            msg->flags &= ~GOSSIP_FLAG_HAS_COORD;
+        }
+    }
+    if (msg->flags & GOSSIP_FLAG_HAS_LOAD) {
+        if (offset + LOAD_TRAILER_SIZE <= buffer_size) {
+            offset += gossip_deserialize_load(buffer + offset, &msg->load);
+        } else {
+            msg->flags &= ~GOSSIP_FLAG_HAS_LOAD;
+        }
+    }
+    
     return 0;
 }
 
@@ -315,6 +454,13 @@ int gossip_deserialize_bootstrap_response(const uint8_t *buffer,
 size_t gossip_message_serialized_size(const gossip_message_t *msg) {
     if (!msg) return 0;
     
-    // Header (16 bytes) + updates (MEMBER_UPDATE_SIZE each)
-    return 16 + (msg->num_updates * MEMBER_UPDATE_SIZE);
+    // Header (16 bytes) + updates (MEMBER_UPDATE_SIZE each) + trailers
+    size_t size = 16 + (msg->num_updates * MEMBER_UPDATE_SIZE);
+    if (msg->flags & GOSSIP_FLAG_HAS_COORD) {
+        size += COORD_TRAILER_SIZE;
+    }
+    if (msg->flags & GOSSIP_FLAG_HAS_LOAD) {
+        size += LOAD_TRAILER_SIZE;
+    }
+    return size;
 }
\ No newline at end of file
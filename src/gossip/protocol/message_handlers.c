@@ -7,6 +7,14 @@
 // MESSAGE HANDLERS (Pure state transitions)
 // ============================================================================
 
+// Copy a member out of the current view snapshot (no lock held afterwards)
+static cluster_member_t* lookup_member(gossip_protocol_t *proto,
+                                       node_id_t node_id,
+                                       cluster_member_t *out) {
+    return cluster_view_lookup(proto->cluster_view, node_id, out) == RESULT_OK ?
+           out : NULL;
+}
+
 // Add this helper function at the top of the file
 static void send_cluster_snapshot(gossip_protocol_t *proto,
                                   const char *dest_ip,
@@ -19,13 +27,14 @@ static void send_cluster_snapshot(gossip_protocol_t *proto,
         .num_updates = 0
     };
     
-    pthread_rwlock_rdlock(&proto->cluster_view->lock);
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(proto->cluster_view);
+    if (!snap) return;
     
     // Pack all alive members into response
-    for (size_t i = 0; i < proto->cluster_view->count && 
+    for (size_t i = 0; i < snap->count && 
          response.num_updates < GOSSIP_MAX_PIGGYBACK_UPDATES; i++) {
         
-        cluster_member_t *m = &proto->cluster_view->members[i];
+        const cluster_member_t *m = &snap->members[i];
         
         if (m->status == NODE_STATUS_DEAD) continue;
         
@@ -42,7 +51,7 @@ static void send_cluster_snapshot(gossip_protocol_t *proto,
         response.num_updates++;
     }
     
-    pthread_rwlock_unlock(&proto->cluster_view->lock);
+    cluster_view_snapshot_release(snap);
     
     LOG_INFO("SWIM: Sending cluster snapshot to %s:%u (%u members)",
              dest_ip, dest_port, response.num_updates);
@@ -53,63 +62,16 @@ static void send_cluster_snapshot(gossip_protocol_t *proto,
     }
 }
 
-// Modify handle_ping to detect JOIN messages
-static void handle_ping(gossip_protocol_t *proto,
-                       const gossip_message_t *msg,
-                       const char *src_ip,
-                       uint16_t src_port)
+// Apply piggybacked membership updates (PING / JOIN / LEAVE / GOSSIP)
+static void process_piggyback_updates(gossip_protocol_t *proto,
+                                      const gossip_message_t *msg,
+                                      const char *via)
 {
-    LOG_DEBUG("SWIM: Processing PING from node %u (updates=%u)", 
-              msg->sender_id, msg->num_updates);
-    
-    // Check if this is a JOIN message (sender not in cluster)
-    int is_new_member = 0;
-    cluster_member_t *existing = cluster_view_get(proto->cluster_view, msg->sender_id);
-    
-    if (!existing) {
-        is_new_member = 1;
-        
-        // 🔥 ADD THE SENDER TO CLUSTER VIEW
-        cluster_member_t new_sender = {
-            .node_id = msg->sender_id,
-            .node_type = proto->my_type, // We don't know their type yet
-            .status = NODE_STATUS_ALIVE,
-            .incarnation = 0,
-            .last_seen_ms = time_now_ms()
-        };
-        
-        // Extract IP/port from sender
-        safe_strncpy(new_sender.ip_address, src_ip, MAX_IP_LEN);
-        new_sender.gossip_port = src_port;
-        new_sender.data_port = 0; // Unknown until we get metadata
-        
-        cluster_view_add(proto->cluster_view, &new_sender);
-        
-        LOG_INFO("SWIM: Added sender node %u to cluster view", msg->sender_id);
-        
-        if (proto->callbacks.on_member_alive) {
-            gossip_member_update_t update = {
-                .node_id = msg->sender_id,
-                .node_type = new_sender.node_type,
-                .status = NODE_STATUS_ALIVE,
-                .incarnation = 0,
-                .timestamp_ms = time_now_ms()
-            };
-            safe_strncpy(update.ip_address, src_ip, MAX_IP_LEN);
-            update.gossip_port = src_port;
-            
-            proto->callbacks.on_member_alive(msg->sender_id, &update, 
-                                            proto->callback_context);
-        }
-    } else {
-        cluster_view_release(proto->cluster_view);
-    }
-    
-    // Process piggyback updates (existing code)...
     for (uint8_t i = 0; i < msg->num_updates; i++) {
         const gossip_member_update_t *upd = &msg->updates[i];
         
-        cluster_member_t *existing = cluster_view_get(proto->cluster_view, upd->node_id);
+        cluster_member_t existing_copy;
+        cluster_member_t *existing = lookup_member(proto, upd->node_id, &existing_copy);
         
         if (!existing) {
             // New member discovered
@@ -126,7 +88,7 @@ static void handle_ping(gossip_protocol_t *proto,
             
             cluster_view_add(proto->cluster_view, &new_member);
             
-            LOG_INFO("SWIM: Discovered new member %u via PING", upd->node_id);
+            LOG_INFO("SWIM: Discovered new member %u via %s", upd->node_id, via);
             proto->stats.updates_received++;
             
             // Notify callback
@@ -140,8 +102,6 @@ static void handle_ping(gossip_protocol_t *proto,
                 upd->status == NODE_STATUS_ALIVE &&
                 upd->incarnation > existing->incarnation) {
                 
-                cluster_view_release(proto->cluster_view);
-                
                 cluster_member_t rejoin = {
                     .node_id = upd->node_id,
                     .node_type = upd->node_type,
@@ -164,7 +124,6 @@ static void handle_ping(gossip_protocol_t *proto,
             } else if (upd->incarnation > existing->incarnation) {
                 // Standard update
                 node_status_t old_status = existing->status;
-                cluster_view_release(proto->cluster_view);
                 
                 cluster_view_update_status(proto->cluster_view, upd->node_id,
                                          upd->status, upd->incarnation);
@@ -181,6 +140,7 @@ static void handle_ping(gossip_protocol_t *proto,
                     }
                 } else if (upd->status == NODE_STATUS_DEAD) {
                     proto->stats.dead_count++;
+                    gossip_protocol_forget_peer(proto, upd->node_id);
                     if (proto->callbacks.on_member_dead) {
                         proto->callbacks.on_member_dead(upd->node_id,
                                                        proto->callback_context);
@@ -191,11 +151,64 @@ static void handle_ping(gossip_protocol_t *proto,
                                                         proto->callback_context);
                     }
                 }
-            } else {
-                cluster_view_release(proto->cluster_view);
             }
         }
     }
+}
+
+// Modify handle_ping to detect JOIN messages
+static void handle_ping(gossip_protocol_t *proto,
+                       const gossip_message_t *msg,
+                       const char *src_ip,
+                       uint16_t src_port)
+{
+    LOG_DEBUG("SWIM: Processing PING from node %u (updates=%u)", 
+              msg->sender_id, msg->num_updates);
+    
+    // Check if this is a JOIN message (sender not in cluster)
+    int is_new_member = 0;
+    cluster_member_t existing_copy;
+    cluster_member_t *existing = lookup_member(proto, msg->sender_id, &existing_copy);
+    
+    if (!existing) {
+        is_new_member = 1;
+        
+        // 🔥 ADD THE SENDER TO CLUSTER VIEW
+        cluster_member_t new_sender = {
+            .node_id = msg->sender_id,
+            .node_type = proto->my_type, // We don't know their type yet
+            .status = NODE_STATUS_ALIVE,
+            .incarnation = 0,
+            .last_seen_ms = time_now_ms()
+        };
+        
+        // Extract IP/port from sender
+        safe_strncpy(new_sender.ip_address, src_ip, MAX_IP_LEN);
+        new_sender.gossip_port = src_port;
+        new_sender.data_port = 0; // Unknown until we get metadata
+        
+        cluster_view_add(proto->cluster_view, &new_sender);
+        
+        LOG_INFO("SWIM: Added sender node %u to cluster view", msg->sender_id);
+        
+        if (proto->callbacks.on_member_alive) {
+            gossip_member_update_t update = {
+                .node_id = msg->sender_id,
+                .node_type = new_sender.node_type,
+                .status = NODE_STATUS_ALIVE,
+                .incarnation = 0,
+                .timestamp_ms = time_now_ms()
+            };
+            safe_strncpy(update.ip_address, src_ip, MAX_IP_LEN);
+            update.gossip_port = src_port;
+            
+            proto->callbacks.on_member_alive(msg->sender_id, &update, 
+                                            proto->callback_context);
+        }
+    }
+    
+    // Process piggyback updates
+    process_piggyback_updates(proto, msg, "PING");
     
     // If this was a JOIN from a new member, send full cluster snapshot
     if (is_new_member) {
@@ -207,20 +220,20 @@ static void handle_ping(gossip_protocol_t *proto,
     gossip_message_t ack_msg = {
         .version = 1,
         .msg_type = GOSSIP_MSG_ACK,
-        .flags = 0,
+        .flags = GOSSIP_FLAG_HAS_COORD,
         .sender_id = proto->my_id,
         .sequence_num = __sync_fetch_and_add(&proto->sequence_num, 1),
         .num_updates = 0
     };
+    gossip_protocol_get_coord(proto, &ack_msg.coord);
+    gossip_protocol_attach_load(proto, &ack_msg);
     
     // Include cluster state in ACK (anti-entropy)
-    pthread_rwlock_rdlock(&proto->cluster_view->lock);
-    
-    size_t max_updates = ROOLE_MIN(proto->cluster_view->count,
-                                   GOSSIP_MAX_PIGGYBACK_UPDATES);
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(proto->cluster_view);
+    size_t max_updates = snap ? ROOLE_MIN(snap->count, GOSSIP_MAX_PIGGYBACK_UPDATES) : 0;
     
     for (size_t i = 0; i < max_updates && ack_msg.num_updates < GOSSIP_MAX_PIGGYBACK_UPDATES; i++) {
-        cluster_member_t *m = &proto->cluster_view->members[i];
+        const cluster_member_t *m = &snap->members[i];
         
         if (m->status == NODE_STATUS_DEAD || m->node_id == proto->my_id) {
             continue;
@@ -239,7 +252,7 @@ static void handle_ping(gossip_protocol_t *proto,
         ack_msg.num_updates++;
     }
     
-    pthread_rwlock_unlock(&proto->cluster_view->lock);
+    cluster_view_snapshot_release(snap);
     
     // Request engine to send ACK
     if (proto->callbacks.on_send_message) {
@@ -259,29 +272,36 @@ static void handle_ack(gossip_protocol_t *proto,
     LOG_DEBUG("SWIM: Processing ACK from node %u (updates=%u)",
               msg->sender_id, msg->num_updates);
     
-    // Clear pending ACK
-    remove_pending_ack(proto, msg->sender_id);
+    // Clear pending ACK; the time it was outstanding is the probe RTT
+    uint64_t rtt_us = 0;
+    if (complete_pending_ack(proto, msg->sender_id, &rtt_us) == 0 && rtt_us > 0) {
+        uint32_t sample = (uint32_t)ROOLE_MIN(rtt_us, (uint64_t)UINT32_MAX);
+        gossip_protocol_record_rtt(proto, msg->sender_id, sample);
+        if (proto->callbacks.on_rtt_sample) {
+            proto->callbacks.on_rtt_sample(msg->sender_id, sample,
+                                          proto->callback_context);
+        }
+    }
     proto->stats.acks_received++;
     
     // Check if sender was suspected - if so, mark alive
-    cluster_member_t *member = cluster_view_get(proto->cluster_view, msg->sender_id);
+    cluster_member_t member_copy;
+    cluster_member_t *member = lookup_member(proto, msg->sender_id, &member_copy);
     if (member && member->status == NODE_STATUS_SUSPECT) {
         uint64_t incarnation = member->incarnation;
-        cluster_view_release(proto->cluster_view);
         
         cluster_view_update_status(proto->cluster_view, msg->sender_id,
                                   NODE_STATUS_ALIVE, incarnation);
         
         LOG_INFO("SWIM: Node %u recovered from SUSPECT", msg->sender_id);
-    } else if (member) {
-        cluster_view_release(proto->cluster_view);
     }
     
     // Process piggyback updates (same as PING)
     for (uint8_t i = 0; i < msg->num_updates; i++) {
         const gossip_member_update_t *upd = &msg->updates[i];
         
-        cluster_member_t *existing = cluster_view_get(proto->cluster_view, upd->node_id);
+        cluster_member_t existing_copy;
+        cluster_member_t *existing = lookup_member(proto, upd->node_id, &existing_copy);
         
         if (!existing) {
             // New member
@@ -306,14 +326,10 @@ static void handle_ack(gossip_protocol_t *proto,
                                                 proto->callback_context);
             }
         } else if (upd->incarnation > existing->incarnation) {
-            cluster_view_release(proto->cluster_view);
-            
             cluster_view_update_status(proto->cluster_view, upd->node_id,
                                      upd->status, upd->incarnation);
             
             proto->stats.updates_received++;
-        } else {
-            cluster_view_release(proto->cluster_view);
         }
     }
 }
@@ -360,12 +376,11 @@ static void handle_suspect(gossip_protocol_t *proto,
             }
         } else if (upd->node_id != proto->my_id && upd->status == NODE_STATUS_SUSPECT) {
             // Mark other node as suspect
-            cluster_member_t *existing = cluster_view_get(proto->cluster_view, upd->node_id);
+            cluster_member_t existing_copy;
+            cluster_member_t *existing = lookup_member(proto, upd->node_id, &existing_copy);
             
             if (existing && upd->incarnation >= existing->incarnation &&
                 existing->status == NODE_STATUS_ALIVE) {
-                cluster_view_release(proto->cluster_view);
-                
                 cluster_view_update_status(proto->cluster_view, upd->node_id,
                                          NODE_STATUS_SUSPECT, upd->incarnation);
                 
@@ -376,8 +391,6 @@ static void handle_suspect(gossip_protocol_t *proto,
                     proto->callbacks.on_member_suspect(upd->node_id, upd->incarnation,
                                                       proto->callback_context);
                 }
-            } else if (existing) {
-                cluster_view_release(proto->cluster_view);
             }
         }
     }
@@ -391,11 +404,10 @@ static void handle_alive(gossip_protocol_t *proto,
     for (uint8_t i = 0; i < msg->num_updates; i++) {
         const gossip_member_update_t *upd = &msg->updates[i];
         
-        cluster_member_t *existing = cluster_view_get(proto->cluster_view, upd->node_id);
+        cluster_member_t existing_copy;
+        cluster_member_t *existing = lookup_member(proto, upd->node_id, &existing_copy);
         
         if (existing && upd->incarnation > existing->incarnation) {
-            cluster_view_release(proto->cluster_view);
-            
             cluster_view_update_status(proto->cluster_view, upd->node_id,
                                      NODE_STATUS_ALIVE, upd->incarnation);
             
@@ -406,8 +418,6 @@ static void handle_alive(gossip_protocol_t *proto,
                 proto->callbacks.on_member_alive(upd->node_id, upd,
                                                 proto->callback_context);
             }
-        } else if (existing) {
-            cluster_view_release(proto->cluster_view);
         }
     }
 }
@@ -420,26 +430,34 @@ static void handle_dead(gossip_protocol_t *proto,
     for (uint8_t i = 0; i < msg->num_updates; i++) {
         const gossip_member_update_t *upd = &msg->updates[i];
         
-        cluster_member_t *existing = cluster_view_get(proto->cluster_view, upd->node_id);
+        cluster_member_t existing_copy;
+        cluster_member_t *existing = lookup_member(proto, upd->node_id, &existing_copy);
         
         if (existing) {
-            cluster_view_release(proto->cluster_view);
-            
             cluster_view_update_status(proto->cluster_view, upd->node_id,
                                      NODE_STATUS_DEAD, upd->incarnation);
             
             LOG_INFO("SWIM: Node %u marked as DEAD", upd->node_id);
             proto->stats.dead_count++;
+            gossip_protocol_forget_peer(proto, upd->node_id);
             
             if (proto->callbacks.on_member_dead) {
                 proto->callbacks.on_member_dead(upd->node_id, proto->callback_context);
             }
-        } else if (existing) {
-            cluster_view_release(proto->cluster_view);
         }
     }
 }
 
+static void handle_gossip(gossip_protocol_t *proto,
+                         const gossip_message_t *msg)
+{
+    LOG_DEBUG("SWIM: Processing GOSSIP from node %u (updates=%u)",
+              msg->sender_id, msg->num_updates);
+    
+    // Dissemination only: no ACK, no pending state
+    process_piggyback_updates(proto, msg, "GOSSIP");
+}
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
@@ -457,6 +475,17 @@ int gossip_protocol_handle_message(
         return 0;
     }
     
+    // Learn sender's coordinate before any RTT sample uses it
+    if (msg->flags & GOSSIP_FLAG_HAS_COORD) {
+        gossip_protocol_note_peer_coord(proto, msg->sender_id, &msg->coord);
+    }
+    
+    if ((msg->flags & GOSSIP_FLAG_HAS_LOAD) && proto->callbacks.on_peer_load) {
+        proto->stats.load_received++;
+        proto->callbacks.on_peer_load(msg->sender_id, &msg->load,
+                                     proto->callback_context);
+    }
+    
     switch (msg->msg_type) {
         case GOSSIP_MSG_PING:
             handle_ping(proto, msg, src_ip, src_port);
@@ -478,6 +507,10 @@ int gossip_protocol_handle_message(
             handle_dead(proto, msg);
             break;
 
+        case GOSSIP_MSG_GOSSIP:
+            handle_gossip(proto, msg);
+            break;
+
         case GOSSIP_MSG_JOIN:
         case GOSSIP_MSG_LEAVE:
             handle_ping(proto, msg, src_ip, src_port); 
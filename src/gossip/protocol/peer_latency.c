@@ -0,0 +1,208 @@
+// src/gossip/protocol/peer_latency.c
+// Per-peer RTT tracking and Vivaldi coordinate maintenance
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "roole/gossip/gossip_protocol.h"
+#include "roole/gossip/vivaldi.h"
+#include "roole/logger/logger.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define NODE_ID_SPACE (UINT16_MAX + 1)
+
+// ============================================================================
+// TABLE LIFECYCLE
+// ============================================================================
+
+int gossip_latency_init(gossip_latency_table_t *table, size_t capacity) {
+    if (!table || capacity == 0) return -1;
+
+    memset(table, 0, sizeof(*table));
+
+    table->entries = calloc(capacity, sizeof(gossip_peer_latency_t));
+    table->slot_of = calloc(NODE_ID_SPACE, sizeof(uint16_t));
+    if (!table->entries || !table->slot_of) {
+        free(table->entries);
+        free(table->slot_of);
+        return -1;
+    }
+
+    table->capacity = capacity;
+    vivaldi_init(&table->coord);
+    pthread_mutex_init(&table->lock, NULL);
+    return 0;
+}
+
+void gossip_latency_destroy(gossip_latency_table_t *table) {
+    if (!table || !table->entries) return;
+
+    pthread_mutex_destroy(&table->lock);
+    free(table->entries);
+    free(table->slot_of);
+    table->entries = NULL;
+    table->slot_of = NULL;
+}
+
+// Find or create entry; caller holds table->lock
+static gossip_peer_latency_t* entry_for_locked(gossip_latency_table_t *table,
+                                               node_id_t node_id) {
+    uint16_t slot = table->slot_of[node_id];
+    if (slot) {
+        return &table->entries[slot - 1];
+    }
+
+    if (table->count >= table->capacity) {
+        return NULL;
+    }
+
+    gossip_peer_latency_t *e = &table->entries[table->count++];
+    memset(e, 0, sizeof(*e));
+    e->node_id = node_id;
+    table->slot_of[node_id] = (uint16_t)table->count;
+    return e;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void gossip_protocol_record_rtt(gossip_protocol_t *proto, node_id_t node_id, uint32_t rtt_us) {
+    if (!proto || !proto->latency.entries || rtt_us == 0) return;
+
+    gossip_latency_table_t *table = &proto->latency;
+
+    pthread_mutex_lock(&table->lock);
+
+    gossip_peer_latency_t *e = entry_for_locked(table, node_id);
+    if (!e) {
+        pthread_mutex_unlock(&table->lock);
+        LOG_DEBUG("SWIM: Latency table full, dropping RTT for node %u", node_id);
+        return;
+    }
+
+    // RFC 6298 style smoothing
+    if (e->samples == 0) {
+        e->srtt_us = rtt_us;
+        e->rttvar_us = rtt_us / 2;
+        e->min_rtt_us = rtt_us;
+    } else {
+        uint32_t dev = e->srtt_us > rtt_us ? e->srtt_us - rtt_us : rtt_us - e->srtt_us;
+        e->rttvar_us = (uint32_t)(((uint64_t)e->rttvar_us * 3 + dev) / 4);
+        e->srtt_us = (uint32_t)(((uint64_t)e->srtt_us * 7 + rtt_us) / 8);
+        if (rtt_us < e->min_rtt_us) {
+            e->min_rtt_us = rtt_us;
+        }
+    }
+    e->last_rtt_us = rtt_us;
+    e->last_sample_ms = time_now_ms();
+    e->samples++;
+
+    if (e->has_coord) {
+        vivaldi_update(&table->coord, &e->coord, (float)rtt_us);
+    }
+
+    uint32_t srtt_us = e->srtt_us;
+    proto->stats.rtt_samples++;
+
+    pthread_mutex_unlock(&table->lock);
+
+    LOG_DEBUG("SWIM: RTT to node %u: %uus (srtt=%uus)", node_id, rtt_us, srtt_us);
+}
+
+void gossip_protocol_note_peer_coord(gossip_protocol_t *proto, node_id_t node_id,
+                                     const gossip_coord_t *coord) {
+    if (!proto || !proto->latency.entries || !vivaldi_is_valid(coord)) return;
+
+    pthread_mutex_lock(&proto->latency.lock);
+
+    gossip_peer_latency_t *e = entry_for_locked(&proto->latency, node_id);
+    if (e) {
+        e->coord = *coord;
+        e->has_coord = 1;
+    }
+
+    pthread_mutex_unlock(&proto->latency.lock);
+}
+
+void gossip_protocol_forget_peer(gossip_protocol_t *proto, node_id_t node_id) {
+    if (!proto || !proto->latency.entries) return;
+
+    gossip_latency_table_t *table = &proto->latency;
+
+    pthread_mutex_lock(&table->lock);
+
+    uint16_t slot = table->slot_of[node_id];
+    if (slot) {
+        // Swap-remove keeps entries dense
+        size_t idx = slot - 1;
+        size_t last = table->count - 1;
+        if (idx != last) {
+            table->entries[idx] = table->entries[last];
+            table->slot_of[table->entries[idx].node_id] = (uint16_t)(idx + 1);
+        }
+        table->slot_of[node_id] = 0;
+        table->count--;
+    }
+
+    pthread_mutex_unlock(&table->lock);
+}
+
+uint32_t gossip_protocol_estimate_rtt_us(gossip_protocol_t *proto, node_id_t node_id) {
+    if (!proto || !proto->latency.entries) return 0;
+
+    gossip_latency_table_t *table = &proto->latency;
+    uint32_t estimate = 0;
+
+    pthread_mutex_lock(&table->lock);
+
+    uint16_t slot = table->slot_of[node_id];
+    if (slot) {
+        const gossip_peer_latency_t *e = &table->entries[slot - 1];
+        uint64_t now = time_now_ms();
+        int fresh = e->samples > 0 &&
+                    now - e->last_sample_ms < GOSSIP_RTT_STALE_MS;
+
+        if (fresh) {
+            estimate = e->srtt_us;
+        } else if (e->has_coord) {
+            estimate = (uint32_t)vivaldi_distance_us(&table->coord, &e->coord);
+        } else if (e->samples > 0) {
+            estimate = e->srtt_us;
+        }
+    }
+
+    pthread_mutex_unlock(&table->lock);
+
+    return estimate;
+}
+
+int gossip_protocol_get_peer_latency(gossip_protocol_t *proto, node_id_t node_id,
+                                     gossip_peer_latency_t *out) {
+    if (!proto || !out || !proto->latency.entries) return -1;
+
+    int rc = -1;
+
+    pthread_mutex_lock(&proto->latency.lock);
+    uint16_t slot = proto->latency.slot_of[node_id];
+    if (slot) {
+        *out = proto->latency.entries[slot - 1];
+        rc = 0;
+    }
+    pthread_mutex_unlock(&proto->latency.lock);
+
+    return rc;
+}
+
+void gossip_protocol_get_coord(gossip_protocol_t *proto, gossip_coord_t *out) {
+    if (!proto || !out) return;
+
+    if (!proto->latency.entries) {
+        vivaldi_init(out);
+        return;
+    }
+
+    pthread_mutex_lock(&proto->latency.lock);
+    *out = proto->latency.coord;
+    pthread_mutex_unlock(&proto->latency.lock);
+}
@@ -17,19 +17,25 @@ int add_pending_ack(gossip_protocol_t *proto, node_id_t target_node) {
     for (int i = 0; i < MAX_PENDING_ACKS; i++) {
         if (!proto->pending_acks[i].active) {
             proto->pending_acks[i].target_node = target_node;
-            proto->pending_acks[i].ping_sent_ms = time_now_ms();
+            proto->pending_acks[i].ping_sent_us = time_now_us();
             proto->pending_acks[i].active = 1;
             return 0;
         }
     }
-    LOG_WARN("Pending ACK table full");
+    LOG_WARN_RATELIMITED("Pending ACK table full");
     return -1;
 }
 
-int remove_pending_ack(gossip_protocol_t *proto, node_id_t target_node) {
+int complete_pending_ack(gossip_protocol_t *proto, node_id_t target_node,
+                         uint64_t *out_rtt_us) {
     for (int i = 0; i < MAX_PENDING_ACKS; i++) {
         if (proto->pending_acks[i].active && 
             proto->pending_acks[i].target_node == target_node) {
+            if (out_rtt_us) {
+                uint64_t now = time_now_us();
+                uint64_t sent = proto->pending_acks[i].ping_sent_us;
+                *out_rtt_us = now > sent ? now - sent : 0;
+            }
             proto->pending_acks[i].active = 0;
             return 0;
         }
@@ -37,6 +43,46 @@ int remove_pending_ack(gossip_protocol_t *proto, node_id_t target_node) {
     return -1;
 }
 
+int remove_pending_ack(gossip_protocol_t *proto, node_id_t target_node) {
+    return complete_pending_ack(proto, target_node, NULL);
+}
+
+// ============================================================================
+// LOCAL LOAD SUMMARY
+// ============================================================================
+
+void gossip_protocol_attach_load(gossip_protocol_t *proto, gossip_message_t *msg) {
+    if (!proto || !msg || !proto->callbacks.get_local_load ||
+        proto->config.load_report_interval_ms == 0) {
+        return;
+    }
+    
+    gossip_load_cache_t *cache = &proto->local_load;
+    uint64_t now = time_now_ms();
+    
+    pthread_mutex_lock(&cache->lock);
+    
+    if (!cache->valid ||
+        now - cache->sampled_ms >= proto->config.load_report_interval_ms) {
+        member_load_t sample;
+        memset(&sample, 0, sizeof(sample));
+        if (proto->callbacks.get_local_load(&sample, proto->callback_context) == 0) {
+            cache->load = sample;
+            cache->valid = 1;
+        }
+        // Failed samples are retried next interval, not on every message
+        cache->sampled_ms = now;
+        proto->stats.load_samples++;
+    }
+    
+    if (cache->valid) {
+        msg->load = cache->load;
+        msg->flags |= GOSSIP_FLAG_HAS_LOAD;
+    }
+    
+    pthread_mutex_unlock(&cache->lock);
+}
+
 // ============================================================================
 // PROTOCOL CREATION
 // ============================================================================
@@ -82,48 +128,173 @@ gossip_protocol_t* gossip_protocol_create(
     
     memset(&proto->stats, 0, sizeof(proto->stats));
     
+    if (proto->config.min_protocol_period_ms == 0 ||
+        proto->config.min_protocol_period_ms > proto->config.protocol_period_ms) {
+        proto->config.min_protocol_period_ms = proto->config.protocol_period_ms;
+    }
+    if (proto->config.max_protocol_period_ms < proto->config.protocol_period_ms) {
+        proto->config.max_protocol_period_ms = proto->config.protocol_period_ms;
+    }
+    proto->adaptive.period_ms = proto->config.protocol_period_ms;
+    proto->adaptive.fanout = 1;
+    
+    if (gossip_latency_init(&proto->latency, cluster_view->capacity) != 0) {
+        LOG_ERROR("Failed to allocate peer latency table");
+        free(proto);
+        return NULL;
+    }
+    pthread_mutex_init(&proto->local_load.lock, NULL);
+    
     LOG_INFO("SWIM protocol created (node_id=%u, type=%d)", my_id, my_type);
     return proto;
 }
 
+// ============================================================================
+// ADAPTIVE FANOUT / PERIOD
+// ============================================================================
+
+static uint32_t ceil_log2(size_t n) {
+    uint32_t bits = 0;
+    while (((size_t)1 << bits) < n) bits++;
+    return bits;
+}
+
+// Fanout for this round: 1 (probe only) while the view is stable,
+// up to config.fanout for ~log2(N) rounds after each change.
+static uint32_t select_fanout(gossip_protocol_t *proto, uint64_t churn,
+                              size_t peer_count) {
+    gossip_adaptive_state_t *a = &proto->adaptive;
+    
+    if (churn > 0) {
+        a->dissemination_rounds = ROOLE_MAX(1u, ceil_log2(peer_count + 1));
+    }
+    
+    uint32_t fanout = 1;
+    if (a->dissemination_rounds > 0) {
+        a->dissemination_rounds--;
+        fanout = ROOLE_MIN(proto->config.fanout, (uint32_t)GOSSIP_MAX_FANOUT);
+        fanout = (uint32_t)ROOLE_MIN((size_t)fanout, peer_count);
+        fanout = ROOLE_MAX(fanout, 1u);
+    }
+    
+    a->fanout = fanout;
+    return fanout;
+}
+
+// Retune period from smoothed loss and churn:
+// loss -> back off (avoid congestion-driven false suspicions),
+// churn -> speed up (converge faster), stable -> drift up (save bandwidth).
+static void adapt_period(gossip_protocol_t *proto, uint64_t churn) {
+    gossip_adaptive_state_t *a = &proto->adaptive;
+    const gossip_config_t *cfg = &proto->config;
+    
+    uint64_t pings = proto->stats.pings_sent - a->last_pings_sent;
+    uint64_t timeouts = proto->stats.ack_timeouts - a->last_ack_timeouts;
+    a->last_pings_sent = proto->stats.pings_sent;
+    a->last_ack_timeouts = proto->stats.ack_timeouts;
+    
+    double loss = pings ? (double)timeouts / (double)pings : 0.0;
+    if (loss > 1.0) loss = 1.0;
+    a->loss_ewma = 0.8 * a->loss_ewma + 0.2 * loss;
+    a->churn_ewma = 0.8 * a->churn_ewma + 0.2 * (double)churn;
+    
+    if (!cfg->adaptive_period) {
+        a->period_ms = cfg->protocol_period_ms;
+        return;
+    }
+    
+    uint32_t period = a->period_ms;
+    if (a->loss_ewma > 0.25) {
+        period += period / 2;
+    } else if (a->churn_ewma > 0.5) {
+        period /= 2;
+    } else {
+        period += ROOLE_MAX(cfg->protocol_period_ms / 10, 1u);
+    }
+    
+    period = ROOLE_MAX(period, cfg->min_protocol_period_ms);
+    period = ROOLE_MIN(period, cfg->max_protocol_period_ms);
+    
+    if (period != a->period_ms) {
+        LOG_DEBUG("SWIM: Period %ums -> %ums (loss=%.2f churn=%.2f)",
+                  a->period_ms, period, a->loss_ewma, a->churn_ewma);
+    }
+    a->period_ms = period;
+}
+
+uint32_t gossip_protocol_get_period_ms(const gossip_protocol_t *proto)
+{
+    if (!proto) return 0;
+    return proto->adaptive.period_ms;
+}
+
+// ============================================================================
+// SWIM ROUND
+// ============================================================================
+
 void gossip_protocol_run_swim_round(gossip_protocol_t *proto)
 {
     if (!proto) return;
     
-    // Select random peer (exclude self and dead nodes)
-    node_id_t target = 0;
-    node_id_t peer_list[MAX_CLUSTER_NODES];
-    size_t peer_count = 0;
+    // One consistent view for peer selection and anti-entropy
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(proto->cluster_view);
+    if (!snap) return;
     
-    pthread_rwlock_rdlock(&proto->cluster_view->lock);
+    // Membership churn since last round (every view mutation bumps version)
+    uint64_t churn = snap->version - proto->adaptive.last_view_version;
+    proto->adaptive.last_view_version = snap->version;
     
-    for (size_t i = 0; i < proto->cluster_view->count; i++) {
-        cluster_member_t *m = &proto->cluster_view->members[i];
-        
+    size_t peer_count = 0;
+    for (size_t i = 0; i < snap->count; i++) {
+        const cluster_member_t *m = &snap->members[i];
         if (m->node_id != proto->my_id && m->status != NODE_STATUS_DEAD) {
-            peer_list[peer_count++] = m->node_id;
+            peer_count++;
         }
     }
     
-    pthread_rwlock_unlock(&proto->cluster_view->lock);
-    
     if (peer_count == 0) {
+        cluster_view_snapshot_release(snap);
+        adapt_period(proto, churn);
         LOG_DEBUG("SWIM: No peers available for PING");
         return;
     }
     
-    target = peer_list[rand() % peer_count];
+    uint32_t fanout = select_fanout(proto, churn, peer_count);
+    
+    // Pick `fanout` distinct random peers (reservoir sampling, exclude
+    // self and dead nodes). The probe target is a random member of the
+    // sample: membership is uniform, slot order is not.
+    const cluster_member_t *chosen[GOSSIP_MAX_FANOUT];
+    size_t seen = 0;
+    
+    for (size_t i = 0; i < snap->count; i++) {
+        const cluster_member_t *m = &snap->members[i];
+        
+        if (m->node_id == proto->my_id || m->status == NODE_STATUS_DEAD) {
+            continue;
+        }
+        
+        if (seen < fanout) {
+            chosen[seen] = m;
+        } else {
+            size_t j = (size_t)rand() % (seen + 1);
+            if (j < fanout) {
+                chosen[j] = m;
+            }
+        }
+        seen++;
+    }
     
-    // Get target info
-    cluster_member_t *target_member = cluster_view_get(proto->cluster_view, target);
-    if (!target_member) return;
+    size_t probe = (size_t)rand() % fanout;
+    const cluster_member_t *target_member = chosen[probe];
+    chosen[probe] = chosen[0];
+    chosen[0] = target_member;
+    node_id_t target = target_member->node_id;
     
     char target_ip[MAX_IP_LEN];
     uint16_t target_port = target_member->gossip_port;
     safe_strncpy(target_ip, target_member->ip_address, MAX_IP_LEN);
     
-    cluster_view_release(proto->cluster_view);
-    
     // Build PING message with cluster state
     gossip_message_t ping_msg = {
         .version = 1,
@@ -147,13 +318,19 @@ void gossip_protocol_run_swim_round(gossip_protocol_t *proto)
     ping_msg.updates[0] = self_update;
     ping_msg.num_updates = 1;
     
-    // Include cluster state (anti-entropy)
-    pthread_rwlock_rdlock(&proto->cluster_view->lock);
-    
-    for (size_t i = 0; i < proto->cluster_view->count && 
-         ping_msg.num_updates < GOSSIP_MAX_PIGGYBACK_UPDATES; i++) {
+    // Advertise our coordinate so the target can place us, and our load
+    ping_msg.flags |= GOSSIP_FLAG_HAS_COORD;
+    gossip_protocol_get_coord(proto, &ping_msg.coord);
+    gossip_protocol_attach_load(proto, &ping_msg);
+    
+    // Include cluster state (anti-entropy). The window rotates each round
+    // so views larger than one message still reach every peer.
+    size_t start = proto->anti_entropy_cursor % snap->count;
+    size_t scanned = 0;
+    for (; scanned < snap->count && 
+         ping_msg.num_updates < GOSSIP_MAX_PIGGYBACK_UPDATES; scanned++) {
         
-        cluster_member_t *m = &proto->cluster_view->members[i];
+        const cluster_member_t *m = &snap->members[(start + scanned) % snap->count];
         
         if (m->status == NODE_STATUS_DEAD || m->node_id == proto->my_id) {
             continue;
@@ -171,12 +348,12 @@ void gossip_protocol_run_swim_round(gossip_protocol_t *proto)
         
         ping_msg.num_updates++;
     }
-    
-    pthread_rwlock_unlock(&proto->cluster_view->lock);
+    proto->anti_entropy_cursor = start + scanned;
     
     // Track pending ACK
     add_pending_ack(proto, target);
     proto->stats.pings_sent++;
+    proto->stats.updates_sent += ping_msg.num_updates;
     
     // Request engine to send PING
     if (proto->callbacks.on_send_message) {
@@ -186,6 +363,26 @@ void gossip_protocol_run_swim_round(gossip_protocol_t *proto)
     
     LOG_DEBUG("SWIM: Sent PING to node %u (%s:%u, updates=%u)",
               target, target_ip, target_port, ping_msg.num_updates);
+    
+    // Disseminate the same updates to the remaining fanout peers (no ACK)
+    for (uint32_t k = 1; k < fanout; k++) {
+        gossip_message_t gossip_msg = ping_msg;
+        gossip_msg.msg_type = GOSSIP_MSG_GOSSIP;
+        gossip_msg.sequence_num = __sync_fetch_and_add(&proto->sequence_num, 1);
+        
+        proto->stats.gossip_sent++;
+        proto->stats.updates_sent += gossip_msg.num_updates;
+        
+        if (proto->callbacks.on_send_message) {
+            proto->callbacks.on_send_message(&gossip_msg, chosen[k]->ip_address,
+                                            chosen[k]->gossip_port,
+                                            proto->callback_context);
+        }
+    }
+    
+    cluster_view_snapshot_release(snap);
+    
+    adapt_period(proto, churn);
 }
 
 void gossip_protocol_check_timeouts(gossip_protocol_t *proto)
@@ -193,12 +390,14 @@ void gossip_protocol_check_timeouts(gossip_protocol_t *proto)
     if (!proto) return;
     
     uint64_t now = time_now_ms();
+    uint64_t now_us = time_now_us();
     
     // Check ACK timeouts
     for (int i = 0; i < MAX_PENDING_ACKS; i++) {
         if (!proto->pending_acks[i].active) continue;
         
-        uint64_t elapsed = now - proto->pending_acks[i].ping_sent_ms;
+        uint64_t sent_us = proto->pending_acks[i].ping_sent_us;
+        uint64_t elapsed = now_us > sent_us ? (now_us - sent_us) / 1000 : 0;
         
         if (elapsed > proto->config.ack_timeout_ms) {
             node_id_t node = proto->pending_acks[i].target_node;
@@ -207,11 +406,11 @@ void gossip_protocol_check_timeouts(gossip_protocol_t *proto)
             proto->stats.ack_timeouts++;
             
             // Get current status
-            cluster_member_t *member = cluster_view_get(proto->cluster_view, node);
+            cluster_member_t member;
             
-            if (member && member->status == NODE_STATUS_ALIVE) {
-                uint64_t incarnation = member->incarnation;
-                cluster_view_release(proto->cluster_view);
+            if (cluster_view_lookup(proto->cluster_view, node, &member) == RESULT_OK &&
+                member.status == NODE_STATUS_ALIVE) {
+                uint64_t incarnation = member.incarnation;
                 
                 // Mark as SUSPECT
                 cluster_view_update_status(proto->cluster_view, node,
@@ -224,30 +423,28 @@ void gossip_protocol_check_timeouts(gossip_protocol_t *proto)
                     proto->callbacks.on_member_suspect(node, incarnation,
                                                       proto->callback_context);
                 }
-            } else if (member) {
-                cluster_view_release(proto->cluster_view);
             }
             
             proto->pending_acks[i].active = 0;
         }
     }
     
-    // Check SUSPECT -> DEAD timeouts
-    pthread_rwlock_rdlock(&proto->cluster_view->lock);
+    // Check SUSPECT -> DEAD timeouts (snapshot stays valid across updates)
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(proto->cluster_view);
+    if (!snap) return;
     
-    for (size_t i = 0; i < proto->cluster_view->count; i++) {
-        cluster_member_t *m = &proto->cluster_view->members[i];
+    for (size_t i = 0; i < snap->count; i++) {
+        const cluster_member_t *m = &snap->members[i];
         
         if (m->status != NODE_STATUS_SUSPECT) continue;
         
-        uint64_t elapsed = now - m->last_seen_ms;
+        // Snapshot may carry a last_seen stamped after `now` was taken
+        uint64_t elapsed = now > m->last_seen_ms ? now - m->last_seen_ms : 0;
         
         if (elapsed > proto->config.dead_timeout_ms) {
             node_id_t node_id = m->node_id;
             uint64_t incarnation = m->incarnation;
             
-            pthread_rwlock_unlock(&proto->cluster_view->lock);
-            
             LOG_ERROR("SWIM: Node %u suspected for %lums, marking as DEAD",
                      node_id, elapsed);
             
@@ -255,16 +452,15 @@ void gossip_protocol_check_timeouts(gossip_protocol_t *proto)
                                      NODE_STATUS_DEAD, incarnation);
             
             proto->stats.dead_count++;
+            gossip_protocol_forget_peer(proto, node_id);
             
             if (proto->callbacks.on_member_dead) {
                 proto->callbacks.on_member_dead(node_id, proto->callback_context);
             }
-            
-            pthread_rwlock_rdlock(&proto->cluster_view->lock);
         }
     }
     
-    pthread_rwlock_unlock(&proto->cluster_view->lock);
+    cluster_view_snapshot_release(snap);
 }
 
 void gossip_protocol_announce_join(gossip_protocol_t *proto)
@@ -351,12 +547,18 @@ void gossip_protocol_get_stats(gossip_protocol_t *proto,
 {
     if (!proto || !out_stats) return;
     *out_stats = proto->stats;
+    out_stats->current_period_ms = proto->adaptive.period_ms;
+    out_stats->current_fanout = proto->adaptive.fanout;
+    gossip_protocol_get_coord(proto, &out_stats->coord);
 }
 
 void gossip_protocol_destroy(gossip_protocol_t *proto)
 {
     if (!proto) return;
     
+    gossip_latency_destroy(&proto->latency);
+    pthread_mutex_destroy(&proto->local_load.lock);
+    
     LOG_INFO("SWIM protocol destroyed");
     free(proto);
 }
\ No newline at end of file
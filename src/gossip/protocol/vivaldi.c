@@ -0,0 +1,119 @@
+// src/gossip/protocol/vivaldi.c
+// Vivaldi network coordinates (Dabek et al., with height vectors)
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "roole/gossip/vivaldi.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static float vec_magnitude(const float *v) {
+    float sum = 0.0f;
+    for (int d = 0; d < GOSSIP_COORD_DIMS; d++) {
+        sum += v[d] * v[d];
+    }
+    return sqrtf(sum);
+}
+
+// Unit vector from b to a; random direction when the two coincide
+static void unit_vector_at(const gossip_coord_t *a, const gossip_coord_t *b,
+                           float *out) {
+    float diff[GOSSIP_COORD_DIMS];
+    for (int d = 0; d < GOSSIP_COORD_DIMS; d++) {
+        diff[d] = a->vec[d] - b->vec[d];
+    }
+
+    float mag = vec_magnitude(diff);
+    if (mag > 1e-6f) {
+        for (int d = 0; d < GOSSIP_COORD_DIMS; d++) {
+            out[d] = diff[d] / mag;
+        }
+        return;
+    }
+
+    for (int d = 0; d < GOSSIP_COORD_DIMS; d++) {
+        diff[d] = (float)rand() / (float)RAND_MAX - 0.5f;
+    }
+    mag = vec_magnitude(diff);
+    for (int d = 0; d < GOSSIP_COORD_DIMS; d++) {
+        out[d] = mag > 1e-6f ? diff[d] / mag : (d == 0 ? 1.0f : 0.0f);
+    }
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void vivaldi_init(gossip_coord_t *coord) {
+    if (!coord) return;
+
+    memset(coord, 0, sizeof(*coord));
+    coord->height = VIVALDI_MIN_HEIGHT_US;
+    coord->error = VIVALDI_INITIAL_ERROR;
+}
+
+int vivaldi_is_valid(const gossip_coord_t *coord) {
+    if (!coord) return 0;
+
+    for (int d = 0; d < GOSSIP_COORD_DIMS; d++) {
+        if (!isfinite(coord->vec[d]) || fabsf(coord->vec[d]) > VIVALDI_MAX_RTT_US) {
+            return 0;
+        }
+    }
+
+    return isfinite(coord->height) && coord->height >= 0.0f &&
+           coord->height <= VIVALDI_MAX_RTT_US &&
+           isfinite(coord->error) && coord->error >= 0.0f;
+}
+
+float vivaldi_distance_us(const gossip_coord_t *a, const gossip_coord_t *b) {
+    if (!a || !b) return 0.0f;
+
+    float diff[GOSSIP_COORD_DIMS];
+    for (int d = 0; d < GOSSIP_COORD_DIMS; d++) {
+        diff[d] = a->vec[d] - b->vec[d];
+    }
+
+    return vec_magnitude(diff) + a->height + b->height;
+}
+
+int vivaldi_update(gossip_coord_t *local, const gossip_coord_t *remote, float rtt_us) {
+    if (!local || !vivaldi_is_valid(remote)) return -1;
+    if (!(rtt_us > 0.0f) || rtt_us > VIVALDI_MAX_RTT_US) return -1;
+
+    float dist = vivaldi_distance_us(local, remote);
+
+    // Weight the sample by relative confidence
+    float total_error = local->error + remote->error;
+    float weight = total_error > 0.0f ? local->error / total_error : 0.5f;
+
+    float sample_error = fabsf(dist - rtt_us) / rtt_us;
+    local->error = sample_error * VIVALDI_CE * weight +
+                   local->error * (1.0f - VIVALDI_CE * weight);
+    if (local->error > VIVALDI_INITIAL_ERROR) {
+        local->error = VIVALDI_INITIAL_ERROR;
+    }
+
+    // Spring force: positive pushes away (too close), negative pulls in
+    float force = VIVALDI_CC * weight * (rtt_us - dist);
+
+    float unit[GOSSIP_COORD_DIMS];
+    unit_vector_at(local, remote, unit);
+    for (int d = 0; d < GOSSIP_COORD_DIMS; d++) {
+        local->vec[d] += unit[d] * force;
+    }
+
+    if (dist > 0.0f) {
+        local->height += (local->height + remote->height) * force / dist;
+    }
+    if (local->height < VIVALDI_MIN_HEIGHT_US) {
+        local->height = VIVALDI_MIN_HEIGHT_US;
+    }
+
+    return 0;
+}
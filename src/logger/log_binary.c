@@ -0,0 +1,648 @@
+// src/logger/log_binary.c - Binary log records and stream decoding
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "roole/logger/log_binary.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// ============================================================================
+// FORMAT PARSING
+// ============================================================================
+
+// One conversion specification, as found while walking a format string
+typedef struct {
+    const char *start;          // At '%'
+    const char *end;            // One past the conversion character
+    int width_star;
+    int prec_star;
+    int has_prec;
+    unsigned prec;
+    char length[3];             // Length modifier as written
+    char conv;
+} conv_spec_t;
+
+// Parse the conversion starting at p (which points at '%').
+// Returns 1 for a conversion, 0 for "%%", -1 if malformed.
+static int next_conversion(const char *p, conv_spec_t *spec) {
+    memset(spec, 0, sizeof(*spec));
+    spec->start = p++;
+
+    if (*p == '%') {
+        spec->end = p + 1;
+        return 0;
+    }
+
+    while (*p && strchr("-+ #0'", *p)) p++;
+
+    if (*p == '*') {
+        spec->width_star = 1;
+        p++;
+    } else {
+        while (*p >= '0' && *p <= '9') p++;
+    }
+
+    if (*p == '.') {
+        spec->has_prec = 1;
+        p++;
+        if (*p == '*') {
+            spec->prec_star = 1;
+            p++;
+        } else {
+            while (*p >= '0' && *p <= '9') {
+                if (spec->prec < 100000) spec->prec = spec->prec * 10 + (unsigned)(*p - '0');
+                p++;
+            }
+        }
+    }
+
+    size_t len = 0;
+    while (*p && strchr("hlLqjzt", *p) && len < 2) {
+        spec->length[len++] = *p++;
+    }
+
+    if (!*p) return -1;
+    spec->conv = *p++;
+    spec->end = p;
+    return 1;
+}
+
+static int arg_type_for(const conv_spec_t *spec) {
+    const char *len = spec->length;
+
+    switch (spec->conv) {
+        case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+            if (len[0] == 'l' && len[1] == 'l') return LOG_ARG_LLONG;
+            if (len[0] == 'q') return LOG_ARG_LLONG;
+            if (len[0] == 'l') return LOG_ARG_LONG;
+            if (len[0] == 'z') return LOG_ARG_SIZE;
+            if (len[0] == 'j') return LOG_ARG_INTMAX;
+            if (len[0] == 't') return LOG_ARG_PTRDIFF;
+            return LOG_ARG_INT;
+        case 'c':
+            return len[0] ? -1 : LOG_ARG_INT;
+        case 'e': case 'E': case 'f': case 'F':
+        case 'g': case 'G': case 'a': case 'A':
+            return len[0] == 'L' ? LOG_ARG_LONG_DOUBLE : LOG_ARG_DOUBLE;
+        case 'p':
+            return LOG_ARG_PTR;
+        case 's':
+            if (len[0]) return -1;  // Wide strings
+            if (spec->prec_star) return LOG_ARG_STRING_STAR;
+            return spec->has_prec ? LOG_ARG_STRING_FIXED : LOG_ARG_STRING;
+        default:
+            return -1;              // %n, %m and anything exotic
+    }
+}
+
+int log_format_parse(const char *fmt, log_arg_spec_t *specs, int max) {
+    int n = 0;
+
+    for (const char *p = fmt; *p; ) {
+        if (*p != '%') {
+            p++;
+            continue;
+        }
+
+        conv_spec_t spec;
+        int rc = next_conversion(p, &spec);
+        if (rc < 0) return -1;
+        p = spec.end;
+        if (rc == 0) continue;
+
+        int type = arg_type_for(&spec);
+        if (type < 0) return -1;
+
+        int needed = 1 + spec.width_star + spec.prec_star;
+        if (n + needed > max) return -1;
+
+        if (spec.width_star) specs[n++] = (log_arg_spec_t){ LOG_ARG_INT, 0 };
+        if (spec.prec_star) specs[n++] = (log_arg_spec_t){ LOG_ARG_INT, 0 };
+        uint16_t limit = spec.prec > LOG_ARG_STRING_MAX ? LOG_ARG_STRING_MAX : (uint16_t)spec.prec;
+        specs[n++] = (log_arg_spec_t){ (uint8_t)type, limit };
+    }
+
+    return n;
+}
+
+// ============================================================================
+// ARGUMENT CAPTURE
+// ============================================================================
+
+static size_t encoded_size(uint8_t type) {
+    switch (type) {
+        case LOG_ARG_INT:         return sizeof(int32_t);
+        case LOG_ARG_LONG_DOUBLE: return sizeof(long double);
+        case LOG_ARG_STRING:
+        case LOG_ARG_STRING_FIXED:
+        case LOG_ARG_STRING_STAR: return sizeof(uint16_t);
+        default:                  return sizeof(int64_t);
+    }
+}
+
+size_t log_args_encode(const log_arg_spec_t *specs, int nargs, va_list *args,
+                       uint8_t *out, size_t cap) {
+    size_t used = 0;
+    int last_int = -1;
+
+    // Room the fixed-size arguments still need, so strings cannot starve them
+    size_t reserve = 0;
+    for (int i = 0; i < nargs; i++) reserve += encoded_size(specs[i].type);
+    if (reserve > cap) return 0;
+
+    for (int i = 0; i < nargs; i++) {
+        uint8_t type = specs[i].type;
+        reserve -= encoded_size(type);
+        int64_t wide = 0;
+
+        switch (type) {
+            case LOG_ARG_INT: {
+                int32_t v = va_arg(*args, int);
+                memcpy(out + used, &v, sizeof(v));
+                used += sizeof(v);
+                last_int = v;
+                continue;
+            }
+            case LOG_ARG_LONG:    wide = va_arg(*args, long); break;
+            case LOG_ARG_LLONG:   wide = va_arg(*args, long long); break;
+            case LOG_ARG_SIZE:    wide = (int64_t)va_arg(*args, size_t); break;
+            case LOG_ARG_INTMAX:  wide = va_arg(*args, intmax_t); break;
+            case LOG_ARG_PTRDIFF: wide = va_arg(*args, ptrdiff_t); break;
+            case LOG_ARG_PTR:     wide = (int64_t)(uintptr_t)va_arg(*args, void*); break;
+            case LOG_ARG_DOUBLE: {
+                double v = va_arg(*args, double);
+                memcpy(&wide, &v, sizeof(v));
+                break;
+            }
+            case LOG_ARG_LONG_DOUBLE: {
+                long double v = va_arg(*args, long double);
+                memcpy(out + used, &v, sizeof(v));
+                used += sizeof(v);
+                continue;
+            }
+            default: {
+                const char *s = va_arg(*args, const char*);
+                if (!s) s = "(null)";
+
+                size_t limit = LOG_ARG_STRING_MAX;
+                if (type == LOG_ARG_STRING_FIXED) limit = specs[i].limit;
+                if (type == LOG_ARG_STRING_STAR && last_int >= 0 &&
+                    (size_t)last_int < limit) {
+                    limit = (size_t)last_int;
+                }
+                size_t room = cap - used - sizeof(uint16_t) - reserve;
+                if (limit > room) limit = room;
+
+                uint16_t len = (uint16_t)strnlen(s, limit);
+                memcpy(out + used, &len, sizeof(len));
+                memcpy(out + used + sizeof(len), s, len);
+                used += sizeof(len) + len;
+                continue;
+            }
+        }
+
+        memcpy(out + used, &wide, sizeof(wide));
+        used += sizeof(wide);
+    }
+
+    return used;
+}
+
+// ============================================================================
+// RENDERING
+// ============================================================================
+
+// Rebuild "%<flags><width><prec><length><conv>" with a length modifier that
+// matches how the value was stored
+static void build_spec(const conv_spec_t *spec, uint8_t type, char *out, size_t cap) {
+    const char *body_end = spec->start + 1;
+    while (body_end < spec->end - 1 && !strchr("hlLqjzt", *body_end)) body_end++;
+
+    size_t body = (size_t)(body_end - spec->start);
+    if (body > cap - 4) body = cap - 4;
+    memcpy(out, spec->start, body);
+
+    const char *length = "";
+    if (type == LOG_ARG_LONG || type == LOG_ARG_LLONG || type == LOG_ARG_SIZE ||
+        type == LOG_ARG_INTMAX || type == LOG_ARG_PTRDIFF) {
+        length = "ll";
+    } else if (type == LOG_ARG_LONG_DOUBLE) {
+        length = "L";
+    } else if (type == LOG_ARG_INT && spec->length[0] == 'h') {
+        length = spec->length;
+    }
+
+    size_t len = strlen(length);
+    memcpy(out + body, length, len);
+    out[body + len] = spec->conv;
+    out[body + len + 1] = '\0';
+}
+
+#define RENDER_WITH_STARS(value) \
+    (stars == 0 ? snprintf(out, cap, fmt, value) : \
+     stars == 1 ? snprintf(out, cap, fmt, star[0], value) : \
+                  snprintf(out, cap, fmt, star[0], star[1], value))
+
+static int render_value(char *out, size_t cap, const char *fmt, int stars, const int *star,
+                        uint8_t type, const uint8_t *data, size_t size) {
+    switch (type) {
+        case LOG_ARG_INT: {
+            int32_t v;
+            memcpy(&v, data, sizeof(v));
+            return RENDER_WITH_STARS((int)v);
+        }
+        case LOG_ARG_DOUBLE: {
+            double v;
+            memcpy(&v, data, sizeof(v));
+            return RENDER_WITH_STARS(v);
+        }
+        case LOG_ARG_LONG_DOUBLE: {
+            long double v;
+            memcpy(&v, data, sizeof(v));
+            return RENDER_WITH_STARS(v);
+        }
+        case LOG_ARG_PTR: {
+            int64_t v;
+            memcpy(&v, data, sizeof(v));
+            return RENDER_WITH_STARS((void*)(uintptr_t)v);
+        }
+        case LOG_ARG_STRING:
+        case LOG_ARG_STRING_FIXED:
+        case LOG_ARG_STRING_STAR: {
+            char text[LOG_ARGS_MAX + 1];
+            if (size > LOG_ARGS_MAX) size = LOG_ARGS_MAX;
+            memcpy(text, data, size);
+            text[size] = '\0';
+            return RENDER_WITH_STARS(text);
+        }
+        default: {
+            int64_t v;
+            memcpy(&v, data, sizeof(v));
+            return RENDER_WITH_STARS((long long)v);
+        }
+    }
+}
+
+size_t log_args_render(const char *fmt, const log_arg_spec_t *specs, int nargs,
+                       const uint8_t *args, size_t args_len, char *out, size_t cap) {
+    size_t used = 0;
+    size_t pos = 0;
+    int arg = 0;
+
+    if (cap == 0) return 0;
+
+    for (const char *p = fmt; *p && used < cap - 1; ) {
+        if (*p != '%') {
+            out[used++] = *p++;
+            continue;
+        }
+
+        conv_spec_t spec;
+        int rc = next_conversion(p, &spec);
+        if (rc <= 0) {
+            if (rc == 0) out[used++] = '%';
+            p = rc == 0 ? spec.end : p + 1;
+            continue;
+        }
+        p = spec.end;
+
+        // Star arguments come first, then the value
+        int star[2];
+        int stars = 0;
+        for (int k = 0; k < spec.width_star + spec.prec_star; k++) {
+            if (arg >= nargs || pos + sizeof(int32_t) > args_len) return used;
+            int32_t v;
+            memcpy(&v, args + pos, sizeof(v));
+            pos += sizeof(v);
+            star[stars++] = v;
+            arg++;
+        }
+        if (arg >= nargs) break;
+
+        uint8_t type = specs[arg++].type;
+        size_t size = encoded_size(type);
+        if (pos + size > args_len) break;
+
+        const uint8_t *data = args + pos;
+        if (type == LOG_ARG_STRING || type == LOG_ARG_STRING_FIXED ||
+            type == LOG_ARG_STRING_STAR) {
+            uint16_t len;
+            memcpy(&len, data, sizeof(len));
+            if (pos + sizeof(len) + len > args_len) break;
+            data += sizeof(len);
+            size = len;
+            pos += sizeof(len) + len;
+        } else {
+            pos += size;
+        }
+
+        char conv[32];
+        build_spec(&spec, type, conv, sizeof(conv));
+        int written = render_value(out + used, cap - used, conv, stars, star, type, data, size);
+        if (written > 0) used += (size_t)written;
+        if (used > cap - 1) used = cap - 1;
+    }
+
+    out[used] = '\0';
+    return used;
+}
+
+size_t log_line_render(const log_line_t *line, log_time_cache_t *cache,
+                       char *out, size_t cap) {
+    time_t sec = (time_t)(line->timestamp_ns / 1000000000ull);
+    int ms = (int)(line->timestamp_ns / 1000000ull % 1000);
+
+    if (sec != cache->sec) {
+        struct tm tm;
+        localtime_r(&sec, &tm);
+        int n = snprintf(cache->text, sizeof(cache->text), "%04d-%02d-%02dT%02d:%02d:%02d",
+                         tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                         tm.tm_hour, tm.tm_min, tm.tm_sec);
+        cache->len = n > 0 ? (size_t)n : 0;
+        cache->sec = sec;
+    }
+
+    int n = snprintf(out, cap, "[%.*s.%03dZ][%s]", (int)cache->len, cache->text, ms,
+                     logger_level_to_string(line->level));
+    size_t used = n > 0 ? (size_t)n : 0;
+
+    if (line->context && used < cap) {
+        n = snprintf(out + used, cap - used, "%.*s", (int)line->context_len, line->context);
+        if (n > 0) used += (size_t)n;
+        if (line->component_len > 0 && used < cap) {
+            n = snprintf(out + used, cap - used, "[%.*s]",
+                         (int)line->component_len, line->component);
+            if (n > 0) used += (size_t)n;
+        }
+    }
+    if (used < cap) {
+        n = snprintf(out + used, cap - used, "[tid:%04lx][%s:%d] ",
+                     line->thread_id % 0xFFFF, line->file, line->line);
+        if (n > 0) used += (size_t)n;
+    }
+    if (used >= cap - 1) used = cap - 2;
+
+    used += log_args_render(line->fmt, line->specs, line->nargs, line->args,
+                            line->args_len, out + used, cap - used - 1);
+    out[used++] = '\n';
+    return used;
+}
+
+// ============================================================================
+// STREAM ENCODING
+// ============================================================================
+
+#define PUT(value) do { \
+        memcpy(out + used, &(value), sizeof(value)); \
+        used += sizeof(value); \
+    } while (0)
+
+#define PUT_BYTES(src, len) do { \
+        memcpy(out + used, (src), (len)); \
+        used += (len); \
+    } while (0)
+
+size_t log_stream_encode_header(uint8_t *out, size_t cap) {
+    size_t used = 0;
+    uint32_t version = LOG_STREAM_VERSION;
+    if (cap < 8) return 0;
+    PUT_BYTES(LOG_STREAM_MAGIC, 4);
+    PUT(version);
+    return used;
+}
+
+size_t log_stream_encode_site(uint32_t id, const log_site_t *site,
+                              uint8_t *out, size_t cap) {
+    size_t used = 0;
+    uint16_t file_len = (uint16_t)strnlen(site->file, UINT16_MAX);
+    uint16_t fmt_len = (uint16_t)strnlen(site->fmt, UINT16_MAX);
+    uint8_t kind = LOG_STREAM_SITE;
+    uint8_t level = (uint8_t)site->level;
+    uint32_t line = (uint32_t)site->line;
+    uint8_t nargs = (uint8_t)site->nargs;
+
+    if (14u + nargs * 3u + file_len + fmt_len > cap) return 0;
+
+    PUT(kind);
+    PUT(id);
+    PUT(level);
+    PUT(line);
+    PUT(nargs);
+    for (int i = 0; i < nargs; i++) {
+        PUT(site->args[i].type);
+        PUT(site->args[i].limit);
+    }
+    PUT(file_len);
+    PUT(fmt_len);
+    PUT_BYTES(site->file, file_len);
+    PUT_BYTES(site->fmt, fmt_len);
+    return used;
+}
+
+size_t log_stream_encode_context(const char *text, size_t len, uint8_t *out, size_t cap) {
+    size_t used = 0;
+    uint8_t kind = LOG_STREAM_CONTEXT;
+    uint16_t len16 = (uint16_t)len;
+
+    if (3 + len > cap) return 0;
+
+    PUT(kind);
+    PUT(len16);
+    PUT_BYTES(text, len);
+    return used;
+}
+
+size_t log_stream_encode_record(uint32_t site_id, const log_line_t *line,
+                                uint8_t *out, size_t cap) {
+    size_t used = 0;
+    uint8_t kind = LOG_STREAM_RECORD;
+    uint64_t ts = line->timestamp_ns;
+    uint64_t tid = line->thread_id;
+    uint16_t comp_len = (uint16_t)line->component_len;
+    uint16_t args_len = (uint16_t)line->args_len;
+
+    if (25u + comp_len + args_len > cap) return 0;
+
+    PUT(kind);
+    PUT(site_id);
+    PUT(ts);
+    PUT(tid);
+    PUT(comp_len);
+    PUT(args_len);
+    PUT_BYTES(line->component, comp_len);
+    PUT_BYTES(line->args, args_len);
+    return used;
+}
+
+size_t log_stream_encode_text(const char *text, size_t len, uint8_t *out, size_t cap) {
+    size_t used = 0;
+    uint8_t kind = LOG_STREAM_TEXT;
+    uint16_t len16 = (uint16_t)len;
+
+    if (3 + len > cap) return 0;
+
+    PUT(kind);
+    PUT(len16);
+    PUT_BYTES(text, len);
+    return used;
+}
+
+// ============================================================================
+// STREAM DECODING
+// ============================================================================
+
+typedef struct {
+    log_level_t level;
+    int line;
+    int nargs;
+    log_arg_spec_t specs[LOG_SITE_MAX_ARGS];
+    char *file;
+    char *fmt;
+} decoded_site_t;
+
+static int read_exact(FILE *in, void *buf, size_t len) {
+    return fread(buf, 1, len, in) == len ? 0 : -1;
+}
+
+static char* read_string(FILE *in, size_t len) {
+    char *s = malloc(len + 1);
+    if (!s) return NULL;
+    if (read_exact(in, s, len) != 0) {
+        free(s);
+        return NULL;
+    }
+    s[len] = '\0';
+    return s;
+}
+
+static int decode_site(FILE *in, decoded_site_t **sites, size_t *capacity) {
+    uint32_t id, line;
+    uint8_t level, nargs;
+    if (read_exact(in, &id, sizeof(id)) || read_exact(in, &level, sizeof(level)) ||
+        read_exact(in, &line, sizeof(line)) || read_exact(in, &nargs, sizeof(nargs)) ||
+        nargs > LOG_SITE_MAX_ARGS || id == 0 || id > 1000000) {
+        return -1;
+    }
+
+    if (id >= *capacity) {
+        size_t grown = *capacity ? *capacity : 64;
+        while (grown <= id) grown *= 2;
+        decoded_site_t *next = realloc(*sites, grown * sizeof(decoded_site_t));
+        if (!next) return -1;
+        memset(next + *capacity, 0, (grown - *capacity) * sizeof(decoded_site_t));
+        *sites = next;
+        *capacity = grown;
+    }
+
+    decoded_site_t *site = &(*sites)[id];
+    free(site->file);
+    free(site->fmt);
+    memset(site, 0, sizeof(*site));
+    site->level = (log_level_t)level;
+    site->line = (int)line;
+    site->nargs = nargs;
+
+    for (int i = 0; i < nargs; i++) {
+        if (read_exact(in, &site->specs[i].type, sizeof(uint8_t)) ||
+            read_exact(in, &site->specs[i].limit, sizeof(uint16_t))) {
+            return -1;
+        }
+    }
+
+    uint16_t file_len, fmt_len;
+    if (read_exact(in, &file_len, sizeof(file_len)) ||
+        read_exact(in, &fmt_len, sizeof(fmt_len))) {
+        return -1;
+    }
+    site->file = read_string(in, file_len);
+    site->fmt = read_string(in, fmt_len);
+    return site->file && site->fmt ? 0 : -1;
+}
+
+long log_stream_decode(FILE *in, FILE *out) {
+    char magic[4];
+    uint32_t version;
+    if (read_exact(in, magic, sizeof(magic)) || memcmp(magic, LOG_STREAM_MAGIC, 4) != 0 ||
+        read_exact(in, &version, sizeof(version)) || version != LOG_STREAM_VERSION) {
+        return -1;
+    }
+
+    decoded_site_t *sites = NULL;
+    size_t capacity = 0;
+    char context[UINT16_MAX + 1];
+    size_t context_len = 0;
+    int have_context = 0;
+    log_time_cache_t cache = { .sec = -1 };
+    long records = 0;
+    int failed = 0;
+
+    uint8_t kind;
+    while (!failed && read_exact(in, &kind, sizeof(kind)) == 0) {
+        if (kind == LOG_STREAM_SITE) {
+            failed = decode_site(in, &sites, &capacity) != 0;
+        } else if (kind == LOG_STREAM_CONTEXT) {
+            uint16_t len;
+            failed = read_exact(in, &len, sizeof(len)) || read_exact(in, context, len);
+            context_len = len;
+            have_context = 1;
+        } else if (kind == LOG_STREAM_TEXT) {
+            uint16_t len;
+            char text[UINT16_MAX];
+            failed = read_exact(in, &len, sizeof(len)) || read_exact(in, text, len);
+            if (!failed) {
+                fwrite(text, 1, len, out);
+                records++;
+            }
+        } else if (kind == LOG_STREAM_RECORD) {
+            uint32_t site_id;
+            uint64_t ts, tid;
+            uint16_t comp_len, args_len;
+            char component[UINT16_MAX];
+            uint8_t args[UINT16_MAX];
+
+            if (read_exact(in, &site_id, sizeof(site_id)) || read_exact(in, &ts, sizeof(ts)) ||
+                read_exact(in, &tid, sizeof(tid)) ||
+                read_exact(in, &comp_len, sizeof(comp_len)) ||
+                read_exact(in, &args_len, sizeof(args_len)) ||
+                read_exact(in, component, comp_len) || read_exact(in, args, args_len) ||
+                site_id >= capacity || !sites[site_id].fmt) {
+                failed = 1;
+                break;
+            }
+
+            const decoded_site_t *site = &sites[site_id];
+            log_line_t line = {
+                .timestamp_ns = ts,
+                .thread_id = (unsigned long)tid,
+                .level = site->level,
+                .file = site->file,
+                .line = site->line,
+                .fmt = site->fmt,
+                .specs = site->specs,
+                .nargs = site->nargs,
+                .context = have_context ? context : NULL,
+                .context_len = context_len,
+                .component = component,
+                .component_len = comp_len,
+                .args = args,
+                .args_len = args_len
+            };
+
+            char text[LOG_ARGS_MAX + 1024];
+            size_t len = log_line_render(&line, &cache, text, sizeof(text));
+            fwrite(text, 1, len, out);
+            records++;
+        } else {
+            failed = 1;
+        }
+    }
+
+    for (size_t i = 0; i < capacity; i++) {
+        free(sites[i].file);
+        free(sites[i].fmt);
+    }
+    free(sites);
+
+    return failed ? -1 : records;
+}
@@ -3,62 +3,205 @@
 #define _POSIX_C_SOURCE 200809L
 
 #include "roole/logger/logger.h"
+#include "roole/logger/log_binary.h"
 #include <stdio.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <time.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdarg.h>
+#include <poll.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <sys/eventfd.h>
 
 // ============================================================================
 // CONFIGURATION
 // ============================================================================
 
-#define LOG_BUFFER_SIZE 4096
+#define LOG_RING_SIZE (64 * 1024)           // Per-thread ring, power of two
+#define LOG_RING_HIGH_WATER (LOG_RING_SIZE / 2)
+#define LOG_LINE_MAX 2048                   // Longest single formatted line
 #define FLUSH_INTERVAL_MS 10
-#define CRITICAL_BUFFER_THRESHOLD 3072
+#define LOG_WRITEV_BATCH 64                 // iovecs per writev() call
+#define LOG_OUT_BUFFER (64 * 1024)          // Writer output buffer (record modes)
+#define LOG_OUT_RESERVE (8 * 1024)          // Room kept for one rendered record
+#define LOG_BINARY_DEFAULT_PATH "roole.rlog"
 
 // Log format modes
 typedef enum {
     LOG_FORMAT_TEXT = 0,    // Traditional text format
-    LOG_FORMAT_JSON = 1     // Structured JSON format
+    LOG_FORMAT_JSON = 1,    // Structured JSON format
+    LOG_FORMAT_DEFERRED = 2,// Raw args in the ring, text rendered by the writer
+    LOG_FORMAT_BINARY = 3   // Raw args written to a file, decoded offline
 } log_format_t;
 
+#define RECORD_MODE(format) ((format) >= LOG_FORMAT_DEFERRED)
+
+// ============================================================================
+// PER-THREAD RINGS
+// ============================================================================
+
+// Single-producer (owning thread) / single-consumer (writer thread) byte
+// ring holding complete, newline-terminated lines. head and tail are
+// free-running byte counters; only the owner advances head, only the
+// writer advances tail.
+typedef struct log_ring {
+    uint64_t head __attribute__((aligned(64)));
+    uint64_t tail __attribute__((aligned(64)));
+    int in_use;                             // Claimed by a live thread
+    struct log_ring *next;                  // Registry link (append-only)
+    char data[LOG_RING_SIZE];
+} log_ring_t;
+
+// Ring entry in the record modes. Followed by the component path and the
+// payload: captured args, or a finished line when site is NULL.
+typedef struct {
+    uint32_t length;                        // Header + component + payload
+    uint16_t component_len;
+    uint16_t payload_len;
+    const log_site_t *site;
+    const void *context;                    // published_context_t, may be NULL
+    uint64_t timestamp_ns;
+    uint64_t thread_id;
+} log_record_t;
+
+#define LOG_RECORD_MAX (sizeof(log_record_t) + 128 + LOG_ARGS_MAX)
+
+// Context published by logger_set_context(). Readers load the pointer
+// without locking, so replaced versions are never freed (the context is
+// set once or twice per process).
+typedef struct published_context {
+    log_context_t ctx;
+    char text[128];                         // "[node:N][cluster]"
+    size_t text_len;
+    char json[160];                         // "\"node_id\":N,\"cluster\":\"..\","
+    size_t json_len;
+} published_context_t;
+
+// Per-thread timestamp cache: localtime_r runs once per second, the
+// millisecond digits are patched in place.
+typedef struct {
+    time_t sec;
+    int ms;
+    char text[32];
+    size_t len;
+} timestamp_cache_t;
+
 // ============================================================================
 // GLOBAL STATE
 // ============================================================================
 
 static log_level_t g_log_level = LOG_LEVEL_INFO;
+int g_logger_threshold = LOG_LEVEL_INFO;
+
+// Per-component overrides. Readers cache their effective level per thread
+// and only look at the table again when the generation changes.
+static log_component_level_t g_component_levels[LOG_MAX_COMPONENT_LEVELS];
+static size_t g_component_level_count = 0;
+static uint32_t g_levels_generation = 1;
+static pthread_mutex_t g_levels_lock = PTHREAD_MUTEX_INITIALIZER;
 static log_format_t g_log_format = LOG_FORMAT_TEXT;  // Default to text
-static log_context_t g_log_context = {0};
-static pthread_mutex_t g_context_lock = PTHREAD_MUTEX_INITIALIZER;
-static pthread_t g_flush_thread;
-static volatile int g_shutdown = 0;
+static published_context_t *g_context = NULL;
 
-// Thread-local log buffer
-typedef struct log_buffer {
-    char data[LOG_BUFFER_SIZE];
-    size_t used;
-    pthread_mutex_t lock;
-} log_buffer_t;
+static log_ring_t *g_rings = NULL;          // Lock-free registry, unbounded
+static pthread_key_t g_ring_key;
+static pthread_once_t g_ring_key_once = PTHREAD_ONCE_INIT;
 
-static __thread log_buffer_t *tls_log_buffer = NULL;
+static pthread_t g_writer_thread;
+static int g_writer_running = 0;
+static int g_shutdown = 0;
+static int g_wake_fd = -1;
+static int g_out_fd = STDOUT_FILENO;        // Binary mode writes to its own file
 
-// Component stack (unchanged from before)
+// Writer-side state for the record modes
+static log_time_cache_t g_writer_time = { .sec = -1 };
+static const void *g_stream_context = NULL;
+static uint32_t g_stream_site_count = 0;
+static uint32_t g_stream_epoch = 0;         // Bumped per binary file
+
+// Eager sites carry their message pre-rendered as a single string
+static const log_arg_spec_t g_eager_spec = { LOG_ARG_STRING, 0 };
+
+static __thread log_ring_t *tls_ring = NULL;
+static __thread timestamp_cache_t tls_timestamp = { .sec = -1 };
+static __thread unsigned long tls_thread_id = 0;
+
+// Component stack; the joined path is rebuilt on push/pop only
 #define MAX_COMPONENT_STACK 4
 typedef struct {
     char components[MAX_COMPONENT_STACK][32];
     int depth;
+    char path[128];
+    size_t path_len;
+    log_level_t level;              // Effective level for this stack
+    uint32_t level_generation;      // 0 = recompute
 } component_stack_t;
 
 static __thread component_stack_t tls_component_stack = {0};
 
-// Ring buffer for cross-thread log aggregation
-#define RING_BUFFER_SIZE 128
-static log_buffer_t *g_ring_buffers[RING_BUFFER_SIZE];
-static size_t g_ring_count = 0;
-static pthread_mutex_t g_ring_lock = PTHREAD_MUTEX_INITIALIZER;
+// ============================================================================
+// LEVELS
+// ============================================================================
+
+// Caller holds g_levels_lock
+static void levels_changed_locked(void) {
+    int threshold = g_log_level;
+    for (size_t i = 0; i < g_component_level_count; i++) {
+        if ((int)g_component_levels[i].level < threshold) {
+            threshold = g_component_levels[i].level;
+        }
+    }
+    __atomic_store_n(&g_logger_threshold, threshold, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&g_levels_generation, 1, __ATOMIC_RELEASE);
+}
+
+// "raft" matches "raft" and "raft:heartbeat", not "rafters"
+static size_t component_match(const char *pattern, const char *name) {
+    size_t len = strlen(pattern);
+    if (strncmp(pattern, name, len) != 0) return 0;
+    return name[len] == '\0' || name[len] == ':' ? len : 0;
+}
+
+// Innermost component with an override decides; otherwise the global level
+static log_level_t effective_level(void) {
+    component_stack_t *stack = &tls_component_stack;
+    uint32_t generation = __atomic_load_n(&g_levels_generation, __ATOMIC_ACQUIRE);
+    if (stack->level_generation == generation) return stack->level;
+    
+    // No overrides (the common case): no need to look at the table
+    log_level_t level = __atomic_load_n(&g_log_level, __ATOMIC_RELAXED);
+    if (stack->depth == 0 || __atomic_load_n(&g_component_level_count, __ATOMIC_RELAXED) == 0) {
+        stack->level = level;
+        stack->level_generation = generation;
+        return level;
+    }
+    
+    pthread_mutex_lock(&g_levels_lock);
+    level = g_log_level;
+    for (int d = stack->depth - 1; d >= 0; d--) {
+        size_t best = 0;
+        for (size_t i = 0; i < g_component_level_count; i++) {
+            size_t len = component_match(g_component_levels[i].component,
+                                         stack->components[d]);
+            if (len > best) {
+                best = len;
+                level = g_component_levels[i].level;
+            }
+        }
+        if (best > 0) break;
+    }
+    pthread_mutex_unlock(&g_levels_lock);
+    
+    stack->level = level;
+    stack->level_generation = generation;
+    return level;
+}
 
 // ============================================================================
 // FORMAT DETECTION (from environment variable)
@@ -74,8 +217,13 @@ static void detect_log_format(void) {
         } else if (strcasecmp(format_env, "text") == 0) {
             g_log_format = LOG_FORMAT_TEXT;
             fprintf(stderr, "[logger] Using text log format\n");
+        } else if (strcasecmp(format_env, "deferred") == 0) {
+            g_log_format = LOG_FORMAT_DEFERRED;
+            fprintf(stderr, "[logger] Using deferred text log format\n");
+        } else if (strcasecmp(format_env, "binary") == 0) {
+            g_log_format = LOG_FORMAT_BINARY;
         } else {
-            fprintf(stderr, "[logger] Unknown ROOLE_LOG_FORMAT='%s', using text\n", 
+            fprintf(stderr, "[logger] Unknown ROOLE_LOG_FORMAT='%s', using text\n",
                     format_env);
             g_log_format = LOG_FORMAT_TEXT;
         }
@@ -132,52 +280,324 @@ static void json_escape_string(const char *input, char *output, size_t output_si
 }
 
 // ============================================================================
-// INTERNAL FUNCTIONS (unchanged)
+// RING REGISTRY
+// ============================================================================
+
+static void release_ring(void *arg) {
+    log_ring_t *ring = arg;
+    // Pending bytes stay in the ring; the writer drains them regardless
+    __atomic_store_n(&ring->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void create_ring_key(void) {
+    pthread_key_create(&g_ring_key, release_ring);
+}
+
+static log_ring_t* get_tls_ring(void) {
+    if (tls_ring) return tls_ring;
+    
+    pthread_once(&g_ring_key_once, create_ring_key);
+    
+    // Reuse a ring left behind by an exited thread before growing the list
+    log_ring_t *ring = __atomic_load_n(&g_rings, __ATOMIC_ACQUIRE);
+    for (; ring; ring = ring->next) {
+        int expected = 0;
+        if (__atomic_load_n(&ring->in_use, __ATOMIC_RELAXED) == 0 &&
+            __atomic_compare_exchange_n(&ring->in_use, &expected, 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    
+    if (!ring) {
+        if (posix_memalign((void**)&ring, 64, sizeof(log_ring_t)) != 0) {
+            return NULL;
+        }
+        memset(ring, 0, offsetof(log_ring_t, data));
+        ring->in_use = 1;
+        
+        ring->next = __atomic_load_n(&g_rings, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&g_rings, &ring->next, ring, 1,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        }
+    }
+    
+    pthread_setspecific(g_ring_key, ring);
+    tls_ring = ring;
+    return ring;
+}
+
+static void wake_writer(void) {
+    uint64_t one = 1;
+    ssize_t n = write(g_wake_fd, &one, sizeof(one));
+    (void)n;
+}
+
+// Copy one complete line into the caller's ring. Only blocks when the
+// ring is full, i.e. when the writer has fallen a whole ring behind.
+// Returns -1 if the writer stopped meanwhile and the line was not queued.
+static int ring_append(log_ring_t *ring, const char *line, size_t len) {
+    uint64_t head = ring->head;
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    uint64_t used = head - tail;
+    
+    while (len > LOG_RING_SIZE - used) {
+        if (!__atomic_load_n(&g_writer_running, __ATOMIC_ACQUIRE)) {
+            return -1;  // Shutting down; nobody will make room
+        }
+        wake_writer();
+        sched_yield();
+        tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        used = head - tail;
+    }
+    
+    size_t offset = head & (LOG_RING_SIZE - 1);
+    size_t first = LOG_RING_SIZE - offset;
+    if (first > len) first = len;
+    memcpy(ring->data + offset, line, first);
+    memcpy(ring->data, line + first, len - first);
+    
+    __atomic_store_n(&ring->head, head + len, __ATOMIC_RELEASE);
+    
+    // Kick the writer once per crossing instead of on every line
+    if (used < LOG_RING_HIGH_WATER && used + len >= LOG_RING_HIGH_WATER) {
+        wake_writer();
+    }
+    
+    return 0;
+}
+
+static void write_fully(int fd, struct iovec *iov, int count) {
+    while (count > 0) {
+        ssize_t n = writev(fd, iov, count);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;  // Nowhere to report it; drop the batch
+        }
+        while (count > 0 && (size_t)n >= iov->iov_len) {
+            n -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + n;
+            iov->iov_len -= (size_t)n;
+        }
+    }
+}
+
+// ============================================================================
+// WRITER THREAD
 // ============================================================================
 
-static log_buffer_t* get_tls_buffer(void) {
-    if (!tls_log_buffer) {
-        tls_log_buffer = calloc(1, sizeof(log_buffer_t));
-        pthread_mutex_init(&tls_log_buffer->lock, NULL);
+typedef struct {
+    struct iovec iov[LOG_WRITEV_BATCH];
+    int count;
+    log_ring_t *rings[LOG_WRITEV_BATCH];    // A ring that did not wrap uses one iovec
+    uint64_t new_tail[LOG_WRITEV_BATCH];
+    int ring_count;
+} write_batch_t;
+
+static void batch_commit(write_batch_t *batch) {
+    if (batch->count > 0) {
+        write_fully(STDOUT_FILENO, batch->iov, batch->count);
+    }
+    for (int i = 0; i < batch->ring_count; i++) {
+        __atomic_store_n(&batch->rings[i]->tail, batch->new_tail[i], __ATOMIC_RELEASE);
+    }
+    batch->count = 0;
+    batch->ring_count = 0;
+}
+
+// Hand everything currently buffered to the kernel in as few writev()
+// calls as possible. Returns the number of bytes written.
+static size_t drain_lines(void) {
+    write_batch_t batch = { .count = 0 };
+    size_t total = 0;
+    int flushed_stdio = 0;
+    
+    for (log_ring_t *ring = __atomic_load_n(&g_rings, __ATOMIC_ACQUIRE);
+         ring; ring = ring->next) {
+        uint64_t tail = ring->tail;
+        uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
         
-        pthread_mutex_lock(&g_ring_lock);
-        if (g_ring_count < RING_BUFFER_SIZE) {
-            g_ring_buffers[g_ring_count++] = tls_log_buffer;
+        if (head == tail) continue;
+        
+        if (!flushed_stdio) {
+            // Keep printf() output that predates these lines in front of them
+            fflush(stdout);
+            flushed_stdio = 1;
         }
-        pthread_mutex_unlock(&g_ring_lock);
+        
+        if (batch.count + 2 > LOG_WRITEV_BATCH) {
+            batch_commit(&batch);
+        }
+        
+        size_t offset = tail & (LOG_RING_SIZE - 1);
+        size_t len = head - tail;
+        size_t first = LOG_RING_SIZE - offset;
+        if (first > len) first = len;
+        
+        batch.iov[batch.count++] = (struct iovec){ ring->data + offset, first };
+        if (len > first) {
+            batch.iov[batch.count++] = (struct iovec){ ring->data, len - first };
+        }
+        batch.rings[batch.ring_count] = ring;
+        batch.new_tail[batch.ring_count++] = head;
+        total += len;
     }
-    return tls_log_buffer;
+    
+    batch_commit(&batch);
+    return total;
+}
+
+static void ring_copy_out(const log_ring_t *ring, uint64_t pos, void *dst, size_t len) {
+    size_t offset = pos & (LOG_RING_SIZE - 1);
+    size_t first = LOG_RING_SIZE - offset;
+    if (first > len) first = len;
+    memcpy(dst, ring->data + offset, first);
+    memcpy((char*)dst + first, ring->data, len - first);
 }
 
-static void flush_buffer(log_buffer_t *buf) {
-    if (!buf || buf->used == 0) return;
+static void record_to_line(const log_record_t *rec, const uint8_t *body, log_line_t *line) {
+    const log_site_t *site = rec->site;
+    const published_context_t *ctx = rec->context;
+    int eager = __atomic_load_n(&site->state, __ATOMIC_ACQUIRE) == LOG_SITE_EAGER;
     
-    pthread_mutex_lock(&buf->lock);
-    if (buf->used > 0) {
-        fwrite(buf->data, 1, buf->used, stdout);
-        fflush(stdout);
-        buf->used = 0;
+    *line = (log_line_t){
+        .timestamp_ns = rec->timestamp_ns,
+        .thread_id = (unsigned long)rec->thread_id,
+        .level = site->level,
+        .file = site->file,
+        .line = site->line,
+        .fmt = eager ? "%s" : site->fmt,
+        .specs = eager ? &g_eager_spec : site->args,
+        .nargs = eager ? 1 : site->nargs,
+        .context = ctx ? ctx->text : NULL,
+        .context_len = ctx ? ctx->text_len : 0,
+        .component = (const char*)body,
+        .component_len = rec->component_len,
+        .args = body + rec->component_len,
+        .args_len = rec->payload_len
+    };
+}
+
+// Turn one record into output bytes: a text line (deferred) or stream
+// entries (binary). out has at least LOG_OUT_RESERVE bytes free.
+static size_t render_record(const log_record_t *rec, const uint8_t *body,
+                            uint8_t *out, size_t cap) {
+    const uint8_t *payload = body + rec->component_len;
+    
+    if (!rec->site) {
+        if (g_log_format == LOG_FORMAT_BINARY) {
+            return log_stream_encode_text((const char*)payload, rec->payload_len, out, cap);
+        }
+        memcpy(out, payload, rec->payload_len);
+        return rec->payload_len;
     }
-    pthread_mutex_unlock(&buf->lock);
+    
+    log_line_t line;
+    record_to_line(rec, body, &line);
+    
+    if (g_log_format != LOG_FORMAT_BINARY) {
+        return log_line_render(&line, &g_writer_time, (char*)out, cap);
+    }
+    
+    size_t used = 0;
+    if (rec->context && rec->context != g_stream_context) {
+        used += log_stream_encode_context(line.context, line.context_len, out, cap);
+        g_stream_context = rec->context;
+    }
+    
+    log_site_t *site = (log_site_t*)rec->site;
+    if (site->stream_epoch != g_stream_epoch) {
+        log_site_t view = *site;
+        view.fmt = line.fmt;
+        view.nargs = line.nargs;
+        if (line.specs == &g_eager_spec) view.args[0] = g_eager_spec;
+        site->stream_id = ++g_stream_site_count;
+        site->stream_epoch = g_stream_epoch;
+        used += log_stream_encode_site(site->stream_id, &view, out + used, cap - used);
+    }
+    
+    used += log_stream_encode_record(site->stream_id, &line, out + used, cap - used);
+    return used;
+}
+
+static void write_out(const uint8_t *data, size_t len) {
+    struct iovec iov = { (void*)data, len };
+    write_fully(g_out_fd, &iov, 1);
+}
+
+// Record modes: decode every buffered record, render it into one output
+// buffer and write that in large chunks. Returns bytes consumed.
+static size_t drain_records(void) {
+    static uint8_t out[LOG_OUT_BUFFER];     // Writer (or shutdown) only
+    size_t used = 0;
+    size_t total = 0;
+    int flushed_stdio = 0;
+    
+    for (log_ring_t *ring = __atomic_load_n(&g_rings, __ATOMIC_ACQUIRE);
+         ring; ring = ring->next) {
+        uint64_t tail = ring->tail;
+        uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        
+        if (head == tail) continue;
+        
+        if (!flushed_stdio) {
+            fflush(stdout);
+            flushed_stdio = 1;
+        }
+        
+        while (tail != head) {
+            log_record_t rec;
+            uint8_t body[LOG_RECORD_MAX];
+            ring_copy_out(ring, tail, &rec, sizeof(rec));
+            ring_copy_out(ring, tail + sizeof(rec), body, rec.length - sizeof(rec));
+            
+            if (LOG_OUT_BUFFER - used < LOG_OUT_RESERVE) {
+                write_out(out, used);
+                used = 0;
+            }
+            used += render_record(&rec, body, out + used, LOG_OUT_BUFFER - used);
+            
+            tail += rec.length;
+            total += rec.length;
+        }
+        
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+    
+    if (used > 0) write_out(out, used);
+    return total;
+}
+
+static size_t drain_rings(void) {
+    return RECORD_MODE(g_log_format) ? drain_records() : drain_lines();
 }
 
-static void* flush_thread_fn(void *arg) {
+static void* writer_thread_fn(void *arg) {
     (void)arg;
+    struct pollfd pfd = { .fd = g_wake_fd, .events = POLLIN };
     
-    while (!g_shutdown) {
-        usleep(FLUSH_INTERVAL_MS * 1000);
+    while (!__atomic_load_n(&g_shutdown, __ATOMIC_ACQUIRE)) {
+        if (drain_rings() > 0) continue;
         
-        pthread_mutex_lock(&g_ring_lock);
-        for (size_t i = 0; i < g_ring_count; i++) {
-            flush_buffer(g_ring_buffers[i]);
+        if (poll(&pfd, 1, FLUSH_INTERVAL_MS) > 0) {
+            uint64_t value;
+            ssize_t n = read(g_wake_fd, &value, sizeof(value));
+            (void)n;
         }
-        pthread_mutex_unlock(&g_ring_lock);
     }
     
     return NULL;
 }
 
-static const char* level_to_string(log_level_t level) {
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+const char* logger_level_to_string(log_level_t level) {
     switch (level) {
         case LOG_LEVEL_DEBUG: return "DEBUG";
         case LOG_LEVEL_INFO:  return "INFO";
@@ -187,122 +607,230 @@ static const char* level_to_string(log_level_t level) {
     }
 }
 
-static void get_timestamp(char *buf, size_t size) {
+static const char* get_timestamp(size_t *len) {
     struct timespec ts;
     clock_gettime(CLOCK_REALTIME, &ts);
     
-    struct tm tm;
-    localtime_r(&ts.tv_sec, &tm);
+    timestamp_cache_t *cache = &tls_timestamp;
+    int ms = (int)(ts.tv_nsec / 1000000);
     
-    snprintf(buf, size, "%04d-%02d-%02dT%02d:%02d:%02d.%03ldZ",
-             tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
-             tm.tm_hour, tm.tm_min, tm.tm_sec, ts.tv_nsec / 1000000);
+    if (ts.tv_sec != cache->sec) {
+        struct tm tm;
+        localtime_r(&ts.tv_sec, &tm);
+        
+        int n = snprintf(cache->text, sizeof(cache->text),
+                         "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                         tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                         tm.tm_hour, tm.tm_min, tm.tm_sec, ms);
+        cache->len = n > 0 ? (size_t)n : 0;
+        cache->sec = ts.tv_sec;
+        cache->ms = ms;
+    } else if (ms != cache->ms && cache->len >= 4) {
+        char *digits = cache->text + cache->len - 4;  // "mmmZ"
+        digits[0] = (char)('0' + ms / 100);
+        digits[1] = (char)('0' + ms / 10 % 10);
+        digits[2] = (char)('0' + ms % 10);
+        cache->ms = ms;
+    }
+    
+    *len = cache->len;
+    return cache->text;
 }
 
-static void get_component_path(char *buf, size_t size) {
-    if (tls_component_stack.depth == 0) {
-        buf[0] = '\0';
+static void rebuild_component_path(void) {
+    component_stack_t *stack = &tls_component_stack;
+    size_t offset = 0;
+    stack->path[0] = '\0';
+    
+    for (int i = 0; i < stack->depth && offset < sizeof(stack->path) - 1; i++) {
+        int written = snprintf(stack->path + offset, sizeof(stack->path) - offset, "%s%s",
+                               i > 0 ? ":" : "", stack->components[i]);
+        if (written > 0) offset += written;
+    }
+    stack->path_len = strnlen(stack->path, sizeof(stack->path));
+}
+
+static unsigned long get_thread_id(void) {
+    if (!tls_thread_id) {
+        tls_thread_id = (unsigned long)pthread_self();
+    }
+    return tls_thread_id;
+}
+
+static size_t append_bytes(char *line, size_t used, const char *src, size_t len) {
+    if (used + len > LOG_LINE_MAX - 1) len = LOG_LINE_MAX - 1 - used;
+    memcpy(line + used, src, len);
+    return used + len;
+}
+
+static size_t append_format(char *line, size_t used, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int written = vsnprintf(line + used, LOG_LINE_MAX - used, fmt, args);
+    va_end(args);
+    
+    if (written < 0) return used;
+    used += (size_t)written;
+    return used < LOG_LINE_MAX - 1 ? used : LOG_LINE_MAX - 1;
+}
+
+// Hand a finished line to the writer, or write it directly when no writer
+// thread is running (before logger_init / after logger_shutdown).
+static void emit_line(log_level_t level, const char *line, size_t len) {
+    if (level == LOG_LEVEL_ERROR) {
+        ssize_t n = write(STDERR_FILENO, line, len);
+        (void)n;
         return;
     }
     
-    size_t offset = 0;
-    for (int i = 0; i < tls_component_stack.depth && offset < size - 1; i++) {
-        int written = snprintf(buf + offset, size - offset, "%s%s",
-                              i > 0 ? ":" : "",
-                              tls_component_stack.components[i]);
-        if (written > 0) offset += written;
+    log_ring_t *ring = NULL;
+    if (__atomic_load_n(&g_writer_running, __ATOMIC_ACQUIRE)) {
+        ring = get_tls_ring();
+    }
+    
+    int queued = -1;
+    if (ring && RECORD_MODE(g_log_format)) {
+        // Record modes: the ring only holds records, so wrap the line
+        uint8_t buf[sizeof(log_record_t) + LOG_LINE_MAX];
+        log_record_t rec = {
+            .length = (uint32_t)(sizeof(rec) + len),
+            .payload_len = (uint16_t)len
+        };
+        memcpy(buf, &rec, sizeof(rec));
+        memcpy(buf + sizeof(rec), line, len);
+        queued = ring_append(ring, (const char*)buf, rec.length);
+    } else if (ring) {
+        queued = ring_append(ring, line, len);
+    }
+    
+    if (queued != 0) {
+        ssize_t n = write(STDOUT_FILENO, line, len);
+        (void)n;
     }
 }
 
 // ============================================================================
-// TEXT FORMAT LOGGING (Original)
+// DEFERRED FORMATTING (record modes)
 // ============================================================================
 
-static void logger_log_text(log_level_t level, const char *file, int line, 
-                           const char *fmt, va_list args) {
-    log_buffer_t *buf = get_tls_buffer();
-    pthread_mutex_lock(&buf->lock);
-    
-    if (buf->used > CRITICAL_BUFFER_THRESHOLD) {
-        fwrite(buf->data, 1, buf->used, stdout);
-        fflush(stdout);
-        buf->used = 0;
-    }
-    
-    char timestamp[32];
-    get_timestamp(timestamp, sizeof(timestamp));
-    
-    int written = 0;
-    unsigned long thread_id = (unsigned long)pthread_self();
-    char component_path[128];
-    get_component_path(component_path, sizeof(component_path));
-
-    pthread_mutex_lock(&g_context_lock);
-    if (g_log_context.initialized) {
-        if (component_path[0] != '\0') {
-            written = snprintf(buf->data + buf->used, LOG_BUFFER_SIZE - buf->used,
-                            "[%s][%s][node:%u][%s][%s][tid:%04lx][%s:%d] ",
-                            timestamp, level_to_string(level),
-                            g_log_context.node_id, g_log_context.cluster_name,
-                            component_path, 
-                            thread_id % 0xFFFF,
-                            file, line);
+// Parse the site's format once. Returns 1 if fmt can be captured raw.
+static int site_prepare(log_site_t *site, const char *fmt) {
+    int state = __atomic_load_n(&site->state, __ATOMIC_ACQUIRE);
+    
+    if (state == LOG_SITE_UNPARSED) {
+        int expected = LOG_SITE_UNPARSED;
+        if (__atomic_compare_exchange_n(&site->state, &expected, LOG_SITE_PARSING, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            site->fmt = fmt;
+            int n = log_format_parse(fmt, site->args, LOG_SITE_MAX_ARGS);
+            site->nargs = n < 0 ? 0 : n;
+            state = n < 0 ? LOG_SITE_EAGER : LOG_SITE_BINARY;
+            __atomic_store_n(&site->state, state, __ATOMIC_RELEASE);
         } else {
-            written = snprintf(buf->data + buf->used, LOG_BUFFER_SIZE - buf->used,
-                            "[%s][%s][node:%u][%s][tid:%04lx][%s:%d] ",
-                            timestamp, level_to_string(level),
-                            g_log_context.node_id, g_log_context.cluster_name,
-                            thread_id % 0xFFFF,
-                            file, line);
+            state = expected;
         }
-    } else {
-        written = snprintf(buf->data + buf->used, LOG_BUFFER_SIZE - buf->used,
-                        "[%s][%s][tid:%04lx][%s:%d] ",
-                        timestamp, level_to_string(level), thread_id % 0xFFFF,
-                        file, line);
     }
-    pthread_mutex_unlock(&g_context_lock);
     
-    if (written > 0) buf->used += written;
+    while (state == LOG_SITE_PARSING) {
+        sched_yield();
+        state = __atomic_load_n(&site->state, __ATOMIC_ACQUIRE);
+    }
     
-    written = vsnprintf(buf->data + buf->used, LOG_BUFFER_SIZE - buf->used, fmt, args);
-    if (written > 0) buf->used += written;
+    // A non-literal format may differ between calls; those take the text path
+    return site->fmt == fmt;
+}
+
+// Capture the call into a record. Costs a clock read and a few memcpys;
+// vsnprintf only runs for formats that cannot be captured (EAGER sites).
+static int record_site(log_ring_t *ring, log_site_t *site, const char *fmt, va_list *args) {
+    uint8_t buf[LOG_RECORD_MAX];
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
     
-    if (buf->used < LOG_BUFFER_SIZE - 1) {
-        buf->data[buf->used++] = '\n';
-    }
+    log_record_t rec = {
+        .component_len = (uint16_t)tls_component_stack.path_len,
+        .site = site,
+        .context = __atomic_load_n(&g_context, __ATOMIC_ACQUIRE),
+        .timestamp_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec,
+        .thread_id = get_thread_id()
+    };
     
-    if (level == LOG_LEVEL_ERROR) {
-        fwrite(buf->data, 1, buf->used, stderr);
-        fflush(stderr);
-        buf->used = 0;
+    uint8_t *body = buf + sizeof(rec);
+    memcpy(body, tls_component_stack.path, rec.component_len);
+    uint8_t *payload = body + rec.component_len;
+    
+    if (__atomic_load_n(&site->state, __ATOMIC_ACQUIRE) == LOG_SITE_BINARY) {
+        rec.payload_len = (uint16_t)log_args_encode(site->args, site->nargs, args,
+                                                     payload, LOG_ARGS_MAX);
+    } else {
+        char *message = (char*)payload + sizeof(uint16_t);
+        int n = vsnprintf(message, LOG_ARGS_MAX - sizeof(uint16_t), fmt, *args);
+        uint16_t len = n < 0 ? 0 : (uint16_t)(n < LOG_ARGS_MAX - 2 ? n : LOG_ARGS_MAX - 3);
+        memcpy(payload, &len, sizeof(len));
+        rec.payload_len = (uint16_t)(sizeof(len) + len);
     }
     
-    pthread_mutex_unlock(&buf->lock);
+    rec.length = (uint32_t)(sizeof(rec) + rec.component_len + rec.payload_len);
+    memcpy(buf, &rec, sizeof(rec));
+    
+    if (ring_append(ring, (const char*)buf, rec.length) == 0) return 0;
+    
+    // Writer stopped while we waited for room: render here instead
+    log_line_t line;
+    char text[LOG_RECORD_MAX + LOG_LINE_MAX];
+    log_time_cache_t cache = { .sec = -1 };
+    record_to_line(&rec, body, &line);
+    size_t len = log_line_render(&line, &cache, text, sizeof(text));
+    ssize_t n = write(STDOUT_FILENO, text, len);
+    (void)n;
+    return 0;
 }
 
 // ============================================================================
-// JSON FORMAT LOGGING (NEW)
+// TEXT FORMAT LOGGING (Original)
 // ============================================================================
 
-static void logger_log_json(log_level_t level, const char *file, int line,
+static void logger_log_text(log_level_t level, const char *file, int line_no,
                            const char *fmt, va_list args) {
-    log_buffer_t *buf = get_tls_buffer();
-    pthread_mutex_lock(&buf->lock);
+    char line[LOG_LINE_MAX];
+    size_t used = 0;
+    size_t ts_len;
+    const char *timestamp = get_timestamp(&ts_len);
+    const char *component_path = tls_component_stack.path;
+    published_context_t *ctx = __atomic_load_n(&g_context, __ATOMIC_ACQUIRE);
     
-    if (buf->used > CRITICAL_BUFFER_THRESHOLD) {
-        fwrite(buf->data, 1, buf->used, stdout);
-        fflush(stdout);
-        buf->used = 0;
-    }
+    line[used++] = '[';
+    used = append_bytes(line, used, timestamp, ts_len);
+    used = append_format(line, used, "][%s]", logger_level_to_string(level));
     
-    char timestamp[32];
-    get_timestamp(timestamp, sizeof(timestamp));
+    if (ctx) {
+        used = append_bytes(line, used, ctx->text, ctx->text_len);
+        if (tls_component_stack.depth > 0) {
+            used = append_format(line, used, "[%s]", component_path);
+        }
+    }
+    used = append_format(line, used, "[tid:%04lx][%s:%d] ",
+                         get_thread_id() % 0xFFFF, file, line_no);
     
-    char component_path[128];
-    get_component_path(component_path, sizeof(component_path));
+    int written = vsnprintf(line + used, LOG_LINE_MAX - used, fmt, args);
+    if (written > 0) {
+        used += (size_t)written;
+        if (used > LOG_LINE_MAX - 1) used = LOG_LINE_MAX - 1;
+    }
+    line[used++] = '\n';
     
-    unsigned long thread_id = (unsigned long)pthread_self();
+    emit_line(level, line, used);
+}
+
+// ============================================================================
+// JSON FORMAT LOGGING (NEW)
+// ============================================================================
+
+static void logger_log_json(log_level_t level, const char *file, int line_no,
+                           const char *fmt, va_list args) {
+    size_t ts_len;
+    const char *timestamp = get_timestamp(&ts_len);
+    published_context_t *ctx = __atomic_load_n(&g_context, __ATOMIC_ACQUIRE);
     
     // Format the actual log message
     char message[1024];
@@ -313,91 +841,209 @@ static void logger_log_json(log_level_t level, const char *file, int line,
     json_escape_string(message, escaped_message, sizeof(escaped_message));
     
     // Build JSON log line
-    int written = 0;
-    
-    pthread_mutex_lock(&g_context_lock);
-    
-    if (g_log_context.initialized) {
-        if (component_path[0] != '\0') {
-            written = snprintf(buf->data + buf->used, LOG_BUFFER_SIZE - buf->used,
-                "{\"timestamp\"%s,\"level\":\"%s\",\"node_id\":%u,"
-                "\"cluster\":\"%s\",\"component\":\"%s\",\"thread_id\":%lu,"
-                "\"file\":\"%s\",\"line\":%d,\"message\":\"%s\"}\n",
-                timestamp, level_to_string(level), g_log_context.node_id,
-                g_log_context.cluster_name, component_path, thread_id,
-                file, line, escaped_message);
-        } else {
-            written = snprintf(buf->data + buf->used, LOG_BUFFER_SIZE - buf->used,
-                "{\"timestamp\":\"%s\",\"level\":\"%s\",\"node_id\":%u,"
-                "\"cluster\":\"%s\",\"thread_id\":%lu,"
-                "\"file\":\"%s\",\"line\":%d,\"message\":\"%s\"}\n",
-                timestamp, level_to_string(level), g_log_context.node_id,
-                g_log_context.cluster_name, thread_id,
-                file, line, escaped_message);
-        }
-    } else {
-        written = snprintf(buf->data + buf->used, LOG_BUFFER_SIZE - buf->used,
-            "{\"timestamp\":\"%s\",\"level\":\"%s\",\"thread_id\":%lu,"
-            "\"file\":\"%s\",\"line\":%d,\"message\":\"%s\"}\n",
-            timestamp, level_to_string(level), thread_id,
-            file, line, escaped_message);
-    }
-    
-    pthread_mutex_unlock(&g_context_lock);
+    char line[LOG_LINE_MAX];
+    size_t used = append_format(line, 0, "{\"timestamp\":\"%.*s\",\"level\":\"%s\",",
+                                (int)ts_len, timestamp, logger_level_to_string(level));
     
-    if (written > 0) buf->used += written;
-    
-    if (level == LOG_LEVEL_ERROR) {
-        fwrite(buf->data, 1, buf->used, stderr);
-        fflush(stderr);
-        buf->used = 0;
+    if (ctx) {
+        used = append_bytes(line, used, ctx->json, ctx->json_len);
+        if (tls_component_stack.depth > 0) {
+            used = append_format(line, used, "\"component\":\"%s\",",
+                                 tls_component_stack.path);
+        }
     }
+    used = append_format(line, used,
+                         "\"thread_id\":%lu,\"file\":\"%s\",\"line\":%d,\"message\":\"%s\"}",
+                         get_thread_id(), file, line_no, escaped_message);
+    line[used++] = '\n';
     
-    pthread_mutex_unlock(&buf->lock);
+    emit_line(level, line, used);
 }
 
 // ============================================================================
 // PUBLIC API
 // ============================================================================
 
+static void open_binary_output(void) {
+    const char *path = getenv("ROOLE_LOG_BINARY_PATH");
+    if (!path || !*path) path = LOG_BINARY_DEFAULT_PATH;
+    
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    uint8_t header[16];
+    size_t len = log_stream_encode_header(header, sizeof(header));
+    
+    if (fd < 0 || write(fd, header, len) != (ssize_t)len) {
+        fprintf(stderr, "[logger] Cannot write binary log to %s, using deferred text\n", path);
+        if (fd >= 0) close(fd);
+        g_log_format = LOG_FORMAT_DEFERRED;
+        return;
+    }
+    
+    fprintf(stderr, "[logger] Writing binary log to %s (decode with roole-logdecode)\n", path);
+    g_out_fd = fd;
+    g_stream_context = NULL;
+    g_stream_site_count = 0;
+    g_stream_epoch++;
+}
+
 void logger_init(void) {
+    if (__atomic_load_n(&g_writer_running, __ATOMIC_ACQUIRE)) return;
+    
     detect_log_format();  // Check ROOLE_LOG_FORMAT environment variable
+    if (g_log_format == LOG_FORMAT_BINARY) {
+        open_binary_output();
+    }
+    
+    // Kept open for the life of the process: a producer that raced with
+    // logger_shutdown() may still kick it
+    if (g_wake_fd < 0) {
+        g_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (g_wake_fd < 0) {
+            fprintf(stderr, "[logger] eventfd failed, logging synchronously\n");
+            return;
+        }
+    }
     
-    g_shutdown = 0;
-    pthread_create(&g_flush_thread, NULL, flush_thread_fn, NULL);
+    __atomic_store_n(&g_shutdown, 0, __ATOMIC_RELEASE);
+    if (pthread_create(&g_writer_thread, NULL, writer_thread_fn, NULL) != 0) {
+        fprintf(stderr, "[logger] Writer thread failed, logging synchronously\n");
+        return;
+    }
+    __atomic_store_n(&g_writer_running, 1, __ATOMIC_RELEASE);
 }
 
 void logger_shutdown(void) {
-    g_shutdown = 1;
-    pthread_join(g_flush_thread, NULL);
+    if (!__atomic_load_n(&g_writer_running, __ATOMIC_ACQUIRE)) return;
     
-    pthread_mutex_lock(&g_ring_lock);
-    for (size_t i = 0; i < g_ring_count; i++) {
-        flush_buffer(g_ring_buffers[i]);
-        pthread_mutex_destroy(&g_ring_buffers[i]->lock);
-        free(g_ring_buffers[i]);
+    // New lines go straight to stdout from here on
+    __atomic_store_n(&g_writer_running, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_shutdown, 1, __ATOMIC_RELEASE);
+    wake_writer();
+    pthread_join(g_writer_thread, NULL);
+    
+    // Writer is gone, so this thread is now the only consumer. Rings stay
+    // registered (live threads still own theirs) and are reused if the
+    // logger is started again.
+    drain_rings();
+    fflush(stdout);
+    
+    if (g_out_fd != STDOUT_FILENO) {
+        close(g_out_fd);
+        g_out_fd = STDOUT_FILENO;
     }
-    g_ring_count = 0;
-    pthread_mutex_unlock(&g_ring_lock);
 }
 
 void logger_set_level(log_level_t level) {
-    g_log_level = level;
+    pthread_mutex_lock(&g_levels_lock);
+    __atomic_store_n(&g_log_level, level, __ATOMIC_RELAXED);
+    levels_changed_locked();
+    pthread_mutex_unlock(&g_levels_lock);
+}
+
+log_level_t logger_get_level(void) {
+    pthread_mutex_lock(&g_levels_lock);
+    log_level_t level = g_log_level;
+    pthread_mutex_unlock(&g_levels_lock);
+    return level;
+}
+
+int logger_parse_level(const char *name, log_level_t *level) {
+    static const struct { const char *name; log_level_t level; } names[] = {
+        { "debug", LOG_LEVEL_DEBUG }, { "info", LOG_LEVEL_INFO },
+        { "warn", LOG_LEVEL_WARN }, { "warning", LOG_LEVEL_WARN },
+        { "error", LOG_LEVEL_ERROR }
+    };
+    
+    for (size_t i = 0; name && i < sizeof(names) / sizeof(names[0]); i++) {
+        if (strcasecmp(name, names[i].name) == 0) {
+            *level = names[i].level;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int logger_set_component_level(const char *component, log_level_t level) {
+    if (!component || !*component || strlen(component) >= LOG_COMPONENT_NAME_LEN) {
+        return -1;
+    }
+    
+    pthread_mutex_lock(&g_levels_lock);
+    size_t i = 0;
+    while (i < g_component_level_count &&
+           strcmp(g_component_levels[i].component, component) != 0) {
+        i++;
+    }
+    if (i == LOG_MAX_COMPONENT_LEVELS) {
+        pthread_mutex_unlock(&g_levels_lock);
+        return -1;
+    }
+    if (i == g_component_level_count) {
+        snprintf(g_component_levels[i].component, LOG_COMPONENT_NAME_LEN, "%s", component);
+        __atomic_store_n(&g_component_level_count, i + 1, __ATOMIC_RELAXED);
+    }
+    g_component_levels[i].level = level;
+    levels_changed_locked();
+    pthread_mutex_unlock(&g_levels_lock);
+    return 0;
+}
+
+int logger_clear_component_level(const char *component) {
+    int rc = -1;
+    
+    pthread_mutex_lock(&g_levels_lock);
+    for (size_t i = 0; component && i < g_component_level_count; i++) {
+        if (strcmp(g_component_levels[i].component, component) == 0) {
+            size_t last = g_component_level_count - 1;
+            g_component_levels[i] = g_component_levels[last];
+            __atomic_store_n(&g_component_level_count, last, __ATOMIC_RELAXED);
+            levels_changed_locked();
+            rc = 0;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_levels_lock);
+    return rc;
+}
+
+size_t logger_get_component_levels(log_component_level_t *out, size_t max) {
+    pthread_mutex_lock(&g_levels_lock);
+    size_t count = g_component_level_count < max ? g_component_level_count : max;
+    memcpy(out, g_component_levels, count * sizeof(log_component_level_t));
+    pthread_mutex_unlock(&g_levels_lock);
+    return count;
 }
 
 void logger_set_context(uint16_t node_id, const char *cluster_name, const char *node_type) {
-    pthread_mutex_lock(&g_context_lock);
-    g_log_context.node_id = node_id;
-    snprintf(g_log_context.cluster_name, sizeof(g_log_context.cluster_name), 
+    published_context_t *next = calloc(1, sizeof(published_context_t));
+    if (!next) return;
+    
+    next->ctx.node_id = node_id;
+    snprintf(next->ctx.cluster_name, sizeof(next->ctx.cluster_name),
              "%s", cluster_name ? cluster_name : "unknown");
-    snprintf(g_log_context.node_type, sizeof(g_log_context.node_type),
+    snprintf(next->ctx.node_type, sizeof(next->ctx.node_type),
              "%s", node_type ? node_type : "unknown");
-    g_log_context.initialized = 1;
-    pthread_mutex_unlock(&g_context_lock);
+    next->ctx.initialized = 1;
+    
+    // Pre-render the context part of every line once
+    int n = snprintf(next->text, sizeof(next->text), "[node:%u][%s]",
+                     next->ctx.node_id, next->ctx.cluster_name);
+    next->text_len = n > 0 ? (size_t)n : 0;
+    if (next->text_len >= sizeof(next->text)) next->text_len = sizeof(next->text) - 1;
+    
+    char escaped[128];
+    json_escape_string(next->ctx.cluster_name, escaped, sizeof(escaped));
+    n = snprintf(next->json, sizeof(next->json), "\"node_id\":%u,\"cluster\":\"%s\",",
+                 next->ctx.node_id, escaped);
+    next->json_len = n > 0 ? (size_t)n : 0;
+    if (next->json_len >= sizeof(next->json)) next->json_len = sizeof(next->json) - 1;
+    
+    // Readers may still hold the previous version, so it is not freed
+    __atomic_store_n(&g_context, next, __ATOMIC_RELEASE);
 }
 
 void logger_log(log_level_t level, const char *file, int line, const char *fmt, ...) {
-    if (level < g_log_level) return;
+    if (level < effective_level()) return;
     
     va_list args;
     va_start(args, fmt);
@@ -411,9 +1057,70 @@ void logger_log(log_level_t level, const char *file, int line, const char *fmt,
     va_end(args);
 }
 
+void logger_log_site(log_site_t *site, const char *fmt, ...) {
+    if (site->level < effective_level()) return;
+    
+    va_list args;
+    va_start(args, fmt);
+    
+    log_ring_t *ring = NULL;
+    if (RECORD_MODE(g_log_format) && site->level != LOG_LEVEL_ERROR &&
+        __atomic_load_n(&g_writer_running, __ATOMIC_ACQUIRE)) {
+        ring = get_tls_ring();
+    }
+    
+    if (ring && site_prepare(site, fmt)) {
+        record_site(ring, site, fmt, &args);
+    } else if (g_log_format == LOG_FORMAT_JSON) {
+        logger_log_json(site->level, site->file, site->line, fmt, args);
+    } else {
+        logger_log_text(site->level, site->file, site->line, fmt, args);
+    }
+    
+    va_end(args);
+}
+
+int logger_ratelimit_allow(log_ratelimit_t *limit, const log_site_t *site) {
+    // Filtered messages neither spend tokens nor count as suppressed
+    if (site->level < effective_level()) return 0;
+    
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    uint64_t now = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    
+    uint64_t tat = __atomic_load_n(&limit->tat_ns, __ATOMIC_RELAXED);
+    for (;;) {
+        if (tat > now + limit->tolerance_ns) {
+            __atomic_fetch_add(&limit->suppressed, 1, __ATOMIC_RELAXED);
+            return 0;
+        }
+        uint64_t next = (tat > now ? tat : now) + limit->interval_ns;
+        if (__atomic_compare_exchange_n(&limit->tat_ns, &tat, next, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    
+    uint64_t dropped = __atomic_exchange_n(&limit->suppressed, 0, __ATOMIC_RELAXED);
+    if (dropped > 0) {
+        logger_log(site->level, site->file, site->line,
+                   "%llu similar messages suppressed", (unsigned long long)dropped);
+    }
+    return 1;
+}
+
 void logger_flush(void) {
-    log_buffer_t *buf = get_tls_buffer();
-    flush_buffer(buf);
+    log_ring_t *ring = tls_ring;
+    if (!ring || !__atomic_load_n(&g_writer_running, __ATOMIC_ACQUIRE)) return;
+    
+    // Only the writer may consume the ring; wait for it to catch up
+    uint64_t target = ring->head;
+    for (int i = 0; i < 1000; i++) {
+        if (__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= target) return;
+        wake_writer();
+        struct timespec ts = { 0, 1000000 };
+        nanosleep(&ts, NULL);
+    }
 }
 
 void logger_push_component(const char *component_name) {
@@ -421,11 +1128,15 @@ void logger_push_component(const char *component_name) {
         snprintf(tls_component_stack.components[tls_component_stack.depth], 32,
                 "%s", component_name);
         tls_component_stack.depth++;
+        tls_component_stack.level_generation = 0;
+        rebuild_component_path();
     }
 }
 
 void logger_pop_component(void) {
     if (tls_component_stack.depth > 0) {
         tls_component_stack.depth--;
+        tls_component_stack.level_generation = 0;
+        rebuild_component_path();
     }
-}
\ No newline at end of file
+}
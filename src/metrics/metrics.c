@@ -11,7 +11,113 @@
 #include <string.h>
 #include <stdio.h>
 #include <pthread.h>
+#include <stdarg.h>
 
+// Shard assigned to the calling thread on its first update
+static __thread int tls_shard = -1;
+static int g_next_shard = 0;
+
+// ============================================================================
+// HASH INDEX
+// ============================================================================
+
+// Open-addressing table of (hash, item) pairs, probed without a lock.
+// Writers hold the owner's lock. A slot's hash is written before its item
+// is published with a release store, and slots are never cleared, so a
+// reader sees either an empty slot or a complete one. Growth publishes a
+// new table and keeps the old one on the retired list until destroy, since
+// readers may still be probing it; a stale miss just takes the locked path.
+typedef struct metric_index_slot {
+    uint64_t hash;
+    void *item;
+} metric_index_slot_t;
+
+typedef struct metric_index {
+    size_t size;                        // Power of two
+    size_t used;
+    struct metric_index *retired;       // Previous, smaller table
+    metric_index_slot_t slots[];
+} metric_index_t;
+
+#define METRIC_INDEX_INITIAL_SIZE 16
+
+typedef int (*index_match_fn)(const void *item, const void *key);
+
+static metric_index_t* index_create(size_t size) {
+    metric_index_t *index = calloc(1, sizeof(metric_index_t) +
+                                      size * sizeof(metric_index_slot_t));
+    if (index) index->size = size;
+    return index;
+}
+
+static void index_destroy(metric_index_t *index) {
+    while (index) {
+        metric_index_t *retired = index->retired;
+        free(index);
+        index = retired;
+    }
+}
+
+static void* index_find(metric_index_t *const *table, uint64_t hash,
+                        index_match_fn match, const void *key) {
+    const metric_index_t *index = __atomic_load_n(table, __ATOMIC_ACQUIRE);
+    size_t mask = index->size - 1;
+    
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        void *item = __atomic_load_n(&index->slots[i].item, __ATOMIC_ACQUIRE);
+        if (!item) return NULL;
+        if (index->slots[i].hash == hash && match(item, key)) return item;
+    }
+}
+
+static void index_place(metric_index_t *index, uint64_t hash, void *item) {
+    size_t mask = index->size - 1;
+    size_t i = hash & mask;
+    while (index->slots[i].item) {
+        i = (i + 1) & mask;
+    }
+    index->slots[i].hash = hash;
+    __atomic_store_n(&index->slots[i].item, item, __ATOMIC_RELEASE);
+    index->used++;
+}
+
+// Caller holds the owner's lock
+static int index_insert(metric_index_t **table, uint64_t hash, void *item) {
+    metric_index_t *index = *table;
+    
+    // Keep the load factor under 3/4 so probes stay short
+    if ((index->used + 1) * 4 > index->size * 3) {
+        metric_index_t *grown = index_create(index->size * 2);
+        if (!grown) return -1;
+        
+        for (size_t i = 0; i < index->size; i++) {
+            if (index->slots[i].item) {
+                index_place(grown, index->slots[i].hash, index->slots[i].item);
+            }
+        }
+        grown->retired = index;
+        __atomic_store_n(table, grown, __ATOMIC_RELEASE);
+        index = grown;
+    }
+    
+    index_place(index, hash, item);
+    return 0;
+}
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+// FNV-1a over at most max - 1 bytes, the part safe_strncpy() keeps
+static uint64_t fnv1a_append(uint64_t hash, const char *s, size_t max) {
+    for (size_t i = 0; s && s[i] && i + 1 < max; i++) {
+        hash ^= (unsigned char)s[i];
+        hash *= FNV_PRIME;
+    }
+    // Separator so ("ab", "c") and ("a", "bc") differ
+    hash ^= 0xff;
+    hash *= FNV_PRIME;
+    return hash;
+}
 
 // ============================================================================
 // REGISTRY MANAGEMENT
@@ -24,152 +130,320 @@ metrics_registry_t* metrics_registry_init(void) {
         return NULL;
     }
     
+    reg->index = index_create(METRIC_INDEX_INITIAL_SIZE);
+    if (!reg->index) {
+        LOG_ERROR("Failed to allocate metrics index");
+        free(reg);
+        return NULL;
+    }
+    
     if (pthread_mutex_init(&reg->lock, NULL) != 0) {
         LOG_ERROR("Failed to initialize registry mutex");
+        index_destroy(reg->index);
         free(reg);
         return NULL;
     }
+    pthread_mutex_init(&reg->render_lock, NULL);
     
-    reg->count = 0;
+    reg->cache_ttl_ms = METRICS_RENDER_CACHE_TTL_MS;
     
     LOG_INFO("Metrics registry initialized");
     return reg;
 }
 
+static void series_free(metric_family_t *family, metric_series_t *series) {
+    if (family->type == METRIC_TYPE_HISTOGRAM) {
+        free(((histogram_metric_t*)series)->shards);
+    } else {
+        free(((metrics_t*)series)->shards);
+    }
+    free(series);
+}
+
 void metrics_registry_destroy(metrics_registry_t *reg) {
     if (!reg) return;
     
     pthread_mutex_lock(&reg->lock);
     
-    // Destroy all metric mutexes
-    for (size_t i = 0; i < MAX_METRICS_PER_REGISTRY; i++) {
-        if (reg->metrics[i].active) {
-            pthread_mutex_destroy(&reg->metrics[i].lock);
+    metric_family_t *family = reg->first;
+    while (family) {
+        metric_family_t *next_family = family->next;
+        
+        metric_series_t *series = family->first;
+        while (series) {
+            metric_series_t *next = series->next;
+            series_free(family, series);
+            series = next;
         }
+        
+        index_destroy(family->index);
+        pthread_mutex_destroy(&family->lock);
+        free(family);
+        family = next_family;
     }
+    index_destroy(reg->index);
     
     pthread_mutex_unlock(&reg->lock);
     pthread_mutex_destroy(&reg->lock);
     
+    metrics_text_release(reg->cached_text);
+    pthread_mutex_destroy(&reg->render_lock);
+    
     free(reg);
     LOG_INFO("Metrics registry destroyed");
 }
 
 // ============================================================================
-// HELPER: Generate metric key for lookup
+// FAMILY AND SERIES LOOKUP
 // ============================================================================
 
-static void generate_metric_key(char *key_buf, size_t key_buf_size,
-                                const char *name,
-                                size_t num_labels,
-                                const metric_label_t *labels) {
-    snprintf(key_buf, key_buf_size, "%s", name);
-    
-    // Append sorted labels to create unique key
-    for (size_t i = 0; i < num_labels; i++) {
-        size_t current_len = strlen(key_buf);
-        snprintf(key_buf + current_len, key_buf_size - current_len,
-                "_%s=%s", labels[i].name, labels[i].value);
+static const char* type_name(metric_type_t type) {
+    switch (type) {
+        case METRIC_TYPE_COUNTER: return "counter";
+        case METRIC_TYPE_GAUGE: return "gauge";
+        case METRIC_TYPE_HISTOGRAM: return "histogram";
     }
+    return "untyped";
 }
 
-// ============================================================================
-// METRIC CREATION
-// ============================================================================
+static int family_matches(const void *item, const void *key) {
+    const metric_family_t *family = item;
+    return strncmp(family->name, key, MAX_METRIC_NAME_LEN - 1) == 0;
+}
 
-static metrics_t* find_or_create_metric(metrics_registry_t *reg,
-                                        const char *name,
-                                        const char *help,
-                                        metric_type_t type,
-                                        size_t num_labels,
-                                        const metric_label_t *labels) {
-    if (!reg || !name || !help) return NULL;
+// Labels being looked up: either name/value pairs, or a vector's bound
+// names plus caller-supplied values
+typedef struct label_key {
+    size_t count;
+    const metric_label_t *labels;
+    const char (*names)[MAX_LABEL_NAME_LEN];
+    const char *const *values;
+} label_key_t;
+
+static const char* key_name(const label_key_t *key, size_t i) {
+    return key->labels ? key->labels[i].name : key->names[i];
+}
+
+static const char* key_value(const label_key_t *key, size_t i) {
+    const char *value = key->labels ? key->labels[i].value : key->values[i];
+    return value ? value : "";
+}
+
+static uint64_t hash_labels(const label_key_t *key) {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < key->count; i++) {
+        hash = fnv1a_append(hash, key_name(key, i), MAX_LABEL_NAME_LEN);
+        hash = fnv1a_append(hash, key_value(key, i), MAX_LABEL_VALUE_LEN);
+    }
+    return hash;
+}
+
+static int series_matches(const void *item, const void *key_ptr) {
+    const metric_series_t *series = item;
+    const label_key_t *key = key_ptr;
     
-    if (num_labels > MAX_LABELS_PER_METRIC) {
-        LOG_ERROR("Too many labels: %zu (max: %d)", num_labels, MAX_LABELS_PER_METRIC);
+    if (series->num_labels != key->count) return 0;
+    for (size_t i = 0; i < key->count; i++) {
+        if (strncmp(series->labels[i].name, key_name(key, i), MAX_LABEL_NAME_LEN - 1) != 0 ||
+            strncmp(series->labels[i].value, key_value(key, i), MAX_LABEL_VALUE_LEN - 1) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// A family created as a vector must be requested with the same label names
+static int family_labels_match(const metric_family_t *family, size_t num_label_names,
+                               const char *const *label_names) {
+    if (!label_names) return 1;
+    if (family->num_label_names != num_label_names) return 0;
+    for (size_t i = 0; i < num_label_names; i++) {
+        if (strncmp(family->label_names[i], label_names[i], MAX_LABEL_NAME_LEN - 1) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static metric_family_t* check_family(metric_family_t *family, metric_type_t type,
+                                     size_t num_label_names,
+                                     const char *const *label_names) {
+    if (family->type != type) {
+        LOG_ERROR("Metric %s already registered as %s, not %s",
+                  family->name, type_name(family->type), type_name(type));
+        return NULL;
+    }
+    if (!family_labels_match(family, num_label_names, label_names)) {
+        LOG_ERROR("Metric %s already registered with other label names", family->name);
         return NULL;
     }
+    return family;
+}
+
+static metric_family_t* find_or_create_family(metrics_registry_t *reg,
+                                              const char *name,
+                                              const char *help,
+                                              metric_type_t type,
+                                              histogram_buckets_type_t buckets_type,
+                                              size_t num_label_names,
+                                              const char *const *label_names) {
+    uint64_t hash = fnv1a_append(FNV_OFFSET_BASIS, name, MAX_METRIC_NAME_LEN);
     
-    char metric_key[512];
-    generate_metric_key(metric_key, sizeof(metric_key), name, num_labels, labels);
+    metric_family_t *family = index_find(&reg->index, hash, family_matches, name);
+    if (family) {
+        return check_family(family, type, num_label_names, label_names);
+    }
     
     pthread_mutex_lock(&reg->lock);
     
-    // Search for existing metric
-    for (size_t i = 0; i < MAX_METRICS_PER_REGISTRY; i++) {
-        if (!reg->metrics[i].active) continue;
-        
-        // Check if name matches
-        if (strcmp(reg->metrics[i].name, name) != 0) continue;
-        
-        // Check if labels match
-        if (reg->metrics[i].num_labels != num_labels) continue;
-        
-        int labels_match = 1;
-        for (size_t j = 0; j < num_labels; j++) {
-            if (strcmp(reg->metrics[i].labels[j].name, labels[j].name) != 0 ||
-                strcmp(reg->metrics[i].labels[j].value, labels[j].value) != 0) {
-                labels_match = 0;
-                break;
-            }
-        }
-        
-        if (labels_match) {
-            pthread_mutex_unlock(&reg->lock);
-            return &reg->metrics[i];
-        }
+    // Someone may have created it since the lock-free probe
+    family = index_find(&reg->index, hash, family_matches, name);
+    if (family) {
+        pthread_mutex_unlock(&reg->lock);
+        return check_family(family, type, num_label_names, label_names);
     }
     
-    // Not found, create new metric
-    if (reg->count >= MAX_METRICS_PER_REGISTRY) {
+    family = calloc(1, sizeof(metric_family_t));
+    if (!family || !(family->index = index_create(METRIC_INDEX_INITIAL_SIZE))) {
+        free(family);
         pthread_mutex_unlock(&reg->lock);
-        LOG_ERROR("Metrics registry full");
+        LOG_ERROR("Failed to allocate metric family %s", name);
         return NULL;
     }
     
-    // Find free slot
-    size_t slot = SIZE_MAX;
-    for (size_t i = 0; i < MAX_METRICS_PER_REGISTRY; i++) {
-        if (!reg->metrics[i].active) {
-            slot = i;
-            break;
+    safe_strncpy(family->name, name, MAX_METRIC_NAME_LEN);
+    safe_strncpy(family->help, help ? help : "", MAX_METRIC_HELP_LEN);
+    family->type = type;
+    family->buckets_type = buckets_type;
+    family->hash = hash;
+    if (label_names) {
+        family->num_label_names = num_label_names;
+        for (size_t i = 0; i < num_label_names; i++) {
+            safe_strncpy(family->label_names[i], label_names[i], MAX_LABEL_NAME_LEN);
         }
     }
+    pthread_mutex_init(&family->lock, NULL);
     
-    if (slot == SIZE_MAX) {
+    if (index_insert(&reg->index, hash, family) != 0) {
+        index_destroy(family->index);
+        pthread_mutex_destroy(&family->lock);
+        free(family);
         pthread_mutex_unlock(&reg->lock);
+        LOG_ERROR("Failed to grow metrics index");
         return NULL;
     }
     
-    metrics_t *m = &reg->metrics[slot];
-    memset(m, 0, sizeof(metrics_t));
+    // Published to render_text()
+    if (reg->last) {
+        __atomic_store_n(&reg->last->next, family, __ATOMIC_RELEASE);
+    } else {
+        __atomic_store_n(&reg->first, family, __ATOMIC_RELEASE);
+    }
+    reg->last = family;
     
-    safe_strncpy(m->name, name, MAX_METRIC_NAME_LEN);
-    safe_strncpy(m->help, help, MAX_METRIC_HELP_LEN);
-    m->type = type;
-    m->value = 0.0;
-    m->num_labels = num_labels;
+    pthread_mutex_unlock(&reg->lock);
     
-    for (size_t i = 0; i < num_labels; i++) {
-        safe_strncpy(m->labels[i].name, labels[i].name, MAX_LABEL_NAME_LEN);
-        safe_strncpy(m->labels[i].value, labels[i].value, MAX_LABEL_VALUE_LEN);
+    LOG_DEBUG("Created new %s metric: %s", type_name(type), name);
+    return family;
+}
+
+static metric_series_t* create_series(metric_family_t *family) {
+    if (family->type == METRIC_TYPE_HISTOGRAM) {
+        histogram_metric_t *h = calloc(1, sizeof(histogram_metric_t));
+        if (!h) return NULL;
+        if (posix_memalign((void**)&h->shards, 64,
+                           HISTOGRAM_SHARDS * sizeof(histogram_shard_t)) != 0) {
+            free(h);
+            return NULL;
+        }
+        memset(h->shards, 0, HISTOGRAM_SHARDS * sizeof(histogram_shard_t));
+        h->buckets = metrics_get_buckets(family->buckets_type);
+        return &h->series;
     }
     
-    if (pthread_mutex_init(&m->lock, NULL) != 0) {
-        pthread_mutex_unlock(&reg->lock);
-        LOG_ERROR("Failed to initialize metric mutex");
+    metrics_t *m = calloc(1, sizeof(metrics_t));
+    if (!m) return NULL;
+    if (posix_memalign((void**)&m->shards, 64,
+                       METRICS_SHARDS * sizeof(metric_shard_t)) != 0) {
+        free(m);
         return NULL;
     }
+    memset(m->shards, 0, METRICS_SHARDS * sizeof(metric_shard_t));
+    return &m->series;
+}
+
+static metric_series_t* find_or_create_series(metric_family_t *family,
+                                              const label_key_t *key) {
+    uint64_t hash = hash_labels(key);
     
-    m->active = 1;
-    reg->count++;
+    metric_series_t *series = index_find(&family->index, hash, series_matches, key);
+    if (series) return series;
     
-    pthread_mutex_unlock(&reg->lock);
+    pthread_mutex_lock(&family->lock);
+    
+    series = index_find(&family->index, hash, series_matches, key);
+    if (series) {
+        pthread_mutex_unlock(&family->lock);
+        return series;
+    }
+    
+    series = create_series(family);
+    if (!series) {
+        pthread_mutex_unlock(&family->lock);
+        LOG_ERROR("Failed to allocate metric %s", family->name);
+        return NULL;
+    }
+    
+    series->family = family;
+    series->hash = hash;
+    series->num_labels = key->count;
+    for (size_t i = 0; i < key->count; i++) {
+        safe_strncpy(series->labels[i].name, key_name(key, i), MAX_LABEL_NAME_LEN);
+        safe_strncpy(series->labels[i].value, key_value(key, i), MAX_LABEL_VALUE_LEN);
+    }
     
-    LOG_DEBUG("Created new %s metric: %s", 
-              type == METRIC_TYPE_COUNTER ? "counter" : "gauge", name);
+    if (index_insert(&family->index, hash, series) != 0) {
+        series_free(family, series);
+        pthread_mutex_unlock(&family->lock);
+        LOG_ERROR("Failed to grow index of metric %s", family->name);
+        return NULL;
+    }
+    
+    if (family->last) {
+        __atomic_store_n(&family->last->next, series, __ATOMIC_RELEASE);
+    } else {
+        __atomic_store_n(&family->first, series, __ATOMIC_RELEASE);
+    }
+    family->last = series;
     
-    return m;
+    pthread_mutex_unlock(&family->lock);
+    return series;
+}
+
+// ============================================================================
+// METRIC CREATION
+// ============================================================================
+
+static metric_series_t* find_or_create_metric(metrics_registry_t *reg,
+                                              const char *name,
+                                              const char *help,
+                                              metric_type_t type,
+                                              histogram_buckets_type_t buckets_type,
+                                              size_t num_labels,
+                                              const metric_label_t *labels) {
+    if (!reg || !name) return NULL;
+    
+    if (num_labels > MAX_LABELS_PER_METRIC || (num_labels > 0 && !labels)) {
+        LOG_ERROR("Invalid labels: %zu (max: %d)", num_labels, MAX_LABELS_PER_METRIC);
+        return NULL;
+    }
+    
+    metric_family_t *family = find_or_create_family(reg, name, help, type, buckets_type,
+                                                    0, NULL);
+    if (!family) return NULL;
+    
+    label_key_t key = { .count = num_labels, .labels = labels };
+    return find_or_create_series(family, &key);
 }
 
 metrics_t* metrics_get_or_create_counter(metrics_registry_t *reg,
@@ -177,7 +451,8 @@ metrics_t* metrics_get_or_create_counter(metrics_registry_t *reg,
                                           const char *help,
                                           size_t num_labels,
                                           const metric_label_t *labels) {
-    return find_or_create_metric(reg, name, help, METRIC_TYPE_COUNTER, num_labels, labels);
+    return (metrics_t*)find_or_create_metric(reg, name, help, METRIC_TYPE_COUNTER,
+                                             HISTOGRAM_BUCKETS_CUSTOM, num_labels, labels);
 }
 
 metrics_t* metrics_get_or_create_gauge(metrics_registry_t *reg,
@@ -185,383 +460,653 @@ metrics_t* metrics_get_or_create_gauge(metrics_registry_t *reg,
                                         const char *help,
                                         size_t num_labels,
                                         const metric_label_t *labels) {
-    return find_or_create_metric(reg, name, help, METRIC_TYPE_GAUGE, num_labels, labels);
+    return (metrics_t*)find_or_create_metric(reg, name, help, METRIC_TYPE_GAUGE,
+                                             HISTOGRAM_BUCKETS_CUSTOM, num_labels, labels);
 }
 
+histogram_metric_t* metrics_get_or_create_histogram(
+    metrics_registry_t *reg,
+    const char *name,
+    const char *help,
+    histogram_buckets_type_t buckets_type,
+    size_t num_labels,
+    const metric_label_t *labels) {
+    
+    return (histogram_metric_t*)find_or_create_metric(reg, name, help, METRIC_TYPE_HISTOGRAM,
+                                                      buckets_type, num_labels, labels);
+}
+
+// ============================================================================
+// METRIC VECTORS
+// ============================================================================
+
+static metrics_vec_t* create_vec(metrics_registry_t *reg, const char *name,
+                                 const char *help, metric_type_t type,
+                                 histogram_buckets_type_t buckets_type,
+                                 size_t num_labels, const char *const *label_names) {
+    if (!reg || !name || !label_names || num_labels > MAX_LABELS_PER_METRIC) {
+        return NULL;
+    }
+    return find_or_create_family(reg, name, help, type, buckets_type,
+                                 num_labels, label_names);
+}
+
+metrics_vec_t* metrics_counter_vec(metrics_registry_t *reg, const char *name,
+                                   const char *help, size_t num_labels,
+                                   const char *const *label_names) {
+    return create_vec(reg, name, help, METRIC_TYPE_COUNTER, HISTOGRAM_BUCKETS_CUSTOM,
+                      num_labels, label_names);
+}
+
+metrics_vec_t* metrics_gauge_vec(metrics_registry_t *reg, const char *name,
+                                 const char *help, size_t num_labels,
+                                 const char *const *label_names) {
+    return create_vec(reg, name, help, METRIC_TYPE_GAUGE, HISTOGRAM_BUCKETS_CUSTOM,
+                      num_labels, label_names);
+}
+
+metrics_vec_t* metrics_histogram_vec(metrics_registry_t *reg, const char *name,
+                                     const char *help,
+                                     histogram_buckets_type_t buckets_type,
+                                     size_t num_labels,
+                                     const char *const *label_names) {
+    return create_vec(reg, name, help, METRIC_TYPE_HISTOGRAM, buckets_type,
+                      num_labels, label_names);
+}
+
+static metric_series_t* vec_with(metrics_vec_t *vec, const char *const *label_values) {
+    if (!vec || (vec->num_label_names > 0 && !label_values)) return NULL;
+    
+    label_key_t key = {
+        .count = vec->num_label_names,
+        .names = (const char (*)[MAX_LABEL_NAME_LEN])vec->label_names,
+        .values = label_values
+    };
+    return find_or_create_series(vec, &key);
+}
+
+metrics_t* metrics_vec_with(metrics_vec_t *vec, const char *const *label_values) {
+    if (vec && vec->type == METRIC_TYPE_HISTOGRAM) return NULL;
+    return (metrics_t*)vec_with(vec, label_values);
+}
+
+histogram_metric_t* metrics_vec_histogram_with(metrics_vec_t *vec,
+                                               const char *const *label_values) {
+    if (vec && vec->type != METRIC_TYPE_HISTOGRAM) return NULL;
+    return (histogram_metric_t*)vec_with(vec, label_values);
+}
 // ============================================================================
 // METRIC OPERATIONS
 // ============================================================================
 
+static metric_shard_t* local_shard(metrics_t *metric) {
+    if (tls_shard < 0) {
+        tls_shard = __atomic_fetch_add(&g_next_shard, 1, __ATOMIC_RELAXED) % METRICS_SHARDS;
+    }
+    return &metric->shards[tls_shard];
+}
+
+static void shard_add(metrics_t *metric, double val) {
+    metric_shard_t *shard = local_shard(metric);
+    
+    // Whole numbers (the common case) take the plain atomic add
+    if (val == (double)(int64_t)val) {
+        __atomic_fetch_add(&shard->steps, (int64_t)val, __ATOMIC_RELAXED);
+        return;
+    }
+    
+    double expected, desired;
+    __atomic_load(&shard->amount, &expected, __ATOMIC_RELAXED);
+    do {
+        desired = expected + val;
+    } while (!__atomic_compare_exchange(&shard->amount, &expected, &desired, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+static double shards_total(const metrics_t *metric) {
+    int64_t steps = 0;
+    double amount = 0.0;
+    for (int i = 0; i < METRICS_SHARDS; i++) {
+        double a;
+        steps += __atomic_load_n(&metric->shards[i].steps, __ATOMIC_RELAXED);
+        __atomic_load(&metric->shards[i].amount, &a, __ATOMIC_RELAXED);
+        amount += a;
+    }
+    return (double)steps + amount;
+}
+
 void metrics_counter_inc(metrics_t *metric) {
     if (!metric) return;
-    pthread_mutex_lock(&metric->lock);
-    metric->value += 1.0;
-    pthread_mutex_unlock(&metric->lock);
+    __atomic_fetch_add(&local_shard(metric)->steps, 1, __ATOMIC_RELAXED);
 }
 
 void metrics_counter_add(metrics_t *metric, double val) {
     if (!metric || val < 0.0) return;
-    pthread_mutex_lock(&metric->lock);
-    metric->value += val;
-    pthread_mutex_unlock(&metric->lock);
+    shard_add(metric, val);
 }
 
 void metrics_gauge_set(metrics_t *metric, double val) {
     if (!metric) return;
-    pthread_mutex_lock(&metric->lock);
-    metric->value = val;
-    pthread_mutex_unlock(&metric->lock);
+    // Concurrent inc/dec land either before or after the set, never lost
+    double base = val - shards_total(metric);
+    __atomic_store(&metric->base, &base, __ATOMIC_RELAXED);
+}
+
+void metrics_counter_set(metrics_t *metric, double val) {
+    if (!metric) return;
+    double base = val - shards_total(metric);
+    __atomic_store(&metric->base, &base, __ATOMIC_RELAXED);
 }
 
 void metrics_gauge_inc(metrics_t *metric) {
     if (!metric) return;
-    pthread_mutex_lock(&metric->lock);
-    metric->value += 1.0;
-    pthread_mutex_unlock(&metric->lock);
+    __atomic_fetch_add(&local_shard(metric)->steps, 1, __ATOMIC_RELAXED);
 }
 
 void metrics_gauge_dec(metrics_t *metric) {
     if (!metric) return;
-    pthread_mutex_lock(&metric->lock);
-    metric->value -= 1.0;
-    pthread_mutex_unlock(&metric->lock);
+    __atomic_fetch_sub(&local_shard(metric)->steps, 1, __ATOMIC_RELAXED);
+}
+
+double metrics_get_value(const metrics_t *metric) {
+    if (!metric) return 0.0;
+    double base;
+    __atomic_load(&metric->base, &base, __ATOMIC_RELAXED);
+    return base + shards_total(metric);
 }
 
 // ============================================================================
-// PROMETHEUS TEXT FORMAT RENDERING
+// RENDER OUTPUT
 // ============================================================================
 
-char* metrics_registry_render_prometheus(metrics_registry_t *reg) {
-    if (!reg) return NULL;
-    
-    // Allocate large buffer for output
-    size_t buffer_size = 65536;  // 64KB should be enough
-    char *buffer = malloc(buffer_size);
-    if (!buffer) {
-        LOG_ERROR("Failed to allocate render buffer");
-        return NULL;
+// Output grows by appending chunks, so rendering never truncates and
+// never copies what was already written
+typedef struct metrics_chunk {
+    struct metrics_chunk *next;
+    size_t len;
+    size_t cap;
+    char data[];
+} metrics_chunk_t;
+
+struct metrics_text {
+    metrics_chunk_t *head;
+    metrics_chunk_t *tail;
+    size_t length;
+    int refs;
+    int failed;                 // An allocation failed; output is incomplete
+};
+
+static metrics_text_t* text_create(void) {
+    metrics_text_t *text = calloc(1, sizeof(metrics_text_t));
+    if (text) text->refs = 1;
+    return text;
+}
+
+static void text_free(metrics_text_t *text) {
+    metrics_chunk_t *chunk = text->head;
+    while (chunk) {
+        metrics_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
     }
+    free(text);
+}
+
+static void text_printf(metrics_text_t *text, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void text_printf(metrics_text_t *text, const char *fmt, ...) {
+    if (text->failed) return;
     
-    buffer[0] = '\0';
-    size_t offset = 0;
-    
-    pthread_mutex_lock(&reg->lock);
+    metrics_chunk_t *chunk = text->tail;
+    size_t room = chunk ? chunk->cap - chunk->len : 0;
     
-    // ========================================================================
-    // RENDER COUNTER/GAUGE METRICS
-    // ========================================================================
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(chunk ? chunk->data + chunk->len : NULL, room, fmt, args);
+    va_end(args);
+    if (n < 0) return;
     
-    for (size_t i = 0; i < MAX_METRICS_PER_REGISTRY; i++) {
-        if (!reg->metrics[i].active) continue;
-        
-        metrics_t *m = &reg->metrics[i];
-        pthread_mutex_lock(&m->lock);
-        
-        if (offset + 512 >= buffer_size) {
-            LOG_WARN("Metrics buffer full, truncating output");
-            pthread_mutex_unlock(&m->lock);
-            break;
+    if ((size_t)n >= room) {
+        // Didn't fit: format again into a fresh chunk
+        size_t cap = (size_t)n + 1 > METRICS_RENDER_CHUNK_SIZE ?
+                     (size_t)n + 1 : METRICS_RENDER_CHUNK_SIZE;
+        chunk = malloc(sizeof(metrics_chunk_t) + cap);
+        if (!chunk) {
+            text->failed = 1;
+            return;
         }
-        
-        // HELP
-        int written = snprintf(buffer + offset, buffer_size - offset,
-                              "# HELP %s %s\n", m->name, m->help);
-        if (written < 0 || (size_t)written >= buffer_size - offset) {
-            pthread_mutex_unlock(&m->lock);
-            break;
+        chunk->next = NULL;
+        chunk->len = 0;
+        chunk->cap = cap;
+        if (text->tail) {
+            text->tail->next = chunk;
+        } else {
+            text->head = chunk;
         }
-        offset += written;
+        text->tail = chunk;
         
-        // TYPE
-        written = snprintf(buffer + offset, buffer_size - offset,
-                          "# TYPE %s %s\n",
-                          m->name,
-                          m->type == METRIC_TYPE_COUNTER ? "counter" : "gauge");
-        if (written < 0 || (size_t)written >= buffer_size - offset) {
-            pthread_mutex_unlock(&m->lock);
-            break;
-        }
-        offset += written;
-        
-        // Metric name
-        written = snprintf(buffer + offset, buffer_size - offset, "%s", m->name);
-        if (written < 0 || (size_t)written >= buffer_size - offset) {
-            pthread_mutex_unlock(&m->lock);
-            break;
-        }
-        offset += written;
+        va_start(args, fmt);
+        vsnprintf(chunk->data, cap, fmt, args);
+        va_end(args);
+    }
+    
+    chunk->len += (size_t)n;
+    text->length += (size_t)n;
+}
+
+void metrics_text_release(metrics_text_t *text) {
+    if (text && __atomic_sub_fetch(&text->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        text_free(text);
+    }
+}
+
+size_t metrics_text_length(const metrics_text_t *text) {
+    return text ? text->length : 0;
+}
+
+const char* metrics_text_next_chunk(const metrics_text_t *text, const void **cursor,
+                                    size_t *len) {
+    if (!text || !cursor) return NULL;
+    
+    const metrics_chunk_t *chunk = *cursor ?
+        ((const metrics_chunk_t*)*cursor)->next : text->head;
+    *cursor = chunk;
+    if (!chunk) return NULL;
+    
+    if (len) *len = chunk->len;
+    return chunk->data;
+}
+
+// ============================================================================
+// PROMETHEUS TEXT FORMAT RENDERING
+// ============================================================================
+
+// name="value",... with \, " and newlines escaped in values
+static void format_labels(char *out, size_t out_size,
+                          const metric_label_t *labels, size_t num_labels) {
+    size_t pos = 0;
+    out[0] = '\0';
+    
+    for (size_t i = 0; i < num_labels && pos + 1 < out_size; i++) {
+        int n = snprintf(out + pos, out_size - pos, "%s%s=\"",
+                         i > 0 ? "," : "", labels[i].name);
+        if (n < 0 || (size_t)n >= out_size - pos) break;
+        pos += (size_t)n;
         
-        // Labels
-        if (m->num_labels > 0) {
-            written = snprintf(buffer + offset, buffer_size - offset, "{");
-            if (written < 0 || (size_t)written >= buffer_size - offset) {
-                pthread_mutex_unlock(&m->lock);
-                break;
-            }
-            offset += written;
-            
-            for (size_t j = 0; j < m->num_labels; j++) {
-                written = snprintf(buffer + offset, buffer_size - offset,
-                                  "%s%s=\"%s\"",
-                                  j > 0 ? "," : "",
-                                  m->labels[j].name,
-                                  m->labels[j].value);
-                if (written < 0 || (size_t)written >= buffer_size - offset) {
-                    pthread_mutex_unlock(&m->lock);
-                    goto done;
-                }
-                offset += written;
-            }
-            
-            written = snprintf(buffer + offset, buffer_size - offset, "}");
-            if (written < 0 || (size_t)written >= buffer_size - offset) {
-                pthread_mutex_unlock(&m->lock);
-                break;
+        for (const char *v = labels[i].value; *v && pos + 3 < out_size; v++) {
+            if (*v == '\\' || *v == '"') {
+                out[pos++] = '\\';
+                out[pos++] = *v;
+            } else if (*v == '\n') {
+                out[pos++] = '\\';
+                out[pos++] = 'n';
+            } else {
+                out[pos++] = *v;
             }
-            offset += written;
         }
-        
-        // Value
-        written = snprintf(buffer + offset, buffer_size - offset,
-                          " %.0f\n", m->value);
-        if (written < 0 || (size_t)written >= buffer_size - offset) {
-            pthread_mutex_unlock(&m->lock);
-            break;
-        }
-        offset += written;
-        
-        pthread_mutex_unlock(&m->lock);
+        if (pos + 2 > out_size) break;
+        out[pos++] = '"';
+        out[pos] = '\0';
     }
+}
+
+#define LABEL_TEXT_SIZE (MAX_LABELS_PER_METRIC * (MAX_LABEL_NAME_LEN + 2 * MAX_LABEL_VALUE_LEN + 4))
+
+static void render_metric(metrics_text_t *text, const metrics_t *m) {
+    const metric_series_t *s = &m->series;
+    char label_str[LABEL_TEXT_SIZE];
+    format_labels(label_str, sizeof(label_str), s->labels, s->num_labels);
     
-    // ========================================================================
-    // RENDER HISTOGRAM METRICS (FIXED)
-    // ========================================================================
+    text_printf(text, "%s%s%s%s %.0f\n", s->family->name,
+                s->num_labels > 0 ? "{" : "", label_str, s->num_labels > 0 ? "}" : "",
+                metrics_get_value(m));
+}
+
+// Buckets, sum and count go to text; the precomputed quantiles to
+// quantiles, which is appended once every series of the family is done
+static void render_histogram(metrics_text_t *text, metrics_text_t *quantiles,
+                             const histogram_metric_t *h, histogram_snapshot_t *snap) {
+    metrics_histogram_snapshot(h, snap);
     
-    LOG_DEBUG("Rendering %zu histograms", reg->histogram_count);
+    const char *name = h->series.family->name;
+    char label_str[LABEL_TEXT_SIZE];
+    format_labels(label_str, sizeof(label_str), h->series.labels, h->series.num_labels);
+    const char *sep = h->series.num_labels > 0 ? "," : "";
     
-    for (size_t i = 0; i < reg->histogram_count; i++) {
-        histogram_metric_t *h = &reg->histograms[i];
-        
-        if (!h->active) {
-            LOG_DEBUG("  Histogram %zu inactive, skipping", i);
+    // Cumulative counts at each exported bound
+    uint64_t cumulative = 0;
+    size_t next = 0;
+    for (size_t j = 0; j < h->buckets.count; j++) {
+        double bound = h->buckets.upper_bounds[j];
+        if (isinf(bound)) {
+            text_printf(text, "%s_bucket{%s%sle=\"+Inf\"} %lu\n",
+                        name, label_str, sep, snap->count);
             continue;
         }
-        
-        pthread_mutex_lock(&h->lock);
-        
-        if (offset + 2048 >= buffer_size) {
-            LOG_WARN("Buffer full, cannot render histogram %s", h->name);
-            pthread_mutex_unlock(&h->lock);
-            break;
+        while (next < HISTOGRAM_BUCKETS &&
+               (double)metrics_histogram_bucket_upper(next) <= bound) {
+            cumulative += snap->counts[next++];
         }
-        
-        LOG_DEBUG("Rendering histogram: %s (buckets=%zu)", h->name, h->buckets.count);
-        
-        // HELP
-        int written = snprintf(buffer + offset, buffer_size - offset,
-                              "# HELP %s %s\n", h->name, h->help);
-        offset += written;
-        
-        // TYPE
-        written = snprintf(buffer + offset, buffer_size - offset,
-                          "# TYPE %s histogram\n", h->name);
-        offset += written;
-        
-        // Build label string (reusable for all histogram lines)
-        char label_str[512] = {0};
-        if (h->num_labels > 0) {
-            size_t label_offset = 0;
-            for (size_t j = 0; j < h->num_labels; j++) {
-                label_offset += snprintf(label_str + label_offset, 
-                                        sizeof(label_str) - label_offset,
-                                        "%s%s=\"%s\"",
-                                        j > 0 ? "," : "",
-                                        h->labels[j].name,
-                                        h->labels[j].value);
-            }
-        }
-        
-        // Render buckets
-        for (size_t j = 0; j < h->buckets.count; j++) {
-            if (offset + 256 >= buffer_size) break;
-            
-            // Format: metric_name_bucket{labels,le="upper_bound"} count
-            written = snprintf(buffer + offset, buffer_size - offset,
-                              "%s_bucket{%s%sle=\"",
-                              h->name,
-                              label_str,
-                              h->num_labels > 0 ? "," : "");
-            offset += written;
-            
-            // Format upper bound (+Inf for last bucket)
-            if (isinf(h->buckets.upper_bounds[j])) {
-                written = snprintf(buffer + offset, buffer_size - offset, "+Inf");
-            } else {
-                written = snprintf(buffer + offset, buffer_size - offset,
-                                  "%.2f", h->buckets.upper_bounds[j]);
-            }
-            offset += written;
-            
-            // ✅ FIX: Use atomic load for bucket counts
-            uint64_t bucket_count = __atomic_load_n(&h->bucket_counts[j], __ATOMIC_RELAXED);
-            
-            written = snprintf(buffer + offset, buffer_size - offset,
-                              "\"} %lu\n", bucket_count);
-            offset += written;
+        text_printf(text, "%s_bucket{%s%sle=\"%.0f\"} %lu\n",
+                    name, label_str, sep, bound, cumulative);
+    }
+    
+    text_printf(text, "%s_sum{%s} %lu\n%s_count{%s} %lu\n",
+                name, label_str, snap->sum,
+                name, label_str, snap->count);
+    
+    // Precomputed quantiles, so dashboards need no histogram_quantile()
+    text_printf(quantiles, "%s_quantile{%s%squantile=\"0.5\"} %.1f\n"
+                           "%s_quantile{%s%squantile=\"0.99\"} %.1f\n"
+                           "%s_quantile{%s%squantile=\"0.999\"} %.1f\n",
+                name, label_str, sep, metrics_histogram_quantile(snap, 0.5),
+                name, label_str, sep, metrics_histogram_quantile(snap, 0.99),
+                name, label_str, sep, metrics_histogram_quantile(snap, 0.999));
+}
+
+// Move src's chunks to the end of dst
+static void text_append(metrics_text_t *dst, metrics_text_t *src) {
+    if (src->failed) dst->failed = 1;
+    if (src->head) {
+        if (dst->tail) {
+            dst->tail->next = src->head;
+        } else {
+            dst->head = src->head;
         }
-        
-        // ✅ FIX: Use atomic loads for sum and count
-        uint64_t total_count = __atomic_load_n(&h->count, __ATOMIC_RELAXED);
-        uint64_t total_sum = __atomic_load_n(&h->sum, __ATOMIC_RELAXED);
-        
-        // Render _sum
-        written = snprintf(buffer + offset, buffer_size - offset,
-                          "%s_sum{%s} %lu\n",
-                          h->name, label_str, total_sum);
-        offset += written;
-        
-        // Render _count
-        written = snprintf(buffer + offset, buffer_size - offset,
-                          "%s_count{%s} %lu\n",
-                          h->name, label_str, total_count);
-        offset += written;
-        
-        pthread_mutex_unlock(&h->lock);
+        dst->tail = src->tail;
+        dst->length += src->length;
     }
+    src->head = src->tail = NULL;
+    src->length = 0;
+    src->failed = 0;
+}
+
+static void render_family(metrics_text_t *text, metrics_text_t *quantiles,
+                          metric_family_t *family, histogram_snapshot_t *snap) {
+    metric_series_t *s = __atomic_load_n(&family->first, __ATOMIC_ACQUIRE);
+    if (!s) return;     // Vector with no series yet
     
-done:
-    pthread_mutex_unlock(&reg->lock);
+    text_printf(text, "# HELP %s %s\n# TYPE %s %s\n",
+                family->name, family->help, family->name, type_name(family->type));
     
-    LOG_DEBUG("Rendered %zu bytes of metrics (histograms included)", offset);
-    return buffer;
+    if (family->type != METRIC_TYPE_HISTOGRAM) {
+        for (; s; s = __atomic_load_n(&s->next, __ATOMIC_ACQUIRE)) {
+            render_metric(text, (const metrics_t*)s);
+        }
+        return;
+    }
+    
+    for (; s; s = __atomic_load_n(&s->next, __ATOMIC_ACQUIRE)) {
+        render_histogram(text, quantiles, (const histogram_metric_t*)s, snap);
+    }
+    text_printf(text, "# HELP %s_quantile %s (quantiles)\n# TYPE %s_quantile gauge\n",
+                family->name, family->help, family->name);
+    text_append(text, quantiles);
 }
 
-histogram_metric_t* metrics_get_or_create_histogram(
-    metrics_registry_t *reg,
-    const char *name,
-    const char *help,
-    histogram_buckets_type_t buckets_type,
-    size_t num_labels,
-    const metric_label_t *labels) {
+// Walks the registry without its lock: families and series are appended
+// with release stores once fully initialised and are never removed, and
+// every value is read with relaxed atomics
+static metrics_text_t* render_text(metrics_registry_t *reg) {
+    metrics_text_t *text = text_create();
+    metrics_text_t *quantiles = text_create();
+    histogram_snapshot_t *snap = malloc(sizeof(histogram_snapshot_t));
+    if (!text || !quantiles || !snap) {
+        free(snap);
+        if (quantiles) text_free(quantiles);
+        if (text) text_free(text);
+        return NULL;
+    }
     
-    if (!reg || !name) return NULL;
+    for (metric_family_t *family = __atomic_load_n(&reg->first, __ATOMIC_ACQUIRE);
+         family; family = __atomic_load_n(&family->next, __ATOMIC_ACQUIRE)) {
+        render_family(text, quantiles, family, snap);
+    }
     
-    char metric_key[512];
-    generate_metric_key(metric_key, sizeof(metric_key), name, num_labels, labels);
+    free(snap);
+    text_free(quantiles);
     
-    pthread_mutex_lock(&reg->lock);
+    if (text->failed) {
+        LOG_ERROR("Failed to allocate metrics render buffer");
+        text_free(text);
+        return NULL;
+    }
     
-    // Search existing
-    for (size_t i = 0; i < reg->histogram_count; i++) {
-        if (!reg->histograms[i].active) continue;
-        if (strcmp(reg->histograms[i].name, name) == 0) {
-            // Match labels
-            int match = 1;
-            for (size_t j = 0; j < num_labels; j++) {
-                if (strcmp(reg->histograms[i].labels[j].name, labels[j].name) != 0 ||
-                    strcmp(reg->histograms[i].labels[j].value, labels[j].value) != 0) {
-                    match = 0;
-                    break;
-                }
-            }
-            if (match) {
-                pthread_mutex_unlock(&reg->lock);
-                return &reg->histograms[i];
-            }
+    LOG_DEBUG("Rendered %zu bytes of metrics", text->length);
+    return text;
+}
+
+metrics_text_t* metrics_registry_render(metrics_registry_t *reg) {
+    if (!reg) return NULL;
+    
+    // One render at a time; scrapes arriving meanwhile reuse its result
+    pthread_mutex_lock(&reg->render_lock);
+    
+    uint64_t now = time_now_ms();
+    uint32_t ttl = __atomic_load_n(&reg->cache_ttl_ms, __ATOMIC_RELAXED);
+    
+    if (!reg->cached_text || ttl == 0 || now - reg->cached_at_ms >= ttl) {
+        for (size_t i = 0; i < reg->num_collectors; i++) {
+            reg->collectors[i].fn(reg, reg->collectors[i].ctx);
+        }
+        metrics_text_t *fresh = render_text(reg);
+        if (fresh) {
+            metrics_text_release(reg->cached_text);
+            reg->cached_text = fresh;
+            reg->cached_at_ms = now;
         }
     }
     
-    // Create new
-    if (reg->histogram_count >= MAX_METRICS_PER_REGISTRY) {
-        pthread_mutex_unlock(&reg->lock);
-        return NULL;
+    metrics_text_t *text = reg->cached_text;
+    if (text) {
+        __atomic_add_fetch(&text->refs, 1, __ATOMIC_RELAXED);
     }
     
-    histogram_metric_t *h = &reg->histograms[reg->histogram_count];
-    memset(h, 0, sizeof(histogram_metric_t));
+    pthread_mutex_unlock(&reg->render_lock);
+    return text;
+}
+
+// ============================================================================
+// COLLECTORS
+// ============================================================================
+
+int metrics_registry_add_collector(metrics_registry_t *reg, metrics_collector_fn fn,
+                                   void *ctx) {
+    if (!reg || !fn) return -1;
     
-    safe_strncpy(h->name, name, MAX_METRIC_NAME_LEN);
-    safe_strncpy(h->help, help, MAX_METRIC_HELP_LEN);
-    h->num_labels = num_labels;
-    for (size_t i = 0; i < num_labels; i++) {
-        h->labels[i] = labels[i];
+    pthread_mutex_lock(&reg->render_lock);
+    int rc = -1;
+    if (reg->num_collectors < METRICS_MAX_COLLECTORS) {
+        reg->collectors[reg->num_collectors].fn = fn;
+        reg->collectors[reg->num_collectors].ctx = ctx;
+        reg->num_collectors++;
+        rc = 0;
     }
+    pthread_mutex_unlock(&reg->render_lock);
     
-    h->buckets = metrics_get_buckets(buckets_type);
-    h->count = 0;
-    h->sum = 0;
-    for (size_t i = 0; i < h->buckets.count; i++) {
-        h->bucket_counts[i] = 0;
+    if (rc != 0) {
+        LOG_ERROR("Metrics collector table full (%d)", METRICS_MAX_COLLECTORS);
     }
+    return rc;
+}
+
+void metrics_registry_remove_collector(metrics_registry_t *reg, metrics_collector_fn fn,
+                                       void *ctx) {
+    if (!reg) return;
     
-    pthread_mutex_init(&h->lock, NULL);
-    h->active = 1;
-    reg->histogram_count++;
+    // Waits out a render in progress, which may be calling this collector
+    pthread_mutex_lock(&reg->render_lock);
+    for (size_t i = 0; i < reg->num_collectors; i++) {
+        if (reg->collectors[i].fn == fn && reg->collectors[i].ctx == ctx) {
+            memmove(&reg->collectors[i], &reg->collectors[i + 1],
+                    (reg->num_collectors - i - 1) * sizeof(metrics_collector_t));
+            reg->num_collectors--;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&reg->render_lock);
+}
+
+void metrics_registry_set_cache_ttl(metrics_registry_t *reg, uint32_t ttl_ms) {
+    if (!reg) return;
+    __atomic_store_n(&reg->cache_ttl_ms, ttl_ms, __ATOMIC_RELAXED);
+}
+
+char* metrics_registry_render_prometheus(metrics_registry_t *reg) {
+    metrics_text_t *text = metrics_registry_render(reg);
+    if (!text) return NULL;
     
-    pthread_mutex_unlock(&reg->lock);
-    return h;
+    char *buffer = malloc(text->length + 1);
+    if (buffer) {
+        size_t offset = 0;
+        for (const metrics_chunk_t *c = text->head; c; c = c->next) {
+            memcpy(buffer + offset, c->data, c->len);
+            offset += c->len;
+        }
+        buffer[offset] = '\0';
+    } else {
+        LOG_ERROR("Failed to allocate render buffer");
+    }
+    
+    metrics_text_release(text);
+    return buffer;
 }
 
-histogram_buckets_t metrics_get_buckets(histogram_buckets_type_t type) {
+static histogram_buckets_t power_of_two_buckets(int first_exp, int last_exp) {
     histogram_buckets_t buckets = {0};
-    
+    for (int e = first_exp; e <= last_exp && buckets.count < HISTOGRAM_MAX_BUCKETS - 1; e++) {
+        buckets.upper_bounds[buckets.count++] = (double)(1ULL << e);
+    }
+    buckets.upper_bounds[buckets.count++] = INFINITY;
+    return buckets;
+}
+
+histogram_buckets_t metrics_get_buckets(histogram_buckets_type_t type) {
     switch (type) {
         case HISTOGRAM_BUCKETS_LATENCY_MS:
-            buckets.count = 9;
-            buckets.upper_bounds[0] = 1;
-            buckets.upper_bounds[1] = 5;
-            buckets.upper_bounds[2] = 10;
-            buckets.upper_bounds[3] = 50;
-            buckets.upper_bounds[4] = 100;
-            buckets.upper_bounds[5] = 500;
-            buckets.upper_bounds[6] = 1000;
-            buckets.upper_bounds[7] = 5000;
-            buckets.upper_bounds[8] = INFINITY;
-            break;
-            
+            return power_of_two_buckets(0, 16);
+        
         case HISTOGRAM_BUCKETS_LATENCY_US:
-            buckets.count = 8;
-            buckets.upper_bounds[0] = 100;
-            buckets.upper_bounds[1] = 500;
-            buckets.upper_bounds[2] = 1000;
-            buckets.upper_bounds[3] = 5000;
-            buckets.upper_bounds[4] = 10000;
-            buckets.upper_bounds[5] = 50000;
-            buckets.upper_bounds[6] = 100000;
-            buckets.upper_bounds[7] = INFINITY;
-            break;
-            
+            return power_of_two_buckets(0, 26);
+        
         case HISTOGRAM_BUCKETS_SIZE_BYTES:
-            buckets.count = 9;
-            buckets.upper_bounds[0] = 256;
-            buckets.upper_bounds[1] = 1024;
-            buckets.upper_bounds[2] = 4096;
-            buckets.upper_bounds[3] = 16384;
-            buckets.upper_bounds[4] = 65536;
-            buckets.upper_bounds[5] = 262144;
-            buckets.upper_bounds[6] = 1048576;
-            buckets.upper_bounds[7] = 4194304;
-            buckets.upper_bounds[8] = INFINITY;
-            break;
-            
+            return power_of_two_buckets(6, 26);
+        
         case HISTOGRAM_BUCKETS_CUSTOM:
-            // User must set manually
-            buckets.count = 0;
             break;
     }
+    
+    // Only +Inf until the caller supplies bounds
+    return power_of_two_buckets(1, 0);
+}
+
+histogram_buckets_t metrics_custom_buckets(const double *bounds, size_t count) {
+    histogram_buckets_t buckets = {0};
+    for (size_t i = 0; bounds && i < count && buckets.count < HISTOGRAM_MAX_BUCKETS - 1; i++) {
+        if (isinf(bounds[i])) break;
+        buckets.upper_bounds[buckets.count++] = bounds[i];
+    }
+    buckets.upper_bounds[buckets.count++] = INFINITY;
     return buckets;
 }
 
+// ============================================================================
+// HISTOGRAM RECORDING
+// ============================================================================
+
+// Index of value x in the plain log-linear layout: exact below
+// 2 * HISTOGRAM_SUB_BUCKETS, then HISTOGRAM_SUB_BUCKETS per power of two
+static size_t log_linear_index(uint64_t x) {
+    if (x < HISTOGRAM_SUB_BUCKETS) return (size_t)x;
+    if (x >> HISTOGRAM_MAX_EXPONENT) x = (1ULL << HISTOGRAM_MAX_EXPONENT) - 1;
+    
+    int exponent = 63 - __builtin_clzll(x);
+    int shift = exponent - HISTOGRAM_SUB_BUCKET_BITS;
+    if (shift < 0) shift = 0;
+    return (size_t)shift * HISTOGRAM_SUB_BUCKETS + (size_t)(x >> shift);
+}
+
+// Largest value in the plain layout's bucket
+static uint64_t log_linear_upper(size_t index) {
+    if (index < 2 * HISTOGRAM_SUB_BUCKETS) return index;
+    size_t shift = index / HISTOGRAM_SUB_BUCKETS - 1;
+    uint64_t lower = (uint64_t)(index - shift * HISTOGRAM_SUB_BUCKETS) << shift;
+    return lower + (1ULL << shift) - 1;
+}
+
+// Shifted by one so that bucket edges are inclusive upper bounds
+size_t metrics_histogram_bucket_index(uint64_t value) {
+    return value == 0 ? 0 : 1 + log_linear_index(value - 1);
+}
+
+uint64_t metrics_histogram_bucket_upper(size_t index) {
+    return index == 0 ? 0 : log_linear_upper(index - 1) + 1;
+}
+
+void metrics_histogram_record(histogram_metric_t *metric, uint64_t value) {
+    if (!metric) return;
+    
+    if (tls_shard < 0) {
+        tls_shard = __atomic_fetch_add(&g_next_shard, 1, __ATOMIC_RELAXED) % METRICS_SHARDS;
+    }
+    histogram_shard_t *shard = &metric->shards[tls_shard % HISTOGRAM_SHARDS];
+    
+    __atomic_fetch_add(&shard->counts[metrics_histogram_bucket_index(value)], 1,
+                       __ATOMIC_RELAXED);
+    __atomic_fetch_add(&shard->sum, value, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&shard->count, 1, __ATOMIC_RELAXED);
+}
+
 void metrics_histogram_observe(histogram_metric_t *metric, int value) {
+    metrics_histogram_record(metric, value < 0 ? 0 : (uint64_t)value);
+}
+
+void metrics_histogram_snapshot(const histogram_metric_t *metric,
+                                histogram_snapshot_t *out) {
+    memset(out, 0, sizeof(*out));
     if (!metric) return;
     
-    __sync_fetch_and_add(&metric->count, 1);
-    __sync_fetch_and_add(&metric->sum, value);  
+    for (int s = 0; s < HISTOGRAM_SHARDS; s++) {
+        const histogram_shard_t *shard = &metric->shards[s];
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            out->counts[i] += __atomic_load_n(&shard->counts[i], __ATOMIC_RELAXED);
+        }
+        out->sum += __atomic_load_n(&shard->sum, __ATOMIC_RELAXED);
+    }
     
-    for (size_t i = 0; i < metric->buckets.count; i++) {
-        if (value <= metric->buckets.upper_bounds[i]) {
-            __sync_fetch_and_add(&metric->bucket_counts[i], 1);
-            break;
+    // Derived from the buckets so a snapshot is always self-consistent
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        out->count += out->counts[i];
+    }
+}
+
+void metrics_histogram_snapshot_merge(histogram_snapshot_t *dst,
+                                      const histogram_snapshot_t *src) {
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        dst->counts[i] += src->counts[i];
+    }
+    dst->count += src->count;
+    dst->sum += src->sum;
+}
+
+double metrics_histogram_quantile(const histogram_snapshot_t *snap, double q) {
+    if (!snap || snap->count == 0) return 0.0;
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+    
+    uint64_t rank = (uint64_t)ceil(q * (double)snap->count);
+    if (rank == 0) rank = 1;
+    
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += snap->counts[i];
+        if (seen >= rank) {
+            if (i == 0) return 0.0;
+            double lower = (double)metrics_histogram_bucket_upper(i - 1) + 1.0;
+            double upper = (double)metrics_histogram_bucket_upper(i);
+            return (lower + upper) / 2.0;
         }
     }
-}
\ No newline at end of file
+    return (double)metrics_histogram_bucket_upper(HISTOGRAM_BUCKETS - 1);
+}
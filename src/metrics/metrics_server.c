@@ -1,6 +1,7 @@
 // src/core/metrics_server.c
-// Simple HTTP server for Prometheus /metrics endpoint
-// Complete rewrite with improved error handling and robustness
+// HTTP server for the Prometheus /metrics endpoint, log levels and JSON
+// debug endpoints. One epoll thread serves every connection with
+// HTTP/1.1 keep-alive, so concurrent scrapes never queue behind each other.
 
 #define _POSIX_C_SOURCE 200809L
 
@@ -11,212 +12,755 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <pthread.h>
 #include <errno.h>
 #include <fcntl.h>
-#include <sys/time.h>
+
+#ifdef ROOLE_HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 // ============================================================================
 // CONSTANTS
 // ============================================================================
 
-#define HTTP_BUFFER_SIZE 8192
-#define MAX_REQUEST_SIZE 4096
-#define SERVER_BACKLOG 10
-#define ACCEPT_TIMEOUT_SEC 1
+#define MAX_REQUEST_SIZE 8192           // Request line + headers (+ ignored body)
+#define HTTP_HEADER_SIZE 512
+#define SERVER_BACKLOG 64
+#define MAX_EPOLL_EVENTS 64
+#define EPOLL_TIMEOUT_MS 1000           // Idle sweep interval
+#define ENDPOINT_INITIAL_SIZE 4096
+#define ENDPOINT_PATH_LEN 64
 
 // ============================================================================
 // SERVER STRUCTURE
 // ============================================================================
 
+// Reference-counted response body, so one compressed render can be sent
+// to several connections. Only touched by the server thread.
+typedef struct http_blob {
+    int refs;
+    size_t len;
+    char data[];
+} http_blob_t;
+
+typedef struct http_conn {
+    int fd;
+    uint64_t last_active_ms;
+    
+    char in[MAX_REQUEST_SIZE];
+    size_t in_len;
+    
+    // Response being written: head, then either blob or the text chunks
+    int sending;
+    char head[HTTP_HEADER_SIZE];
+    size_t head_len;
+    http_blob_t *blob;
+    metrics_text_t *text;
+    const void *cursor;
+    const char *part;                   // Body piece being sent
+    size_t part_len;
+    size_t sent;                        // Of head, then of part
+    int close_after;
+} http_conn_t;
+
+typedef struct http_endpoint {
+    char path[ENDPOINT_PATH_LEN];
+    metrics_endpoint_fn handler;
+    void *ctx;
+} http_endpoint_t;
+
 struct metrics_server {
     metrics_registry_t *registry;
     int server_fd;
+    int epoll_fd;
+    int wake_fd;
     uint16_t port;
     char bind_addr[16];
     pthread_t server_thread;
     volatile int shutdown_flag;
+    
+    http_conn_t *conns[METRICS_SERVER_MAX_CONNECTIONS];
+    size_t conn_count;
+    
+    // Slots are filled under endpoint_lock, then published by the count
+    http_endpoint_t endpoints[METRICS_SERVER_MAX_ENDPOINTS];
+    size_t endpoint_count;
+    pthread_mutex_t endpoint_lock;
+    
+    int log_control;            // Atomic: PUT/DELETE /loglevel allowed
+    
+    // Compressed copy of the last render; scrapes within the registry's
+    // cache TTL get the same text and so skip compression too
+    metrics_text_t *gzip_source;
+    http_blob_t *gzip_blob;
 };
 
+// ============================================================================
+// CONNECTIONS
+// ============================================================================
+
+static void blob_release(http_blob_t *blob) {
+    if (blob && --blob->refs == 0) {
+        free(blob);
+    }
+}
+
+static http_blob_t* blob_create(const char *data, size_t len) {
+    http_blob_t *blob = malloc(sizeof(http_blob_t) + len);
+    if (!blob) return NULL;
+    blob->refs = 1;
+    blob->len = len;
+    if (data) memcpy(blob->data, data, len);
+    return blob;
+}
+
+static void conn_reset_response(http_conn_t *conn) {
+    blob_release(conn->blob);
+    metrics_text_release(conn->text);
+    conn->blob = NULL;
+    conn->text = NULL;
+    conn->cursor = NULL;
+    conn->part = NULL;
+    conn->part_len = 0;
+    conn->sent = 0;
+    conn->head_len = 0;
+    conn->sending = 0;
+}
+
+static void conn_close(metrics_server_t *server, http_conn_t *conn) {
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+    conn_reset_response(conn);
+    
+    for (size_t i = 0; i < server->conn_count; i++) {
+        if (server->conns[i] == conn) {
+            server->conns[i] = server->conns[--server->conn_count];
+            break;
+        }
+    }
+    free(conn);
+}
+
+// Wait for requests while idle, for buffer space while sending
+static void conn_watch(metrics_server_t *server, http_conn_t *conn) {
+    struct epoll_event ev;
+    ev.events = conn->sending ? EPOLLOUT : EPOLLIN;
+    ev.data.ptr = conn;
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, conn->fd, &ev);
+}
+
 // ============================================================================
 // HTTP RESPONSE HELPERS
 // ============================================================================
 
-static void send_http_response(int client_fd, const char *status_line,
-                               const char *content_type, const char *body) {
-    char header[1024];
-    size_t body_len = body ? strlen(body) : 0;
-    
-    int header_len = snprintf(header, sizeof(header),
+static void set_head(http_conn_t *conn, const char *status_line, const char *content_type,
+                     const char *content_encoding, size_t body_len) {
+    int n = snprintf(conn->head, sizeof(conn->head),
         "HTTP/1.1 %s\r\n"
         "Content-Type: %s\r\n"
+        "%s%s%s"
         "Content-Length: %zu\r\n"
-        "Connection: close\r\n"
+        "Connection: %s\r\n"
         "Server: roole-metrics/1.0\r\n"
         "\r\n",
-        status_line, content_type, body_len);
-    
-    if (header_len < 0 || (size_t)header_len >= sizeof(header)) {
-        LOG_ERROR("Failed to format HTTP header");
-        return;
-    }
-    
-    // Send header
-    ssize_t sent = send(client_fd, header, header_len, MSG_NOSIGNAL);
-    if (sent < 0) {
-        LOG_DEBUG("Failed to send HTTP header: %s", strerror(errno));
-        return;
-    }
+        status_line, content_type,
+        content_encoding ? "Content-Encoding: " : "",
+        content_encoding ? content_encoding : "",
+        content_encoding ? "\r\nVary: Accept-Encoding\r\n" : "",
+        body_len,
+        conn->close_after ? "close" : "keep-alive");
+    
+    conn->head_len = n > 0 && (size_t)n < sizeof(conn->head) ? (size_t)n : 0;
+    conn->sending = 1;
+}
+
+static void send_http_response(http_conn_t *conn, const char *status_line,
+                               const char *content_type, const char *body) {
+    size_t body_len = body ? strlen(body) : 0;
     
-    // Send body if present
-    if (body && body_len > 0) {
-        sent = send(client_fd, body, body_len, MSG_NOSIGNAL);
-        if (sent < 0) {
-            LOG_DEBUG("Failed to send HTTP body: %s", strerror(errno));
+    if (body_len > 0) {
+        conn->blob = blob_create(body, body_len);
+        if (!conn->blob) {
+            conn->close_after = 1;
+            body_len = 0;
         }
     }
+    set_head(conn, status_line, content_type, NULL, body_len);
+}
+
+static void send_400_bad_request(http_conn_t *conn) {
+    send_http_response(conn, "400 Bad Request", "text/plain", "400 Bad Request\n");
 }
 
-static void send_400_bad_request(int client_fd) {
-    const char *body = "400 Bad Request\n";
-    send_http_response(client_fd, "400 Bad Request", "text/plain", body);
+static void send_403_forbidden(http_conn_t *conn) {
+    send_http_response(conn, "403 Forbidden", "text/plain", "403 Forbidden\n");
 }
 
-static void send_404_not_found(int client_fd) {
-    const char *body = "404 Not Found\n";
-    send_http_response(client_fd, "404 Not Found", "text/plain", body);
+static void send_404_not_found(http_conn_t *conn) {
+    send_http_response(conn, "404 Not Found", "text/plain", "404 Not Found\n");
 }
 
-static void send_500_internal_error(int client_fd) {
-    const char *body = "500 Internal Server Error\n";
-    send_http_response(client_fd, "500 Internal Server Error", "text/plain", body);
+static void send_500_internal_error(http_conn_t *conn) {
+    send_http_response(conn, "500 Internal Server Error", "text/plain",
+                       "500 Internal Server Error\n");
+}
+
+// Next body piece after the current one is fully sent
+static void next_part(http_conn_t *conn) {
+    conn->sent = 0;
+    if (conn->text) {
+        conn->part = metrics_text_next_chunk(conn->text, &conn->cursor, &conn->part_len);
+    } else if (conn->blob && conn->part == NULL) {
+        conn->part = conn->blob->data;
+        conn->part_len = conn->blob->len;
+    } else {
+        conn->part = NULL;
+    }
+}
+
+// Write as much of the response as the socket takes
+// @return 1 when complete, 0 if the socket is full, -1 on error
+static int conn_flush(http_conn_t *conn) {
+    while (conn->sent < conn->head_len) {
+        ssize_t n = send(conn->fd, conn->head + conn->sent, conn->head_len - conn->sent,
+                         MSG_NOSIGNAL | (conn->blob || conn->text ? MSG_MORE : 0));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+        }
+        conn->sent += (size_t)n;
+        if (conn->sent == conn->head_len) {
+            conn->head_len = 0;
+            next_part(conn);
+            break;
+        }
+    }
+    
+    while (conn->part) {
+        if (conn->sent == conn->part_len) {
+            next_part(conn);
+            continue;
+        }
+        ssize_t n = send(conn->fd, conn->part + conn->sent, conn->part_len - conn->sent,
+                         MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+        }
+        conn->sent += (size_t)n;
+    }
+    
+    return 1;
 }
 
 // ============================================================================
 // HTTP REQUEST PARSING
 // ============================================================================
 
-static int parse_http_request(const char *request, char *method, size_t method_size,
-                              char *path, size_t path_size) {
-    if (!request || !method || !path) {
-        return -1;
+typedef struct http_request {
+    char method[16];
+    char path[256];
+    char *query;                        // Into path, NULL if none
+    int keep_alive;
+    int accepts_gzip;
+    size_t length;                      // Header block plus body
+} http_request_t;
+
+// Does a comma-separated header value list the token (without q=0)?
+static int header_has_token(const char *value, size_t value_len, const char *token) {
+    size_t token_len = strlen(token);
+    const char *end = value + value_len;
+    
+    for (const char *p = value; p < end; ) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) p++;
+        const char *item = p;
+        while (p < end && *p != ',') p++;
+        
+        if ((size_t)(p - item) >= token_len && strncasecmp(item, token, token_len) == 0 &&
+            (item + token_len == p || item[token_len] == ';' || item[token_len] == ' ')) {
+            // "gzip;q=0" declines it
+            for (const char *q = item + token_len; q + 1 < p; q++) {
+                if ((*q == 'q' || *q == 'Q') && q[1] == '=') return strtod(q + 2, NULL) > 0.0;
+            }
+            return 1;
+        }
     }
+    return 0;
+}
+
+// Parse the request at the start of buf
+// @return 1 when a whole request was parsed, 0 if more bytes are needed,
+//         -1 if malformed
+static int parse_http_request(const char *buf, size_t len, http_request_t *req) {
+    const char *end = NULL;
+    for (size_t i = 3; i < len; i++) {
+        if (buf[i] == '\n' && buf[i - 1] == '\r' && buf[i - 2] == '\n' && buf[i - 3] == '\r') {
+            end = buf + i + 1;
+            break;
+        }
+    }
+    if (!end) return len >= MAX_REQUEST_SIZE ? -1 : 0;
     
-    // Parse request line: METHOD PATH HTTP/VERSION
-    int parsed = sscanf(request, "%63s %255s", method, path);
-    if (parsed != 2) {
+    memset(req, 0, sizeof(*req));
+    
+    // Request line: METHOD SP PATH SP HTTP/x.y
+    const char *line_end = memchr(buf, '\r', (size_t)(end - buf));
+    const char *sp1 = memchr(buf, ' ', (size_t)(line_end - buf));
+    const char *sp2 = sp1 ? memchr(sp1 + 1, ' ', (size_t)(line_end - sp1 - 1)) : NULL;
+    if (!sp1 || !sp2 || (size_t)(sp1 - buf) >= sizeof(req->method) ||
+        (size_t)(sp2 - sp1 - 1) >= sizeof(req->path) || sp2 - sp1 - 1 == 0) {
         LOG_DEBUG("Failed to parse HTTP request line");
         return -1;
     }
+    memcpy(req->method, buf, (size_t)(sp1 - buf));
+    memcpy(req->path, sp1 + 1, (size_t)(sp2 - sp1 - 1));
     
-    // Ensure null termination
-    method[method_size - 1] = '\0';
-    path[path_size - 1] = '\0';
+    size_t version_len = (size_t)(line_end - sp2 - 1);
+    if (version_len == 8 && strncmp(sp2 + 1, "HTTP/1.1", 8) == 0) {
+        req->keep_alive = 1;
+    } else if (version_len != 8 || strncmp(sp2 + 1, "HTTP/1.0", 8) != 0) {
+        return -1;
+    }
     
-    LOG_DEBUG("Parsed HTTP request: %s %s", method, path);
-    return 0;
+    // Headers we act on; everything else is ignored
+    size_t content_length = 0;
+    for (const char *line = line_end + 2; line < end - 2; ) {
+        const char *eol = memchr(line, '\r', (size_t)(end - line));
+        const char *colon = memchr(line, ':', (size_t)(eol - line));
+        if (colon) {
+            size_t name_len = (size_t)(colon - line);
+            const char *value = colon + 1;
+            while (value < eol && (*value == ' ' || *value == '\t')) value++;
+            size_t value_len = (size_t)(eol - value);
+            
+            if (name_len == 10 && strncasecmp(line, "Connection", 10) == 0) {
+                if (header_has_token(value, value_len, "close")) req->keep_alive = 0;
+                if (header_has_token(value, value_len, "keep-alive")) req->keep_alive = 1;
+            } else if (name_len == 15 && strncasecmp(line, "Accept-Encoding", 15) == 0) {
+                req->accepts_gzip = header_has_token(value, value_len, "gzip");
+            } else if (name_len == 14 && strncasecmp(line, "Content-Length", 14) == 0) {
+                content_length = strtoul(value, NULL, 10);
+            }
+        }
+        line = eol + 2;
+    }
+    
+    // Bodies are not used by any endpoint, but must be skipped to keep the
+    // connection in sync
+    req->length = (size_t)(end - buf) + content_length;
+    if (req->length > MAX_REQUEST_SIZE) return -1;
+    if (req->length > len) return 0;
+    
+    req->query = strchr(req->path, '?');
+    if (req->query) *req->query++ = '\0';
+    
+    LOG_DEBUG("Parsed HTTP request: %s %s", req->method, req->path);
+    return 1;
 }
 
 // ============================================================================
 // HTTP REQUEST HANDLING
 // ============================================================================
 
-static void handle_metrics_request(int client_fd, metrics_registry_t *registry) {
+#ifdef ROOLE_HAVE_ZLIB
+// Compress text into a gzip body, reusing the previous result while the
+// registry hands out the same cached render. Takes over the caller's
+// reference to text on success.
+static http_blob_t* gzip_text(metrics_server_t *server, metrics_text_t *text) {
+    if (server->gzip_source == text && server->gzip_blob) {
+        metrics_text_release(text);
+        server->gzip_blob->refs++;
+        return server->gzip_blob;
+    }
+    
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return NULL;
+    }
+    
+    size_t bound = deflateBound(&zs, metrics_text_length(text));
+    http_blob_t *blob = blob_create(NULL, bound);
+    if (!blob) {
+        deflateEnd(&zs);
+        return NULL;
+    }
+    
+    zs.next_out = (Bytef*)blob->data;
+    zs.avail_out = (uInt)bound;
+    
+    const void *cursor = NULL;
+    const char *chunk;
+    size_t len;
+    int rc = Z_OK;
+    while (rc == Z_OK && (chunk = metrics_text_next_chunk(text, &cursor, &len)) != NULL) {
+        zs.next_in = (Bytef*)chunk;
+        zs.avail_in = (uInt)len;
+        rc = deflate(&zs, Z_NO_FLUSH);
+    }
+    if (rc == Z_OK) {
+        rc = deflate(&zs, Z_FINISH);
+    }
+    blob->len = zs.total_out;
+    deflateEnd(&zs);
+    
+    if (rc != Z_STREAM_END) {
+        LOG_ERROR("Failed to compress metrics: %d", rc);
+        blob_release(blob);
+        return NULL;
+    }
+    
+    metrics_text_release(server->gzip_source);
+    blob_release(server->gzip_blob);
+    server->gzip_source = text;
+    server->gzip_blob = blob;
+    blob->refs++;               // One for the cache, one for the caller
+    return blob;
+}
+#endif
+
+static void handle_metrics_request(metrics_server_t *server, http_conn_t *conn,
+                                   const http_request_t *req) {
     LOG_DEBUG("Handling /metrics request");
     
-    // Render metrics in Prometheus format
-    char *metrics_text = metrics_registry_render_prometheus(registry);
+    // Render (or reuse the cached render of) metrics in Prometheus format
+    metrics_text_t *text = metrics_registry_render(server->registry);
     
-    if (!metrics_text) {
+    if (!text) {
         LOG_ERROR("Failed to render metrics");
-        send_500_internal_error(client_fd);
+        send_500_internal_error(conn);
         return;
     }
     
-    // Send successful response with metrics
-    send_http_response(client_fd, 
-                      "200 OK", 
-                      "text/plain; version=0.0.4; charset=utf-8",
-                      metrics_text);
+    static const char *content_type = "text/plain; version=0.0.4; charset=utf-8";
+
+#ifdef ROOLE_HAVE_ZLIB
+    if (req->accepts_gzip) {
+        http_blob_t *blob = gzip_text(server, text);
+        if (blob) {
+            conn->blob = blob;
+            set_head(conn, "200 OK", content_type, "gzip", blob->len);
+            return;
+        }
+    }
+#else
+    (void)req;
+#endif
     
-    free(metrics_text);
-    LOG_DEBUG("Metrics response sent successfully");
+    // Stream the chunks as rendered; no flattening copy
+    conn->text = text;
+    set_head(conn, "200 OK", content_type, NULL, metrics_text_length(text));
 }
 
-static void handle_http_request(int client_fd, metrics_registry_t *registry) {
-    char request[MAX_REQUEST_SIZE];
+static void handle_endpoint_request(http_conn_t *conn, const http_endpoint_t *endpoint) {
+    size_t cap = ENDPOINT_INITIAL_SIZE;
+    
+    for (int attempt = 0; attempt < 2; attempt++) {
+        http_blob_t *blob = blob_create(NULL, cap);
+        if (!blob) break;
+        
+        int n = endpoint->handler(endpoint->ctx, blob->data, cap);
+        if (n < 0) {
+            blob_release(blob);
+            break;
+        }
+        if ((size_t)n < cap) {
+            blob->len = (size_t)n;
+            conn->blob = blob;
+            set_head(conn, "200 OK", "application/json", NULL, blob->len);
+            return;
+        }
+        blob_release(blob);
+        cap = (size_t)n + 1;
+    }
     
-    // Receive HTTP request
-    ssize_t bytes_read = recv(client_fd, request, sizeof(request) - 1, 0);
+    LOG_ERROR("Debug endpoint %s failed", endpoint->path);
+    send_500_internal_error(conn);
+}
+
+// Copy the value of key from a "a=1&b=2" query string; 0 if present
+static int query_param(const char *query, const char *key, char *out, size_t out_size) {
+    size_t key_len = strlen(key);
     
-    if (bytes_read < 0) {
-        LOG_DEBUG("Failed to receive HTTP request: %s", strerror(errno));
-        return;
+    for (const char *p = query; p && *p; ) {
+        const char *end = strchr(p, '&');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+        
+        if (len > key_len && strncmp(p, key, key_len) == 0 && p[key_len] == '=') {
+            size_t value_len = len - key_len - 1;
+            if (value_len >= out_size) return -1;
+            memcpy(out, p + key_len + 1, value_len);
+            out[value_len] = '\0';
+            return 0;
+        }
+        p = end ? end + 1 : NULL;
+    }
+    return -1;
+}
+
+static void send_log_levels(http_conn_t *conn) {
+    char body[2048];
+    log_component_level_t levels[LOG_MAX_COMPONENT_LEVELS];
+    size_t count = logger_get_component_levels(levels, LOG_MAX_COMPONENT_LEVELS);
+    
+    int used = snprintf(body, sizeof(body), "global=%s\n",
+                        logger_level_to_string(logger_get_level()));
+    for (size_t i = 0; i < count && used > 0 && (size_t)used < sizeof(body); i++) {
+        used += snprintf(body + used, sizeof(body) - used, "%s=%s\n",
+                         levels[i].component, logger_level_to_string(levels[i].level));
     }
     
-    if (bytes_read == 0) {
-        LOG_DEBUG("Client closed connection before sending request");
+    send_http_response(conn, "200 OK", "text/plain", body);
+}
+
+// GET    /loglevel                              list levels
+// PUT    /loglevel?level=debug                  set the global level
+// PUT    /loglevel?component=raft&level=debug   override one component
+// DELETE /loglevel?component=raft               drop an override
+// Changes need metrics_server_set_log_control(server, 1).
+static void handle_loglevel_request(metrics_server_t *server, http_conn_t *conn,
+                                    const char *method, const char *query) {
+    char component[LOG_COMPONENT_NAME_LEN] = "";
+    char level_name[16] = "";
+    log_level_t level;
+    
+    int has_component = query && query_param(query, "component", component,
+                                             sizeof(component)) == 0;
+    int has_level = query && query_param(query, "level", level_name,
+                                         sizeof(level_name)) == 0;
+    
+    if (strcmp(method, "GET") == 0) {
+        send_log_levels(conn);
         return;
     }
     
-    // Null-terminate request
-    request[bytes_read] = '\0';
+    if (!__atomic_load_n(&server->log_control, __ATOMIC_RELAXED)) {
+        send_403_forbidden(conn);
+        return;
+    }
     
-    // Parse request
-    char method[64];
-    char path[256];
+    if (strcmp(method, "DELETE") == 0 && has_component) {
+        if (logger_clear_component_level(component) != 0) {
+            send_404_not_found(conn);
+            return;
+        }
+        LOG_INFO("Log level override for '%s' removed", component);
+        send_log_levels(conn);
+        return;
+    }
     
-    if (parse_http_request(request, method, sizeof(method), 
-                          path, sizeof(path)) != 0) {
-        LOG_DEBUG("Invalid HTTP request");
-        send_400_bad_request(client_fd);
+    if ((strcmp(method, "PUT") == 0 || strcmp(method, "POST") == 0) && has_level &&
+        logger_parse_level(level_name, &level) == 0) {
+        if (has_component) {
+            if (logger_set_component_level(component, level) != 0) {
+                send_400_bad_request(conn);
+                return;
+            }
+            LOG_INFO("Log level for '%s' set to %s", component, logger_level_to_string(level));
+        } else {
+            logger_set_level(level);
+            LOG_INFO("Global log level set to %s", logger_level_to_string(level));
+        }
+        send_log_levels(conn);
         return;
     }
     
+    send_400_bad_request(conn);
+}
+
+static void handle_index_request(metrics_server_t *server, http_conn_t *conn) {
+    char body[1024];
+    int used = snprintf(body, sizeof(body),
+        "Roole Metrics Server\n"
+        "\n"
+        "Available endpoints:\n"
+        "  GET /metrics - Prometheus metrics\n"
+        "  %s /loglevel[?component=NAME][&level=LEVEL] - Log levels\n",
+        __atomic_load_n(&server->log_control, __ATOMIC_RELAXED) ? "GET|PUT|DELETE" : "GET");
+    
+    size_t count = __atomic_load_n(&server->endpoint_count, __ATOMIC_ACQUIRE);
+    for (size_t i = 0; i < count && used > 0 && (size_t)used < sizeof(body); i++) {
+        used += snprintf(body + used, sizeof(body) - used, "  GET %s - JSON snapshot\n",
+                         server->endpoints[i].path);
+    }
+    
+    send_http_response(conn, "200 OK", "text/plain", body);
+}
+
+static void handle_http_request(metrics_server_t *server, http_conn_t *conn,
+                                const http_request_t *req) {
+    const char *method = req->method;
+    const char *path = req->path;
+    int is_get = strcmp(method, "GET") == 0;
+    
     // Route request
-    if (strcmp(method, "GET") == 0 && strcmp(path, "/metrics") == 0) {
-        handle_metrics_request(client_fd, registry);
-    } else if (strcmp(method, "GET") == 0 && strcmp(path, "/") == 0) {
-        // Root path - return simple info page
-        const char *body = 
-            "Roole Metrics Server\n"
-            "\n"
-            "Available endpoints:\n"
-            "  GET /metrics - Prometheus metrics\n";
-        send_http_response(client_fd, "200 OK", "text/plain", body);
-    } else {
-        LOG_DEBUG("Request not found: %s %s", method, path);
-        send_404_not_found(client_fd);
+    if (is_get && strcmp(path, "/metrics") == 0) {
+        handle_metrics_request(server, conn, req);
+        return;
+    }
+    if (strcmp(path, "/loglevel") == 0) {
+        handle_loglevel_request(server, conn, method, req->query);
+        return;
+    }
+    if (is_get && strcmp(path, "/") == 0) {
+        handle_index_request(server, conn);
+        return;
+    }
+    
+    size_t count = __atomic_load_n(&server->endpoint_count, __ATOMIC_ACQUIRE);
+    for (size_t i = 0; is_get && i < count; i++) {
+        if (strcmp(path, server->endpoints[i].path) == 0) {
+            handle_endpoint_request(conn, &server->endpoints[i]);
+            return;
+        }
     }
+    
+    LOG_DEBUG("Request not found: %s %s", method, path);
+    send_404_not_found(conn);
 }
 
 // ============================================================================
 // CLIENT CONNECTION HANDLING
 // ============================================================================
 
-static void handle_client_connection(int client_fd, metrics_registry_t *registry) {
-    // Set socket timeout to prevent hanging
-    struct timeval tv;
-    tv.tv_sec = 5;   // 5 second timeout
-    tv.tv_usec = 0;
-    
-    if (setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0) {
-        LOG_WARN("Failed to set socket receive timeout: %s", strerror(errno));
+// Finish the current response, then answer any pipelined requests
+// @return -1 if the connection was closed
+static int conn_progress(metrics_server_t *server, http_conn_t *conn) {
+    for (;;) {
+        if (conn->sending) {
+            int rc = conn_flush(conn);
+            if (rc < 0) {
+                LOG_DEBUG("Failed to send metrics response: %s", strerror(errno));
+                conn_close(server, conn);
+                return -1;
+            }
+            if (rc == 0) break;             // Resumed on EPOLLOUT
+            
+            conn_reset_response(conn);
+            if (conn->close_after) {
+                conn_close(server, conn);
+                return -1;
+            }
+        }
+        
+        http_request_t req;
+        int parsed = parse_http_request(conn->in, conn->in_len, &req);
+        if (parsed == 0) break;             // Wait for the rest
+        
+        if (parsed < 0) {
+            LOG_DEBUG("Invalid HTTP request");
+            conn->close_after = 1;
+            conn->in_len = 0;
+            send_400_bad_request(conn);
+            continue;
+        }
+        
+        conn->close_after = !req.keep_alive;
+        handle_http_request(server, conn, &req);
+        
+        memmove(conn->in, conn->in + req.length, conn->in_len - req.length);
+        conn->in_len -= req.length;
     }
     
-    if (setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) < 0) {
-        LOG_WARN("Failed to set socket send timeout: %s", strerror(errno));
+    conn_watch(server, conn);
+    return 0;
+}
+
+static void conn_on_readable(metrics_server_t *server, http_conn_t *conn) {
+    for (;;) {
+        if (conn->in_len == sizeof(conn->in)) break;    // Parser rejects it
+        
+        ssize_t n = recv(conn->fd, conn->in + conn->in_len, sizeof(conn->in) - conn->in_len, 0);
+        if (n > 0) {
+            conn->in_len += (size_t)n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        
+        // Closed by the client (or reset)
+        conn_close(server, conn);
+        return;
     }
     
-    // Handle the HTTP request
-    handle_http_request(client_fd, registry);
-    
-    // Close connection (HTTP/1.1 Connection: close)
-    close(client_fd);
+    conn->last_active_ms = time_now_ms();
+    conn_progress(server, conn);
+}
+
+static void accept_connections(metrics_server_t *server) {
+    for (;;) {
+        struct sockaddr_in client_addr;
+        socklen_t client_len = sizeof(client_addr);
+        
+        int client_fd = accept(server->server_fd, (struct sockaddr*)&client_addr,
+                               &client_len);
+        if (client_fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                LOG_WARN_RATELIMITED("accept() failed: %s", strerror(errno));
+            }
+            return;
+        }
+        
+        if (server->conn_count >= METRICS_SERVER_MAX_CONNECTIONS) {
+            LOG_WARN_RATELIMITED("Metrics server at %d connections, refusing client",
+                                 METRICS_SERVER_MAX_CONNECTIONS);
+            close(client_fd);
+            continue;
+        }
+        
+        int flags = fcntl(client_fd, F_GETFL, 0);
+        http_conn_t *conn = calloc(1, sizeof(http_conn_t));
+        if (!conn || flags < 0 || fcntl(client_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+            free(conn);
+            close(client_fd);
+            continue;
+        }
+        conn->fd = client_fd;
+        conn->last_active_ms = time_now_ms();
+        
+        int opt = 1;
+        setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+        
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.ptr = conn;
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, client_fd, &ev) < 0) {
+            LOG_ERROR("epoll_ctl(ADD) failed: %s", strerror(errno));
+            close(client_fd);
+            free(conn);
+            continue;
+        }
+        server->conns[server->conn_count++] = conn;
+        
+        // Get client IP for logging
+        char client_ip[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, sizeof(client_ip));
+        LOG_DEBUG("Accepted connection from %s:%u",
+                  client_ip, ntohs(client_addr.sin_port));
+    }
+}
+
+// Drop keep-alive connections (and stalled senders) idle for too long
+static void close_idle_connections(metrics_server_t *server) {
+    uint64_t now = time_now_ms();
+    for (size_t i = server->conn_count; i > 0; i--) {
+        http_conn_t *conn = server->conns[i - 1];
+        if (now - conn->last_active_ms >= METRICS_SERVER_IDLE_TIMEOUT_MS) {
+            LOG_DEBUG("Closing idle metrics connection");
+            conn_close(server, conn);
+        }
+    }
 }
 
 // ============================================================================
@@ -229,7 +773,7 @@ static int setup_server_socket(const char *bind_addr, uint16_t port) {
     int opt = 1;
     
     // Create socket
-    server_fd = socket(AF_INET, SOCK_STREAM, 0);
+    server_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (server_fd < 0) {
         LOG_ERROR("Failed to create server socket: %s", strerror(errno));
         return -1;
@@ -240,13 +784,6 @@ static int setup_server_socket(const char *bind_addr, uint16_t port) {
         LOG_WARN("Failed to set SO_REUSEADDR: %s", strerror(errno));
     }
     
-    // Set SO_REUSEPORT if available (for better multi-threaded performance)
-#ifdef SO_REUSEPORT
-    if (setsockopt(server_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
-        LOG_DEBUG("Failed to set SO_REUSEPORT (not critical): %s", strerror(errno));
-    }
-#endif
-    
     // Prepare address structure
     memset(&addr, 0, sizeof(addr));
     addr.sin_family = AF_INET;
@@ -273,15 +810,6 @@ static int setup_server_socket(const char *bind_addr, uint16_t port) {
         return -1;
     }
     
-    // ✅ NOW set non-blocking (AFTER listen succeeds)
-    int flags = fcntl(server_fd, F_GETFL, 0);
-    if (flags >= 0) {
-        if (fcntl(server_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
-            LOG_WARN("Failed to set non-blocking mode: %s", strerror(errno));
-            // Continue anyway - not critical
-        }
-    }
-    
     LOG_INFO("Metrics server socket bound to %s:%u", bind_addr, port);
     return server_fd;
 }
@@ -294,98 +822,50 @@ static void* metrics_server_thread_fn(void *arg) {
     metrics_server_t *server = (metrics_server_t*)arg;
     
     logger_push_component("metrics:http");
-    LOG_INFO("Metrics HTTP server thread started (bind=%s, port=%u)", 
-             server->bind_addr, server->port);
-    
-    // Setup server socket
-    server->server_fd = setup_server_socket(server->bind_addr, server->port);
-    if (server->server_fd < 0) {
-        LOG_ERROR("Failed to setup metrics server socket on %s:%u", 
-                  server->bind_addr, server->port);
-        return NULL;
-    }
-    
-    LOG_INFO("Metrics server ready at http://%s:%u/metrics",
+    LOG_INFO("Metrics HTTP server thread started (bind=%s, port=%u)",
              server->bind_addr, server->port);
     
-    // NOW set socket to non-blocking (AFTER listen succeeds)
-    int flags = fcntl(server->server_fd, F_GETFL, 0);
-    if (flags >= 0) {
-        fcntl(server->server_fd, F_SETFL, flags | O_NONBLOCK);
-    }
+    struct epoll_event events[MAX_EPOLL_EVENTS];
+    uint64_t last_sweep_ms = time_now_ms();
     
-    // Main accept loop
-    while (!server->shutdown_flag) {
-        struct sockaddr_in client_addr;
-        socklen_t client_len = sizeof(client_addr);
-        
-        // Accept with timeout using select
-        fd_set read_fds;
-        struct timeval tv;
-        
-        FD_ZERO(&read_fds);
-        FD_SET(server->server_fd, &read_fds);
-        
-        tv.tv_sec = ACCEPT_TIMEOUT_SEC;
-        tv.tv_usec = 0;
-        
-        int select_result = select(server->server_fd + 1, &read_fds, 
-                                   NULL, NULL, &tv);
-        
-        if (select_result < 0) {
-            if (errno == EINTR) {
-                // Interrupted by signal, check shutdown flag
-                continue;
-            }
-            LOG_ERROR("select() failed: %s", strerror(errno));
+    while (!__atomic_load_n(&server->shutdown_flag, __ATOMIC_ACQUIRE)) {
+        int nfds = epoll_wait(server->epoll_fd, events, MAX_EPOLL_EVENTS, EPOLL_TIMEOUT_MS);
+        if (nfds < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR("epoll_wait() failed: %s", strerror(errno));
             break;
         }
         
-        if (select_result == 0) {
-            // Timeout - check shutdown flag and continue
-            continue;
-        }
-        
-        // Socket is ready for accept
-        int client_fd = accept(server->server_fd, 
-                              (struct sockaddr*)&client_addr, 
-                              &client_len);
-        
-        if (client_fd < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                // Would block (shouldn't happen after select, but handle it)
-                continue;
-            }
+        for (int i = 0; i < nfds; i++) {
+            void *ptr = events[i].data.ptr;
             
-            if (server->shutdown_flag) {
-                // Shutting down
-                break;
+            if (ptr == &server->server_fd) {
+                accept_connections(server);
+            } else if (ptr == &server->wake_fd) {
+                continue;                   // Shutdown; flag checked by the loop
+            } else {
+                http_conn_t *conn = ptr;
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    conn_close(server, conn);
+                } else if (events[i].events & EPOLLIN) {
+                    conn_on_readable(server, conn);
+                } else if (events[i].events & EPOLLOUT) {
+                    conn->last_active_ms = time_now_ms();
+                    conn_progress(server, conn);
+                }
             }
-            
-            if (errno == EINTR) {
-                // Interrupted by signal
-                continue;
-            }
-            
-            LOG_WARN("accept() failed: %s", strerror(errno));
-            usleep(100000);  // Brief pause to avoid tight loop on persistent errors
-            continue;
         }
         
-        // Get client IP for logging
-        char client_ip[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, sizeof(client_ip));
-        LOG_DEBUG("Accepted connection from %s:%u", 
-                  client_ip, ntohs(client_addr.sin_port));
-        
-        // Handle client request (synchronous - simple but sufficient for metrics)
-        handle_client_connection(client_fd, server->registry);
+        uint64_t now = time_now_ms();
+        if (now - last_sweep_ms >= EPOLL_TIMEOUT_MS) {
+            close_idle_connections(server);
+            last_sweep_ms = now;
+        }
     }
     
     // Cleanup
-    if (server->server_fd >= 0) {
-        close(server->server_fd);
-        server->server_fd = -1;
+    while (server->conn_count > 0) {
+        conn_close(server, server->conns[server->conn_count - 1]);
     }
     
     LOG_INFO("Metrics HTTP server thread stopped");
@@ -397,6 +877,23 @@ static void* metrics_server_thread_fn(void *arg) {
 // PUBLIC API
 // ============================================================================
 
+static void server_free(metrics_server_t *server) {
+    if (server->server_fd >= 0) close(server->server_fd);
+    if (server->wake_fd >= 0) close(server->wake_fd);
+    if (server->epoll_fd >= 0) close(server->epoll_fd);
+    metrics_text_release(server->gzip_source);
+    blob_release(server->gzip_blob);
+    pthread_mutex_destroy(&server->endpoint_lock);
+    free(server);
+}
+
+static int watch_fd(metrics_server_t *server, int fd, void *tag) {
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.ptr = tag;
+    return epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+}
+
 metrics_server_t* metrics_server_start(metrics_registry_t *registry,
                                         const char *bind_addr,
                                         uint16_t port) {
@@ -417,32 +914,84 @@ metrics_server_t* metrics_server_start(metrics_registry_t *registry,
     server->port = port;
     server->shutdown_flag = 0;
     server->server_fd = -1;
+    server->wake_fd = -1;
+    server->epoll_fd = -1;
+    pthread_mutex_init(&server->endpoint_lock, NULL);
     
     if (safe_strncpy(server->bind_addr, bind_addr, sizeof(server->bind_addr)) != 0) {
         LOG_ERROR("Bind address too long: %s", bind_addr);
-        free(server);
+        server_free(server);
+        return NULL;
+    }
+    
+    // Bind here so callers learn about a taken port immediately
+    server->server_fd = setup_server_socket(server->bind_addr, server->port);
+    server->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    server->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    
+    if (server->server_fd < 0 || server->epoll_fd < 0 || server->wake_fd < 0 ||
+        watch_fd(server, server->server_fd, &server->server_fd) < 0 ||
+        watch_fd(server, server->wake_fd, &server->wake_fd) < 0) {
+        LOG_ERROR("Failed to setup metrics server socket on %s:%u", bind_addr, port);
+        server_free(server);
         return NULL;
     }
     
     // Start server thread
-    if (pthread_create(&server->server_thread, NULL, 
+    if (pthread_create(&server->server_thread, NULL,
                       metrics_server_thread_fn, server) != 0) {
         LOG_ERROR("Failed to create metrics server thread: %s", strerror(errno));
-        free(server);
+        server_free(server);
         return NULL;
     }
     
-    // Detach thread (no need to join on shutdown)
-    if (pthread_detach(server->server_thread) != 0) {
-        LOG_WARN("Failed to detach metrics server thread: %s", strerror(errno));
+    LOG_INFO("Metrics server ready at http://%s:%u/metrics", bind_addr, port);
+    return server;
+}
+
+int metrics_server_add_endpoint(metrics_server_t *server, const char *path,
+                                metrics_endpoint_fn handler, void *ctx) {
+    if (!server || !path || path[0] != '/' || !handler ||
+        strlen(path) >= ENDPOINT_PATH_LEN) {
+        return -1;
+    }
+    
+    pthread_mutex_lock(&server->endpoint_lock);
+    
+    size_t count = server->endpoint_count;
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(server->endpoints[i].path, path) == 0) {
+            pthread_mutex_unlock(&server->endpoint_lock);
+            LOG_ERROR("Metrics endpoint %s already registered", path);
+            return -1;
+        }
+    }
+    if (count >= METRICS_SERVER_MAX_ENDPOINTS) {
+        pthread_mutex_unlock(&server->endpoint_lock);
+        LOG_ERROR("Too many metrics endpoints (max: %d)", METRICS_SERVER_MAX_ENDPOINTS);
+        return -1;
     }
     
-    LOG_INFO("Metrics server starting on http://%s:%u/metrics", bind_addr, port);
+    http_endpoint_t *endpoint = &server->endpoints[count];
+    safe_strncpy(endpoint->path, path, sizeof(endpoint->path));
+    endpoint->handler = handler;
+    endpoint->ctx = ctx;
+    __atomic_store_n(&server->endpoint_count, count + 1, __ATOMIC_RELEASE);
     
-    // Give server thread time to initialize and bind
-    usleep(500000);  // 500ms - increased to ensure binding completes
+    pthread_mutex_unlock(&server->endpoint_lock);
     
-    return server;
+    LOG_INFO("Metrics endpoint registered: %s", path);
+    return 0;
+}
+
+void metrics_server_set_log_control(metrics_server_t *server, int enabled) {
+    if (!server) return;
+    
+    __atomic_store_n(&server->log_control, enabled ? 1 : 0, __ATOMIC_RELAXED);
+    if (enabled) {
+        LOG_WARN("Log levels can be changed over HTTP on %s:%u (unauthenticated)",
+                 server->bind_addr, server->port);
+    }
 }
 
 void metrics_server_shutdown(metrics_server_t *server) {
@@ -450,21 +999,15 @@ void metrics_server_shutdown(metrics_server_t *server) {
     
     LOG_INFO("Shutting down metrics server on port %u", server->port);
     
-    // Signal shutdown
-    server->shutdown_flag = 1;
-    
-    // Close server socket to unblock accept()
-    if (server->server_fd >= 0) {
-        shutdown(server->server_fd, SHUT_RDWR);
-        close(server->server_fd);
-        server->server_fd = -1;
+    // Signal shutdown and wake the loop
+    __atomic_store_n(&server->shutdown_flag, 1, __ATOMIC_RELEASE);
+    uint64_t one = 1;
+    if (write(server->wake_fd, &one, sizeof(one)) < 0) {
+        LOG_WARN("Failed to wake metrics server: %s", strerror(errno));
     }
     
-    // Give thread time to exit gracefully
-    usleep(500000);  // 500ms
-    
-    // Free server structure
-    free(server);
+    pthread_join(server->server_thread, NULL);
+    server_free(server);
     
     LOG_INFO("Metrics server shutdown complete");
-}
\ No newline at end of file
+}
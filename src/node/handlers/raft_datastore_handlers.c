@@ -8,6 +8,7 @@
 #include "roole/raft/raft_datastore.h"
 #include "roole/raft/raft_state.h"
 #include "roole/core/common.h"
+#include "roole/core/trace.h"
 #include "roole/logger/logger.h"
 #include <stdlib.h>
 #include <string.h>
@@ -41,6 +42,7 @@ int handle_raft_kv_set(const uint8_t *request,
     }
     
     // Parse key length and key
+    uint64_t parse_start = trace_begin();
     if (ptr + 2 > end) return RPC_STATUS_BAD_ARGUMENT;
     uint16_t key_len_net;
     memcpy(&key_len_net, ptr, 2);
@@ -70,6 +72,7 @@ int handle_raft_kv_set(const uint8_t *request,
     }
     
     const uint8_t *value = ptr;
+    trace_end(TRACE_STAGE_INGRESS_PARSE, parse_start, request_len);
     
     LOG_DEBUG("Raft KV SET: key=%s, value_len=%u", key, value_len);
     
@@ -234,6 +237,7 @@ int handle_raft_kv_unset(const uint8_t *request,
     }
     
     // Parse key
+    uint64_t parse_start = trace_begin();
     if (ptr + 2 > end) return RPC_STATUS_BAD_ARGUMENT;
     uint16_t key_len_net;
     memcpy(&key_len_net, ptr, 2);
@@ -247,6 +251,7 @@ int handle_raft_kv_unset(const uint8_t *request,
     char key[RAFT_KV_MAX_KEY_LEN];
     memcpy(key, ptr, key_len);
     key[key_len] = '\0';
+    trace_end(TRACE_STAGE_INGRESS_PARSE, parse_start, request_len);
     
     LOG_DEBUG("Raft KV UNSET: key=%s", key);
     
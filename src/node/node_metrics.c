@@ -3,15 +3,51 @@
 
 #define _POSIX_C_SOURCE 200809L
 
-#include "roole/node/node_state.h"
+#include "roole/node/node_metrics.h"
 #include "roole/config/config.h"
 #include "roole/core/common.h"
 #include "roole/core/event_bus.h"
 #include "roole/core/service_registry.h"
+#include "roole/core/trace.h"
 #include "roole/metrics/metrics.h"
+#include "roole/rpc/rpc_server.h"
+#include "roole/rpc/rpc_types.h"
+#include "roole/gossip/gossip_engine.h"
 #include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
 
+#define NUM_STANDARD_LABELS 3
+#define MAX_EXPORTED_LANES 16
+
+// ============================================================================
+// LABELS
+// ============================================================================
+
+// cluster_name, node_id, node_type: carried by every series this node exports
+static void build_standard_labels(node_state_t *state, metric_label_t *labels) {
+    const node_identity_t *id = node_state_get_identity(state);
+    const node_capabilities_t *caps = node_state_get_capabilities(state);
+    
+    safe_strncpy(labels[0].name, "cluster_name", MAX_LABEL_NAME_LEN);
+    safe_strncpy(labels[0].value, id->cluster_name, MAX_LABEL_VALUE_LEN);
+    safe_strncpy(labels[1].name, "node_id", MAX_LABEL_NAME_LEN);
+    snprintf(labels[1].value, MAX_LABEL_VALUE_LEN, "%u", id->node_id);
+    safe_strncpy(labels[2].name, "node_type", MAX_LABEL_NAME_LEN);
+    safe_strncpy(labels[2].value, caps->has_ingress ? "router" : "worker",
+                 MAX_LABEL_VALUE_LEN);
+}
+
+// Standard labels plus one more
+static size_t build_labels_with(node_state_t *state, metric_label_t *labels,
+                                const char *name, const char *value) {
+    build_standard_labels(state, labels);
+    safe_strncpy(labels[NUM_STANDARD_LABELS].name, name, MAX_LABEL_NAME_LEN);
+    safe_strncpy(labels[NUM_STANDARD_LABELS].value, value, MAX_LABEL_VALUE_LEN);
+    return NUM_STANDARD_LABELS + 1;
+}
+
 // ============================================================================
 // DATASTORE CHANGE CALLBACK
 // ============================================================================
@@ -44,6 +80,607 @@ static void on_datastore_changed(const char *key, const char *op, void *user_dat
     LOG_DEBUG("Datastore changed: key=%s, op=%s", key, op);
 }
 
+// ============================================================================
+// DEBUG ENDPOINTS
+// ============================================================================
+
+// Served by the metrics server thread. Each copies state out through
+// snapshots or stats accessors, so a scrape never holds a lock the raft,
+// gossip or RPC paths wait on.
+
+// snprintf-style append: keeps counting past cap so the caller learns the
+// size it needs
+static void json_append(char *buf, size_t cap, int *used, const char *fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static void json_append(char *buf, size_t cap, int *used, const char *fmt, ...) {
+    size_t offset = (size_t)*used < cap ? (size_t)*used : cap;
+    
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf + offset, cap - offset, fmt, args);
+    va_end(args);
+    
+    if (n > 0) *used += n;
+}
+
+static int debug_raft_json(void *ctx, char *buf, size_t cap) {
+    node_state_t *state = (node_state_t*)ctx;
+    int used = 0;
+    
+    if (!state->raft_state) {
+        json_append(buf, cap, &used, "{\"enabled\":false}\n");
+        return used;
+    }
+    
+    raft_stats_t stats;
+    raft_get_stats(state->raft_state, &stats);
+    uint64_t commit = raft_get_commit_index(state->raft_state);
+    uint64_t applied = raft_get_last_applied(state->raft_state);
+    
+    json_append(buf, cap, &used,
+                "{\"enabled\":true,\"role\":\"%s\",\"term\":%lu,\"leader\":%u,"
+                "\"commit_index\":%lu,\"last_applied\":%lu,\"apply_lag\":%lu,",
+                raft_state_to_string(raft_get_state(state->raft_state)),
+                raft_get_term(state->raft_state),
+                (unsigned)raft_get_leader(state->raft_state),
+                commit, applied, commit > applied ? commit - applied : 0);
+    json_append(buf, cap, &used,
+                "\"stats\":{\"elections_started\":%lu,\"elections_won\":%lu,"
+                "\"votes_received\":%lu,\"votes_rejected\":%lu,"
+                "\"append_entries_sent\":%lu,\"append_entries_received\":%lu,"
+                "\"append_entries_success\":%lu,\"append_entries_failed\":%lu,"
+                "\"commands_received\":%lu,\"commands_committed\":%lu,"
+                "\"commands_applied\":%lu,\"snapshots_created\":%lu,"
+                "\"snapshots_installed\":%lu,\"became_follower\":%lu,"
+                "\"became_candidate\":%lu,\"became_leader\":%lu}}\n",
+                stats.elections_started, stats.elections_won,
+                stats.votes_received, stats.votes_rejected,
+                stats.append_entries_sent, stats.append_entries_received,
+                stats.append_entries_success, stats.append_entries_failed,
+                stats.commands_received, stats.commands_committed,
+                stats.commands_applied, stats.snapshots_created,
+                stats.snapshots_installed, stats.became_follower,
+                stats.became_candidate, stats.became_leader);
+    return used;
+}
+
+static const char* member_status_name(node_status_t status) {
+    switch (status) {
+        case NODE_STATUS_ALIVE: return "alive";
+        case NODE_STATUS_SUSPECT: return "suspect";
+        case NODE_STATUS_DEAD: return "dead";
+    }
+    return "unknown";
+}
+
+static const char* member_type_name(node_type_t type) {
+    switch (type) {
+        case NODE_TYPE_ROUTER: return "router";
+        case NODE_TYPE_WORKER: return "worker";
+        case NODE_TYPE_UNKNOWN: break;
+    }
+    return "unknown";
+}
+
+static int debug_cluster_json(void *ctx, char *buf, size_t cap) {
+    node_state_t *state = (node_state_t*)ctx;
+    int used = 0;
+    
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(state->cluster_view);
+    if (!snap) return -1;
+    
+    uint64_t now = time_now_ms();
+    json_append(buf, cap, &used, "{\"self\":%u,\"version\":%lu,\"count\":%zu,\"members\":[",
+                (unsigned)state->identity.node_id, snap->version, snap->count);
+    
+    for (size_t i = 0; i < snap->count; i++) {
+        const cluster_member_t *m = &snap->members[i];
+        json_append(buf, cap, &used,
+                    "%s{\"node_id\":%u,\"type\":\"%s\",\"ip\":\"%s\",\"gossip_port\":%u,"
+                    "\"data_port\":%u,\"status\":\"%s\",\"last_seen_ms_ago\":%lu,"
+                    "\"incarnation\":%lu}",
+                    i > 0 ? "," : "", (unsigned)m->node_id, member_type_name(m->node_type),
+                    m->ip_address, m->gossip_port, m->data_port,
+                    member_status_name(m->status),
+                    now > m->last_seen_ms ? now - m->last_seen_ms : 0, m->incarnation);
+    }
+    json_append(buf, cap, &used, "]}\n");
+    
+    cluster_view_snapshot_release(snap);
+    return used;
+}
+
+static void rpc_stats_json(char *buf, size_t cap, int *used, const char *name,
+                           const char *sep) {
+    service_registry_t *registry = service_registry_global();
+    rpc_server_t *server = registry ?
+        (rpc_server_t*)service_registry_get(registry, SERVICE_TYPE_RPC_SERVER, name) : NULL;
+    
+    if (!server) {
+        json_append(buf, cap, used, "%s\"%s\":null", sep, name);
+        return;
+    }
+    
+    rpc_server_stats_t stats;
+    rpc_server_get_stats(server, &stats);
+    uint64_t done = stats.requests_processed + stats.requests_failed;
+    
+    json_append(buf, cap, used,
+                "%s\"%s\":{\"requests_received\":%lu,\"requests_processed\":%lu,"
+                "\"requests_failed\":%lu,\"requests_inflight\":%lu,"
+                "\"bytes_received\":%lu,\"bytes_sent\":%lu,\"active_connections\":%zu}",
+                sep, name, stats.requests_received, stats.requests_processed,
+                stats.requests_failed,
+                stats.requests_received > done ? stats.requests_received - done : 0,
+                stats.bytes_received, stats.bytes_sent, stats.active_connections);
+}
+
+static int debug_rpc_json(void *ctx, char *buf, size_t cap) {
+    (void)ctx;
+    int used = 0;
+    
+    json_append(buf, cap, &used, "{");
+    rpc_stats_json(buf, cap, &used, "data", "");
+    rpc_stats_json(buf, cap, &used, "ingress", ",");
+    json_append(buf, cap, &used, "}\n");
+    return used;
+}
+
+// ============================================================================
+// COLLECTORS
+// ============================================================================
+
+// Subsystems keep their own counters; these copy them into the registry
+// when a scrape renders, so nothing polls in the background. Series are
+// created on first use and found by hash on later scrapes.
+
+typedef struct stat_field {
+    const char *name;
+    const char *help;
+    metric_type_t type;
+    size_t offset;                    // uint64_t field of the stats struct
+} stat_field_t;
+
+#define STAT_COUNTER(st, field, name, help) \
+    { name, help, METRIC_TYPE_COUNTER, offsetof(st, field) }
+#define STAT_GAUGE(st, field, name, help) \
+    { name, help, METRIC_TYPE_GAUGE, offsetof(st, field) }
+
+static void export_stats(metrics_registry_t *reg, const stat_field_t *fields, size_t count,
+                         const void *stats, size_t num_labels, const metric_label_t *labels) {
+    for (size_t i = 0; i < count; i++) {
+        const stat_field_t *f = &fields[i];
+        double value = (double)*(const uint64_t*)((const char*)stats + f->offset);
+        
+        if (f->type == METRIC_TYPE_COUNTER) {
+            metrics_counter_set(metrics_get_or_create_counter(reg, f->name, f->help,
+                                                              num_labels, labels), value);
+        } else {
+            metrics_gauge_set(metrics_get_or_create_gauge(reg, f->name, f->help,
+                                                          num_labels, labels), value);
+        }
+    }
+}
+
+static void export_gauge(metrics_registry_t *reg, const char *name, const char *help,
+                         size_t num_labels, const metric_label_t *labels, double value) {
+    metrics_gauge_set(metrics_get_or_create_gauge(reg, name, help, num_labels, labels), value);
+}
+
+// Uptime, datastore and membership gauges
+static void collect_node(metrics_registry_t *reg, void *ctx) {
+    (void)reg;
+    node_state_t *state = (node_state_t*)ctx;
+    
+    if (state->metric_uptime_seconds) {
+        uint64_t uptime_seconds = (time_now_ms() - state->start_time_ms) / 1000;
+        metrics_gauge_set(state->metric_uptime_seconds, (double)uptime_seconds);
+    }
+    
+    if (state->datastore) {
+        if (state->metric_datastore_size) {
+            size_t count = datastore_count(state->datastore);
+            metrics_gauge_set(state->metric_datastore_size, (double)count);
+        }
+        
+        if (state->metric_datastore_bytes) {
+            datastore_stats_t stats;
+            datastore_get_stats(state->datastore, &stats);
+            metrics_gauge_set(state->metric_datastore_bytes, 
+                             (double)stats.total_value_bytes);
+        }
+    }
+    
+    node_metrics_update_cluster(state);
+}
+
+static const stat_field_t RAFT_FIELDS[] = {
+    STAT_COUNTER(raft_stats_t, elections_started, "raft_elections_started_total", "Elections started"),
+    STAT_COUNTER(raft_stats_t, elections_won, "raft_elections_won_total", "Elections won"),
+    STAT_COUNTER(raft_stats_t, votes_received, "raft_votes_received_total", "Votes received"),
+    STAT_COUNTER(raft_stats_t, votes_rejected, "raft_votes_rejected_total", "Votes rejected"),
+    STAT_COUNTER(raft_stats_t, append_entries_sent, "raft_append_entries_sent_total",
+                 "AppendEntries RPCs sent"),
+    STAT_COUNTER(raft_stats_t, append_entries_received, "raft_append_entries_received_total",
+                 "AppendEntries RPCs received"),
+    STAT_COUNTER(raft_stats_t, append_entries_success, "raft_append_entries_success_total",
+                 "AppendEntries accepted by followers"),
+    STAT_COUNTER(raft_stats_t, append_entries_failed, "raft_append_entries_failed_total",
+                 "AppendEntries rejected by followers"),
+    STAT_COUNTER(raft_stats_t, commands_received, "raft_commands_received_total",
+                 "Client commands received"),
+    STAT_COUNTER(raft_stats_t, commands_committed, "raft_commands_committed_total",
+                 "Client commands committed"),
+    STAT_COUNTER(raft_stats_t, commands_applied, "raft_commands_applied_total",
+                 "Log entries applied to the state machine"),
+    STAT_COUNTER(raft_stats_t, snapshots_created, "raft_snapshots_created_total",
+                 "Snapshots created"),
+    STAT_COUNTER(raft_stats_t, snapshots_installed, "raft_snapshots_installed_total",
+                 "Snapshots installed from the leader"),
+    STAT_COUNTER(raft_stats_t, became_follower, "raft_became_follower_total",
+                 "Transitions to follower"),
+    STAT_COUNTER(raft_stats_t, became_candidate, "raft_became_candidate_total",
+                 "Transitions to candidate"),
+    STAT_COUNTER(raft_stats_t, became_leader, "raft_became_leader_total",
+                 "Transitions to leader"),
+};
+
+static void collect_raft(metrics_registry_t *reg, void *ctx) {
+    node_state_t *state = (node_state_t*)ctx;
+    if (!state->raft_state) return;
+    
+    metrics_gauge_set(state->metric_raft_term, 
+                    (double)raft_get_term(state->raft_state));
+    metrics_gauge_set(state->metric_raft_state,
+                    (double)raft_get_state(state->raft_state));
+    
+    uint64_t commit = raft_get_commit_index(state->raft_state);
+    uint64_t applied = raft_get_last_applied(state->raft_state);
+    metrics_gauge_set(state->metric_raft_commit_index, (double)commit);
+    
+    metric_label_t labels[NUM_STANDARD_LABELS + 1];
+    build_standard_labels(state, labels);
+    
+    export_gauge(reg, "raft_last_applied", "Raft last applied index",
+                 NUM_STANDARD_LABELS, labels, (double)applied);
+    export_gauge(reg, "raft_apply_lag", "Committed entries not yet applied",
+                 NUM_STANDARD_LABELS, labels, (double)(commit > applied ? commit - applied : 0));
+    
+    raft_stats_t stats;
+    raft_get_stats(state->raft_state, &stats);
+    export_stats(reg, RAFT_FIELDS, ROOLE_ARRAY_SIZE(RAFT_FIELDS), &stats,
+                 NUM_STANDARD_LABELS, labels);
+    
+    // Only the leader tracks followers; series keep their last value after
+    // leadership moves
+    raft_peer_progress_t peers[RAFT_MAX_PEERS];
+    size_t count = raft_get_peer_progress(state->raft_state, peers, RAFT_MAX_PEERS);
+    for (size_t i = 0; i < count; i++) {
+        char peer[16];
+        snprintf(peer, sizeof(peer), "%u", (unsigned)peers[i].peer_id);
+        size_t n = build_labels_with(state, labels, "peer", peer);
+        
+        export_gauge(reg, "raft_peer_replication_lag",
+                     "Log entries a follower is behind the leader (reported by the leader)",
+                     n, labels, (double)peers[i].lag);
+        export_gauge(reg, "raft_peer_match_index",
+                     "Highest log index known replicated on a follower",
+                     n, labels, (double)peers[i].match_index);
+    }
+}
+
+static void collect_rpc_server(metrics_registry_t *reg, node_state_t *state, const char *name) {
+    service_registry_t *registry = service_registry_global();
+    rpc_server_t *server = registry ?
+        (rpc_server_t*)service_registry_get(registry, SERVICE_TYPE_RPC_SERVER, name) : NULL;
+    if (!server) return;
+    
+    rpc_server_stats_t stats;
+    rpc_server_get_stats(server, &stats);
+    uint64_t done = stats.requests_processed + stats.requests_failed;
+    
+    metric_label_t labels[NUM_STANDARD_LABELS + 1];
+    size_t n = build_labels_with(state, labels, "server", name);
+    
+    static const stat_field_t fields[] = {
+        STAT_COUNTER(rpc_server_stats_t, requests_received, "rpc_requests_received_total",
+                     "RPC requests received"),
+        STAT_COUNTER(rpc_server_stats_t, requests_processed, "rpc_requests_processed_total",
+                     "RPC requests handled successfully"),
+        STAT_COUNTER(rpc_server_stats_t, requests_failed, "rpc_requests_failed_total",
+                     "RPC requests whose handler failed"),
+        STAT_COUNTER(rpc_server_stats_t, bytes_received, "rpc_received_bytes_total",
+                     "RPC bytes received"),
+        STAT_COUNTER(rpc_server_stats_t, bytes_sent, "rpc_sent_bytes_total",
+                     "RPC bytes sent"),
+    };
+    export_stats(reg, fields, ROOLE_ARRAY_SIZE(fields), &stats, n, labels);
+    
+    export_gauge(reg, "rpc_active_connections", "Open RPC connections",
+                 n, labels, (double)stats.active_connections);
+    export_gauge(reg, "rpc_requests_inflight", "RPC requests received but not yet answered",
+                 n, labels, (double)(stats.requests_received > done ?
+                                     stats.requests_received - done : 0));
+}
+
+static void collect_rpc(metrics_registry_t *reg, void *ctx) {
+    collect_rpc_server(reg, (node_state_t*)ctx, "data");
+    collect_rpc_server(reg, (node_state_t*)ctx, "ingress");
+}
+
+static const stat_field_t GOSSIP_FIELDS[] = {
+    STAT_COUNTER(gossip_protocol_stats_t, pings_sent, "gossip_pings_sent_total", "SWIM PINGs sent"),
+    STAT_COUNTER(gossip_protocol_stats_t, acks_received, "gossip_acks_received_total",
+                 "SWIM ACKs received"),
+    STAT_COUNTER(gossip_protocol_stats_t, ack_timeouts, "gossip_ack_timeouts_total",
+                 "PINGs that timed out without an ACK"),
+    STAT_COUNTER(gossip_protocol_stats_t, suspect_count, "gossip_suspects_total",
+                 "Members marked suspect"),
+    STAT_COUNTER(gossip_protocol_stats_t, dead_count, "gossip_deaths_total",
+                 "Members marked dead"),
+    STAT_COUNTER(gossip_protocol_stats_t, updates_sent, "gossip_updates_sent_total",
+                 "Membership updates piggybacked"),
+    STAT_COUNTER(gossip_protocol_stats_t, updates_received, "gossip_updates_received_total",
+                 "Membership updates received"),
+    STAT_COUNTER(gossip_protocol_stats_t, gossip_sent, "gossip_extra_messages_sent_total",
+                 "Extra dissemination messages (fanout > 1)"),
+    STAT_COUNTER(gossip_protocol_stats_t, rtt_samples, "gossip_rtt_samples_total",
+                 "PING/ACK round trips measured"),
+    STAT_COUNTER(gossip_protocol_stats_t, load_received, "gossip_load_summaries_received_total",
+                 "Peer load summaries received"),
+};
+
+static const stat_field_t TRANSPORT_FIELDS[] = {
+    STAT_COUNTER(udp_transport_stats_t, bytes_sent, "gossip_transport_sent_bytes_total",
+                 "UDP bytes sent"),
+    STAT_COUNTER(udp_transport_stats_t, bytes_received, "gossip_transport_received_bytes_total",
+                 "UDP bytes received"),
+    STAT_COUNTER(udp_transport_stats_t, packets_sent, "gossip_transport_packets_sent_total",
+                 "UDP packets sent"),
+    STAT_COUNTER(udp_transport_stats_t, packets_received,
+                 "gossip_transport_packets_received_total", "UDP packets received"),
+    STAT_COUNTER(udp_transport_stats_t, send_errors, "gossip_transport_send_errors_total",
+                 "UDP send errors"),
+    STAT_COUNTER(udp_transport_stats_t, recv_errors, "gossip_transport_recv_errors_total",
+                 "UDP receive errors"),
+};
+
+static void collect_gossip(metrics_registry_t *reg, void *ctx) {
+    node_state_t *state = (node_state_t*)ctx;
+    gossip_engine_t *engine = membership_get_gossip_engine(state->membership);
+    if (!engine) return;
+    
+    metric_label_t labels[NUM_STANDARD_LABELS];
+    build_standard_labels(state, labels);
+    
+    gossip_protocol_stats_t proto;
+    gossip_engine_get_protocol_stats(engine, &proto);
+    export_stats(reg, GOSSIP_FIELDS, ROOLE_ARRAY_SIZE(GOSSIP_FIELDS), &proto,
+                 NUM_STANDARD_LABELS, labels);
+    export_gauge(reg, "gossip_period_ms", "Current adaptive protocol period",
+                 NUM_STANDARD_LABELS, labels, (double)proto.current_period_ms);
+    export_gauge(reg, "gossip_fanout", "Current adaptive gossip fanout",
+                 NUM_STANDARD_LABELS, labels, (double)proto.current_fanout);
+    
+    udp_transport_stats_t transport;
+    gossip_engine_get_transport_stats(engine, &transport);
+    export_stats(reg, TRANSPORT_FIELDS, ROOLE_ARRAY_SIZE(TRANSPORT_FIELDS), &transport,
+                 NUM_STANDARD_LABELS, labels);
+}
+
+static const stat_field_t EVENT_BUS_FIELDS[] = {
+    STAT_COUNTER(event_bus_stats_t, events_published, "event_bus_published_total",
+                 "Events published"),
+    STAT_COUNTER(event_bus_stats_t, events_dispatched, "event_bus_dispatched_total",
+                 "Events delivered to handlers"),
+    STAT_COUNTER(event_bus_stats_t, events_dropped, "event_bus_dropped_total",
+                 "Events dropped on a full queue"),
+    STAT_COUNTER(event_bus_stats_t, events_coalesced, "event_bus_coalesced_total",
+                 "Events superseded before delivery"),
+    STAT_COUNTER(event_bus_stats_t, payload_pool_misses, "event_bus_payload_pool_misses_total",
+                 "Large payloads that fell back to malloc"),
+    STAT_GAUGE(event_bus_stats_t, queue_size, "event_bus_queue_size",
+               "Events queued across all lanes"),
+    STAT_GAUGE(event_bus_stats_t, subscribers_total, "event_bus_subscribers",
+               "Registered subscribers"),
+};
+
+static const stat_field_t EVENT_LANE_FIELDS[] = {
+    STAT_GAUGE(event_bus_lane_stats_t, queue_depth, "event_bus_lane_queue_depth",
+               "Events queued on a lane"),
+    STAT_COUNTER(event_bus_lane_stats_t, dispatched, "event_bus_lane_dispatched_total",
+                 "Events taken off a lane"),
+    STAT_COUNTER(event_bus_lane_stats_t, dropped, "event_bus_lane_dropped_total",
+                 "Events dropped on a full lane"),
+    STAT_COUNTER(event_bus_lane_stats_t, coalesced, "event_bus_lane_coalesced_total",
+                 "Events superseded on a lane"),
+    STAT_GAUGE(event_bus_lane_stats_t, avg_latency_us, "event_bus_lane_latency_avg_us",
+               "Average publish-to-handled latency"),
+    STAT_GAUGE(event_bus_lane_stats_t, max_latency_us, "event_bus_lane_latency_max_us",
+               "Maximum publish-to-handled latency"),
+};
+
+static void collect_event_bus(metrics_registry_t *reg, void *ctx) {
+    node_state_t *state = (node_state_t*)ctx;
+    if (!state->event_bus) return;
+    
+    metric_label_t labels[NUM_STANDARD_LABELS + 1];
+    build_standard_labels(state, labels);
+    
+    event_bus_stats_t stats;
+    event_bus_get_stats(state->event_bus, &stats);
+    export_stats(reg, EVENT_BUS_FIELDS, ROOLE_ARRAY_SIZE(EVENT_BUS_FIELDS), &stats,
+                 NUM_STANDARD_LABELS, labels);
+    
+    event_bus_lane_stats_t lanes[MAX_EXPORTED_LANES];
+    size_t count = event_bus_get_lane_stats(state->event_bus, lanes, MAX_EXPORTED_LANES);
+    for (size_t i = 0; i < count; i++) {
+        size_t n = build_labels_with(state, labels, "lane", lanes[i].name);
+        export_stats(reg, EVENT_LANE_FIELDS, ROOLE_ARRAY_SIZE(EVENT_LANE_FIELDS), &lanes[i],
+                     n, labels);
+    }
+}
+
+static const metrics_collector_fn NODE_COLLECTORS[] = {
+    collect_node, collect_raft, collect_rpc, collect_gossip, collect_event_bus,
+};
+
+// ============================================================================
+// RPC LATENCY
+// ============================================================================
+
+// One per RPC server: the server calls on_rpc_request for every request,
+// which records into rpc_request_duration_us{...,server,func}. Series are
+// resolved once per func_id and cached.
+struct node_rpc_metrics {
+    rpc_server_observer_t observer;
+    rpc_server_t *server;
+    node_state_t *state;
+    metrics_vec_t *durations;
+    metrics_vec_t *errors;
+    char name[16];
+    histogram_metric_t *by_func[256];
+    metrics_t *errors_by_func[256];
+    struct node_rpc_metrics *next;
+};
+
+static void rpc_func_labels(node_state_t *state, const char *server, uint8_t func_id,
+                            char (*values)[MAX_LABEL_VALUE_LEN], const char **ptrs) {
+    metric_label_t labels[NUM_STANDARD_LABELS];
+    build_standard_labels(state, labels);
+    for (size_t i = 0; i < NUM_STANDARD_LABELS; i++) {
+        safe_strncpy(values[i], labels[i].value, MAX_LABEL_VALUE_LEN);
+    }
+    safe_strncpy(values[NUM_STANDARD_LABELS], server, MAX_LABEL_VALUE_LEN);
+    snprintf(values[NUM_STANDARD_LABELS + 1], MAX_LABEL_VALUE_LEN, "0x%02x", func_id);
+    for (size_t i = 0; i < NUM_STANDARD_LABELS + 2; i++) {
+        ptrs[i] = values[i];
+    }
+}
+
+static void on_rpc_request(void *ctx, uint8_t func_id, uint8_t status, uint64_t duration_us) {
+    struct node_rpc_metrics *m = (struct node_rpc_metrics*)ctx;
+    
+    // Racing resolutions find the same series, so a lost store is harmless
+    histogram_metric_t *hist = __atomic_load_n(&m->by_func[func_id], __ATOMIC_ACQUIRE);
+    if (!hist) {
+        char values[NUM_STANDARD_LABELS + 2][MAX_LABEL_VALUE_LEN];
+        const char *ptrs[NUM_STANDARD_LABELS + 2];
+        rpc_func_labels(m->state, m->name, func_id, values, ptrs);
+        hist = metrics_vec_histogram_with(m->durations, ptrs);
+        __atomic_store_n(&m->by_func[func_id], hist, __ATOMIC_RELEASE);
+    }
+    metrics_histogram_record(hist, duration_us);
+    
+    if (status != RPC_STATUS_SUCCESS) {
+        metrics_t *errors = __atomic_load_n(&m->errors_by_func[func_id], __ATOMIC_ACQUIRE);
+        if (!errors) {
+            char values[NUM_STANDARD_LABELS + 2][MAX_LABEL_VALUE_LEN];
+            const char *ptrs[NUM_STANDARD_LABELS + 2];
+            rpc_func_labels(m->state, m->name, func_id, values, ptrs);
+            errors = metrics_vec_with(m->errors, ptrs);
+            __atomic_store_n(&m->errors_by_func[func_id], errors, __ATOMIC_RELEASE);
+        }
+        metrics_counter_inc(errors);
+    }
+}
+
+void node_metrics_attach_rpc_server(node_state_t *state, rpc_server_t *server,
+                                    const char *name) {
+    if (!state || !server || !name || !state->metrics_registry) return;
+    
+    static const char *label_names[NUM_STANDARD_LABELS + 2] = {
+        "cluster_name", "node_id", "node_type", "server", "func"
+    };
+    
+    struct node_rpc_metrics *m = safe_calloc(1, sizeof(*m));
+    if (!m) return;
+    
+    m->durations = metrics_histogram_vec(state->metrics_registry, "rpc_request_duration_us",
+                                         "RPC handling time (handler and response send)",
+                                         HISTOGRAM_BUCKETS_LATENCY_US,
+                                         NUM_STANDARD_LABELS + 2, label_names);
+    m->errors = metrics_counter_vec(state->metrics_registry, "rpc_request_errors_total",
+                                    "RPC requests answered with a non-success status",
+                                    NUM_STANDARD_LABELS + 2, label_names);
+    if (!m->durations || !m->errors) {
+        safe_free(m);
+        return;
+    }
+    
+    m->server = server;
+    m->state = state;
+    safe_strncpy(m->name, name, sizeof(m->name));
+    m->observer.on_request = on_rpc_request;
+    m->observer.ctx = m;
+    
+    m->next = state->rpc_metrics;
+    state->rpc_metrics = m;
+    rpc_server_set_observer(server, &m->observer);
+}
+
+void node_metrics_detach_rpc_server(node_state_t *state, rpc_server_t *server) {
+    if (!state || !server) return;
+    
+    for (struct node_rpc_metrics **link = &state->rpc_metrics; *link; link = &(*link)->next) {
+        struct node_rpc_metrics *m = *link;
+        if (m->server != server) continue;
+        
+        // Returns once no request is still inside on_rpc_request
+        rpc_server_set_observer(server, NULL);
+        *link = m->next;
+        safe_free(m);
+        return;
+    }
+}
+
+// ============================================================================
+// TRACE STAGES
+// ============================================================================
+
+// Tracing is process-wide, so is its observer: every recorded span lands in
+// trace_stage_duration_us{...,stage}, resolved once per stage at init
+static struct {
+    trace_observer_t observer;
+    histogram_metric_t *by_stage[TRACE_STAGE_COUNT];
+} g_trace_metrics;
+
+static void on_trace_span(void *ctx, const trace_span_t *span) {
+    (void)ctx;
+    histogram_metric_t *hist = g_trace_metrics.by_stage[span->stage];
+    if (hist) {
+        metrics_histogram_record(hist, span->duration_us);
+    }
+}
+
+static void attach_trace_metrics(node_state_t *state) {
+    static const char *label_names[NUM_STANDARD_LABELS + 1] = {
+        "cluster_name", "node_id", "node_type", "stage"
+    };
+    
+    metrics_vec_t *vec = metrics_histogram_vec(state->metrics_registry, "trace_stage_duration_us",
+                                               "Time traced requests spent in each stage",
+                                               HISTOGRAM_BUCKETS_LATENCY_US,
+                                               NUM_STANDARD_LABELS + 1, label_names);
+    if (!vec) return;
+    
+    metric_label_t labels[NUM_STANDARD_LABELS];
+    build_standard_labels(state, labels);
+    const char *values[NUM_STANDARD_LABELS + 1];
+    for (size_t i = 0; i < NUM_STANDARD_LABELS; i++) {
+        values[i] = labels[i].value;
+    }
+    
+    for (int stage = 0; stage < TRACE_STAGE_COUNT; stage++) {
+        values[NUM_STANDARD_LABELS] = trace_stage_name((trace_stage_t)stage);
+        g_trace_metrics.by_stage[stage] = metrics_vec_histogram_with(vec, values);
+    }
+    
+    g_trace_metrics.observer.on_span = on_trace_span;
+    trace_set_observer(&g_trace_metrics.observer);
+}
+
 // ============================================================================
 // METRICS INITIALIZATION
 // ============================================================================
@@ -80,24 +717,8 @@ int node_metrics_init(node_state_t *state, const char *metrics_addr) {
         return RESULT_ERR_NOMEM;
     }
     
-    // Get identity
-    const node_identity_t *id = node_state_get_identity(state);
-    const node_capabilities_t *caps = node_state_get_capabilities(state);
-    
-    // Build standard labels
-    char node_id_str[32];
-    snprintf(node_id_str, sizeof(node_id_str), "%u", id->node_id);
-    
-    const char *node_type_label = caps->has_ingress ? "router" : "worker";
-    
-    // Create standard labels
-    metric_label_t labels[3];
-    safe_strncpy(labels[0].name, "cluster_name", MAX_LABEL_NAME_LEN);
-    safe_strncpy(labels[0].value, id->cluster_name, MAX_LABEL_VALUE_LEN);
-    safe_strncpy(labels[1].name, "node_id", MAX_LABEL_NAME_LEN);
-    safe_strncpy(labels[1].value, node_id_str, MAX_LABEL_VALUE_LEN);
-    safe_strncpy(labels[2].name, "node_type", MAX_LABEL_NAME_LEN);
-    safe_strncpy(labels[2].value, node_type_label, MAX_LABEL_VALUE_LEN);
+    metric_label_t labels[NUM_STANDARD_LABELS];
+    build_standard_labels(state, labels);
     
     // ========================================================================
     // DATASTORE METRICS
@@ -137,7 +758,7 @@ int node_metrics_init(node_state_t *state, const char *metrics_addr) {
         "Total number of UNSET operations",
         3, labels
     );
-
+    
     // ========================================================================
     // RAFT METRICS
     // ========================================================================
@@ -147,14 +768,14 @@ int node_metrics_init(node_state_t *state, const char *metrics_addr) {
         "Current Raft term",
         3, labels
     );
-
+    
     state->metric_raft_state = metrics_get_or_create_gauge(
         state->metrics_registry,
         "raft_state",
         "Raft role (0=follower, 1=candidate, 2=leader)",
         3, labels
     );
-
+    
     state->metric_raft_commit_index = metrics_get_or_create_gauge(
         state->metrics_registry,
         "raft_commit_index",
@@ -219,9 +840,9 @@ int node_metrics_init(node_state_t *state, const char *metrics_addr) {
     
     state->histogram_datastore_op_duration = metrics_get_or_create_histogram(
         state->metrics_registry,
-        "datastore_op_duration_ms",
-        "Histogram of datastore operation duration in milliseconds",
-        HISTOGRAM_BUCKETS_LATENCY_MS,
+        "datastore_op_duration_us",
+        "Histogram of datastore operation duration in microseconds",
+        HISTOGRAM_BUCKETS_LATENCY_US,
         3, labels
     );
     
@@ -237,6 +858,15 @@ int node_metrics_init(node_state_t *state, const char *metrics_addr) {
         LOG_INFO("Datastore change callback registered");
     }
     
+    // ========================================================================
+    // Register scrape-time collectors
+    // ========================================================================
+    
+    for (size_t i = 0; i < ROOLE_ARRAY_SIZE(NODE_COLLECTORS); i++) {
+        metrics_registry_add_collector(state->metrics_registry, NODE_COLLECTORS[i], state);
+    }
+    attach_trace_metrics(state);
+    
     // ========================================================================
     // Start HTTP server
     // ========================================================================
@@ -254,6 +884,13 @@ int node_metrics_init(node_state_t *state, const char *metrics_addr) {
         return RESULT_ERR_NETWORK;
     }
     
+    metrics_server_add_endpoint(state->metrics_server, "/debug/raft", debug_raft_json, state);
+    metrics_server_add_endpoint(state->metrics_server, "/debug/cluster", debug_cluster_json, state);
+    metrics_server_add_endpoint(state->metrics_server, "/debug/rpc", debug_rpc_json, state);
+    metrics_server_add_endpoint(state->metrics_server, "/debug/trace", trace_render_chrome, NULL);
+    metrics_server_add_endpoint(state->metrics_server, "/debug/trace/otlp", trace_render_otlp,
+                                NULL);
+    
     LOG_INFO("Metrics HTTP server started on http://%s:%u/metrics", 
              metrics_ip, metrics_port);
     
@@ -263,6 +900,13 @@ int node_metrics_init(node_state_t *state, const char *metrics_addr) {
 void node_metrics_shutdown(node_state_t *state) {
     if (!state) return;
     
+    // RPC servers and tracing outlive the registry; stop them recording
+    // first (each call waits out requests already in the observer)
+    for (struct node_rpc_metrics *m = state->rpc_metrics; m; m = m->next) {
+        rpc_server_set_observer(m->server, NULL);
+    }
+    trace_set_observer(NULL);
+    
     if (state->metrics_server) {
         metrics_server_shutdown(state->metrics_server);
         state->metrics_server = NULL;
@@ -273,6 +917,12 @@ void node_metrics_shutdown(node_state_t *state) {
         state->metrics_registry = NULL;
     }
     
+    while (state->rpc_metrics) {
+        struct node_rpc_metrics *next = state->rpc_metrics->next;
+        safe_free(state->rpc_metrics);
+        state->rpc_metrics = next;
+    }
+    
     LOG_INFO("Metrics system shutdown complete");
 }
 
@@ -284,17 +934,18 @@ void node_metrics_update_cluster(node_state_t *state) {
     if (!state) return;
     
     cluster_view_t *view = node_state_get_cluster_view(state);
-    if (!view || !view->members) return;
+    if (!view) return;
     
-    pthread_rwlock_rdlock(&view->lock);
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(view);
+    if (!snap) return;
     
-    size_t total = view->count;
+    size_t total = snap->count;
     size_t active = 0;
     size_t suspect = 0;
     size_t dead = 0;
     
     for (size_t i = 0; i < total; i++) {
-        cluster_member_t *member = &view->members[i];
+        const cluster_member_t *member = &snap->members[i];
         
         switch (member->status) {
             case NODE_STATUS_ALIVE:
@@ -311,7 +962,7 @@ void node_metrics_update_cluster(node_state_t *state) {
         }
     }
     
-    pthread_rwlock_unlock(&view->lock);
+    cluster_view_snapshot_release(snap);
     
     // Update metrics
     if (state->metric_cluster_members_total) {
@@ -327,66 +978,3 @@ void node_metrics_update_cluster(node_state_t *state) {
         metrics_gauge_set(state->metric_cluster_members_dead, (double)dead);
     }
 }
-
-// ============================================================================
-// PERIODIC METRICS UPDATE
-// ============================================================================
-
-void node_metrics_update_periodic(node_state_t *state) {
-    if (!state || !state->metrics_registry) return;
-    
-    // Update uptime
-    if (state->metric_uptime_seconds) {
-        uint64_t uptime_seconds = (time_now_ms() - state->start_time_ms) / 1000;
-        metrics_gauge_set(state->metric_uptime_seconds, (double)uptime_seconds);
-    }
-    
-    // Update datastore metrics
-    if (state->datastore) {
-        if (state->metric_datastore_size) {
-            size_t count = datastore_count(state->datastore);
-            metrics_gauge_set(state->metric_datastore_size, (double)count);
-        }
-        
-        if (state->metric_datastore_bytes) {
-            datastore_stats_t stats;
-            datastore_get_stats(state->datastore, &stats);
-            metrics_gauge_set(state->metric_datastore_bytes, 
-                             (double)stats.total_value_bytes);
-        }
-    }
-
-    // Update RAFT metrics
-    if (state->raft_state) {
-        metrics_gauge_set(state->metric_raft_term, 
-                        (double)raft_get_term(state->raft_state));
-        metrics_gauge_set(state->metric_raft_state,
-                        (double)raft_get_state(state->raft_state));
-        metrics_gauge_set(state->metric_raft_commit_index,
-                        (double)raft_get_commit_index(state->raft_state));
-    }
-    
-    // Update cluster metrics
-    node_metrics_update_cluster(state);
-    
-    // Update event bus metrics
-    service_registry_t *registry = service_registry_global();
-    if (registry) {
-        event_bus_t *event_bus = (event_bus_t*)service_registry_get(registry,
-                                                                     SERVICE_TYPE_EVENT_BUS,
-                                                                     "main");
-        if (event_bus) {
-            event_bus_stats_t stats;
-            event_bus_get_stats(event_bus, &stats);
-            
-            static uint64_t last_log = 0;
-            uint64_t now = time_now_ms();
-            if (now - last_log > 60000) {  // Every 60 seconds
-                LOG_INFO("Event bus: published=%lu dispatched=%lu dropped=%lu queue=%lu",
-                        stats.events_published, stats.events_dispatched, 
-                        stats.events_dropped, stats.queue_size);
-                last_log = now;
-            }
-        }
-    }
-}
\ No newline at end of file
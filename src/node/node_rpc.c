@@ -5,8 +5,10 @@
 
 #include "roole/node/node_rpc.h"
 #include "roole/node/node_handlers.h"
+#include "roole/node/node_metrics.h"
 #include "roole/rpc/rpc_server.h"
 #include "roole/core/common.h"
+#include "roole/core/service_registry.h"
 #include <pthread.h>
 #include <unistd.h>
 
@@ -86,6 +88,13 @@ int node_start_rpc_servers(node_state_t *state) {
     
     LOG_INFO("DATA RPC server created successfully");
     
+    // Expose for load reporting (in-flight requests)
+    service_registry_t *services = service_registry_global();
+    if (services) {
+        service_registry_register(services, SERVICE_TYPE_RPC_SERVER, "data", data_server);
+    }
+    node_metrics_attach_rpc_server(state, data_server, "data");
+    
     // Start DATA server thread
     pthread_t data_thread;
     rpc_server_context_t data_ctx = {
@@ -96,6 +105,10 @@ int node_start_rpc_servers(node_state_t *state) {
     
     if (pthread_create(&data_thread, NULL, rpc_server_thread_fn, &data_ctx) != 0) {
         LOG_ERROR("Failed to create DATA server thread");
+        node_metrics_detach_rpc_server(state, data_server);
+        if (services) {
+            service_registry_unregister(services, SERVICE_TYPE_RPC_SERVER, "data");
+        }
         rpc_server_destroy(data_server);
         rpc_handler_registry_destroy(registry);
         return -1;
@@ -112,7 +125,8 @@ int node_start_rpc_servers(node_state_t *state) {
             .channel_type = RPC_CHANNEL_INGRESS,
             .max_connections = 1024,
             .buffer_size = 8192,
-            .recv_timeout_ms = 10000
+            .recv_timeout_ms = 10000,
+            .trace_requests = 1      // Client requests enter the cluster here
         };
         
         rpc_server_t *ingress_server = rpc_server_create(&ingress_config, registry);
@@ -122,6 +136,12 @@ int node_start_rpc_servers(node_state_t *state) {
         } else {
             LOG_INFO("INGRESS RPC server created successfully");
             
+            if (services) {
+                service_registry_register(services, SERVICE_TYPE_RPC_SERVER, "ingress",
+                                          ingress_server);
+            }
+            node_metrics_attach_rpc_server(state, ingress_server, "ingress");
+            
             // Start INGRESS server thread
             pthread_t ingress_thread;
             rpc_server_context_t ingress_ctx = {
@@ -132,6 +152,10 @@ int node_start_rpc_servers(node_state_t *state) {
             
             if (pthread_create(&ingress_thread, NULL, rpc_server_thread_fn, &ingress_ctx) != 0) {
                 LOG_ERROR("Failed to create INGRESS server thread");
+                node_metrics_detach_rpc_server(state, ingress_server);
+                if (services) {
+                    service_registry_unregister(services, SERVICE_TYPE_RPC_SERVER, "ingress");
+                }
                 rpc_server_destroy(ingress_server);
             } else {
                 pthread_detach(ingress_thread);
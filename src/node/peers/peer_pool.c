@@ -2,11 +2,115 @@
 
 #define _POSIX_C_SOURCE 200809L
 
-#include "roole/node/node_state.h"
+#include "roole/node/peer_pool.h"
+#include "roole/node/peer_ring.h"
+#include "roole/logger/logger.h"
 #include "roole/core/common.h"
 #include <stdlib.h>
 #include <string.h>
 
+// ============================================================================
+// DISPATCHABLE SNAPSHOT (RCU-style, same scheme as cluster_view)
+// ============================================================================
+
+static inline int peer_is_dispatchable(const peer_info_t *peer) {
+    return peer->status == NODE_STATUS_ALIVE && peer->capabilities.can_execute;
+}
+
+static void peer_stats_release(peer_stats_t *stats) {
+    if (stats && __atomic_sub_fetch(&stats->refcount, 1, __ATOMIC_ACQ_REL) == 0) {
+        free(stats);
+    }
+}
+
+static inline uint32_t peer_choice_rtt(const peer_choice_t *choice) {
+    return __atomic_load_n(&choice->stats->rtt_us, __ATOMIC_RELAXED);
+}
+
+static inline float peer_choice_score(const peer_choice_t *choice) {
+    float load_score;
+    __atomic_load(&choice->stats->load_score, &load_score, __ATOMIC_RELAXED);
+    uint32_t active = __atomic_load_n(&choice->stats->active_executions, __ATOMIC_RELAXED);
+    return (float)active + load_score * 10.0f;
+}
+
+// Last reference to a snapshot: drop its references to the peer stats
+static void snapshot_reclaim(rcu_head_t *head) {
+    peer_pool_snapshot_t *snap = (peer_pool_snapshot_t*)head;
+    for (size_t i = 0; i < snap->count; i++) {
+        peer_stats_release(snap->peers[i].stats);
+    }
+    free(snap);
+}
+
+// Rebuild the dispatchable snapshot; caller holds pool->lock
+static int publish_alive_locked(peer_pool_t *pool) {
+    size_t alive = 0;
+    for (size_t i = 0; i < pool->count; i++) {
+        if (peer_is_dispatchable(&pool->peers[i])) alive++;
+    }
+    
+    peer_pool_snapshot_t *snap = malloc(sizeof(peer_pool_snapshot_t) +
+                                        alive * sizeof(peer_choice_t));
+    if (!snap) {
+        LOG_ERROR("Failed to allocate peer pool snapshot");
+        return RESULT_ERR_NOMEM;
+    }
+    
+    rcu_head_init(&snap->rcu);
+    snap->rcu.reclaim = snapshot_reclaim;
+    snap->version = ++pool->version;
+    snap->count = 0;
+    
+    for (size_t i = 0; i < pool->count; i++) {
+        const peer_info_t *peer = &pool->peers[i];
+        if (!peer_is_dispatchable(peer)) continue;
+        
+        peer_choice_t *choice = &snap->peers[snap->count++];
+        choice->node_id = peer->node_id;
+        choice->stats = peer->stats;
+        __atomic_add_fetch(&peer->stats->refcount, 1, __ATOMIC_RELAXED);
+    }
+    
+    rcu_publish(&pool->alive, &snap->rcu);
+    return RESULT_OK;
+}
+
+// Re-key the hash ring from the current snapshot; caller holds pool->lock.
+// Only called when the dispatchable set may have changed, so load and
+// latency updates never touch the ring.
+static void sync_ring_locked(peer_pool_t *pool) {
+    const peer_pool_snapshot_t *snap = (const peer_pool_snapshot_t*)rcu_peek(&pool->alive);
+    if (!snap) return;
+    
+    node_id_t *ids = NULL;
+    if (snap->count > 0) {
+        ids = malloc(snap->count * sizeof(node_id_t));
+        if (!ids) {
+            LOG_ERROR("Failed to allocate peer hash ring members");
+            return;
+        }
+        for (size_t i = 0; i < snap->count; i++) {
+            ids[i] = snap->peers[i].node_id;
+        }
+    }
+    
+    if (peer_ring_update(&pool->ring, ids, snap->count) < 0) {
+        LOG_ERROR("Failed to rebuild peer hash ring");
+    }
+    free(ids);
+}
+
+peer_pool_snapshot_t* peer_pool_snapshot_acquire(peer_pool_t *pool) {
+    if (!pool) return NULL;
+    
+    return (peer_pool_snapshot_t*)rcu_acquire(&pool->alive);
+}
+
+void peer_pool_snapshot_release(peer_pool_snapshot_t *snap) {
+    rcu_release(snap ? &snap->rcu : NULL);
+}
+
 // ============================================================================
 // PEER POOL IMPLEMENTATION
 // ============================================================================
@@ -29,6 +133,19 @@ int peer_pool_init(peer_pool_t *pool, size_t capacity) {
         return RESULT_ERR_INVALID;
     }
     
+    if (peer_ring_init(&pool->ring, PEER_RING_DEFAULT_VNODES) != RESULT_OK) {
+        pthread_mutex_destroy(&pool->lock);
+        safe_free(pool->peers);
+        return RESULT_ERR_NOMEM;
+    }
+    
+    if (publish_alive_locked(pool) != RESULT_OK) {
+        peer_ring_destroy(&pool->ring);
+        pthread_mutex_destroy(&pool->lock);
+        safe_free(pool->peers);
+        return RESULT_ERR_NOMEM;
+    }
+    
     LOG_INFO("Peer pool initialized (capacity: %zu)", capacity);
     return RESULT_OK;
 }
@@ -44,6 +161,7 @@ void peer_pool_destroy(peer_pool_t *pool) {
             rpc_channel_destroy(pool->peers[i].data_channel);
             safe_free(pool->peers[i].data_channel);
         }
+        peer_stats_release(pool->peers[i].stats);
     }
 
     safe_free(pool->peers);
@@ -51,6 +169,10 @@ void peer_pool_destroy(peer_pool_t *pool) {
     pool->count = 0;
     pool->capacity = 0;
 
+    // Outstanding reader references keep their snapshot alive
+    rcu_publish(&pool->alive, NULL);
+    peer_ring_destroy(&pool->ring);
+
     pthread_mutex_unlock(&pool->lock);
     pthread_mutex_destroy(&pool->lock);
 
@@ -79,6 +201,13 @@ int peer_pool_add(peer_pool_t *pool, node_id_t node_id, const char *ip,
         return RESULT_ERR_FULL;
     }
 
+    peer_stats_t *stats = safe_calloc(1, sizeof(peer_stats_t));
+    if (!stats) {
+        pthread_mutex_unlock(&pool->lock);
+        return RESULT_ERR_NOMEM;
+    }
+    stats->refcount = 1;
+
     peer_info_t *peer = &pool->peers[pool->count];
     memset(peer, 0, sizeof(peer_info_t));
 
@@ -88,8 +217,7 @@ int peer_pool_add(peer_pool_t *pool, node_id_t node_id, const char *ip,
     peer->gossip_port = gossip_port;
     peer->data_port = data_port;
     peer->status = NODE_STATUS_ALIVE;
-    peer->active_executions = 0;
-    peer->load_score = 0.0f;
+    peer->stats = stats;
     peer->last_seen_ms = time_now_ms();
     
     // Initialize as NULL - created on-demand
@@ -101,6 +229,8 @@ int peer_pool_add(peer_pool_t *pool, node_id_t node_id, const char *ip,
     peer->capabilities.can_route = 1;
 
     pool->count++;
+    publish_alive_locked(pool);
+    sync_ring_locked(pool);
 
     pthread_mutex_unlock(&pool->lock);
 
@@ -121,6 +251,8 @@ int peer_pool_remove(peer_pool_t *pool, node_id_t node_id) {
                 rpc_channel_destroy(pool->peers[i].data_channel);
                 safe_free(pool->peers[i].data_channel);
             }
+            // Snapshots still listing the peer keep its stats alive
+            peer_stats_release(pool->peers[i].stats);
 
             // Shift remaining peers
             if (i < pool->count - 1) {
@@ -129,6 +261,8 @@ int peer_pool_remove(peer_pool_t *pool, node_id_t node_id) {
             }
 
             pool->count--;
+            publish_alive_locked(pool);
+            sync_ring_locked(pool);
 
             pthread_mutex_unlock(&pool->lock);
             LOG_INFO("Removed peer %u from pool", node_id);
@@ -149,6 +283,8 @@ int peer_pool_update_status(peer_pool_t *pool, node_id_t node_id, node_status_t
         if (pool->peers[i].node_id == node_id) {
             pool->peers[i].status = status;
             pool->peers[i].last_seen_ms = time_now_ms();
+            publish_alive_locked(pool);
+            sync_ring_locked(pool);
             pthread_mutex_unlock(&pool->lock);
             LOG_DEBUG("Peer %u status updated to %d", node_id, status);
             return RESULT_OK;
@@ -167,8 +303,9 @@ int peer_pool_update_load(peer_pool_t *pool, node_id_t node_id,
     
     for (size_t i = 0; i < pool->count; i++) {
         if (pool->peers[i].node_id == node_id) {
-            pool->peers[i].active_executions = active_execs;
-            pool->peers[i].load_score = load_score;
+            peer_stats_t *stats = pool->peers[i].stats;
+            __atomic_store_n(&stats->active_executions, active_execs, __ATOMIC_RELAXED);
+            __atomic_store(&stats->load_score, &load_score, __ATOMIC_RELAXED);
             pool->peers[i].last_seen_ms = time_now_ms();
             
             pthread_mutex_unlock(&pool->lock);
@@ -182,6 +319,23 @@ int peer_pool_update_load(peer_pool_t *pool, node_id_t node_id,
     return RESULT_ERR_NOTFOUND;
 }
 
+int peer_pool_update_latency(peer_pool_t *pool, node_id_t node_id, uint32_t rtt_us) {
+    if (!pool) return RESULT_ERR_INVALID;
+    
+    pthread_mutex_lock(&pool->lock);
+    
+    for (size_t i = 0; i < pool->count; i++) {
+        if (pool->peers[i].node_id == node_id) {
+            __atomic_store_n(&pool->peers[i].stats->rtt_us, rtt_us, __ATOMIC_RELAXED);
+            pthread_mutex_unlock(&pool->lock);
+            return RESULT_OK;
+        }
+    }
+    
+    pthread_mutex_unlock(&pool->lock);
+    return RESULT_ERR_NOTFOUND;
+}
+
 int peer_pool_update_capabilities(peer_pool_t *pool, node_id_t node_id,
                                   const node_capabilities_t *caps) {
     if (!pool || !caps) return RESULT_ERR_INVALID;
@@ -191,6 +345,8 @@ int peer_pool_update_capabilities(peer_pool_t *pool, node_id_t node_id,
     for (size_t i = 0; i < pool->count; i++) {
         if (pool->peers[i].node_id == node_id) {
             pool->peers[i].capabilities = *caps;
+            publish_alive_locked(pool);
+            sync_ring_locked(pool);
             pthread_mutex_unlock(&pool->lock);
             LOG_DEBUG("Peer %u capabilities updated (ingress:%d execute:%d route:%d)",
                      node_id, caps->has_ingress, caps->can_execute, caps->can_route);
@@ -264,61 +420,118 @@ size_t peer_pool_list_by_capability(peer_pool_t *pool, int can_execute,
 // LOAD BALANCING
 // ============================================================================
 
-node_id_t peer_pool_select_least_loaded(peer_pool_t *pool) {
-    if (!pool) return 0;
+// Per-thread xorshift64*, so concurrent dispatchers share no RNG state
+static uint32_t p2c_random(void) {
+    static __thread uint64_t rng_state;
     
-    pthread_mutex_lock(&pool->lock);
+    if (rng_state == 0) {
+        rng_state = time_now_us() ^ (uint64_t)(uintptr_t)&rng_state;
+        if (rng_state == 0) rng_state = 0x9E3779B97F4A7C15ULL;
+    }
+    
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (uint32_t)((rng_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+node_id_t peer_pool_select_p2c(peer_pool_t *pool) {
+    peer_pool_snapshot_t *snap = peer_pool_snapshot_acquire(pool);
+    if (!snap) return 0;
+    
+    node_id_t chosen = 0;
+    
+    if (snap->count == 1) {
+        chosen = snap->peers[0].node_id;
+    } else if (snap->count > 1) {
+        // Two distinct uniform picks
+        size_t a = p2c_random() % snap->count;
+        size_t b = p2c_random() % (snap->count - 1);
+        if (b >= a) b++;
+        
+        const peer_choice_t *pa = &snap->peers[a];
+        const peer_choice_t *pb = &snap->peers[b];
+        float sa = peer_choice_score(pa);
+        float sb = peer_choice_score(pb);
+        
+        // Equal load: prefer the nearer peer when both RTTs are known
+        uint32_t ra = peer_choice_rtt(pa);
+        uint32_t rb = peer_choice_rtt(pb);
+        if (sa == sb && ra && rb) {
+            chosen = ra <= rb ? pa->node_id : pb->node_id;
+        } else {
+            chosen = sa <= sb ? pa->node_id : pb->node_id;
+        }
+    }
+    
+    peer_pool_snapshot_release(snap);
+    return chosen;
+}
+
+node_id_t peer_pool_select_least_loaded(peer_pool_t *pool) {
+    peer_pool_snapshot_t *snap = peer_pool_snapshot_acquire(pool);
+    if (!snap) return 0;
     
     node_id_t best_peer = 0;
     float best_score = 1e9f;
     
-    for (size_t i = 0; i < pool->count; i++) {
-        if (pool->peers[i].status == NODE_STATUS_ALIVE &&
-            pool->peers[i].capabilities.can_execute) {
-            
-            float score = (float)pool->peers[i].active_executions + 
-                         pool->peers[i].load_score * 10.0f;
-            
-            if (score < best_score) {
-                best_score = score;
-                best_peer = pool->peers[i].node_id;
-            }
+    for (size_t i = 0; i < snap->count; i++) {
+        float score = peer_choice_score(&snap->peers[i]);
+        if (score < best_score) {
+            best_score = score;
+            best_peer = snap->peers[i].node_id;
         }
     }
     
-    pthread_mutex_unlock(&pool->lock);
+    peer_pool_snapshot_release(snap);
     
     return best_peer;
 }
 
-static size_t g_round_robin_index = 0;
-
-node_id_t peer_pool_select_round_robin(peer_pool_t *pool) {
-    if (!pool) return 0;
-    
-    pthread_mutex_lock(&pool->lock);
+node_id_t peer_pool_select_nearest(peer_pool_t *pool) {
+    peer_pool_snapshot_t *snap = peer_pool_snapshot_acquire(pool);
+    if (!snap) return 0;
     
-    if (pool->count == 0) {
-        pthread_mutex_unlock(&pool->lock);
-        return 0;
-    }
+    node_id_t best_peer = 0;
+    node_id_t fallback_peer = 0;
+    uint32_t best_rtt = UINT32_MAX;
     
-    // Find next alive peer with execution capability
-    size_t attempts = 0;
-    while (attempts < pool->count) {
-        size_t idx = g_round_robin_index % pool->count;
-        g_round_robin_index++;
+    for (size_t i = 0; i < snap->count; i++) {
+        const peer_choice_t *choice = &snap->peers[i];
+        uint32_t rtt_us = peer_choice_rtt(choice);
         
-        if (pool->peers[idx].status == NODE_STATUS_ALIVE &&
-            pool->peers[idx].capabilities.can_execute) {
-            node_id_t peer_id = pool->peers[idx].node_id;
-            pthread_mutex_unlock(&pool->lock);
-            return peer_id;
+        if (rtt_us == 0) {
+            if (!fallback_peer) fallback_peer = choice->node_id;
+            continue;
         }
         
-        attempts++;
+        if (rtt_us < best_rtt) {
+            best_rtt = rtt_us;
+            best_peer = choice->node_id;
+        }
     }
     
-    pthread_mutex_unlock(&pool->lock);
-    return 0;  // No alive peers with execution capability
-}
\ No newline at end of file
+    peer_pool_snapshot_release(snap);
+    
+    return best_peer ? best_peer : fallback_peer;
+}
+
+node_id_t peer_pool_select_round_robin(peer_pool_t *pool) {
+    peer_pool_snapshot_t *snap = peer_pool_snapshot_acquire(pool);
+    if (!snap) return 0;
+    
+    node_id_t peer_id = 0;
+    if (snap->count > 0) {
+        size_t idx = __atomic_fetch_add(&pool->rr_index, 1, __ATOMIC_RELAXED);
+        peer_id = snap->peers[idx % snap->count].node_id;
+    }
+    
+    peer_pool_snapshot_release(snap);
+    return peer_id;
+}
+
+node_id_t peer_pool_select_by_key(peer_pool_t *pool, const void *key, size_t key_len) {
+    if (!pool || (!key && key_len > 0)) return 0;
+    
+    return peer_ring_lookup(&pool->ring, hash_bytes(key, key_len));
+}
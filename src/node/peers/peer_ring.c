@@ -0,0 +1,218 @@
+// src/node/peers/peer_ring.c
+// Consistent-hash ring with virtual nodes and incremental rebuild
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "roole/node/peer_ring.h"
+#include "roole/logger/logger.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static int compare_node_id(const void *a, const void *b) {
+    node_id_t x = *(const node_id_t*)a;
+    node_id_t y = *(const node_id_t*)b;
+    return (x > y) - (x < y);
+}
+
+static inline int point_less(const peer_ring_point_t *a, const peer_ring_point_t *b) {
+    return a->hash < b->hash || (a->hash == b->hash && a->node_id < b->node_id);
+}
+
+static int compare_point(const void *a, const void *b) {
+    const peer_ring_point_t *x = (const peer_ring_point_t*)a;
+    const peer_ring_point_t *y = (const peer_ring_point_t*)b;
+    return point_less(x, y) ? -1 : (point_less(y, x) ? 1 : 0);
+}
+
+// hash_u64 is a bijection, so (node, vnode) pairs never collide
+static inline uint64_t vnode_hash(node_id_t node_id, uint32_t vnode) {
+    return hash_u64(((uint64_t)node_id << 32) | vnode);
+}
+
+static int member_in(const node_id_t *sorted, size_t count, node_id_t node_id) {
+    return bsearch(&node_id, sorted, count, sizeof(node_id_t), compare_node_id) != NULL;
+}
+
+static peer_ring_snapshot_t* snapshot_alloc(size_t member_count, size_t point_count) {
+    peer_ring_snapshot_t *snap = malloc(sizeof(peer_ring_snapshot_t) +
+                                        point_count * sizeof(peer_ring_point_t) +
+                                        member_count * sizeof(node_id_t));
+    if (!snap) return NULL;
+
+    rcu_head_init(&snap->rcu);
+    snap->member_count = member_count;
+    snap->point_count = point_count;
+    snap->members = (node_id_t*)&snap->points[point_count];
+    return snap;
+}
+
+// Swap in a new ring and wait out readers of the old one
+static void publish(peer_ring_t *ring, peer_ring_snapshot_t *snap) {
+    snap->version = ++ring->version;
+    rcu_publish(&ring->current, &snap->rcu);
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+int peer_ring_init(peer_ring_t *ring, uint32_t vnodes) {
+    if (!ring || vnodes > PEER_RING_MAX_VNODES) return RESULT_ERR_INVALID;
+
+    memset(ring, 0, sizeof(*ring));
+    ring->vnodes = vnodes ? vnodes : PEER_RING_DEFAULT_VNODES;
+
+    peer_ring_snapshot_t *empty = snapshot_alloc(0, 0);
+    if (!empty) return RESULT_ERR_NOMEM;
+
+    publish(ring, empty);
+    return RESULT_OK;
+}
+
+void peer_ring_destroy(peer_ring_t *ring) {
+    if (!ring) return;
+
+    rcu_publish(&ring->current, NULL);
+}
+
+// ============================================================================
+// UPDATE
+// ============================================================================
+
+int peer_ring_update(peer_ring_t *ring, const node_id_t *members, size_t count) {
+    if (!ring || (!members && count > 0)) return RESULT_ERR_INVALID;
+
+    // Writers are serialized, so the current ring cannot go away under us
+    peer_ring_snapshot_t *old = (peer_ring_snapshot_t*)rcu_peek(&ring->current);
+    if (!old) return RESULT_ERR_INVALID;
+
+    node_id_t *sorted = NULL;
+    if (count > 0) {
+        sorted = malloc(count * sizeof(node_id_t));
+        if (!sorted) return RESULT_ERR_NOMEM;
+        memcpy(sorted, members, count * sizeof(node_id_t));
+        qsort(sorted, count, sizeof(node_id_t), compare_node_id);
+
+        size_t unique = 1;
+        for (size_t i = 1; i < count; i++) {
+            if (sorted[i] != sorted[unique - 1]) sorted[unique++] = sorted[i];
+        }
+        count = unique;
+    }
+
+    if (count == old->member_count &&
+        (count == 0 || memcmp(sorted, old->members, count * sizeof(node_id_t)) == 0)) {
+        free(sorted);
+        return 0;
+    }
+
+    // Members new to this ring
+    size_t added = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!member_in(old->members, old->member_count, sorted[i])) added++;
+    }
+
+    // Fresh points only for added members, sorted once
+    peer_ring_point_t *fresh = NULL;
+    size_t fresh_count = added * ring->vnodes;
+    if (fresh_count > 0) {
+        fresh = malloc(fresh_count * sizeof(peer_ring_point_t));
+        if (!fresh) {
+            free(sorted);
+            return RESULT_ERR_NOMEM;
+        }
+
+        size_t n = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (member_in(old->members, old->member_count, sorted[i])) continue;
+            for (uint32_t v = 0; v < ring->vnodes; v++) {
+                fresh[n].hash = vnode_hash(sorted[i], v);
+                fresh[n].node_id = sorted[i];
+                n++;
+            }
+        }
+        qsort(fresh, fresh_count, sizeof(peer_ring_point_t), compare_point);
+    }
+
+    size_t kept = old->point_count - (old->member_count - (count - added)) * ring->vnodes;
+    peer_ring_snapshot_t *snap = snapshot_alloc(count, kept + fresh_count);
+    if (!snap) {
+        free(fresh);
+        free(sorted);
+        return RESULT_ERR_NOMEM;
+    }
+
+    if (count > 0) {
+        memcpy(snap->members, sorted, count * sizeof(node_id_t));
+    }
+
+    // Merge surviving old points with the fresh ones (both sorted)
+    size_t i = 0, j = 0, out = 0;
+    while (i < old->point_count || j < fresh_count) {
+        if (i < old->point_count && !member_in(sorted, count, old->points[i].node_id)) {
+            i++;
+            continue;
+        }
+
+        if (j >= fresh_count ||
+            (i < old->point_count && point_less(&old->points[i], &fresh[j]))) {
+            snap->points[out++] = old->points[i++];
+        } else {
+            snap->points[out++] = fresh[j++];
+        }
+    }
+    snap->point_count = out;
+
+    free(fresh);
+    free(sorted);
+
+    publish(ring, snap);
+
+    LOG_DEBUG("Peer ring v%lu: %zu members, %zu points (+%zu members)",
+              (unsigned long)snap->version, count, out, added);
+    return 1;
+}
+
+// ============================================================================
+// LOOKUP
+// ============================================================================
+
+peer_ring_snapshot_t* peer_ring_acquire(peer_ring_t *ring) {
+    if (!ring) return NULL;
+
+    return (peer_ring_snapshot_t*)rcu_acquire(&ring->current);
+}
+
+void peer_ring_release(peer_ring_snapshot_t *snap) {
+    rcu_release(snap ? &snap->rcu : NULL);
+}
+
+node_id_t peer_ring_snapshot_lookup(const peer_ring_snapshot_t *snap, uint64_t key_hash) {
+    if (!snap || snap->point_count == 0) return 0;
+
+    // First point with hash >= key_hash, wrapping past the end
+    size_t lo = 0, hi = snap->point_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (snap->points[mid].hash < key_hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return snap->points[lo == snap->point_count ? 0 : lo].node_id;
+}
+
+node_id_t peer_ring_lookup(peer_ring_t *ring, uint64_t key_hash) {
+    peer_ring_snapshot_t *snap = peer_ring_acquire(ring);
+    if (!snap) return 0;
+
+    node_id_t owner = peer_ring_snapshot_lookup(snap, key_hash);
+    peer_ring_release(snap);
+    return owner;
+}
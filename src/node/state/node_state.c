@@ -6,9 +6,13 @@
 #include "roole/node/node_state.h"
 #include "roole/node/node_capabilities.h"
 #include "roole/node/node_metrics.h"
+#include "roole/node/raft_peer_sync.h"
 #include "roole/config/config.h"
 #include "roole/core/service_registry.h"
 #include "roole/core/common.h"
+#include "roole/core/trace.h"
+#include "roole/rpc/rpc_server.h"
+#include "roole/gossip/gossip_crypto.h"
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
@@ -39,6 +43,30 @@ static void parse_addr_port(const char *addr_str, char *ip, uint16_t *port) {
 // CLEANUP THREAD (Periodic maintenance)
 // ============================================================================
 
+// Lane health is exported as metrics too; the log keeps a trail when no
+// one is scraping
+static void log_event_bus_stats(node_state_t *state) {
+    if (!state->event_bus) return;
+    
+    event_bus_stats_t stats;
+    event_bus_get_stats(state->event_bus, &stats);
+    LOG_INFO("Event bus: published=%lu dispatched=%lu dropped=%lu coalesced=%lu "
+            "queue=%lu lanes=%lu pool_misses=%lu",
+            stats.events_published, stats.events_dispatched, 
+            stats.events_dropped, stats.events_coalesced,
+            stats.queue_size, stats.lanes, stats.payload_pool_misses);
+    
+    event_bus_lane_stats_t lanes[16];
+    size_t n = event_bus_get_lane_stats(state->event_bus, lanes, 16);
+    for (size_t i = 0; i < n; i++) {
+        LOG_INFO("  lane %-24s depth=%lu dispatched=%lu dropped=%lu "
+                "latency avg=%luus max=%luus",
+                lanes[i].name, lanes[i].queue_depth, lanes[i].dispatched,
+                lanes[i].dropped, lanes[i].avg_latency_us,
+                lanes[i].max_latency_us);
+    }
+}
+
 static void* cleanup_thread_fn(void *arg) {
     node_state_t *state = (node_state_t*)arg;
     
@@ -55,6 +83,8 @@ static void* cleanup_thread_fn(void *arg) {
             // Simple maintenance - can be extended
             LOG_DEBUG("Cleanup cycle completed");
         }
+        
+        log_event_bus_stats(state);
     }
     
     LOG_INFO("Cleanup thread stopped");
@@ -64,125 +94,121 @@ static void* cleanup_thread_fn(void *arg) {
 }
 
 // ============================================================================
-// RAFT UPDATE THREAD
+// MEMBERSHIP EVENTS
 // ============================================================================
 
-static void* raft_peer_sync_thread_fn(void *arg) {
-    node_state_t *state = (node_state_t*)arg;
-    
-    logger_push_component("raft:peers");
-    LOG_INFO("Raft peer sync thread started");
-    
-    // Track known peers
-    node_id_t known_peers[MAX_CLUSTER_NODES] = {0};
-    size_t known_peer_count = 0;
-    
-    while (!state->shutdown_flag) {
-        if (!state->raft_state) {
-            sleep(1);
-            continue;
-        }
-        
-        // Get current cluster members from cluster_view
-        pthread_rwlock_rdlock(&state->cluster_view->lock);
-        
-        node_id_t current_peers[MAX_CLUSTER_NODES];
-        size_t current_peer_count = 0;
-        
-        for (size_t i = 0; i < state->cluster_view->count; i++) {
-            cluster_member_t *m = &state->cluster_view->members[i];
-            
-            // Only track ALIVE peers that are not ourselves
-            if (m->node_id != state->identity.node_id && 
-                m->status == NODE_STATUS_ALIVE) {
-                current_peers[current_peer_count++] = m->node_id;
-            }
-        }
-        
-        pthread_rwlock_unlock(&state->cluster_view->lock);
-        
-        // Detect new peers (in current but not in known)
-        for (size_t i = 0; i < current_peer_count; i++) {
-            node_id_t peer_id = current_peers[i];
-            int is_new = 1;
-            
-            for (size_t j = 0; j < known_peer_count; j++) {
-                if (known_peers[j] == peer_id) {
-                    is_new = 0;
-                    break;
-                }
-            }
-            
-            if (is_new) {
-                // New peer discovered - add to Raft
-                cluster_member_t *member = cluster_view_get(state->cluster_view, peer_id);
-                if (member) {
-                    LOG_INFO("Raft: Discovered new peer %u (%s:%u)",
-                            peer_id, member->ip_address, member->data_port);
-                    
-                    raft_add_peer(state->raft_state, peer_id,
-                                 member->ip_address, member->data_port);
-                    
-                    cluster_view_release(state->cluster_view);
-                }
+// Delivered by the gossip engine on membership changes
+static void on_member_event(node_id_t node_id,
+                            node_type_t node_type,
+                            const char *ip_address,
+                            uint16_t data_port,
+                            const char *event_type,
+                            void *user_data) {
+    node_state_t *state = (node_state_t*)user_data;
+    (void)node_type;
+    
+    LOG_DEBUG("Member event: node %u %s", node_id, event_type);
+    
+    // Keep the routing pool in step with membership
+    if (state->peer_pool && node_id != state->identity.node_id) {
+        if (strcmp(event_type, MEMBER_EVENT_JOIN) == 0 ||
+            strcmp(event_type, MEMBER_EVENT_UPDATE) == 0) {
+            cluster_member_t member;
+            uint16_t gossip_port = 0;
+            if (cluster_view_lookup(state->cluster_view, node_id, &member) == RESULT_OK) {
+                gossip_port = member.gossip_port;
             }
+            peer_pool_add(state->peer_pool, node_id, ip_address, gossip_port, data_port);
+            peer_pool_update_status(state->peer_pool, node_id, NODE_STATUS_ALIVE);
+        } else if (strcmp(event_type, MEMBER_EVENT_FAILED) == 0) {
+            peer_pool_update_status(state->peer_pool, node_id, NODE_STATUS_SUSPECT);
+        } else if (strcmp(event_type, MEMBER_EVENT_LEAVE) == 0) {
+            peer_pool_remove(state->peer_pool, node_id);
         }
-        
-        // Detect removed peers (in known but not in current)
-        for (size_t i = 0; i < known_peer_count; i++) {
-            node_id_t peer_id = known_peers[i];
-            int still_exists = 0;
-            
-            for (size_t j = 0; j < current_peer_count; j++) {
-                if (current_peers[j] == peer_id) {
-                    still_exists = 1;
-                    break;
-                }
-            }
-            
-            if (!still_exists) {
-                // Peer removed - remove from Raft
-                LOG_INFO("Raft: Peer %u left cluster", peer_id);
-                raft_remove_peer(state->raft_state, peer_id);
-            }
-        }
-        
-        // Update known peers list
-        memcpy(known_peers, current_peers, current_peer_count * sizeof(node_id_t));
-        known_peer_count = current_peer_count;
-        
-        // Check every 5 seconds
-        sleep(5);
     }
     
-    LOG_INFO("Raft peer sync thread stopped");
-    logger_pop_component();
-    return NULL;
+    if (state->raft_peer_sync) {
+        raft_peer_sync_notify(state->raft_peer_sync, node_id,
+                              ip_address, data_port, event_type);
+    }
+}
+
+// Delivered on the gossip receiver thread for every PING/ACK round trip
+static void on_member_rtt(node_id_t node_id, uint32_t rtt_us, void *user_data) {
+    node_state_t *state = (node_state_t*)user_data;
+    
+    if (state->histogram_gossip_rtt) {
+        metrics_histogram_record(state->histogram_gossip_rtt, rtt_us);
+    }
+    
+    if (state->peer_pool) {
+        peer_pool_update_latency(state->peer_pool, node_id,
+                                 membership_estimate_rtt_us(state->membership, node_id));
+    }
 }
 
 // ============================================================================
-// METRICS UPDATE THREAD
+// LOAD SUMMARY (piggybacked on gossip)
 // ============================================================================
 
-static void* metrics_update_thread_fn(void *arg) {
-    node_state_t *state = (node_state_t*)arg;
+static inline uint16_t saturate_u16(uint64_t value) {
+    return value > UINT16_MAX ? UINT16_MAX : (uint16_t)value;
+}
+
+// Sampled by the gossip protocol at most once per report interval
+static int on_local_load(member_load_t *out_load, void *user_data) {
+    node_state_t *state = (node_state_t*)user_data;
     
-    logger_push_component("metrics");
-    LOG_INFO("Metrics update thread started");
+    memset(out_load, 0, sizeof(*out_load));
     
-    while (!state->shutdown_flag) {
-        sleep(10);  // Update every 10 seconds
-        
-        if (state->shutdown_flag) break;
-        
-        // Update periodic metrics
-        node_metrics_update_periodic(state);
+    double loadavg;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (getloadavg(&loadavg, 1) == 1 && cpus > 0) {
+        double pct = loadavg * 100.0 / (double)cpus;
+        out_load->cpu_pct = (uint8_t)(pct > 100.0 ? 100.0 : pct);
     }
     
-    LOG_INFO("Metrics update thread stopped");
-    logger_pop_component();
+    if (state->event_bus) {
+        event_bus_stats_t bus_stats;
+        event_bus_get_stats(state->event_bus, &bus_stats);
+        out_load->queue_depth = saturate_u16(bus_stats.queue_size);
+    }
     
-    return NULL;
+    service_registry_t *registry = service_registry_global();
+    rpc_server_t *data_server = registry ?
+        (rpc_server_t*)service_registry_get(registry, SERVICE_TYPE_RPC_SERVER, "data") : NULL;
+    if (data_server) {
+        rpc_server_stats_t rpc_stats;
+        rpc_server_get_stats(data_server, &rpc_stats);
+        uint64_t done = rpc_stats.requests_processed + rpc_stats.requests_failed;
+        out_load->rpc_inflight = saturate_u16(rpc_stats.requests_received > done ?
+                                              rpc_stats.requests_received - done : 0);
+    }
+    
+    if (state->raft_state) {
+        uint64_t commit = raft_get_commit_index(state->raft_state);
+        uint64_t applied = raft_get_last_applied(state->raft_state);
+        uint64_t lag = commit > applied ? commit - applied : 0;
+        out_load->raft_apply_lag = lag > UINT32_MAX ? UINT32_MAX : (uint32_t)lag;
+    }
+    
+    return 0;
+}
+
+// Delivered on the gossip receiver thread for every summary received
+static void on_peer_load(node_id_t node_id, const member_load_t *load, void *user_data) {
+    node_state_t *state = (node_state_t*)user_data;
+    
+    if (!state->peer_pool) return;
+    
+    // CPU dominates; queueing and apply lag each add up to one more unit
+    float score = (float)load->cpu_pct / 100.0f +
+                  (float)ROOLE_MIN(load->queue_depth, 1024) / 1024.0f +
+                  (float)ROOLE_MIN(load->raft_apply_lag, 1024u) / 1024.0f;
+    
+    peer_pool_update_load(state->peer_pool, node_id,
+                          (uint32_t)load->active_executions + load->rpc_inflight,
+                          score);
 }
 
 // ============================================================================
@@ -229,6 +255,15 @@ result_t node_state_init(node_state_t **out_state, const roole_config_t *config)
     node_detect_capabilities(config, &state->capabilities, &state->identity);
     node_print_capabilities(&state->capabilities, &state->identity);
     
+    // Request tracing: ROOLE_TRACE_SAMPLE=N traces one in N client requests
+    // (default off). Traced RPCs and log entries carry an extension older
+    // nodes cannot parse, so leave it off while a cluster runs mixed versions.
+    const char *sample_env = getenv("ROOLE_TRACE_SAMPLE");
+    uint32_t sample_one_in = sample_env ? (uint32_t)strtoul(sample_env, NULL, 10) : 0;
+    if (trace_init(state->identity.node_id, 0, sample_one_in) != 0) {
+        LOG_WARN("Failed to initialize tracing (continuing without traces)");
+    }
+    
     // ========================================================================
     // 2. Initialize Datastore (Core Subsystem)
     // ========================================================================
@@ -356,11 +391,32 @@ result_t node_state_init(node_state_t **out_state, const roole_config_t *config)
         return RESULT_ERROR(RESULT_ERR_INVALID, "Failed to initialize membership");
     }
     
+    if (config->gossip_keys[0] != '\0') {
+        state->gossip_keyring = gossip_keyring_create();
+        if (!state->gossip_keyring ||
+            gossip_keyring_load_spec(state->gossip_keyring, config->gossip_keys) <= 0 ||
+            membership_set_keyring(state->membership, state->gossip_keyring) != RESULT_OK) {
+            membership_shutdown(state->membership);
+            gossip_keyring_destroy(state->gossip_keyring);
+            cluster_view_destroy(state->cluster_view);
+            safe_free(state->cluster_view);
+            peer_pool_destroy(state->peer_pool);
+            safe_free(state->peer_pool);
+            datastore_destroy(state->datastore);
+            safe_free(state->datastore);
+            safe_free(state);
+            return RESULT_ERROR(RESULT_ERR_INVALID, "Failed to enable gossip encryption");
+        }
+    }
+    
     // ========================================================================
     // 6. Initialize Event Bus
     // ========================================================================
     
-    state->event_bus = event_bus_create();
+    event_bus_config_t bus_config = {
+        .lane_mode = config->event_lanes
+    };
+    state->event_bus = event_bus_create_with_config(&bus_config);
     if (!state->event_bus) {
         membership_shutdown(state->membership);
         cluster_view_destroy(state->cluster_view);
@@ -380,6 +436,8 @@ result_t node_state_init(node_state_t **out_state, const roole_config_t *config)
     if (config->ports.metrics_addr[0] != '\0') {
         if (node_metrics_init(state, config->ports.metrics_addr) != RESULT_OK) {
             LOG_WARN("Failed to initialize metrics (continuing without metrics)");
+        } else if (state->metrics_server) {
+            metrics_server_set_log_control(state->metrics_server, config->log_remote_control);
         }
     } else {
         LOG_INFO("Metrics disabled (no metrics address configured)");
@@ -422,17 +480,6 @@ result_t node_state_start(node_state_t *state) {
         return RESULT_ERROR(RESULT_ERR_INVALID, "Failed to start cleanup thread");
     }
     
-    // Start metrics update thread (if metrics enabled)
-    if (state->metrics_registry) {
-        if (pthread_create(&state->metrics_update_thread, NULL, 
-                          metrics_update_thread_fn, state) != 0) {
-            LOG_ERROR("Failed to create metrics update thread");
-            state->shutdown_flag = 1;
-            pthread_join(state->cleanup_thread, NULL);
-            return RESULT_ERROR(RESULT_ERR_INVALID, "Failed to start metrics thread");
-        }
-    }
-
     // ========================================================================
     // Start Raft State Machine
     // ========================================================================
@@ -449,14 +496,25 @@ result_t node_state_start(node_state_t *state) {
     }
 
     if (state->raft_state) {
-        if (pthread_create(&state->raft_peer_sync_thread, NULL,
-                          raft_peer_sync_thread_fn, state) != 0) {
-            LOG_ERROR("Failed to create Raft peer sync thread");
+        state->raft_peer_sync = raft_peer_sync_create(state->raft_state,
+                                                      state->cluster_view,
+                                                      state->identity.node_id, 0);
+        if (!state->raft_peer_sync || raft_peer_sync_start(state->raft_peer_sync) != 0) {
+            LOG_ERROR("Failed to start Raft peer sync");
             return RESULT_ERROR(RESULT_ERR_INVALID, "Raft peer sync failed");
         }
-        LOG_INFO("Raft peer sync thread started");
+        LOG_INFO("Raft peer sync started (event-driven)");
     }
     
+    // Membership changes drive Raft peer add/remove
+    membership_set_callback(state->membership, on_member_event, state);
+    
+    // Probe RTTs feed the latency histogram and peer selection
+    membership_set_rtt_callback(state->membership, on_member_rtt, state);
+    
+    // Advertise our load and track peers' load via gossip piggyback
+    membership_set_load_callbacks(state->membership, on_local_load, on_peer_load, state);
+    
     LOG_INFO("Node services started successfully");
     return RESULT_SUCCESS();
 }
@@ -532,14 +590,15 @@ void node_state_shutdown(node_state_t *state) {
         pthread_join(state->cleanup_thread, NULL);
     }
     
-    // Stop metrics update thread
-    if (state->metrics_update_thread) {
-        pthread_join(state->metrics_update_thread, NULL);
+    // Stop Raft peer sync (detach from membership events first)
+    if (state->membership) {
+        membership_set_callback(state->membership, NULL, NULL);
+        membership_set_rtt_callback(state->membership, NULL, NULL);
+        membership_set_load_callbacks(state->membership, NULL, NULL, NULL);
     }
-
-    // Stop RAFT update thread
-    if (state->raft_peer_sync_thread) {
-        pthread_join(state->raft_peer_sync_thread, NULL);
+    if (state->raft_peer_sync) {
+        raft_peer_sync_destroy(state->raft_peer_sync);
+        state->raft_peer_sync = NULL;
     }
 
     LOG_INFO("Node shutdown complete");
@@ -568,6 +627,10 @@ void node_state_destroy(node_state_t *state) {
         state->membership = NULL;
     }
     
+    // Only after the engine is gone: its threads use the keyring
+    gossip_keyring_destroy(state->gossip_keyring);
+    state->gossip_keyring = NULL;
+    
     if (state->cluster_view) {
         cluster_view_destroy(state->cluster_view);
         safe_free(state->cluster_view);
@@ -586,6 +649,8 @@ void node_state_destroy(node_state_t *state) {
         state->datastore = NULL;
     }
     
+    trace_shutdown();
+    
     safe_free(state);
     
     LOG_INFO("Node state destroyed");
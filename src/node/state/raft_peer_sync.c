@@ -0,0 +1,349 @@
+// src/node/state/raft_peer_sync.c
+// Event-driven Raft peer discovery with debounced, O(1)-per-node diffing
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "roole/node/raft_peer_sync.h"
+#include "roole/logger/logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#define NODE_ID_SPACE (UINT16_MAX + 1)
+
+// Desired state for one node, latest event wins
+typedef struct {
+    node_id_t node_id;
+    int want_peer;
+    char ip_address[MAX_IP_LEN];
+    uint16_t data_port;
+} pending_change_t;
+
+struct raft_peer_sync {
+    raft_state_t *raft;
+    cluster_view_t *view;
+    node_id_t self_id;
+    uint32_t debounce_ms;
+
+    // Pending changes, indexed by node_id (slot + 1, 0 = none)
+    pending_change_t *pending;
+    size_t pending_count;
+    uint16_t *pending_slot;
+
+    // Nodes currently registered with Raft (bitmap by node_id)
+    uint8_t *in_raft;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_t thread;
+    int thread_started;
+    int reconcile_requested;        // Under lock: diff against the view now
+    volatile int shutdown_flag;
+};
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static inline int bit_test(const uint8_t *bits, node_id_t id) {
+    return (bits[id >> 3] >> (id & 7)) & 1;
+}
+
+static inline void bit_set(uint8_t *bits, node_id_t id, int value) {
+    if (value) {
+        bits[id >> 3] |= (uint8_t)(1u << (id & 7));
+    } else {
+        bits[id >> 3] &= (uint8_t)~(1u << (id & 7));
+    }
+}
+
+static void deadline_after_ms(struct timespec *ts, uint32_t ms) {
+    clock_gettime(CLOCK_REALTIME, ts);
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+// Record desired state; caller holds sync->lock
+// @return 0 on success, -1 if the batch is full (a later reconcile retries)
+static int record_change_locked(raft_peer_sync_t *sync, node_id_t node_id,
+                                int want_peer, const char *ip, uint16_t port) {
+    uint16_t slot = sync->pending_slot[node_id];
+    pending_change_t *pc;
+
+    if (slot) {
+        pc = &sync->pending[slot - 1];
+    } else {
+        if (sync->pending_count >= MAX_CLUSTER_NODES) return -1;
+        pc = &sync->pending[sync->pending_count++];
+        sync->pending_slot[node_id] = (uint16_t)sync->pending_count;
+        pc->node_id = node_id;
+    }
+
+    pc->want_peer = want_peer;
+    if (want_peer && ip) {
+        safe_strncpy(pc->ip_address, ip, MAX_IP_LEN);
+        pc->data_port = port;
+    }
+    return 0;
+}
+
+// Apply a batch of coalesced changes; runs without sync->lock
+static void apply_changes(raft_peer_sync_t *sync,
+                          const pending_change_t *changes, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const pending_change_t *pc = &changes[i];
+        int present = bit_test(sync->in_raft, pc->node_id);
+
+        if (pc->want_peer && !present) {
+            LOG_INFO("Raft: Adding peer %u (%s:%u)",
+                     pc->node_id, pc->ip_address, pc->data_port);
+            if (raft_add_peer(sync->raft, pc->node_id,
+                              pc->ip_address, pc->data_port) == 0) {
+                bit_set(sync->in_raft, pc->node_id, 1);
+            }
+        } else if (!pc->want_peer && present) {
+            LOG_INFO("Raft: Removing peer %u", pc->node_id);
+            raft_remove_peer(sync->raft, pc->node_id);
+            bit_set(sync->in_raft, pc->node_id, 0);
+        }
+    }
+}
+
+// Full diff against the cluster view: O(N) over members plus O(N) over
+// registered peers. Safety net for events missed before registration.
+static void reconcile_with_view(raft_peer_sync_t *sync) {
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(sync->view);
+    if (!snap) return;
+
+    uint8_t *alive = calloc(NODE_ID_SPACE / 8, 1);
+    if (!alive) {
+        cluster_view_snapshot_release(snap);
+        return;
+    }
+
+    pthread_mutex_lock(&sync->lock);
+
+    for (size_t i = 0; i < snap->count; i++) {
+        const cluster_member_t *m = &snap->members[i];
+        if (m->node_id == sync->self_id || m->status != NODE_STATUS_ALIVE) {
+            continue;
+        }
+        bit_set(alive, m->node_id, 1);
+        if (!bit_test(sync->in_raft, m->node_id) && !sync->pending_slot[m->node_id] &&
+            record_change_locked(sync, m->node_id, 1, m->ip_address, m->data_port) != 0) {
+            break;      // Batch full; the next pass picks up the rest
+        }
+    }
+
+    for (size_t byte = 0; byte < NODE_ID_SPACE / 8; byte++) {
+        uint8_t stale = sync->in_raft[byte] & (uint8_t)~alive[byte];
+        while (stale) {
+            int bit = __builtin_ctz(stale);
+            node_id_t id = (node_id_t)(byte * 8 + (size_t)bit);
+            if (!sync->pending_slot[id] && record_change_locked(sync, id, 0, NULL, 0) != 0) {
+                break;
+            }
+            stale &= (uint8_t)(stale - 1);
+        }
+    }
+
+    pthread_mutex_unlock(&sync->lock);
+
+    free(alive);
+    cluster_view_snapshot_release(snap);
+}
+
+// ============================================================================
+// APPLY THREAD
+// ============================================================================
+
+static void* apply_thread_fn(void *arg) {
+    raft_peer_sync_t *sync = (raft_peer_sync_t*)arg;
+
+    logger_push_component("raft:peers");
+    LOG_INFO("Raft peer sync started (debounce=%ums)", sync->debounce_ms);
+
+    pending_change_t *batch = calloc(MAX_CLUSTER_NODES, sizeof(pending_change_t));
+    if (!batch) {
+        LOG_ERROR("Failed to allocate peer sync batch");
+        logger_pop_component();
+        return NULL;
+    }
+
+    reconcile_with_view(sync);
+    uint64_t last_reconcile_ms = time_now_ms();
+
+    while (!sync->shutdown_flag) {
+        struct timespec deadline;
+
+        pthread_mutex_lock(&sync->lock);
+
+        // Sleep until the first change (or periodic reconcile)
+        deadline_after_ms(&deadline, RAFT_PEER_SYNC_RECONCILE_INTERVAL_MS);
+        while (sync->pending_count == 0 && !sync->reconcile_requested &&
+               !sync->shutdown_flag) {
+            if (pthread_cond_timedwait(&sync->cond, &sync->lock, &deadline) == ETIMEDOUT) {
+                break;
+            }
+        }
+
+        // in_raft is only touched on this thread, so requested reconciles
+        // run here too
+        if (sync->reconcile_requested && !sync->shutdown_flag) {
+            sync->reconcile_requested = 0;
+            pthread_mutex_unlock(&sync->lock);
+            reconcile_with_view(sync);
+            last_reconcile_ms = time_now_ms();
+            pthread_mutex_lock(&sync->lock);
+        }
+
+        // Debounce: let flapping members settle before touching Raft
+        if (sync->pending_count > 0 && !sync->shutdown_flag) {
+            deadline_after_ms(&deadline, sync->debounce_ms);
+            while (!sync->shutdown_flag &&
+                   pthread_cond_timedwait(&sync->cond, &sync->lock, &deadline) != ETIMEDOUT) {
+                // Further notifications just update pending state
+            }
+        }
+
+        size_t count = sync->pending_count;
+        memcpy(batch, sync->pending, count * sizeof(pending_change_t));
+        for (size_t i = 0; i < count; i++) {
+            sync->pending_slot[batch[i].node_id] = 0;
+        }
+        sync->pending_count = 0;
+
+        pthread_mutex_unlock(&sync->lock);
+
+        if (sync->shutdown_flag) break;
+
+        if (count > 0) {
+            apply_changes(sync, batch, count);
+        }
+
+        uint64_t now = time_now_ms();
+        if (now - last_reconcile_ms >= RAFT_PEER_SYNC_RECONCILE_INTERVAL_MS) {
+            reconcile_with_view(sync);
+            last_reconcile_ms = now;
+        }
+    }
+
+    free(batch);
+    LOG_INFO("Raft peer sync stopped");
+    logger_pop_component();
+    return NULL;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+raft_peer_sync_t* raft_peer_sync_create(raft_state_t *raft,
+                                        cluster_view_t *view,
+                                        node_id_t self_id,
+                                        uint32_t debounce_ms) {
+    if (!raft || !view) return NULL;
+
+    raft_peer_sync_t *sync = safe_calloc(1, sizeof(raft_peer_sync_t));
+    if (!sync) return NULL;
+
+    sync->raft = raft;
+    sync->view = view;
+    sync->self_id = self_id;
+    sync->debounce_ms = debounce_ms ? debounce_ms : RAFT_PEER_SYNC_DEFAULT_DEBOUNCE_MS;
+
+    sync->pending = safe_calloc(MAX_CLUSTER_NODES, sizeof(pending_change_t));
+    sync->pending_slot = safe_calloc(NODE_ID_SPACE, sizeof(uint16_t));
+    sync->in_raft = safe_calloc(NODE_ID_SPACE / 8, 1);
+
+    if (!sync->pending || !sync->pending_slot || !sync->in_raft) {
+        safe_free(sync->pending);
+        safe_free(sync->pending_slot);
+        safe_free(sync->in_raft);
+        safe_free(sync);
+        return NULL;
+    }
+
+    pthread_mutex_init(&sync->lock, NULL);
+    pthread_cond_init(&sync->cond, NULL);
+
+    return sync;
+}
+
+int raft_peer_sync_start(raft_peer_sync_t *sync) {
+    if (!sync) return -1;
+
+    if (pthread_create(&sync->thread, NULL, apply_thread_fn, sync) != 0) {
+        LOG_ERROR("Failed to create Raft peer sync thread");
+        return -1;
+    }
+
+    sync->thread_started = 1;
+    return 0;
+}
+
+void raft_peer_sync_notify(raft_peer_sync_t *sync,
+                           node_id_t node_id,
+                           const char *ip_address,
+                           uint16_t data_port,
+                           const char *event_type) {
+    if (!sync || !event_type || node_id == sync->self_id) return;
+
+    int want_peer;
+    if (strcmp(event_type, MEMBER_EVENT_JOIN) == 0 ||
+        strcmp(event_type, MEMBER_EVENT_UPDATE) == 0) {
+        want_peer = 1;
+    } else if (strcmp(event_type, MEMBER_EVENT_LEAVE) == 0 ||
+               strcmp(event_type, MEMBER_EVENT_FAILED) == 0) {
+        want_peer = 0;
+    } else {
+        return;
+    }
+
+    pthread_mutex_lock(&sync->lock);
+
+    if (record_change_locked(sync, node_id, want_peer, ip_address, data_port) == 0) {
+        pthread_cond_signal(&sync->cond);
+    } else {
+        // Batch full; the periodic reconcile will pick this node up
+        LOG_WARN("Raft peer sync backlog full, deferring node %u", node_id);
+    }
+
+    pthread_mutex_unlock(&sync->lock);
+}
+
+void raft_peer_sync_reconcile(raft_peer_sync_t *sync) {
+    if (!sync) return;
+
+    pthread_mutex_lock(&sync->lock);
+    sync->reconcile_requested = 1;
+    pthread_cond_signal(&sync->cond);
+    pthread_mutex_unlock(&sync->lock);
+}
+
+void raft_peer_sync_destroy(raft_peer_sync_t *sync) {
+    if (!sync) return;
+
+    pthread_mutex_lock(&sync->lock);
+    sync->shutdown_flag = 1;
+    pthread_cond_broadcast(&sync->cond);
+    pthread_mutex_unlock(&sync->lock);
+
+    if (sync->thread_started) {
+        pthread_join(sync->thread, NULL);
+    }
+
+    pthread_cond_destroy(&sync->cond);
+    pthread_mutex_destroy(&sync->lock);
+
+    safe_free(sync->pending);
+    safe_free(sync->pending_slot);
+    safe_free(sync->in_raft);
+    safe_free(sync);
+}
@@ -6,6 +6,7 @@
 #include "roole/raft/raft_state.h"
 #include "roole/raft/raft_rpc.h"
 #include "roole/core/common.h"
+#include "roole/core/trace.h"
 #include "roole/logger/logger.h"
 #include <stdlib.h>
 #include <string.h>
@@ -446,8 +447,13 @@ static void* apply_thread_fn(void *arg) {
                 
                 // Apply to state machine
                 if (state->callbacks.on_apply) {
+                    uint64_t apply_start = entry->trace_id ? time_now_us() : 0;
                     state->callbacks.on_apply(entry, state->callbacks.user_data);
                     state->stats.commands_applied++;
+                    if (apply_start) {
+                        trace_record(TRACE_STAGE_APPLY, entry->trace_id, apply_start,
+                                     time_now_us(), i);
+                    }
                 }
                 
                 pthread_rwlock_unlock(&state->persistent->lock);
@@ -639,6 +645,7 @@ int raft_submit_command(raft_state_t *state,
     entry->data_len = data_len;
     entry->timestamp_ms = time_now_ms();
     entry->client_id = 0;
+    entry->trace_id = trace_current();
     
     state->persistent->log_count++;
     
@@ -867,4 +874,28 @@ void raft_get_stats(raft_state_t *state, raft_stats_t *out_stats) {
     pthread_mutex_lock(&state->stats.lock);
     *out_stats = state->stats;
     pthread_mutex_unlock(&state->stats.lock);
+}
+
+size_t raft_get_peer_progress(raft_state_t *state, raft_peer_progress_t *out, size_t max) {
+    if (!state || !out || max == 0 || !raft_is_leader(state)) return 0;
+    
+    uint64_t last_log_idx = get_last_log_index(state);
+    
+    // Same order as raft_add_peer: peer list, then leader state
+    pthread_mutex_lock(&state->peers_lock);
+    pthread_mutex_lock(&state->leader_state->lock);
+    
+    size_t count = ROOLE_MIN(state->leader_state->peer_count, max);
+    for (size_t i = 0; i < count; i++) {
+        uint64_t match = state->leader_state->match_index[i];
+        out[i].peer_id = state->leader_state->peers[i];
+        out[i].next_index = state->leader_state->next_index[i];
+        out[i].match_index = match;
+        out[i].lag = last_log_idx > match ? last_log_idx - match : 0;
+    }
+    
+    pthread_mutex_unlock(&state->leader_state->lock);
+    pthread_mutex_unlock(&state->peers_lock);
+    
+    return count;
 }
\ No newline at end of file
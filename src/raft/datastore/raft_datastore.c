@@ -7,6 +7,7 @@
 #include "roole/raft/raft_datastore.h"
 #include "roole/raft/raft_state.h"
 #include "roole/core/common.h"
+#include "roole/core/trace.h"
 #include "roole/logger/logger.h"
 #include <stdlib.h>
 #include <string.h>
@@ -252,7 +253,7 @@ int raft_cmd_deserialize_and_execute(const uint8_t *data,
             record = find_free_slot(store);
             if (!record) {
                 pthread_rwlock_unlock(&store->lock);
-                LOG_ERROR("Raft KV: Store full, cannot SET %s", key);
+                LOG_ERROR_RATELIMITED("Raft KV: Store full, cannot SET %s", key);
                 return -1;
             }
             
@@ -398,6 +399,7 @@ int raft_datastore_set(raft_datastore_t *store,
     LOG_DEBUG("Raft KV: SET request for key=%s, len=%zu", key, value_len);
     
     // 1. Serialize command
+    uint64_t submit_start = trace_begin();
     uint8_t cmd_buffer[RAFT_KV_MAX_VALUE_SIZE + 512];
     size_t cmd_len = raft_cmd_serialize_set(key, value, value_len,
                                              cmd_buffer, sizeof(cmd_buffer));
@@ -418,10 +420,13 @@ int raft_datastore_set(raft_datastore_t *store,
         return RESULT_ERR_INVALID;
     }
     
+    trace_end(TRACE_STAGE_RAFT_SUBMIT, submit_start, log_index);
     LOG_DEBUG("Raft KV: Command submitted (index=%lu, term=%lu)", log_index, log_term);
     
     // 3. Wait for commit
+    uint64_t wait_start = trace_begin();
     result = raft_wait_committed(store->raft_state, log_index, timeout_ms);
+    trace_end(TRACE_STAGE_COMMIT_WAIT, wait_start, log_index);
     
     if (result != 0) {
         LOG_ERROR("Raft KV: Timeout waiting for commit");
@@ -491,6 +496,7 @@ int raft_datastore_unset(raft_datastore_t *store,
     LOG_DEBUG("Raft KV: UNSET request for key=%s", key);
     
     // 1. Serialize command
+    uint64_t submit_start = trace_begin();
     uint8_t cmd_buffer[512];
     size_t cmd_len = raft_cmd_serialize_unset(key, cmd_buffer, sizeof(cmd_buffer));
     
@@ -508,9 +514,12 @@ int raft_datastore_unset(raft_datastore_t *store,
         LOG_DEBUG("Raft KV: Not leader, cannot UNSET");
         return RESULT_ERR_INVALID;
     }
+    trace_end(TRACE_STAGE_RAFT_SUBMIT, submit_start, log_index);
     
     // 3. Wait for commit
+    uint64_t wait_start = trace_begin();
     result = raft_wait_committed(store->raft_state, log_index, timeout_ms);
+    trace_end(TRACE_STAGE_COMMIT_WAIT, wait_start, log_index);
     
     if (result != 0) {
         LOG_ERROR("Raft KV: Timeout waiting for commit");
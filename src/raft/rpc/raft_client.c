@@ -78,7 +78,7 @@ int raft_rpc_append_entries(rpc_client_t *client,
     // Estimate: 38 bytes header + entries
     size_t est_size = 38;
     for (size_t i = 0; i < req->entry_count; i++) {
-        est_size += 31 + req->entries[i].data_len;
+        est_size += raft_log_entry_wire_size(&req->entries[i]);
     }
     
     uint8_t *req_buffer = safe_malloc(est_size);
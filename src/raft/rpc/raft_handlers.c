@@ -7,6 +7,7 @@
 #include "roole/raft/raft_state.h"
 #include "roole/rpc/rpc_types.h"
 #include "roole/core/common.h"
+#include "roole/core/trace.h"
 #include "roole/logger/logger.h"
 #include <stdlib.h>
 #include <string.h>
@@ -238,7 +239,14 @@ int handle_raft_append_entries(const uint8_t *request,
     
     // Rule 4 & 5: Append entries
     if (req.entry_count > 0) {
+        uint64_t append_start = time_now_us();
         append_log_entries(state, req.entries, req.entry_count, req.prev_log_index);
+        uint64_t append_end = time_now_us();
+        
+        for (size_t i = 0; i < req.entry_count; i++) {
+            trace_record(TRACE_STAGE_FOLLOWER_APPEND, req.entries[i].trace_id,
+                         append_start, append_end, req.entries[i].index);
+        }
         
         LOG_INFO("Raft: Appended %zu entries starting at index %lu",
                  req.entry_count, req.prev_log_index + 1);
@@ -51,10 +51,16 @@ static inline uint64_t read_u64(const uint8_t *buffer) {
 // LOG ENTRY SERIALIZATION
 // ============================================================================
 
+size_t raft_log_entry_wire_size(const raft_log_entry_t *entry) {
+    return RAFT_LOG_ENTRY_FIXED_SIZE + entry->data_len +
+           (entry->trace_id ? RAFT_ENTRY_TRACE_EXT_SIZE : 0);
+}
+
 /**
  * Serialize log entry
  * Format: [term:8][index:8][type:1][data_len:4][data][timestamp:8][client_id:2]
- * Total: 31 + data_len bytes
+ *         [trace_id:8, only when RAFT_ENTRY_FLAG_TRACED is set in type]
+ * Total: RAFT_LOG_ENTRY_FIXED_SIZE (31) + data_len bytes (+ 8 if traced)
  */
 size_t raft_serialize_log_entry(const raft_log_entry_t *entry,
                                  uint8_t *buffer,
@@ -64,7 +70,7 @@ size_t raft_serialize_log_entry(const raft_log_entry_t *entry,
         return 0;
     }
     
-    size_t required = 8 + 8 + 1 + 4 + entry->data_len + 8 + 2;
+    size_t required = raft_log_entry_wire_size(entry);
     
     if (buffer_size < required) {
         LOG_ERROR("Buffer too small for log entry: need %zu, have %zu", 
@@ -83,7 +89,7 @@ size_t raft_serialize_log_entry(const raft_log_entry_t *entry,
     offset += 8;
     
     // Type (1 byte)
-    buffer[offset++] = (uint8_t)entry->type;
+    buffer[offset++] = (uint8_t)entry->type | (entry->trace_id ? RAFT_ENTRY_FLAG_TRACED : 0);
     
     // Data length (4 bytes)
     write_u32(buffer + offset, (uint32_t)entry->data_len);
@@ -103,6 +109,12 @@ size_t raft_serialize_log_entry(const raft_log_entry_t *entry,
     write_u16(buffer + offset, entry->client_id);
     offset += 2;
     
+    // Trace ID (8 bytes, traced entries only)
+    if (entry->trace_id) {
+        write_u64(buffer + offset, entry->trace_id);
+        offset += RAFT_ENTRY_TRACE_EXT_SIZE;
+    }
+    
     LOG_DEBUG("Serialized log entry: index=%lu, term=%lu, size=%zu bytes",
               entry->index, entry->term, offset);
     
@@ -115,7 +127,7 @@ size_t raft_serialize_log_entry(const raft_log_entry_t *entry,
 int raft_deserialize_log_entry(const uint8_t *buffer,
                                 size_t buffer_len,
                                 raft_log_entry_t *entry) {
-    if (!buffer || !entry || buffer_len < 31) {
+    if (!buffer || !entry || buffer_len < RAFT_LOG_ENTRY_FIXED_SIZE) {
         LOG_ERROR("Invalid log entry deserialization parameters");
         return -1;
     }
@@ -132,8 +144,15 @@ int raft_deserialize_log_entry(const uint8_t *buffer,
     entry->index = read_u64(buffer + offset);
     offset += 8;
     
-    // Type
-    entry->type = (raft_entry_type_t)buffer[offset++];
+    // Type (the traced flag announces the trace ID extension)
+    uint8_t type_byte = buffer[offset++];
+    entry->type = (raft_entry_type_t)(type_byte & ~RAFT_ENTRY_FLAG_TRACED);
+    size_t fixed_size = RAFT_LOG_ENTRY_FIXED_SIZE +
+                        ((type_byte & RAFT_ENTRY_FLAG_TRACED) ? RAFT_ENTRY_TRACE_EXT_SIZE : 0);
+    if (buffer_len < fixed_size) {
+        LOG_ERROR("Truncated traced log entry");
+        return -1;
+    }
     
     // Data length
     entry->data_len = read_u32(buffer + offset);
@@ -141,7 +160,7 @@ int raft_deserialize_log_entry(const uint8_t *buffer,
     
     // Validate data length
     if (entry->data_len > 0) {
-        if (offset + entry->data_len + 8 + 2 > buffer_len) {
+        if (entry->data_len > buffer_len - fixed_size) {
             LOG_ERROR("Invalid log entry data length: %zu", entry->data_len);
             return -1;
         }
@@ -167,6 +186,12 @@ int raft_deserialize_log_entry(const uint8_t *buffer,
     entry->client_id = read_u16(buffer + offset);
     offset += 2;
     
+    // Trace ID
+    if (type_byte & RAFT_ENTRY_FLAG_TRACED) {
+        entry->trace_id = read_u64(buffer + offset);
+        offset += RAFT_ENTRY_TRACE_EXT_SIZE;
+    }
+    
     LOG_DEBUG("Deserialized log entry: index=%lu, term=%lu, data_len=%zu",
               entry->index, entry->term, entry->data_len);
     
@@ -435,8 +460,7 @@ int raft_deserialize_append_entries_req(const uint8_t *buffer,
             }
             
             // Calculate size of this entry to advance offset
-            size_t entry_size = 31 + req->entries[i].data_len;
-            offset += entry_size;
+            offset += raft_log_entry_wire_size(&req->entries[i]);
         }
     } else {
         req->entries = NULL;
@@ -5,6 +5,7 @@
 #include "roole/rpc/rpc_channel.h"
 #include "roole/rpc/rpc_types.h"
 #include "roole/core/common.h"
+#include "roole/core/trace.h"
 #include "roole/logger/logger.h"
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -249,16 +250,20 @@ int rpc_client_call(rpc_client_t *client, uint8_t func_id,
     uint8_t *tx_buffer = rpc_channel_get_tx_buffer(&client->channel);
     size_t tx_buffer_size = rpc_channel_get_tx_buffer_size(&client->channel);
     
-    if (request_len + RPC_HEADER_SIZE > tx_buffer_size) {
-        LOG_ERROR("Request too large: %zu + %d > %zu", 
-                 request_len, RPC_HEADER_SIZE, tx_buffer_size);
+    // Work done for a traced request stays in its trace on the callee
+    trace_id_t trace_id = trace_current();
+    size_t header_len = RPC_HEADER_SIZE + (trace_id ? RPC_TRACE_EXT_SIZE : 0);
+    
+    if (request_len + header_len > tx_buffer_size) {
+        LOG_ERROR("Request too large: %zu + %zu > %zu", 
+                 request_len, header_len, tx_buffer_size);
         pthread_mutex_unlock(&client->lock);
         return RPC_STATUS_BAD_ARGUMENT;
     }
     
-    size_t msg_len = rpc_pack_message(tx_buffer, client->local_node_id, request_id,
-                                      RPC_TYPE_REQUEST, RPC_STATUS_SUCCESS, func_id,
-                                      request, request_len);
+    size_t msg_len = rpc_pack_message_traced(tx_buffer, client->local_node_id, request_id,
+                                             RPC_TYPE_REQUEST, RPC_STATUS_SUCCESS, func_id,
+                                             trace_id, request, request_len);
     
     // Send request
     int sockfd = rpc_channel_get_fd(&client->channel);
@@ -306,8 +311,16 @@ int rpc_client_call(rpc_client_t *client, uint8_t func_id,
     LOG_DEBUG("Received response header: status=%u, total_len=%u", 
              status, header.total_len);
     
+    // Skip header extensions (a traced response carries our own trace ID)
+    uint8_t ext_buf[RPC_TRACE_EXT_SIZE];
+    size_t ext_len = rpc_header_len(&header) - RPC_HEADER_SIZE;
+    if (ext_len > 0 && recv_exact(sockfd, ext_buf, ext_len, timeout_ms) < 0) {
+        LOG_ERROR("Failed to receive response header extension");
+        return RPC_STATUS_TIMEOUT;
+    }
+    
     // Receive payload if present
-    size_t payload_len = header.total_len - RPC_HEADER_SIZE;
+    size_t payload_len = header.total_len - rpc_header_len(&header);
     
     if (payload_len > 0) {
         *response = (uint8_t*)safe_malloc(payload_len);
@@ -346,15 +359,18 @@ int rpc_client_send_async(rpc_client_t *client, uint8_t func_id,
     uint8_t *tx_buffer = rpc_channel_get_tx_buffer(&client->channel);
     size_t tx_buffer_size = rpc_channel_get_tx_buffer_size(&client->channel);
     
-    if (request_len + RPC_HEADER_SIZE > tx_buffer_size) {
+    trace_id_t trace_id = trace_current();
+    size_t header_len = RPC_HEADER_SIZE + (trace_id ? RPC_TRACE_EXT_SIZE : 0);
+    
+    if (request_len + header_len > tx_buffer_size) {
         LOG_ERROR("Request too large for async send");
         pthread_mutex_unlock(&client->lock);
         return -1;
     }
     
-    size_t msg_len = rpc_pack_message(tx_buffer, client->local_node_id, request_id,
-                                      RPC_TYPE_REQUEST, RPC_STATUS_SUCCESS, func_id,
-                                      request, request_len);
+    size_t msg_len = rpc_pack_message_traced(tx_buffer, client->local_node_id, request_id,
+                                             RPC_TYPE_REQUEST, RPC_STATUS_SUCCESS, func_id,
+                                             trace_id, request, request_len);
     
     int sockfd = rpc_channel_get_fd(&client->channel);
     ssize_t sent = send(sockfd, tx_buffer, msg_len, 0);
@@ -2,13 +2,23 @@
 #include "roole/rpc/rpc_types.h"
 #include "roole/core/common.h"
 #include <arpa/inet.h>
+#include <endian.h>
 #include <string.h>
 
 size_t rpc_pack_message(uint8_t *buffer, node_id_t node_id, uint32_t request_id, 
                          uint8_t type, uint8_t status, uint8_t func_id, 
                          const uint8_t *payload, size_t payload_len) {
+    return rpc_pack_message_traced(buffer, node_id, request_id, type, status, func_id, 0,
+                                   payload, payload_len);
+}
+
+size_t rpc_pack_message_traced(uint8_t *buffer, node_id_t node_id, uint32_t request_id,
+                               uint8_t type, uint8_t status, uint8_t func_id,
+                               uint64_t trace_id,
+                               const uint8_t *payload, size_t payload_len) {
     
-    uint32_t total_len = (uint32_t)(RPC_HEADER_SIZE + payload_len);
+    size_t header_len = RPC_HEADER_SIZE + (trace_id ? RPC_TRACE_EXT_SIZE : 0);
+    uint32_t total_len = (uint32_t)(header_len + payload_len);
     uint32_t net_total_len = htonl(total_len);
     uint32_t net_request_id = htonl(request_id);
     uint16_t net_node_id = htons(node_id);
@@ -18,14 +28,19 @@ size_t rpc_pack_message(uint8_t *buffer, node_id_t node_id, uint32_t request_id,
     memcpy(buffer + 8, &net_node_id, 2);
 
     rpc_type_status_t type_and_status;
-    type_and_status.fields.type = type;
+    type_and_status.fields.type = type | (trace_id ? RPC_TYPE_FLAG_TRACED : 0);
     type_and_status.fields.status = status;
     buffer[10] = type_and_status.byte;
 
     buffer[11] = func_id;
 
+    if (trace_id) {
+        uint64_t net_trace_id = htobe64(trace_id);
+        memcpy(buffer + RPC_HEADER_SIZE, &net_trace_id, RPC_TRACE_EXT_SIZE);
+    }
+
     if (payload_len > 0 && payload != NULL) {
-        memcpy(buffer + RPC_HEADER_SIZE, payload, payload_len);
+        memcpy(buffer + header_len, payload, payload_len);
     }
 
     return total_len;
@@ -50,12 +65,15 @@ int rpc_unpack_header(const uint8_t *buffer, rpc_header_t *header) {
     
     // Extract type_and_status at offset 10
     header->type_and_status.byte = buffer[10];
+    header->flags = header->type_and_status.fields.type & RPC_TYPE_FLAG_TRACED;
+    header->type_and_status.fields.type &= ~RPC_TYPE_FLAG_TRACED;
+    header->trace_id = 0;
     
     // Extract func_id at offset 11
     header->func_id = buffer[11];
 
     // Validate header
-    if (header->total_len < RPC_HEADER_SIZE) {
+    if (header->total_len < rpc_header_len(header)) {
         return -1;
     }
     
@@ -65,4 +83,16 @@ int rpc_unpack_header(const uint8_t *buffer, rpc_header_t *header) {
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+size_t rpc_header_len(const rpc_header_t *header) {
+    return RPC_HEADER_SIZE + ((header->flags & RPC_TYPE_FLAG_TRACED) ? RPC_TRACE_EXT_SIZE : 0);
+}
+
+void rpc_unpack_trace(const uint8_t *buffer, rpc_header_t *header) {
+    if (!(header->flags & RPC_TYPE_FLAG_TRACED)) return;
+
+    uint64_t net_trace_id;
+    memcpy(&net_trace_id, buffer + RPC_HEADER_SIZE, RPC_TRACE_EXT_SIZE);
+    header->trace_id = be64toh(net_trace_id);
+}
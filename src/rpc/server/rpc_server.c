@@ -5,6 +5,8 @@
 #include "roole/rpc/rpc_channel.h"
 #include "roole/rpc/rpc_types.h"
 #include "roole/core/common.h"
+#include "roole/core/rcu.h"
+#include "roole/core/trace.h"
 #include "roole/logger/logger.h"
 #include <sys/socket.h>
 #include <sys/epoll.h>
@@ -47,6 +49,10 @@ struct rpc_server {
     _Atomic uint64_t bytes_sent;
     _Atomic size_t active_connections;
     
+    // Per-request observer (metrics); swapped while the loop runs
+    const rpc_server_observer_t *observer;
+    rcu_gate_t observer_gate;           // Held around on_request calls
+    
     pthread_mutex_t lock;
 };
 
@@ -88,6 +94,15 @@ static void close_connection(rpc_server_t *server, connection_state_t *conn) {
 static void process_request(rpc_server_t *server, connection_state_t *conn,
                            const rpc_header_t *header, const uint8_t *payload) {
     server->requests_received++;
+    uint64_t start_us = time_now_us();
+    
+    // Requests entering the cluster here start a trace; internal ones carry
+    // the caller's. Handlers (and RPCs they send) see it as the current trace.
+    trace_id_t trace_id = header->trace_id;
+    if (!trace_id && server->config.trace_requests) {
+        trace_id = trace_new_id();
+    }
+    trace_set_current(trace_id);
     
     LOG_DEBUG("Processing request: func_id=%u, req_id=%u, sender=%u",
               header->func_id, header->request_id, header->sender_id);
@@ -102,11 +117,11 @@ static void process_request(rpc_server_t *server, connection_state_t *conn,
     uint8_t status = RPC_STATUS_SUCCESS;
     
     if (!handler) {
-        LOG_WARN("No handler for func_id=%u", header->func_id);
+        LOG_WARN_RATELIMITED("No handler for func_id=%u", header->func_id);
         status = RPC_STATUS_FUNC_NOT_FOUND;
     } else {
         // Calculate payload length
-        size_t payload_len = header->total_len - RPC_HEADER_SIZE;
+        size_t payload_len = header->total_len - rpc_header_len(header);
         
         // Invoke handler
         status = handler(payload, payload_len,
@@ -118,7 +133,7 @@ static void process_request(rpc_server_t *server, connection_state_t *conn,
                      header->func_id, response_len);
         } else {
             server->requests_failed++;
-            LOG_WARN("Handler failed: func_id=%u, status=%u", 
+            LOG_WARN_RATELIMITED("Handler failed: func_id=%u, status=%u", 
                     header->func_id, status);
         }
     }
@@ -133,7 +148,7 @@ static void process_request(rpc_server_t *server, connection_state_t *conn,
                                                response_payload, response_len);
     
     if (response_msg_len > tx_buffer_size) {
-        LOG_ERROR("Response too large: %zu > %zu", response_msg_len, tx_buffer_size);
+        LOG_ERROR_RATELIMITED("Response too large: %zu > %zu", response_msg_len, tx_buffer_size);
         // Try to send error response without payload
         response_msg_len = rpc_pack_message(tx_buffer, 0, header->request_id,
                                            RPC_TYPE_RESPONSE, RPC_STATUS_INTERNAL_ERROR,
@@ -145,13 +160,25 @@ static void process_request(rpc_server_t *server, connection_state_t *conn,
         server->bytes_sent += sent;
         LOG_DEBUG("Response sent: %zd bytes", sent);
     } else {
-        LOG_ERROR("Failed to send response: %s", strerror(errno));
+        LOG_ERROR_RATELIMITED("Failed to send response: %s", strerror(errno));
     }
     
     // Free response payload
     if (response_payload) {
         safe_free(response_payload);
     }
+    
+    uint64_t end_us = time_now_us();
+    trace_record(TRACE_STAGE_RPC, trace_id, start_us, end_us, header->func_id);
+    trace_set_current(0);
+    
+    uint32_t token = rcu_read_enter(&server->observer_gate);
+    const rpc_server_observer_t *observer = __atomic_load_n(&server->observer,
+                                                            __ATOMIC_SEQ_CST);
+    if (observer) {
+        observer->on_request(observer->ctx, header->func_id, status, end_us - start_us);
+    }
+    rcu_read_exit(&server->observer_gate, token);
 }
 
 // ============================================================================
@@ -171,7 +198,7 @@ static void handle_connection_data(rpc_server_t *server, connection_state_t *con
         if (received == 0) {
             LOG_DEBUG("Connection closed by peer: fd=%d", conn->fd);
         } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
-            LOG_ERROR("recv() failed: %s", strerror(errno));
+            LOG_ERROR_RATELIMITED("recv() failed: %s", strerror(errno));
         }
         close_connection(server, conn);
         return;
@@ -188,14 +215,14 @@ static void handle_connection_data(rpc_server_t *server, connection_state_t *con
     while (rx_data_len >= RPC_HEADER_SIZE) {
         rpc_header_t header;
         if (rpc_unpack_header(rx_buffer, &header) < 0) {
-            LOG_ERROR("Invalid RPC header, closing connection");
+            LOG_ERROR_RATELIMITED("Invalid RPC header, closing connection");
             close_connection(server, conn);
             return;
         }
         
         // Validate header
-        if (header.total_len < RPC_HEADER_SIZE || header.total_len > rx_buffer_size) {
-            LOG_ERROR("Invalid message length: %u (buffer size: %zu)", 
+        if (header.total_len < rpc_header_len(&header) || header.total_len > rx_buffer_size) {
+            LOG_ERROR_RATELIMITED("Invalid message length: %u (buffer size: %zu)", 
                      header.total_len, rx_buffer_size);
             close_connection(server, conn);
             return;
@@ -208,9 +235,11 @@ static void handle_connection_data(rpc_server_t *server, connection_state_t *con
             break;  // Need more data
         }
         
-        // Extract payload
-        const uint8_t *payload = (header.total_len > RPC_HEADER_SIZE) ?
-                                 (rx_buffer + RPC_HEADER_SIZE) : NULL;
+        // Extract trace ID and payload
+        rpc_unpack_trace(rx_buffer, &header);
+        size_t header_len = rpc_header_len(&header);
+        const uint8_t *payload = (header.total_len > header_len) ?
+                                 (rx_buffer + header_len) : NULL;
         
         // Process request
         process_request(server, conn, &header, payload);
@@ -234,7 +263,7 @@ static void accept_connection(rpc_server_t *server) {
     int client_fd = accept(server->listen_fd, (struct sockaddr*)&client_addr, &addr_len);
     if (client_fd < 0) {
         if (errno != EAGAIN && errno != EWOULDBLOCK) {
-            LOG_ERROR("accept() failed: %s", strerror(errno));
+            LOG_ERROR_RATELIMITED("accept() failed: %s", strerror(errno));
         }
         return;
     }
@@ -253,7 +282,7 @@ static void accept_connection(rpc_server_t *server) {
     // Find free connection slot
     connection_state_t *conn = find_free_connection(server);
     if (!conn) {
-        LOG_WARN("Max connections reached (%zu), rejecting client", 
+        LOG_WARN_RATELIMITED("Max connections reached (%zu), rejecting client", 
                 server->max_connections);
         close(client_fd);
         return;
@@ -287,9 +316,10 @@ static void accept_connection(rpc_server_t *server) {
     
     char ip[INET_ADDRSTRLEN];
     inet_ntop(AF_INET, &client_addr.sin_addr, ip, sizeof(ip));
-    LOG_INFO("New connection: fd=%d, from=%s:%u (active=%zu)", 
-             client_fd, ip, ntohs(client_addr.sin_port),
-             (size_t)server->active_connections);
+    LOG_RATELIMITED(LOG_LEVEL_INFO, LOG_RATELIMIT_PER_SEC, LOG_RATELIMIT_BURST,
+        "New connection: fd=%d, from=%s:%u (active=%zu)", 
+        client_fd, ip, ntohs(client_addr.sin_port),
+        (size_t)server->active_connections);
 }
 
 // ============================================================================
@@ -514,4 +544,13 @@ void rpc_server_get_stats(rpc_server_t *server, rpc_server_stats_t *out_stats) {
     out_stats->bytes_received = server->bytes_received;
     out_stats->bytes_sent = server->bytes_sent;
     out_stats->active_connections = server->active_connections;
-}
\ No newline at end of file
+}
+
+void rpc_server_set_observer(rpc_server_t *server, const rpc_server_observer_t *observer) {
+    if (!server) return;
+    
+    __atomic_store_n(&server->observer, observer, __ATOMIC_SEQ_CST);
+    
+    // A request that loaded the previous observer may still be calling it
+    rcu_synchronize(&server->observer_gate);
+}
@@ -0,0 +1,112 @@
+// test/tools/gossip_crypto_bench.c
+// Per-packet cost of gossip sealing/opening vs. serialization
+//
+// Usage: gossip_crypto_bench [iterations]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "roole/gossip/gossip_crypto.h"
+#include "roole/gossip/gossip_types.h"
+#include "roole/core/common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_KEY "1:000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+
+static double ns_per_op(uint64_t start_us, uint64_t end_us, long iterations)
+{
+    return (double)(end_us - start_us) * 1000.0 / (double)iterations;
+}
+
+static void bench_size(gossip_keyring_t *keyring, size_t size, long iterations)
+{
+    uint8_t plain[GOSSIP_MAX_PAYLOAD_SIZE];
+    uint8_t sealed[GOSSIP_MAX_PAYLOAD_SIZE];
+    uint8_t opened[GOSSIP_MAX_PAYLOAD_SIZE];
+    for (size_t i = 0; i < size; i++) plain[i] = (uint8_t)(i * 31);
+
+    ssize_t sealed_len = 0;
+
+    uint64_t start = time_now_us();
+    for (long i = 0; i < iterations; i++) {
+        sealed_len = gossip_crypto_seal(keyring, plain, size, sealed, sizeof(sealed));
+    }
+    double seal_ns = ns_per_op(start, time_now_us(), iterations);
+
+    if (sealed_len < 0) {
+        fprintf(stderr, "seal failed for %zu bytes\n", size);
+        return;
+    }
+
+    start = time_now_us();
+    for (long i = 0; i < iterations; i++) {
+        if (gossip_crypto_open(keyring, sealed, (size_t)sealed_len, opened, sizeof(opened)) < 0) {
+            fprintf(stderr, "open failed for %zu bytes\n", size);
+            return;
+        }
+    }
+    double open_ns = ns_per_op(start, time_now_us(), iterations);
+
+    printf("  %5zu B   seal %7.0f ns (%6.0f MB/s)   open %7.0f ns (%6.0f MB/s)\n",
+           size, seal_ns, size * 1000.0 / seal_ns,
+           open_ns, size * 1000.0 / open_ns);
+}
+
+static void bench_serialize(long iterations)
+{
+    gossip_message_t msg = {
+        .version = 1,
+        .msg_type = GOSSIP_MSG_PING,
+        .sender_id = 1,
+        .num_updates = GOSSIP_MAX_PIGGYBACK_UPDATES
+    };
+    for (int i = 0; i < GOSSIP_MAX_PIGGYBACK_UPDATES; i++) {
+        msg.updates[i].node_id = (node_id_t)(i + 1);
+        msg.updates[i].status = NODE_STATUS_ALIVE;
+        safe_strncpy(msg.updates[i].ip_address, "10.0.0.1", MAX_IP_LEN);
+    }
+
+    uint8_t buffer[GOSSIP_MAX_PAYLOAD_SIZE];
+    ssize_t size = 0;
+
+    uint64_t start = time_now_us();
+    for (long i = 0; i < iterations; i++) {
+        msg.sequence_num = (uint64_t)i;
+        size = gossip_message_serialize(&msg, buffer, sizeof(buffer));
+    }
+    double ns = ns_per_op(start, time_now_us(), iterations);
+
+    printf("  serialize full PING (%zd B): %.0f ns\n", size, ns);
+}
+
+int main(int argc, char *argv[])
+{
+    long iterations = argc > 1 ? atol(argv[1]) : 200000;
+    if (iterations <= 0) iterations = 200000;
+
+    if (!gossip_crypto_available()) {
+        printf("Gossip encryption not compiled in (ENABLE_GOSSIP_CRYPTO / OpenSSL)\n");
+        return 1;
+    }
+
+    gossip_keyring_t *keyring = gossip_keyring_create();
+    if (!keyring || gossip_keyring_load_spec(keyring, BENCH_KEY) != 1) {
+        fprintf(stderr, "Failed to set up keyring\n");
+        return 1;
+    }
+
+    printf("Gossip AES-256-GCM overhead (%ld iterations, +%d bytes/packet)\n",
+           iterations, GOSSIP_CRYPTO_OVERHEAD);
+
+    bench_serialize(iterations);
+
+    static const size_t sizes[] = { 64, 256, 512, 1024,
+                                    GOSSIP_MAX_PAYLOAD_SIZE - GOSSIP_CRYPTO_OVERHEAD };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        bench_size(keyring, sizes[i], iterations);
+    }
+
+    gossip_keyring_destroy(keyring);
+    return 0;
+}
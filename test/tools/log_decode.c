@@ -0,0 +1,38 @@
+// test/tools/log_decode.c
+// Decode a binary log (ROOLE_LOG_FORMAT=binary) back into text lines
+//
+// Usage: roole-logdecode [file]   (reads stdin without a file)
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "roole/logger/log_binary.h"
+#include <stdio.h>
+#include <string.h>
+
+int main(int argc, char *argv[])
+{
+    if (argc > 2 || (argc == 2 && strcmp(argv[1], "-h") == 0)) {
+        fprintf(stderr, "Usage: %s [file]\n", argv[0]);
+        return 2;
+    }
+
+    FILE *in = stdin;
+    if (argc == 2 && strcmp(argv[1], "-") != 0) {
+        in = fopen(argv[1], "rb");
+        if (!in) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    long records = log_stream_decode(in, stdout);
+
+    if (in != stdin) fclose(in);
+
+    if (records < 0) {
+        fflush(stdout);
+        fprintf(stderr, "Malformed or truncated binary log\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,210 @@
+// test/unit/cluster/test_cluster_view.c
+// Unit tests for cluster_view snapshots (versioning, immutability, concurrency)
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include "roole/cluster/cluster_view.h"
+
+static cluster_member_t make_member(node_id_t id, node_status_t status, uint64_t inc)
+{
+    cluster_member_t m = {
+        .node_id = id,
+        .node_type = NODE_TYPE_WORKER,
+        .gossip_port = 8000 + id,
+        .data_port = 9000 + id,
+        .status = status,
+        .incarnation = inc
+    };
+    safe_strncpy(m.ip_address, "127.0.0.1", MAX_IP_LEN);
+    return m;
+}
+
+// ============================================================================
+// TEST: Snapshot version increases on every mutation
+// ============================================================================
+
+static int test_snapshot_versioning(void)
+{
+    printf("\n=== Test: Snapshot Versioning ===\n");
+
+    cluster_view_t view;
+    assert(cluster_view_init(&view, 16) == RESULT_OK);
+
+    uint64_t v0 = cluster_view_version(&view);
+    assert(v0 > 0);
+
+    cluster_member_t m = make_member(1, NODE_STATUS_ALIVE, 0);
+    assert(cluster_view_add(&view, &m) == RESULT_OK);
+    uint64_t v1 = cluster_view_version(&view);
+    assert(v1 > v0);
+
+    assert(cluster_view_update_status(&view, 1, NODE_STATUS_SUSPECT, 0) == RESULT_OK);
+    uint64_t v2 = cluster_view_version(&view);
+    assert(v2 > v1);
+
+    assert(cluster_view_remove(&view, 1) == RESULT_OK);
+    uint64_t v3 = cluster_view_version(&view);
+    assert(v3 > v2);
+
+    // Failed mutation does not publish
+    assert(cluster_view_remove(&view, 1) == RESULT_ERR_NOTFOUND);
+    assert(cluster_view_version(&view) == v3);
+
+    cluster_view_destroy(&view);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Held snapshot is immutable while writers mutate the view
+// ============================================================================
+
+static int test_snapshot_immutable(void)
+{
+    printf("\n=== Test: Snapshot Immutable ===\n");
+
+    cluster_view_t view;
+    assert(cluster_view_init(&view, 16) == RESULT_OK);
+
+    cluster_member_t m1 = make_member(1, NODE_STATUS_ALIVE, 0);
+    cluster_member_t m2 = make_member(2, NODE_STATUS_ALIVE, 0);
+    cluster_view_add(&view, &m1);
+    cluster_view_add(&view, &m2);
+
+    cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(&view);
+    assert(snap != NULL);
+    assert(snap->count == 2);
+
+    cluster_view_update_status(&view, 2, NODE_STATUS_DEAD, 1);
+    cluster_view_remove(&view, 1);
+
+    // Old snapshot unchanged
+    assert(snap->count == 2);
+    const cluster_member_t *found = cluster_view_snapshot_find(snap, 2);
+    assert(found != NULL);
+    assert(found->status == NODE_STATUS_ALIVE);
+    assert(cluster_view_snapshot_find(snap, 1) != NULL);
+
+    // Lookup sees the new state
+    cluster_member_t copy;
+    assert(cluster_view_lookup(&view, 1, &copy) == RESULT_ERR_NOTFOUND);
+    assert(cluster_view_lookup(&view, 2, &copy) == RESULT_OK);
+    assert(copy.status == NODE_STATUS_DEAD);
+    assert(copy.incarnation == 1);
+
+    // Snapshot outlives the view
+    cluster_view_destroy(&view);
+    assert(snap->count == 2);
+    cluster_view_snapshot_release(snap);
+
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Concurrent readers always observe a consistent snapshot
+// ============================================================================
+
+#define STRESS_READERS 4
+#define STRESS_ROUNDS 2000
+
+typedef struct {
+    cluster_view_t *view;
+    volatile int stop;
+    int errors;
+} stress_ctx_t;
+
+static void* reader_thread(void *arg)
+{
+    stress_ctx_t *ctx = (stress_ctx_t*)arg;
+    uint64_t last_version = 0;
+
+    while (!ctx->stop) {
+        cluster_view_snapshot_t *snap = cluster_view_snapshot_acquire(ctx->view);
+        if (!snap) continue;
+
+        // Versions never go backwards for a single reader
+        if (snap->version < last_version) {
+            __atomic_add_fetch(&ctx->errors, 1, __ATOMIC_RELAXED);
+        }
+        last_version = snap->version;
+
+        // Every member the writer publishes has gossip_port == 8000 + node_id
+        for (size_t i = 0; i < snap->count; i++) {
+            if (snap->members[i].gossip_port != 8000 + snap->members[i].node_id) {
+                __atomic_add_fetch(&ctx->errors, 1, __ATOMIC_RELAXED);
+            }
+        }
+
+        cluster_view_snapshot_release(snap);
+    }
+    return NULL;
+}
+
+static int test_concurrent_readers(void)
+{
+    printf("\n=== Test: Concurrent Readers ===\n");
+
+    cluster_view_t view;
+    assert(cluster_view_init(&view, 64) == RESULT_OK);
+
+    stress_ctx_t ctx = { .view = &view, .stop = 0, .errors = 0 };
+    pthread_t readers[STRESS_READERS];
+
+    for (int i = 0; i < STRESS_READERS; i++) {
+        pthread_create(&readers[i], NULL, reader_thread, &ctx);
+    }
+
+    for (int round = 0; round < STRESS_ROUNDS; round++) {
+        node_id_t id = (node_id_t)(1 + round % 32);
+        cluster_member_t m = make_member(id, NODE_STATUS_ALIVE, (uint64_t)round);
+        cluster_view_add(&view, &m);
+        if (round % 3 == 0) {
+            cluster_view_remove(&view, id);
+        }
+    }
+
+    ctx.stop = 1;
+    for (int i = 0; i < STRESS_READERS; i++) {
+        pthread_join(readers[i], NULL);
+    }
+
+    printf("Final version: %lu, errors: %d\n", cluster_view_version(&view), ctx.errors);
+    assert(ctx.errors == 0);
+
+    cluster_view_destroy(&view);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST RUNNER
+// ============================================================================
+
+int main(void)
+{
+    printf("===========================================\n");
+    printf("  Cluster View Unit Tests\n");
+    printf("===========================================\n");
+
+    int failed = 0;
+
+    if (test_snapshot_versioning() != 0) failed++;
+    if (test_snapshot_immutable() != 0) failed++;
+    if (test_concurrent_readers() != 0) failed++;
+
+    printf("\n===========================================\n");
+    printf("  Summary\n");
+    printf("===========================================\n");
+    if (failed == 0) {
+        printf("✅ All cluster view tests passed!\n");
+        return 0;
+    }
+    printf("❌ %d test(s) failed\n", failed);
+    return 1;
+}
@@ -0,0 +1,621 @@
+// test/unit/core/test_event_bus.c
+// Unit tests for the event bus (MPSC queue, ordering, drops, stats)
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "roole/core/event_bus.h"
+
+#define PRODUCERS 4
+#define EVENTS_PER_PRODUCER 20000
+
+static void wait_until_drained(event_bus_t *bus, uint64_t expected_dispatched)
+{
+    for (int i = 0; i < 5000; i++) {
+        event_bus_stats_t stats;
+        event_bus_get_stats(bus, &stats);
+        if (stats.events_dispatched >= expected_dispatched && stats.queue_size == 0) return;
+        usleep(1000);
+    }
+    assert(!"event bus did not drain");
+}
+
+// ============================================================================
+// TEST: Every accepted event is delivered once, in per-producer order
+// ============================================================================
+
+typedef struct {
+    uint64_t next_seq[PRODUCERS];
+    uint64_t received;
+    int out_of_order;
+} order_ctx_t;
+
+static void order_handler(const event_t *event, void *user_data)
+{
+    order_ctx_t *ctx = user_data;
+    node_id_t producer = event->source_node_id;
+    uint64_t seq = event->data.execution.exec_id;
+
+    // Drops are allowed, reordering within a producer is not
+    if (seq < ctx->next_seq[producer]) ctx->out_of_order++;
+    ctx->next_seq[producer] = seq + 1;
+    ctx->received++;
+}
+
+typedef struct {
+    event_bus_t *bus;
+    node_id_t id;
+    uint64_t accepted;
+} producer_arg_t;
+
+static void* producer_fn(void *arg)
+{
+    producer_arg_t *p = arg;
+    for (uint64_t i = 0; i < EVENTS_PER_PRODUCER; i++) {
+        event_t event = {
+            .type = EVENT_TYPE_EXECUTION_STARTED,
+            .source_node_id = p->id,
+            .data.execution.exec_id = i
+        };
+        while (event_bus_publish(p->bus, &event) != 0) {
+            sched_yield();  // Retry so every event eventually lands
+        }
+        p->accepted++;
+    }
+    return NULL;
+}
+
+static int test_concurrent_publish_ordering()
+{
+    printf("\n=== Test: Concurrent Publish - Delivery and Ordering ===\n");
+
+    event_bus_t *bus = event_bus_create();
+    assert(bus != NULL);
+
+    order_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    assert(event_bus_subscribe(bus, EVENT_TYPE_EXECUTION_STARTED, order_handler, &ctx) == 0);
+
+    pthread_t threads[PRODUCERS];
+    producer_arg_t args[PRODUCERS];
+    for (int i = 0; i < PRODUCERS; i++) {
+        args[i] = (producer_arg_t){ .bus = bus, .id = (node_id_t)i };
+        pthread_create(&threads[i], NULL, producer_fn, &args[i]);
+    }
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    uint64_t total = (uint64_t)PRODUCERS * EVENTS_PER_PRODUCER;
+    wait_until_drained(bus, total);
+
+    event_bus_stats_t stats;
+    event_bus_get_stats(bus, &stats);
+    printf("  published=%lu dispatched=%lu dropped=%lu\n",
+           stats.events_published, stats.events_dispatched, stats.events_dropped);
+
+    assert(stats.events_dispatched == total);
+    assert(stats.events_published == total + stats.events_dropped);
+    assert(stats.subscribers_total == 1);
+
+    // Joining the dispatch thread makes the handler's writes visible
+    event_bus_destroy(bus);
+
+    assert(ctx.received == total);
+    assert(ctx.out_of_order == 0);
+    for (int i = 0; i < PRODUCERS; i++) {
+        assert(ctx.next_seq[i] == EVENTS_PER_PRODUCER);
+    }
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: A stalled subscriber fills the queue; publish drops instead of blocking
+// ============================================================================
+
+typedef struct {
+    pthread_mutex_t gate;
+    int delivered;
+} stall_ctx_t;
+
+static void stall_handler(const event_t *event, void *user_data)
+{
+    (void)event;
+    stall_ctx_t *ctx = user_data;
+    pthread_mutex_lock(&ctx->gate);
+    __atomic_fetch_add(&ctx->delivered, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&ctx->gate);
+}
+
+static int test_full_queue_drops()
+{
+    printf("\n=== Test: Full Queue - Non-Blocking Drop ===\n");
+
+    event_bus_t *bus = event_bus_create();
+    stall_ctx_t ctx = { .delivered = 0 };
+    pthread_mutex_init(&ctx.gate, NULL);
+    assert(event_bus_subscribe(bus, EVENT_TYPE_MESSAGE_ROUTED, stall_handler, &ctx) == 0);
+
+    pthread_mutex_lock(&ctx.gate);
+
+    event_t event = { .type = EVENT_TYPE_MESSAGE_ROUTED };
+    int accepted = 0, rejected = 0;
+    for (int i = 0; i < 4096; i++) {
+        if (event_bus_publish(bus, &event) == 0) accepted++;
+        else rejected++;
+    }
+    printf("  accepted=%d rejected=%d\n", accepted, rejected);
+    assert(rejected > 0);
+
+    event_bus_stats_t stats;
+    event_bus_get_stats(bus, &stats);
+    assert(stats.events_dropped == (uint64_t)rejected);
+    assert(stats.queue_size > 0);
+
+    pthread_mutex_unlock(&ctx.gate);
+    wait_until_drained(bus, (uint64_t)accepted);
+    assert(__atomic_load_n(&ctx.delivered, __ATOMIC_RELAXED) == accepted);
+
+    // Room again after draining
+    assert(event_bus_publish(bus, &event) == 0);
+
+    event_bus_destroy(bus);
+    pthread_mutex_destroy(&ctx.gate);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Sync publish and unsubscribe
+// ============================================================================
+
+static void count_handler(const event_t *event, void *user_data)
+{
+    (void)event;
+    __atomic_fetch_add((int*)user_data, 1, __ATOMIC_RELAXED);
+}
+
+static int test_sync_and_unsubscribe()
+{
+    printf("\n=== Test: Sync Publish and Unsubscribe ===\n");
+
+    event_bus_t *bus = event_bus_create();
+    int count = 0;
+
+    assert(event_bus_subscribe(bus, EVENT_TYPE_PEER_FAILED, count_handler, &count) == 0);
+
+    event_t event = { .type = EVENT_TYPE_PEER_FAILED };
+    assert(event_bus_publish_sync(bus, &event) == 0);
+    assert(count == 1);
+
+    assert(event_bus_unsubscribe(bus, EVENT_TYPE_PEER_FAILED, count_handler) == 0);
+    assert(event_bus_unsubscribe(bus, EVENT_TYPE_PEER_FAILED, count_handler) == -1);
+    assert(event_bus_publish_sync(bus, &event) == 0);
+    assert(count == 1);
+
+    event_bus_destroy(bus);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: A stalled subscriber only stalls its own lane
+// ============================================================================
+
+static int test_lane_isolation(event_lane_mode_t mode, event_type_t slow_type,
+                               event_type_t fast_type)
+{
+    printf("\n=== Test: Lane Isolation (%s) ===\n", event_lane_mode_to_string(mode));
+
+    event_bus_config_t config = { .lane_mode = mode, .queue_size = 2048 };
+    event_bus_t *bus = event_bus_create_with_config(&config);
+    assert(bus != NULL);
+
+    stall_ctx_t slow = { .delivered = 0 };
+    pthread_mutex_init(&slow.gate, NULL);
+    order_ctx_t fast;
+    memset(&fast, 0, sizeof(fast));
+
+    assert(event_bus_subscribe(bus, slow_type, stall_handler, &slow) == 0);
+    assert(event_bus_subscribe(bus, fast_type, order_handler, &fast) == 0);
+
+    pthread_mutex_lock(&slow.gate);
+
+    // With per-subscriber lanes on one type, the fast subscriber also
+    // gets the event that blocks the slow one
+    uint64_t expected_fast = slow_type == fast_type ? 1001 : 1000;
+    int expected_slow = slow_type == fast_type ? 1001 : 1;
+    event_t stuck = { .type = slow_type, .source_node_id = 1 };
+    assert(event_bus_publish(bus, &stuck) == 0);
+
+    // Lanes are created in subscription order: [0] slow, [1] fast.
+    // Wait until the slow lane has picked the event up and is blocked.
+    event_bus_lane_stats_t lanes[8];
+    for (int i = 0; i < 5000; i++) {
+        assert(event_bus_get_lane_stats(bus, lanes, 8) == 2);
+        if (lanes[0].queue_depth == 0) break;
+        usleep(1000);
+    }
+
+    for (uint64_t i = 0; i < 1000; i++) {
+        event_t event = { .type = fast_type, .data.execution.exec_id = i };
+        while (event_bus_publish(bus, &event) != 0) {
+            sched_yield();
+        }
+    }
+
+    // The fast lane drains completely while the slow handler is blocked
+    for (int i = 0; i < 5000; i++) {
+        assert(event_bus_get_lane_stats(bus, lanes, 8) == 2);
+        if (lanes[1].dispatched >= expected_fast) break;
+        usleep(1000);
+    }
+    assert(lanes[1].dispatched == expected_fast);
+    assert(lanes[1].queue_depth == 0);
+    assert(__atomic_load_n(&slow.delivered, __ATOMIC_RELAXED) == 0);
+
+    event_bus_stats_t stats;
+    event_bus_get_stats(bus, &stats);
+    assert(stats.lanes == 2);
+
+    size_t n = event_bus_get_lane_stats(bus, lanes, 8);
+    assert(n == 2);
+    for (size_t i = 0; i < n; i++) {
+        printf("  lane %-20s depth=%lu dispatched=%lu avg=%luus max=%luus\n",
+               lanes[i].name, lanes[i].queue_depth, lanes[i].dispatched,
+               lanes[i].avg_latency_us, lanes[i].max_latency_us);
+    }
+
+    pthread_mutex_unlock(&slow.gate);
+    wait_until_drained(bus, expected_fast + (uint64_t)expected_slow);
+    event_bus_destroy(bus);
+
+    // Per-subscriber lanes on one type: the slow subscriber sees everything
+    assert(slow.delivered == expected_slow);
+    assert(fast.received == expected_fast);
+    assert(fast.out_of_order == 0);
+
+    pthread_mutex_destroy(&slow.gate);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Membership storm - coalesced, never dropped, latest state wins
+// ============================================================================
+
+#define STORM_NODES 200
+#define STORM_UPDATES 50
+
+typedef struct {
+    pthread_mutex_t gate;
+    uint64_t last_incarnation[STORM_NODES + 1];
+    uint64_t delivered;
+    uint64_t batches;
+    int regressions;
+} storm_ctx_t;
+
+static void storm_batch_handler(const event_t *events, size_t count, void *user_data)
+{
+    storm_ctx_t *ctx = user_data;
+    pthread_mutex_lock(&ctx->gate);
+    for (size_t i = 0; i < count; i++) {
+        const event_peer_t *peer = &events[i].data.peer;
+        assert(events[i].type == EVENT_TYPE_PEER_UPDATED);
+        if (peer->incarnation < ctx->last_incarnation[peer->node_id]) ctx->regressions++;
+        ctx->last_incarnation[peer->node_id] = peer->incarnation;
+    }
+    ctx->delivered += count;
+    ctx->batches++;
+    pthread_mutex_unlock(&ctx->gate);
+}
+
+static int test_coalescing_storm()
+{
+    printf("\n=== Test: Coalescing - Membership Storm ===\n");
+
+    event_bus_config_t config = { .queue_size = 64 };
+    event_bus_t *bus = event_bus_create_with_config(&config);
+    storm_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    pthread_mutex_init(&ctx.gate, NULL);
+    assert(event_bus_subscribe_batch(bus, EVENT_TYPE_PEER_UPDATED, storm_batch_handler, &ctx) == 0);
+
+    // Hold the subscriber so updates pile up far beyond the queue size
+    pthread_mutex_lock(&ctx.gate);
+    for (uint64_t inc = 1; inc <= STORM_UPDATES; inc++) {
+        for (node_id_t id = 1; id <= STORM_NODES; id++) {
+            event_t event = {
+                .type = EVENT_TYPE_PEER_UPDATED,
+                .data.peer = { .node_id = id, .incarnation = inc }
+            };
+            assert(event_bus_publish(bus, &event) == 0);
+        }
+    }
+    pthread_mutex_unlock(&ctx.gate);
+
+    event_bus_stats_t stats;
+    for (int i = 0; i < 5000; i++) {
+        event_bus_get_stats(bus, &stats);
+        if (stats.events_dispatched + stats.events_coalesced == STORM_NODES * STORM_UPDATES &&
+            stats.queue_size == 0) break;
+        usleep(1000);
+    }
+    printf("  published=%lu dispatched=%lu coalesced=%lu dropped=%lu\n",
+           stats.events_published, stats.events_dispatched,
+           stats.events_coalesced, stats.events_dropped);
+
+    assert(stats.events_dropped == 0);
+    assert(stats.events_coalesced > 0);
+    assert(stats.events_dispatched + stats.events_coalesced == STORM_NODES * STORM_UPDATES);
+
+    event_bus_destroy(bus);
+
+    printf("  delivered=%lu in %lu batch(es)\n", ctx.delivered, ctx.batches);
+    assert(ctx.regressions == 0);
+    assert(ctx.batches < ctx.delivered);
+    for (node_id_t id = 1; id <= STORM_NODES; id++) {
+        assert(ctx.last_incarnation[id] == STORM_UPDATES);
+    }
+
+    pthread_mutex_destroy(&ctx.gate);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Batch subscribers alongside per-event subscribers; opt-out
+// ============================================================================
+
+static void count_batch_handler(const event_t *events, size_t count, void *user_data)
+{
+    (void)events;
+    __atomic_fetch_add((int*)user_data, (int)count, __ATOMIC_RELAXED);
+}
+
+static int test_batch_and_coalescing_opt_out()
+{
+    printf("\n=== Test: Batch Subscribers and Coalescing Opt-Out ===\n");
+
+    event_bus_t *bus = event_bus_create();
+    int single = 0, batched = 0;
+
+    assert(event_bus_set_coalescing(bus, EVENT_TYPE_PEER_SUSPECT, 0) == 0);
+    assert(event_bus_subscribe(bus, EVENT_TYPE_PEER_SUSPECT, count_handler, &single) == 0);
+    assert(event_bus_subscribe_batch(bus, EVENT_TYPE_PEER_SUSPECT, count_batch_handler,
+                                     &batched) == 0);
+
+    // Same key every time, but coalescing is off: all 100 are delivered
+    event_t event = { .type = EVENT_TYPE_PEER_SUSPECT, .data.peer.node_id = 7 };
+    for (int i = 0; i < 100; i++) {
+        assert(event_bus_publish(bus, &event) == 0);
+    }
+    assert(event_bus_publish_sync(bus, &event) == 0);
+
+    wait_until_drained(bus, 2 * 101);
+    event_bus_stats_t stats;
+    event_bus_get_stats(bus, &stats);
+    assert(stats.events_coalesced == 0);
+
+    assert(event_bus_unsubscribe_batch(bus, EVENT_TYPE_PEER_SUSPECT, count_batch_handler) == 0);
+    assert(event_bus_unsubscribe_batch(bus, EVENT_TYPE_PEER_SUSPECT, count_batch_handler) == -1);
+    assert(stats.subscribers_total == 2);
+
+    event_bus_destroy(bus);
+    assert(single == 101);
+    assert(batched == 101);
+
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: A terminal peer event drops that node's pending coalesced events
+// ============================================================================
+
+typedef struct {
+    event_type_t types[16];
+    node_id_t nodes[16];
+    int count;
+} peer_log_t;
+
+static void peer_log_handler(const event_t *event, void *user_data)
+{
+    peer_log_t *log = user_data;
+    assert(log->count < 16);
+    log->types[log->count] = event->type;
+    log->nodes[log->count] = event->data.peer.node_id;
+    log->count++;
+}
+
+static int test_terminal_event_supersedes_coalesced()
+{
+    printf("\n=== Test: Coalescing - Terminal Event Supersedes Pending ===\n");
+
+    event_bus_t *bus = event_bus_create();
+    stall_ctx_t stall = { .delivered = 0 };
+    pthread_mutex_init(&stall.gate, NULL);
+    peer_log_t log;
+    memset(&log, 0, sizeof(log));
+
+    assert(event_bus_subscribe(bus, EVENT_TYPE_MESSAGE_ROUTED, stall_handler, &stall) == 0);
+    assert(event_bus_subscribe(bus, EVENT_TYPE_PEER_SUSPECT, peer_log_handler, &log) == 0);
+    assert(event_bus_subscribe(bus, EVENT_TYPE_PEER_UPDATED, peer_log_handler, &log) == 0);
+    assert(event_bus_subscribe(bus, EVENT_TYPE_PEER_FAILED, peer_log_handler, &log) == 0);
+
+    // Park the shared lane so everything below is pending at once
+    pthread_mutex_lock(&stall.gate);
+    event_t routed = { .type = EVENT_TYPE_MESSAGE_ROUTED };
+    assert(event_bus_publish(bus, &routed) == 0);
+
+    event_t suspect = { .type = EVENT_TYPE_PEER_SUSPECT, .data.peer.node_id = 7 };
+    event_t updated = { .type = EVENT_TYPE_PEER_UPDATED, .data.peer.node_id = 7 };
+    event_t other = { .type = EVENT_TYPE_PEER_SUSPECT, .data.peer.node_id = 8 };
+    event_t failed = { .type = EVENT_TYPE_PEER_FAILED, .data.peer.node_id = 7 };
+    assert(event_bus_publish(bus, &suspect) == 0);
+    assert(event_bus_publish(bus, &updated) == 0);
+    assert(event_bus_publish(bus, &other) == 0);
+    assert(event_bus_publish(bus, &failed) == 0);
+
+    pthread_mutex_unlock(&stall.gate);
+    wait_until_drained(bus, 3);
+
+    event_bus_stats_t stats;
+    event_bus_get_stats(bus, &stats);
+    assert(stats.events_coalesced == 2);
+    event_bus_destroy(bus);
+
+    // Node 7 ends with FAILED and nothing stale after it; node 8 untouched
+    assert(log.count == 2);
+    for (int i = 0; i < log.count; i++) {
+        if (log.nodes[i] == 7) assert(log.types[i] == EVENT_TYPE_PEER_FAILED);
+        else assert(log.nodes[i] == 8 && log.types[i] == EVENT_TYPE_PEER_SUSPECT);
+    }
+
+    pthread_mutex_destroy(&stall.gate);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Payloads survive the compact queue (inline and pooled, pool overflow)
+// ============================================================================
+
+typedef struct {
+    pthread_mutex_t gate;
+    int peers_ok;
+    int catalogs_ok;
+    int corrupt;
+} payload_ctx_t;
+
+static void payload_handler(const event_t *event, void *user_data)
+{
+    payload_ctx_t *ctx = user_data;
+    pthread_mutex_lock(&ctx->gate);
+
+    if (event->type == EVENT_TYPE_PEER_JOINED) {
+        const event_peer_t *peer = &event->data.peer;
+        char ip[MAX_IP_LEN];
+        snprintf(ip, sizeof(ip), "10.0.0.%u", peer->node_id % 250);
+        if (event->source_node_id == 42 && event->timestamp_ms == 1000u + peer->node_id &&
+            strcmp(peer->ip_address, ip) == 0 && peer->gossip_port == 7000 &&
+            peer->data_port == 7001 && peer->incarnation == peer->node_id * 3u &&
+            peer->status == NODE_STATUS_ALIVE) {
+            ctx->peers_ok++;
+        } else {
+            ctx->corrupt++;
+        }
+    } else if (event->type == EVENT_TYPE_CATALOG_UPDATED) {
+        const event_catalog_t *cat = &event->data.catalog;
+        char name[64];
+        snprintf(name, sizeof(name), "dag-%u-with-a-fairly-long-descriptive-name", cat->dag_id);
+        if (cat->version == cat->dag_id + 1u && strcmp(cat->dag_name, name) == 0) {
+            ctx->catalogs_ok++;
+        } else {
+            ctx->corrupt++;
+        }
+    }
+
+    pthread_mutex_unlock(&ctx->gate);
+}
+
+static int test_payload_roundtrip()
+{
+    printf("\n=== Test: Compact Queue - Payload Roundtrip ===\n");
+
+    // More catalog events in flight than the payload pool holds
+    event_bus_config_t config = { .queue_size = 4096 };
+    event_bus_t *bus = event_bus_create_with_config(&config);
+    payload_ctx_t ctx = { .peers_ok = 0 };
+    pthread_mutex_init(&ctx.gate, NULL);
+    assert(event_bus_subscribe(bus, EVENT_TYPE_PEER_JOINED, payload_handler, &ctx) == 0);
+    assert(event_bus_subscribe(bus, EVENT_TYPE_CATALOG_UPDATED, payload_handler, &ctx) == 0);
+
+    pthread_mutex_lock(&ctx.gate);
+    for (uint32_t i = 1; i <= 1500; i++) {
+        event_t peer = {
+            .type = EVENT_TYPE_PEER_JOINED,
+            .timestamp_ms = 1000u + (i % 1000 + 1),
+            .source_node_id = 42,
+            .data.peer = {
+                .node_id = (node_id_t)(i % 1000 + 1),
+                .node_type = NODE_TYPE_WORKER,
+                .gossip_port = 7000,
+                .data_port = 7001,
+                .status = NODE_STATUS_ALIVE,
+                .incarnation = (i % 1000 + 1) * 3u
+            }
+        };
+        snprintf(peer.data.peer.ip_address, MAX_IP_LEN, "10.0.0.%u", (i % 1000 + 1) % 250);
+        assert(event_bus_publish(bus, &peer) == 0);
+
+        event_t cat = {
+            .type = EVENT_TYPE_CATALOG_UPDATED,
+            .data.catalog = { .dag_id = i, .version = i + 1u }
+        };
+        snprintf(cat.data.catalog.dag_name, sizeof(cat.data.catalog.dag_name),
+                 "dag-%u-with-a-fairly-long-descriptive-name", i);
+        assert(event_bus_publish(bus, &cat) == 0);
+    }
+    pthread_mutex_unlock(&ctx.gate);
+
+    wait_until_drained(bus, 3000);
+
+    event_bus_stats_t stats;
+    event_bus_get_stats(bus, &stats);
+    printf("  dispatched=%lu pool_misses=%lu\n", stats.events_dispatched,
+           stats.payload_pool_misses);
+    assert(stats.events_dropped == 0);
+    assert(stats.payload_pool_misses > 0);
+
+    event_bus_destroy(bus);
+
+    assert(ctx.corrupt == 0);
+    assert(ctx.peers_ok == 1500);
+    assert(ctx.catalogs_ok == 1500);
+
+    pthread_mutex_destroy(&ctx.gate);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("  Event Bus Tests\n");
+    printf("========================================\n");
+
+    int failed = 0;
+
+    if (test_concurrent_publish_ordering() != 0) failed++;
+    if (test_full_queue_drops() != 0) failed++;
+    if (test_sync_and_unsubscribe() != 0) failed++;
+    if (test_lane_isolation(EVENT_LANES_PER_TYPE, EVENT_TYPE_PEER_UPDATED,
+                            EVENT_TYPE_PEER_FAILED) != 0) failed++;
+    if (test_lane_isolation(EVENT_LANES_PER_SUBSCRIBER, EVENT_TYPE_PEER_FAILED,
+                            EVENT_TYPE_PEER_FAILED) != 0) failed++;
+    if (test_coalescing_storm() != 0) failed++;
+    if (test_batch_and_coalescing_opt_out() != 0) failed++;
+    if (test_terminal_event_supersedes_coalesced() != 0) failed++;
+    if (test_payload_roundtrip() != 0) failed++;
+
+    printf("\n========================================\n");
+    if (failed == 0) {
+        printf("✅ All tests passed!\n");
+    } else {
+        printf("❌ %d test(s) failed\n", failed);
+    }
+    printf("========================================\n");
+
+    return failed > 0 ? 1 : 0;
+}
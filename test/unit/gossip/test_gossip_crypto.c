@@ -0,0 +1,191 @@
+// test/unit/gossip/test_gossip_crypto.c
+// Tests for gossip packet sealing, tamper detection and key rotation
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "roole/gossip/gossip_crypto.h"
+#include "roole/gossip/gossip_types.h"
+#include "roole/core/common.h"
+
+#define KEY_A "1:000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+#define KEY_B "2:ffeeddccbbaa99887766554433221100ffeeddccbbaa99887766554433221100"
+
+static ssize_t make_ping(uint8_t *buffer, size_t size)
+{
+    gossip_message_t msg = {
+        .version = 1,
+        .msg_type = GOSSIP_MSG_PING,
+        .sender_id = 7,
+        .sequence_num = 99,
+        .num_updates = 1
+    };
+    msg.updates[0].node_id = 7;
+    msg.updates[0].status = NODE_STATUS_ALIVE;
+    msg.updates[0].gossip_port = 7000;
+    safe_strncpy(msg.updates[0].ip_address, "10.0.0.7", MAX_IP_LEN);
+
+    return gossip_message_serialize(&msg, buffer, size);
+}
+
+// ============================================================================
+// TEST CASES
+// ============================================================================
+
+static int test_seal_open_roundtrip()
+{
+    printf("\n=== Test: Seal/Open Roundtrip ===\n");
+
+    gossip_keyring_t *sender = gossip_keyring_create();
+    gossip_keyring_t *receiver = gossip_keyring_create();
+    assert(gossip_keyring_load_spec(sender, KEY_A) == 1);
+    assert(gossip_keyring_load_spec(receiver, KEY_A) == 1);
+
+    uint8_t plain[GOSSIP_MAX_PAYLOAD_SIZE];
+    ssize_t plain_len = make_ping(plain, sizeof(plain) - GOSSIP_CRYPTO_OVERHEAD);
+    assert(plain_len > 0);
+
+    uint8_t sealed[GOSSIP_MAX_PAYLOAD_SIZE], sealed2[GOSSIP_MAX_PAYLOAD_SIZE];
+    ssize_t sealed_len = gossip_crypto_seal(sender, plain, plain_len, sealed, sizeof(sealed));
+    assert(sealed_len == plain_len + GOSSIP_CRYPTO_OVERHEAD);
+    assert(gossip_crypto_is_sealed(sealed, sealed_len));
+    assert(memcmp(sealed + GOSSIP_CRYPTO_HEADER_SIZE, plain, plain_len) != 0);
+
+    // Nonces never repeat, so identical plaintexts differ on the wire
+    assert(gossip_crypto_seal(sender, plain, plain_len, sealed2, sizeof(sealed2)) == sealed_len);
+    assert(memcmp(sealed, sealed2, sealed_len) != 0);
+
+    uint8_t opened[GOSSIP_MAX_PAYLOAD_SIZE];
+    ssize_t opened_len = gossip_crypto_open(receiver, sealed, sealed_len, opened, sizeof(opened));
+    assert(opened_len == plain_len);
+    assert(memcmp(opened, plain, plain_len) == 0);
+
+    gossip_message_t msg;
+    assert(gossip_message_deserialize(opened, opened_len, &msg) == 0);
+    assert(msg.sender_id == 7 && msg.sequence_num == 99);
+
+    // Undersized output buffers are rejected up front
+    assert(gossip_crypto_seal(sender, plain, plain_len, sealed2, plain_len) == -1);
+
+    gossip_keyring_destroy(sender);
+    gossip_keyring_destroy(receiver);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+static int test_tampering_rejected()
+{
+    printf("\n=== Test: Tampered Packets Rejected ===\n");
+
+    gossip_keyring_t *keyring = gossip_keyring_create();
+    gossip_keyring_t *stranger = gossip_keyring_create();
+    assert(gossip_keyring_load_spec(keyring, KEY_A) == 1);
+    assert(gossip_keyring_load_spec(stranger, "1:" "00000000000000000000000000000000"
+                                              "00000000000000000000000000000000") == 1);
+
+    uint8_t plain[GOSSIP_MAX_PAYLOAD_SIZE];
+    ssize_t plain_len = make_ping(plain, sizeof(plain));
+
+    uint8_t sealed[GOSSIP_MAX_PAYLOAD_SIZE], opened[GOSSIP_MAX_PAYLOAD_SIZE];
+    ssize_t sealed_len = gossip_crypto_seal(keyring, plain, plain_len, sealed, sizeof(sealed));
+    assert(sealed_len > 0);
+
+    // Every single-bit flip (header, nonce, body, tag) must fail
+    for (ssize_t i = 0; i < sealed_len; i++) {
+        sealed[i] ^= 0x01;
+        assert(gossip_crypto_open(keyring, sealed, sealed_len, opened, sizeof(opened)) == -1);
+        sealed[i] ^= 0x01;
+    }
+
+    // Truncation, wrong key under the same ID, plaintext
+    assert(gossip_crypto_open(keyring, sealed, sealed_len - 1, opened, sizeof(opened)) == -1);
+    assert(gossip_crypto_open(stranger, sealed, sealed_len, opened, sizeof(opened)) == -1);
+    assert(gossip_crypto_open(keyring, plain, plain_len, opened, sizeof(opened)) == -1);
+    assert(!gossip_crypto_is_sealed(plain, plain_len));
+
+    // Original still opens
+    assert(gossip_crypto_open(keyring, sealed, sealed_len, opened, sizeof(opened)) == plain_len);
+
+    gossip_keyring_destroy(keyring);
+    gossip_keyring_destroy(stranger);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+static int test_key_rotation()
+{
+    printf("\n=== Test: Key Rotation ===\n");
+
+    gossip_keyring_t *old_node = gossip_keyring_create();
+    gossip_keyring_t *new_node = gossip_keyring_create();
+    assert(gossip_keyring_load_spec(old_node, KEY_A) == 1);
+    assert(gossip_keyring_load_spec(new_node, KEY_B "," KEY_A) == 2);
+    assert(gossip_keyring_count(new_node) == 2);
+
+    uint8_t plain[GOSSIP_MAX_PAYLOAD_SIZE];
+    ssize_t plain_len = make_ping(plain, sizeof(plain));
+    uint8_t sealed[GOSSIP_MAX_PAYLOAD_SIZE], opened[GOSSIP_MAX_PAYLOAD_SIZE];
+
+    // Mid-rotation: new node seals with key 2, still accepts key 1
+    ssize_t len = gossip_crypto_seal(old_node, plain, plain_len, sealed, sizeof(sealed));
+    assert(sealed[1] == 1);
+    assert(gossip_crypto_open(new_node, sealed, len, opened, sizeof(opened)) == plain_len);
+
+    len = gossip_crypto_seal(new_node, plain, plain_len, sealed, sizeof(sealed));
+    assert(sealed[1] == 2);
+    assert(gossip_crypto_open(old_node, sealed, len, opened, sizeof(opened)) == -1);
+
+    // Primary cannot be removed; retiring key 1 stops accepting it
+    assert(gossip_keyring_remove(new_node, 2) == -1);
+    assert(gossip_keyring_remove(new_node, 1) == 0);
+    len = gossip_crypto_seal(old_node, plain, plain_len, sealed, sizeof(sealed));
+    assert(gossip_crypto_open(new_node, sealed, len, opened, sizeof(opened)) == -1);
+
+    // Bad specs
+    gossip_keyring_t *bad = gossip_keyring_create();
+    assert(gossip_keyring_load_spec(bad, "1:abcd") == -1);
+    assert(gossip_keyring_load_spec(bad, "x:" "00") == -1);
+    assert(gossip_keyring_load_spec(bad, KEY_A "00") == -1);
+    assert(gossip_crypto_seal(bad, plain, plain_len, sealed, sizeof(sealed)) == -1);
+
+    gossip_keyring_destroy(bad);
+    gossip_keyring_destroy(old_node);
+    gossip_keyring_destroy(new_node);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("  Gossip Crypto Tests\n");
+    printf("========================================\n");
+
+    if (!gossip_crypto_available()) {
+        printf("Gossip encryption not compiled in, skipping\n");
+        return 0;
+    }
+
+    int failed = 0;
+
+    if (test_seal_open_roundtrip() != 0) failed++;
+    if (test_tampering_rejected() != 0) failed++;
+    if (test_key_rotation() != 0) failed++;
+
+    printf("\n========================================\n");
+    if (failed == 0) {
+        printf("✅ All tests passed!\n");
+    } else {
+        printf("❌ %d test(s) failed\n", failed);
+    }
+    printf("========================================\n");
+
+    return failed > 0 ? 1 : 0;
+}
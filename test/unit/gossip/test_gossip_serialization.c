@@ -263,6 +263,100 @@ static int test_bootstrap_response_roundtrip()
     return 0;
 }
 
+static int test_coord_trailer_roundtrip()
+{
+    printf("\n=== Test: Coordinate Trailer Roundtrip ===\n");
+    
+    gossip_message_t original = {
+        .version = 1,
+        .msg_type = GOSSIP_MSG_ACK,
+        .flags = GOSSIP_FLAG_HAS_COORD,
+        .sender_id = 7,
+        .sequence_num = 99,
+        .num_updates = 1
+    };
+    original.updates[0].node_id = 7;
+    original.updates[0].status = NODE_STATUS_ALIVE;
+    safe_strncpy(original.updates[0].ip_address, "10.0.0.7", MAX_IP_LEN);
+    original.coord.vec[0] = 1250.5f;
+    original.coord.vec[1] = -310.25f;
+    original.coord.vec[2] = 42.0f;
+    original.coord.height = 85.0f;
+    original.coord.error = 0.4f;
+    
+    uint8_t buffer[GOSSIP_MAX_PAYLOAD_SIZE];
+    ssize_t size = gossip_message_serialize(&original, buffer, sizeof(buffer));
+    assert(size == (ssize_t)gossip_message_serialized_size(&original));
+    
+    gossip_message_t decoded;
+    assert(gossip_message_deserialize(buffer, size, &decoded) == 0);
+    assert(decoded.flags & GOSSIP_FLAG_HAS_COORD);
+    assert(decoded.num_updates == 1);
+    assert(memcmp(&decoded.coord, &original.coord, sizeof(gossip_coord_t)) == 0);
+    
+    // Trailer cut off in transit: updates survive, flag is cleared
+    assert(gossip_message_deserialize(buffer, size - 4, &decoded) == 0);
+    assert(decoded.num_updates == 1);
+    assert(!(decoded.flags & GOSSIP_FLAG_HAS_COORD));
+    
+    // No room for trailer when serializing: flag dropped on the wire
+    size_t without = gossip_message_serialized_size(&original) - 20;
+    size = gossip_message_serialize(&original, buffer, without);
+    assert(size == (ssize_t)without);
+    assert(gossip_message_deserialize(buffer, size, &decoded) == 0);
+    assert(!(decoded.flags & GOSSIP_FLAG_HAS_COORD));
+    
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+static int test_load_trailer_roundtrip()
+{
+    printf("\n=== Test: Load Trailer Roundtrip (with Coordinate) ===\n");
+    
+    gossip_message_t original = {
+        .version = 1,
+        .msg_type = GOSSIP_MSG_PING,
+        .flags = GOSSIP_FLAG_HAS_COORD | GOSSIP_FLAG_HAS_LOAD,
+        .sender_id = 3,
+        .sequence_num = 5,
+        .num_updates = 0
+    };
+    original.coord.height = 120.0f;
+    original.coord.error = 0.8f;
+    original.load.cpu_pct = 73;
+    original.load.queue_depth = 4096;
+    original.load.rpc_inflight = 17;
+    original.load.active_executions = 2;
+    original.load.raft_apply_lag = 70000;
+    
+    uint8_t buffer[GOSSIP_MAX_PAYLOAD_SIZE];
+    ssize_t size = gossip_message_serialize(&original, buffer, sizeof(buffer));
+    assert(size == (ssize_t)gossip_message_serialized_size(&original));
+    assert(size == 16 + 20 + 12);
+    
+    gossip_message_t decoded;
+    assert(gossip_message_deserialize(buffer, size, &decoded) == 0);
+    assert(decoded.flags == (GOSSIP_FLAG_HAS_COORD | GOSSIP_FLAG_HAS_LOAD));
+    assert(decoded.coord.height == 120.0f);
+    assert(decoded.load.cpu_pct == 73);
+    assert(decoded.load.queue_depth == 4096);
+    assert(decoded.load.rpc_inflight == 17);
+    assert(decoded.load.active_executions == 2);
+    assert(decoded.load.raft_apply_lag == 70000);
+    
+    // Load alone (no coordinate) sits directly after the updates
+    original.flags = GOSSIP_FLAG_HAS_LOAD;
+    size = gossip_message_serialize(&original, buffer, sizeof(buffer));
+    assert(size == 16 + 12);
+    assert(gossip_message_deserialize(buffer, size, &decoded) == 0);
+    assert(decoded.flags == GOSSIP_FLAG_HAS_LOAD);
+    assert(decoded.load.raft_apply_lag == 70000);
+    
+    printf("✅ Test passed\n");
+    return 0;
+}
+
 static int test_message_size_calculation()
 {
     printf("\n=== Test: Message Size Calculation ===\n");
@@ -307,6 +401,8 @@ int main(void)
     if (test_serialize_buffer_too_small() != 0) failed++;
     if (test_bootstrap_response_roundtrip() != 0) failed++;
     if (test_message_size_calculation() != 0) failed++;
+    if (test_coord_trailer_roundtrip() != 0) failed++;
+    if (test_load_trailer_roundtrip() != 0) failed++;
     
     printf("\n===========================================\n");
     printf("  Summary\n");
@@ -0,0 +1,520 @@
+// test/unit/gossip/test_swim_adaptive.c
+// Unit tests for adaptive SWIM: fanout, period, RTT/Vivaldi and load piggyback
+
+#define _POSIX_C_SOURCE 200809L
+#define _BSD_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include "roole/gossip/gossip_protocol.h"
+#include "roole/gossip/vivaldi.h"
+#include "roole/cluster/cluster_view.h"
+
+// Test fixture
+typedef struct {
+    cluster_view_t cluster_view;
+    gossip_protocol_t *protocol;
+    
+    // Track callback invocations
+    int alive_count;
+    int suspect_count;
+    int dead_count;
+    int send_count;
+    
+    node_id_t last_alive_node;
+    node_id_t last_suspect_node;
+    node_id_t last_dead_node;
+    
+    gossip_message_t last_sent_msg;
+    char last_dest_ip[MAX_IP_LEN];
+    uint16_t last_dest_port;
+    
+    int pings_to[32];               // PINGs sent, by dest_port - 8000
+} test_fixture_t;
+
+// Mock callbacks
+static void mock_on_member_alive(node_id_t node_id,
+                                 const gossip_member_update_t *update,
+                                 void *ctx)
+{
+    (void)update;
+    test_fixture_t *fixture = (test_fixture_t*)ctx;
+    fixture->alive_count++;
+    fixture->last_alive_node = node_id;
+    printf("[TEST] Callback: Node %u is ALIVE\n", node_id);
+}
+
+static void mock_on_member_suspect(node_id_t node_id,
+                                   uint64_t incarnation,
+                                   void *ctx)
+{
+    test_fixture_t *fixture = (test_fixture_t*)ctx;
+    fixture->suspect_count++;
+    fixture->last_suspect_node = node_id;
+    printf("[TEST] Callback: Node %u is SUSPECT (inc=%lu)\n", node_id, incarnation);
+}
+
+static void mock_on_member_dead(node_id_t node_id, void *ctx)
+{
+    test_fixture_t *fixture = (test_fixture_t*)ctx;
+    fixture->dead_count++;
+    fixture->last_dead_node = node_id;
+    printf("[TEST] Callback: Node %u is DEAD\n", node_id);
+}
+
+static void mock_on_send_message(const gossip_message_t *msg,
+                                 const char *dest_ip,
+                                 uint16_t dest_port,
+                                 void *ctx)
+{
+    test_fixture_t *fixture = (test_fixture_t*)ctx;
+    fixture->send_count++;
+    fixture->last_sent_msg = *msg;
+    
+    if (dest_ip) {
+        safe_strncpy(fixture->last_dest_ip, dest_ip, MAX_IP_LEN);
+        fixture->last_dest_port = dest_port;
+        if (msg->msg_type == GOSSIP_MSG_PING && dest_port >= 8000 && dest_port < 8032) {
+            fixture->pings_to[dest_port - 8000]++;
+        }
+        printf("[TEST] Send: type=%u to %s:%u updates=%u\n",
+               msg->msg_type, dest_ip, dest_port, msg->num_updates);
+    } else {
+        fixture->last_dest_ip[0] = '\0';
+        fixture->last_dest_port = 0;
+        printf("[TEST] Send: type=%u (broadcast) updates=%u\n",
+               msg->msg_type, msg->num_updates);
+    }
+}
+
+// Setup and teardown
+static void setup_fixture(test_fixture_t *fixture)
+{
+    memset(fixture, 0, sizeof(test_fixture_t));
+    
+    cluster_view_init(&fixture->cluster_view, 100);
+    
+    gossip_config_t config = gossip_default_config();
+    config.ack_timeout_ms = 500;
+    config.dead_timeout_ms = 2000;
+    
+    gossip_protocol_callbacks_t callbacks = {
+        .on_member_alive = mock_on_member_alive,
+        .on_member_suspect = mock_on_member_suspect,
+        .on_member_dead = mock_on_member_dead,
+        .on_send_message = mock_on_send_message
+    };
+    
+    fixture->protocol = gossip_protocol_create(
+        1,                      // my_id
+        NODE_TYPE_ROUTER,       // my_type
+        "127.0.0.1",           // my_ip
+        8000,                  // gossip_port
+        9000,                  // data_port
+        &config,
+        &fixture->cluster_view,
+        &callbacks,
+        fixture
+    );
+    
+    assert(fixture->protocol != NULL);
+}
+
+static void teardown_fixture(test_fixture_t *fixture)
+{
+    if (fixture->protocol) {
+        gossip_protocol_destroy(fixture->protocol);
+    }
+    cluster_view_destroy(&fixture->cluster_view);
+}
+
+
+// ============================================================================
+// TEST: Fanout after membership churn
+// ============================================================================
+
+static int test_fanout_after_churn()
+{
+    printf("\n=== Test: Fanout - Gossip Updates to Multiple Peers After Churn ===\n");
+    
+    test_fixture_t fixture;
+    setup_fixture(&fixture);
+    
+    for (node_id_t id = 2; id <= 5; id++) {
+        cluster_member_t peer = {
+            .node_id = id,
+            .node_type = NODE_TYPE_WORKER,
+            .status = NODE_STATUS_ALIVE,
+            .incarnation = 0,
+            .gossip_port = 8000 + id,
+            .data_port = 9000 + id
+        };
+        safe_strncpy(peer.ip_address, "127.0.0.2", MAX_IP_LEN);
+        cluster_view_add(&fixture.cluster_view, &peer);
+    }
+    
+    // View changed: 1 PING + (fanout - 1) GOSSIP messages
+    gossip_protocol_run_swim_round(fixture.protocol);
+    assert(fixture.send_count == 3);
+    
+    gossip_protocol_stats_t stats;
+    gossip_protocol_get_stats(fixture.protocol, &stats);
+    assert(stats.pings_sent == 1);
+    assert(stats.gossip_sent == 2);
+    assert(stats.current_fanout == 3);
+    
+    // Stable view: elevated fanout lasts ~log2(N) rounds, then probe only
+    for (int i = 0; i < 8; i++) {
+        gossip_protocol_run_swim_round(fixture.protocol);
+    }
+    fixture.send_count = 0;
+    gossip_protocol_run_swim_round(fixture.protocol);
+    assert(fixture.send_count == 1);
+    assert(fixture.last_sent_msg.msg_type == GOSSIP_MSG_PING);
+    
+    teardown_fixture(&fixture);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Probe target is uniform when fanout > 1
+// ============================================================================
+
+static int test_probe_target_uniform()
+{
+    printf("\n=== Test: Probe Target - Uniform Across Peers Under Churn ===\n");
+    
+    test_fixture_t fixture;
+    setup_fixture(&fixture);
+    
+    for (node_id_t id = 2; id <= 5; id++) {
+        cluster_member_t peer = {
+            .node_id = id,
+            .node_type = NODE_TYPE_WORKER,
+            .status = NODE_STATUS_ALIVE,
+            .gossip_port = 8000 + id,
+            .data_port = 9000 + id
+        };
+        safe_strncpy(peer.ip_address, "127.0.0.2", MAX_IP_LEN);
+        cluster_view_add(&fixture.cluster_view, &peer);
+    }
+    
+    // A dead member coming and going keeps the view churning (fanout 3)
+    // without adding a probe candidate
+    cluster_member_t ghost = {
+        .node_id = 20,
+        .node_type = NODE_TYPE_WORKER,
+        .status = NODE_STATUS_DEAD,
+        .gossip_port = 8020,
+        .data_port = 9020
+    };
+    safe_strncpy(ghost.ip_address, "127.0.0.3", MAX_IP_LEN);
+    
+    const int rounds = 1200;
+    srand(7);
+    for (int i = 0; i < rounds; i++) {
+        if (i % 2 == 0) {
+            cluster_view_add(&fixture.cluster_view, &ghost);
+        } else {
+            cluster_view_remove(&fixture.cluster_view, ghost.node_id);
+        }
+        gossip_protocol_run_swim_round(fixture.protocol);
+    }
+    
+    gossip_protocol_stats_t stats;
+    gossip_protocol_get_stats(fixture.protocol, &stats);
+    assert(stats.current_fanout == 3);
+    assert(fixture.pings_to[20] == 0);
+    
+    // Each of the 4 peers expects rounds/4 = 300 probes
+    for (int id = 2; id <= 5; id++) {
+        printf("Peer %d probed %d times\n", id, fixture.pings_to[id]);
+        assert(fixture.pings_to[id] > rounds / 4 - 75);
+        assert(fixture.pings_to[id] < rounds / 4 + 75);
+    }
+    
+    teardown_fixture(&fixture);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Adaptive protocol period
+// ============================================================================
+
+static int test_adaptive_period()
+{
+    printf("\n=== Test: Adaptive Period - Stable Slows Down, Churn Speeds Up ===\n");
+    
+    test_fixture_t fixture;
+    setup_fixture(&fixture);
+    
+    gossip_config_t defaults = gossip_default_config();
+    assert(gossip_protocol_get_period_ms(fixture.protocol) == defaults.protocol_period_ms);
+    
+    // Stable cluster: by default the period never drifts above the base
+    for (int i = 0; i < 20; i++) {
+        gossip_protocol_run_swim_round(fixture.protocol);
+    }
+    assert(gossip_protocol_get_period_ms(fixture.protocol) == defaults.protocol_period_ms);
+    
+    // Sustained churn: period drops to the configured minimum
+    for (node_id_t id = 2; id < 22; id++) {
+        cluster_member_t peer = {
+            .node_id = id,
+            .node_type = NODE_TYPE_WORKER,
+            .status = NODE_STATUS_ALIVE,
+            .gossip_port = 8000 + id,
+            .data_port = 9000 + id
+        };
+        safe_strncpy(peer.ip_address, "127.0.0.2", MAX_IP_LEN);
+        cluster_view_add(&fixture.cluster_view, &peer);
+        gossip_protocol_run_swim_round(fixture.protocol);
+    }
+    assert(gossip_protocol_get_period_ms(fixture.protocol) == defaults.min_protocol_period_ms);
+    
+    teardown_fixture(&fixture);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: RTT measured from PING/ACK feeds latency estimates
+// ============================================================================
+
+static int test_rtt_from_ping_ack()
+{
+    printf("\n=== Test: RTT - PING/ACK Round Trip Updates Latency Estimate ===\n");
+    
+    test_fixture_t fixture;
+    setup_fixture(&fixture);
+    
+    cluster_member_t peer = {
+        .node_id = 2,
+        .node_type = NODE_TYPE_WORKER,
+        .status = NODE_STATUS_ALIVE,
+        .gossip_port = 8002,
+        .data_port = 9002
+    };
+    safe_strncpy(peer.ip_address, "127.0.0.2", MAX_IP_LEN);
+    cluster_view_add(&fixture.cluster_view, &peer);
+    
+    assert(gossip_protocol_estimate_rtt_us(fixture.protocol, 2) == 0);
+    
+    gossip_protocol_run_swim_round(fixture.protocol);
+    assert(fixture.last_sent_msg.msg_type == GOSSIP_MSG_PING);
+    assert(fixture.last_sent_msg.flags & GOSSIP_FLAG_HAS_COORD);
+    
+    usleep(2000);
+    
+    // Peer answers, advertising a coordinate 5ms away
+    gossip_message_t ack = {
+        .version = 1,
+        .msg_type = GOSSIP_MSG_ACK,
+        .flags = GOSSIP_FLAG_HAS_COORD,
+        .sender_id = 2,
+        .sequence_num = 1,
+        .num_updates = 0
+    };
+    vivaldi_init(&ack.coord);
+    ack.coord.vec[0] = 5000.0f;
+    
+    gossip_protocol_handle_message(fixture.protocol, &ack, "127.0.0.2", 8002);
+    
+    gossip_peer_latency_t latency;
+    assert(gossip_protocol_get_peer_latency(fixture.protocol, 2, &latency) == 0);
+    assert(latency.samples == 1);
+    assert(latency.has_coord);
+    assert(latency.last_rtt_us >= 2000);
+    assert(latency.srtt_us == latency.last_rtt_us);
+    
+    uint32_t estimate = gossip_protocol_estimate_rtt_us(fixture.protocol, 2);
+    printf("Measured RTT: %uus, estimate: %uus\n", latency.last_rtt_us, estimate);
+    assert(estimate == latency.srtt_us);
+    
+    // Local coordinate moved away from the origin
+    gossip_coord_t coord;
+    gossip_protocol_get_coord(fixture.protocol, &coord);
+    assert(coord.error < VIVALDI_INITIAL_ERROR);
+    
+    // Unsolicited ACK (no pending PING) is not a sample
+    gossip_protocol_handle_message(fixture.protocol, &ack, "127.0.0.2", 8002);
+    assert(gossip_protocol_get_peer_latency(fixture.protocol, 2, &latency) == 0);
+    assert(latency.samples == 1);
+    
+    teardown_fixture(&fixture);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Load summary piggyback (rate-limited provider, delivery on receipt)
+// ============================================================================
+
+static int g_load_provider_calls;
+static int g_peer_load_calls;
+static member_load_t g_last_peer_load;
+
+static int mock_get_local_load(member_load_t *out_load, void *ctx)
+{
+    (void)ctx;
+    g_load_provider_calls++;
+    out_load->cpu_pct = 42;
+    out_load->rpc_inflight = (uint16_t)g_load_provider_calls;
+    return 0;
+}
+
+static void mock_on_peer_load(node_id_t node_id, const member_load_t *load, void *ctx)
+{
+    (void)ctx;
+    (void)node_id;
+    g_peer_load_calls++;
+    g_last_peer_load = *load;
+}
+
+static int test_load_piggyback()
+{
+    printf("\n=== Test: Load Summary - Rate-Limited Piggyback ===\n");
+    
+    test_fixture_t fixture;
+    setup_fixture(&fixture);
+    
+    fixture.protocol->callbacks.get_local_load = mock_get_local_load;
+    fixture.protocol->callbacks.on_peer_load = mock_on_peer_load;
+    fixture.protocol->config.load_report_interval_ms = 200;
+    g_load_provider_calls = 0;
+    g_peer_load_calls = 0;
+    
+    cluster_member_t peer = {
+        .node_id = 2,
+        .node_type = NODE_TYPE_WORKER,
+        .status = NODE_STATUS_ALIVE,
+        .gossip_port = 8002,
+        .data_port = 9002
+    };
+    safe_strncpy(peer.ip_address, "127.0.0.2", MAX_IP_LEN);
+    cluster_view_add(&fixture.cluster_view, &peer);
+    
+    // Several PINGs within one interval sample the provider once
+    for (int i = 0; i < 5; i++) {
+        gossip_protocol_run_swim_round(fixture.protocol);
+        assert(fixture.last_sent_msg.flags & GOSSIP_FLAG_HAS_LOAD);
+        assert(fixture.last_sent_msg.load.cpu_pct == 42);
+    }
+    assert(g_load_provider_calls == 1);
+    
+    usleep(250000);
+    gossip_protocol_run_swim_round(fixture.protocol);
+    assert(g_load_provider_calls == 2);
+    assert(fixture.last_sent_msg.load.rpc_inflight == 2);
+    
+    // Summaries from peers are delivered on receipt
+    gossip_message_t ping = {
+        .version = 1,
+        .msg_type = GOSSIP_MSG_GOSSIP,
+        .flags = GOSSIP_FLAG_HAS_LOAD,
+        .sender_id = 2,
+        .sequence_num = 1,
+        .num_updates = 0
+    };
+    ping.load.cpu_pct = 90;
+    ping.load.raft_apply_lag = 12;
+    gossip_protocol_handle_message(fixture.protocol, &ping, "127.0.0.2", 8002);
+    assert(g_peer_load_calls == 1);
+    assert(g_last_peer_load.cpu_pct == 90);
+    assert(g_last_peer_load.raft_apply_lag == 12);
+    
+    // No flag, no delivery
+    ping.flags = 0;
+    gossip_protocol_handle_message(fixture.protocol, &ping, "127.0.0.2", 8002);
+    assert(g_peer_load_calls == 1);
+    
+    teardown_fixture(&fixture);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Vivaldi coordinates converge to measured RTTs
+// ============================================================================
+
+static int test_vivaldi_convergence()
+{
+    printf("\n=== Test: Vivaldi - Coordinates Converge to Measured RTT ===\n");
+    
+    // Three nodes on a line: A-B 10ms, B-C 10ms, A-C 20ms
+    const float rtt[3][3] = {
+        {     0.0f, 10000.0f, 20000.0f },
+        { 10000.0f,     0.0f, 10000.0f },
+        { 20000.0f, 10000.0f,     0.0f }
+    };
+    gossip_coord_t nodes[3];
+    for (int i = 0; i < 3; i++) {
+        vivaldi_init(&nodes[i]);
+    }
+    
+    srand(42);
+    for (int round = 0; round < 500; round++) {
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                if (i == j) continue;
+                gossip_coord_t remote = nodes[j];
+                assert(vivaldi_update(&nodes[i], &remote, rtt[i][j]) == 0);
+            }
+        }
+    }
+    
+    for (int i = 0; i < 3; i++) {
+        for (int j = i + 1; j < 3; j++) {
+            float predicted = vivaldi_distance_us(&nodes[i], &nodes[j]);
+            float rel_error = (predicted - rtt[i][j]) / rtt[i][j];
+            if (rel_error < 0) rel_error = -rel_error;
+            printf("Node %d-%d: measured=%.0fus predicted=%.0fus\n",
+                   i, j, rtt[i][j], predicted);
+            assert(rel_error < 0.15f);
+        }
+    }
+    
+    // Garbage samples are rejected
+    gossip_coord_t bad = nodes[1];
+    bad.height = -1.0f;
+    assert(vivaldi_update(&nodes[0], &bad, 1000.0f) == -1);
+    assert(vivaldi_update(&nodes[0], &nodes[1], 0.0f) == -1);
+    
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST RUNNER
+// ============================================================================
+
+int main(void)
+{
+    printf("===========================================\n");
+    printf("  Adaptive SWIM Unit Tests\n");
+    printf("===========================================\n");
+    
+    int failed = 0;
+    
+    if (test_fanout_after_churn() != 0) failed++;
+    if (test_probe_target_uniform() != 0) failed++;
+    if (test_adaptive_period() != 0) failed++;
+    if (test_rtt_from_ping_ack() != 0) failed++;
+    if (test_vivaldi_convergence() != 0) failed++;
+    if (test_load_piggyback() != 0) failed++;
+    
+    printf("\n===========================================\n");
+    printf("  Summary\n");
+    printf("===========================================\n");
+    if (failed == 0) {
+        printf("✅ All adaptive SWIM tests passed!\n");
+        return 0;
+    }
+    printf("❌ %d test(s) failed\n", failed);
+    return 1;
+}
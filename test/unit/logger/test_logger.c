@@ -0,0 +1,601 @@
+// test/unit/logger/test_logger.c
+// Tests for per-thread log rings, the writer thread and line formatting
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <time.h>
+#include "roole/logger/logger.h"
+#include "roole/logger/log_binary.h"
+
+#define CAPTURE_PATH_LEN 64
+
+// ============================================================================
+// STDOUT CAPTURE
+// ============================================================================
+
+typedef struct {
+    char path[CAPTURE_PATH_LEN];
+    int saved_fd;
+} capture_t;
+
+static void capture_begin(capture_t *cap)
+{
+    fflush(stdout);
+    snprintf(cap->path, sizeof(cap->path), "/tmp/roole_logger_test_XXXXXX");
+    int fd = mkstemp(cap->path);
+    assert(fd >= 0);
+    cap->saved_fd = dup(STDOUT_FILENO);
+    dup2(fd, STDOUT_FILENO);
+    close(fd);
+}
+
+// Returns the captured output (caller frees)
+static char* capture_end(capture_t *cap, size_t *len)
+{
+    fflush(stdout);
+    dup2(cap->saved_fd, STDOUT_FILENO);
+    close(cap->saved_fd);
+
+    FILE *f = fopen(cap->path, "rb");
+    assert(f);
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    char *data = malloc((size_t)size + 1);
+    assert(fread(data, 1, (size_t)size, f) == (size_t)size);
+    data[size] = '\0';
+    fclose(f);
+    unlink(cap->path);
+
+    *len = (size_t)size;
+    return data;
+}
+
+// ============================================================================
+// TEST: Many threads, nothing lost or torn
+// ============================================================================
+
+#define WRITER_THREADS 200   // More than the old 128-thread registry
+#define LINES_PER_THREAD 300
+
+static void* log_worker(void *arg)
+{
+    int id = (int)(long)arg;
+    logger_push_component("worker");
+    for (int i = 0; i < LINES_PER_THREAD; i++) {
+        LOG_INFO("thread=%d seq=%d", id, i);
+    }
+    logger_pop_component();
+    return NULL;
+}
+
+static int test_many_threads_no_loss()
+{
+    printf("\n=== Test: Many Threads - No Loss, No Tearing ===\n");
+
+    capture_t cap;
+    capture_begin(&cap);
+
+    logger_init();
+    logger_set_context(7, "test-cluster", "worker");
+
+    pthread_t threads[WRITER_THREADS];
+    for (long i = 0; i < WRITER_THREADS; i++) {
+        assert(pthread_create(&threads[i], NULL, log_worker, (void*)i) == 0);
+    }
+    for (int i = 0; i < WRITER_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    logger_shutdown();
+
+    size_t len;
+    char *out = capture_end(&cap, &len);
+
+    int *next_seq = calloc(WRITER_THREADS, sizeof(int));
+    int lines = 0;
+    for (char *line = strtok(out, "\n"); line; line = strtok(NULL, "\n")) {
+        assert(line[0] == '[');
+        assert(strstr(line, "[INFO][node:7][test-cluster][worker][tid:") != NULL);
+
+        const char *msg = strstr(line, "thread=");
+        assert(msg);
+        int id, seq;
+        assert(sscanf(msg, "thread=%d seq=%d", &id, &seq) == 2);
+        assert(id >= 0 && id < WRITER_THREADS);
+        assert(seq == next_seq[id]);  // Per-thread order preserved
+        next_seq[id]++;
+        lines++;
+    }
+
+    for (int i = 0; i < WRITER_THREADS; i++) {
+        assert(next_seq[i] == LINES_PER_THREAD);
+    }
+    printf("  %d lines from %d threads\n", lines, WRITER_THREADS);
+    assert(lines == WRITER_THREADS * LINES_PER_THREAD);
+
+    free(next_seq);
+    free(out);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Line format, timestamp cache, context updates
+// ============================================================================
+
+static int test_line_format()
+{
+    printf("\n=== Test: Line Format ===\n");
+
+    capture_t cap;
+    capture_begin(&cap);
+
+    logger_init();
+    logger_set_context(3, "alpha", "router");
+    LOG_INFO("first");
+    logger_push_component("gossip");
+    logger_push_component("probe");
+    LOG_WARN("second %d", 2);
+    logger_pop_component();
+    logger_pop_component();
+    logger_set_context(4, "beta", "router");
+    LOG_DEBUG("filtered out");
+    usleep(20000);
+    LOG_INFO("third");
+    logger_flush();
+    logger_shutdown();
+
+    size_t len;
+    char *out = capture_end(&cap, &len);
+
+    char *first = strstr(out, "first");
+    char *second = strstr(out, "second 2");
+    char *third = strstr(out, "third");
+    assert(first && second && third);
+    assert(first < second && second < third);
+    assert(strstr(out, "filtered out") == NULL);
+    assert(strstr(out, "][INFO][node:3][alpha][tid:") != NULL);
+    assert(strstr(out, "][WARN][node:3][alpha][gossip:probe][tid:") != NULL);
+    assert(strstr(out, "][INFO][node:4][beta][tid:") != NULL);
+
+    // "[YYYY-MM-DDTHH:MM:SS.mmmZ]" and millisecond digits stay well-formed
+    for (char *line = strtok(out, "\n"); line; line = strtok(NULL, "\n")) {
+        assert(strlen(line) > 26);
+        assert(line[0] == '[' && line[11] == 'T' && line[20] == '.');
+        assert(line[24] == 'Z' && line[25] == ']');
+        for (int i = 21; i < 24; i++) assert(line[i] >= '0' && line[i] <= '9');
+    }
+
+    free(out);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Logging without a writer thread is synchronous
+// ============================================================================
+
+static int test_synchronous_without_init()
+{
+    printf("\n=== Test: Synchronous Without Writer ===\n");
+
+    capture_t cap;
+    capture_begin(&cap);
+    LOG_INFO("direct line");
+
+    // Visible immediately, before any flush
+    size_t len;
+    char *out = capture_end(&cap, &len);
+    assert(strstr(out, "direct line\n") != NULL);
+
+    free(out);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Captured arguments render exactly like printf
+// ============================================================================
+
+static void __attribute__((format(printf, 1, 2))) check_render(const char *fmt, ...)
+{
+    char expected[512], got[512];
+    va_list args;
+
+    va_start(args, fmt);
+    vsnprintf(expected, sizeof(expected), fmt, args);
+    va_end(args);
+
+    log_arg_spec_t specs[LOG_SITE_MAX_ARGS];
+    int n = log_format_parse(fmt, specs, LOG_SITE_MAX_ARGS);
+    assert(n >= 0);
+
+    uint8_t buf[LOG_ARGS_MAX];
+    va_start(args, fmt);
+    size_t len = log_args_encode(specs, n, &args, buf, sizeof(buf));
+    va_end(args);
+
+    log_args_render(fmt, specs, n, buf, len, got, sizeof(got));
+    if (strcmp(expected, got) != 0) {
+        fprintf(stderr, "fmt '%s': expected '%s' got '%s'\n", fmt, expected, got);
+    }
+    assert(strcmp(expected, got) == 0);
+}
+
+static int test_argument_capture()
+{
+    printf("\n=== Test: Argument Capture ===\n");
+
+    char unterminated[4] = { 'a', 'b', 'c', 'd' };
+
+    check_render("plain text, 100%% literal");
+    check_render("node %u at %s:%d", 7u, "10.0.0.7", 7000);
+    check_render("%-6s|%6s|%.2s|", "ab", "cd", "efgh");
+    check_render("%.*s|%*d|%-*.*f", 3, unterminated, 5, 42, 9, 2, 3.14159);
+    check_render("%ld %lu %lld %llx %zu %zd %jd %td", -1L, 2UL, -3LL, 0xABCDULL,
+                 (size_t)4, (ssize_t)-5, (intmax_t)6, (ptrdiff_t)-7);
+    check_render("%hd %hhu %c %o %#x %X %+d % d %05d", (short)-8, (unsigned char)200,
+                 'z', 8, 255, 255, 9, 10, 11);
+    check_render("%e %g %a %10.3f %Lf", 1234.5, 0.0001, 1.0, -2.5, (long double)1.25);
+    check_render("%p %s", (void*)0x1234, (const char*)NULL);
+
+    // Formats we cannot capture fall back to eager formatting
+    log_arg_spec_t specs[LOG_SITE_MAX_ARGS];
+    assert(log_format_parse("%n", specs, LOG_SITE_MAX_ARGS) == -1);
+    assert(log_format_parse("%m", specs, LOG_SITE_MAX_ARGS) == -1);
+    assert(log_format_parse("%ls", specs, LOG_SITE_MAX_ARGS) == -1);
+    assert(log_format_parse("trailing %", specs, LOG_SITE_MAX_ARGS) == -1);
+    assert(log_format_parse("%d %d", specs, 1) == -1);
+
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Deferred formatting produces the same lines as text mode
+// ============================================================================
+
+static void log_sample_lines(int round)
+{
+    char unterminated[3] = { 'x', 'y', 'z' };
+    const char *dynamic = round % 2 ? "dynamic odd %d" : "dynamic even %d";
+
+    logger_push_component("raft");
+    logger_push_component("apply");
+    LOG_INFO("round=%d key=%s size=%zu ratio=%.3f", round, "user:42", (size_t)4096, 0.5);
+    logger_pop_component();
+    logger_pop_component();
+    LOG_WARN("partial %.*s|", 2, unterminated);
+    errno = ENOENT;
+    LOG_INFO("eager %m after %d", round);
+    LOG_INFO(dynamic, round);  // Non-literal format: takes the text path
+}
+
+static char* capture_sample(const char *format)
+{
+    setenv("ROOLE_LOG_FORMAT", format, 1);
+
+    capture_t cap;
+    capture_begin(&cap);
+    logger_init();
+    logger_set_context(9, "deferred", "worker");
+    for (int round = 0; round < 4; round++) {
+        log_sample_lines(round);
+    }
+    logger_shutdown();
+
+    size_t len;
+    char *out = capture_end(&cap, &len);
+    unsetenv("ROOLE_LOG_FORMAT");
+    return out;
+}
+
+// Drop "[timestamp]" and "[tid:..]" so runs can be compared
+static void strip_volatile(char *text)
+{
+    char *dst = text;
+    for (char *line = text; *line; ) {
+        char *end = strchr(line, '\n');
+        size_t len = end ? (size_t)(end - line + 1) : strlen(line);
+        char *close = memchr(line, ']', len);
+        char *tid = strstr(line, "[tid:");
+        char *tid_end = tid ? strchr(tid, ']') : NULL;
+        assert(close && tid && tid_end && tid_end < line + len);
+
+        size_t head = (size_t)(tid - (close + 1));
+        memmove(dst, close + 1, head);
+        dst += head;
+        size_t tail = len - (size_t)(tid_end + 1 - line);
+        memmove(dst, tid_end + 1, tail);
+        dst += tail;
+        line += len;
+    }
+    *dst = '\0';
+}
+
+static int test_deferred_matches_text()
+{
+    printf("\n=== Test: Deferred Matches Text ===\n");
+
+    char *text = capture_sample("text");
+    char *deferred = capture_sample("deferred");
+    strip_volatile(text);
+    strip_volatile(deferred);
+
+    if (strcmp(text, deferred) != 0) {
+        fprintf(stderr, "text:\n%s\ndeferred:\n%s\n", text, deferred);
+    }
+    assert(strcmp(text, deferred) == 0);
+    assert(strstr(text, "[INFO][node:9][deferred][raft:apply][") != NULL);
+    assert(strstr(text, "key=user:42 size=4096 ratio=0.500") != NULL);
+    assert(strstr(text, "partial xy|") != NULL);
+    assert(strstr(text, "eager No such file or directory after 3") != NULL);
+    assert(strstr(text, "dynamic odd 3") != NULL);
+
+    free(text);
+    free(deferred);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Binary stream written by the logger decodes back to text
+// ============================================================================
+
+static void* binary_worker(void *arg)
+{
+    int id = (int)(long)arg;
+    for (int i = 0; i < 500; i++) {
+        LOG_INFO("worker=%d seq=%d name=%s", id, i, "binary");
+    }
+    return NULL;
+}
+
+static int test_binary_stream_roundtrip()
+{
+    printf("\n=== Test: Binary Stream Roundtrip ===\n");
+
+    char path[] = "/tmp/roole_logger_bin_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    setenv("ROOLE_LOG_FORMAT", "binary", 1);
+    setenv("ROOLE_LOG_BINARY_PATH", path, 1);
+
+    logger_init();
+    logger_set_context(5, "bin", "router");
+
+    pthread_t threads[8];
+    for (long i = 0; i < 8; i++) {
+        assert(pthread_create(&threads[i], NULL, binary_worker, (void*)i) == 0);
+    }
+    for (int i = 0; i < 8; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    logger_shutdown();
+
+    unsetenv("ROOLE_LOG_FORMAT");
+    unsetenv("ROOLE_LOG_BINARY_PATH");
+
+    FILE *in = fopen(path, "rb");
+    assert(in);
+    char *text = NULL;
+    size_t text_len = 0;
+    FILE *out = open_memstream(&text, &text_len);
+    long records = log_stream_decode(in, out);
+    fclose(out);
+    fclose(in);
+    unlink(path);
+
+    printf("  %ld records decoded\n", records);
+    assert(records == 8 * 500);
+
+    int next_seq[8] = {0};
+    for (char *line = strtok(text, "\n"); line; line = strtok(NULL, "\n")) {
+        assert(strstr(line, "][INFO][node:5][bin][tid:") != NULL);
+        int id, seq;
+        const char *msg = strstr(line, "worker=");
+        assert(msg && sscanf(msg, "worker=%d seq=%d", &id, &seq) == 2);
+        assert(id >= 0 && id < 8 && seq == next_seq[id]);
+        assert(strstr(msg, "name=binary") != NULL);
+        next_seq[id]++;
+    }
+    for (int i = 0; i < 8; i++) assert(next_seq[i] == 500);
+
+    free(text);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Per-component levels and skipped argument evaluation
+// ============================================================================
+
+static int evaluations = 0;
+
+static int count_evaluation(void)
+{
+    return ++evaluations;
+}
+
+static int test_component_levels()
+{
+    printf("\n=== Test: Component Levels ===\n");
+
+    capture_t cap;
+    capture_begin(&cap);
+    logger_set_level(LOG_LEVEL_INFO);
+
+    // Disabled statements do not evaluate their arguments
+    LOG_DEBUG("global debug %d", count_evaluation());
+    assert(evaluations == 0);
+
+    assert(logger_set_component_level("raft", LOG_LEVEL_DEBUG) == 0);
+    assert(logger_set_component_level("gossip:protocol", LOG_LEVEL_ERROR) == 0);
+    assert(logger_set_component_level("", LOG_LEVEL_DEBUG) == -1);
+
+    logger_push_component("raft:heartbeat");
+    LOG_DEBUG("raft debug %d", count_evaluation());
+    logger_push_component("gossip:protocol");  // Innermost override wins
+    LOG_WARN("nested warn");
+    logger_pop_component();
+    logger_pop_component();
+
+    logger_push_component("rafters");          // Prefix must end at ':'
+    LOG_DEBUG("rafters debug");
+    logger_pop_component();
+
+    logger_push_component("gossip:protocol");
+    LOG_WARN("gossip warn");
+    LOG_ERROR("gossip error");
+    logger_pop_component();
+
+    log_component_level_t levels[LOG_MAX_COMPONENT_LEVELS];
+    assert(logger_get_component_levels(levels, LOG_MAX_COMPONENT_LEVELS) == 2);
+
+    assert(logger_clear_component_level("raft") == 0);
+    assert(logger_clear_component_level("raft") == -1);
+    logger_push_component("raft:heartbeat");
+    LOG_DEBUG("raft debug after clear %d", count_evaluation());
+    logger_pop_component();
+    assert(logger_clear_component_level("gossip:protocol") == 0);
+
+    // Global level changes apply too
+    logger_set_level(LOG_LEVEL_WARN);
+    LOG_INFO("global info while warn");
+    logger_set_level(LOG_LEVEL_INFO);
+
+    size_t len;
+    char *out = capture_end(&cap, &len);
+
+    assert(evaluations == 1);
+    assert(strstr(out, "raft debug 1") != NULL);
+    assert(strstr(out, "nested warn") == NULL);
+    assert(strstr(out, "rafters debug") == NULL);
+    assert(strstr(out, "gossip warn") == NULL);
+    assert(strstr(out, "global debug") == NULL);
+    assert(strstr(out, "after clear") == NULL);
+    assert(strstr(out, "global info while warn") == NULL);
+
+    log_level_t level;
+    assert(logger_parse_level("Warning", &level) == 0 && level == LOG_LEVEL_WARN);
+    assert(logger_parse_level("trace", &level) == -1);
+
+    free(out);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Rate-limited and sampled statements
+// ============================================================================
+
+static size_t count_occurrences(const char *haystack, const char *needle)
+{
+    size_t count = 0;
+    for (const char *p = strstr(haystack, needle); p; p = strstr(p + 1, needle)) {
+        count++;
+    }
+    return count;
+}
+
+static int test_rate_limit_and_sampling()
+{
+    printf("\n=== Test: Rate Limit And Sampling ===\n");
+
+    capture_t cap;
+    capture_begin(&cap);
+
+    // Burst of 5, then 1/s: a tight loop gets the burst and nothing else
+    evaluations = 0;
+    for (int i = 0; i < 1000; i++) {
+        LOG_RATELIMITED(LOG_LEVEL_WARN, 1, 5, "flood %d", count_evaluation());
+    }
+    assert(evaluations == 5);
+
+    // 1000/s refills a token every millisecond; the first message through
+    // after the burst reports what was dropped
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 50; i++) {
+            LOG_RATELIMITED(LOG_LEVEL_WARN, 1000, 10, "refill %d", i);
+        }
+        struct timespec ts = { 0, 20 * 1000000 };
+        nanosleep(&ts, NULL);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        LOG_SAMPLED(LOG_LEVEL_INFO, 10, "sampled %d;", i);
+    }
+
+    // Filtered statements spend no tokens
+    logger_set_level(LOG_LEVEL_ERROR);
+    for (int i = 0; i < 100; i++) {
+        LOG_RATELIMITED(LOG_LEVEL_WARN, 1, 1, "filtered %d", i);
+    }
+    logger_set_level(LOG_LEVEL_INFO);
+
+    size_t len;
+    char *out = capture_end(&cap, &len);
+
+    assert(count_occurrences(out, "flood ") == 5);
+    assert(strstr(out, "flood 5") != NULL);
+    assert(strstr(out, "flood 6") == NULL);
+
+    assert(strstr(out, " similar messages suppressed") != NULL);
+    assert(count_occurrences(out, "refill ") >= 11);
+    assert(count_occurrences(out, "refill ") < 100);
+
+    assert(count_occurrences(out, "sampled ") == 10);
+    assert(strstr(out, "sampled 0;") != NULL);
+    assert(strstr(out, "sampled 90;") != NULL);
+    assert(strstr(out, "sampled 5;") == NULL);
+
+    assert(strstr(out, "filtered") == NULL);
+
+    free(out);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("  Logger Tests\n");
+    printf("========================================\n");
+
+    int failed = 0;
+
+    if (test_synchronous_without_init() != 0) failed++;
+    if (test_many_threads_no_loss() != 0) failed++;
+    if (test_line_format() != 0) failed++;
+    if (test_argument_capture() != 0) failed++;
+    if (test_deferred_matches_text() != 0) failed++;
+    if (test_binary_stream_roundtrip() != 0) failed++;
+    if (test_component_levels() != 0) failed++;
+    if (test_rate_limit_and_sampling() != 0) failed++;
+
+    printf("\n========================================\n");
+    if (failed == 0) {
+        printf("✅ All tests passed!\n");
+    } else {
+        printf("❌ %d test(s) failed\n", failed);
+    }
+    printf("========================================\n");
+
+    return failed > 0 ? 1 : 0;
+}
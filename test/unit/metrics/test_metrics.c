@@ -0,0 +1,493 @@
+// test/unit/metrics/test_metrics.c
+// Tests for the metrics registry, sharded counters/gauges and rendering
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "roole/metrics/metrics.h"
+#include "roole/logger/logger.h"
+
+#define UPDATE_THREADS 32           // More threads than METRICS_SHARDS
+#define UPDATES_PER_THREAD 100000
+
+// ============================================================================
+// TEST: Counters and gauges under concurrent updates
+// ============================================================================
+
+typedef struct {
+    metrics_t *counter;
+    metrics_t *gauge;
+} update_args_t;
+
+static void* update_worker(void *arg)
+{
+    update_args_t *args = arg;
+    for (int i = 0; i < UPDATES_PER_THREAD; i++) {
+        metrics_counter_inc(args->counter);
+        metrics_gauge_inc(args->gauge);
+        if (i % 2 == 0) {
+            metrics_gauge_dec(args->gauge);
+        }
+    }
+    metrics_counter_add(args->counter, 0.5);
+    return NULL;
+}
+
+static int test_concurrent_updates()
+{
+    printf("\n=== Test: Concurrent Updates ===\n");
+
+    metrics_registry_t *reg = metrics_registry_init();
+    assert(reg);
+
+    update_args_t args = {
+        .counter = metrics_get_or_create_counter(reg, "updates_total", "Updates", 0, NULL),
+        .gauge = metrics_get_or_create_gauge(reg, "in_flight", "In flight", 0, NULL),
+    };
+    assert(args.counter && args.gauge);
+
+    pthread_t threads[UPDATE_THREADS];
+    for (int i = 0; i < UPDATE_THREADS; i++) {
+        assert(pthread_create(&threads[i], NULL, update_worker, &args) == 0);
+    }
+    for (int i = 0; i < UPDATE_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    double expected = (double)UPDATE_THREADS * UPDATES_PER_THREAD + UPDATE_THREADS * 0.5;
+    assert(metrics_get_value(args.counter) == expected);
+    assert(metrics_get_value(args.gauge) == (double)UPDATE_THREADS * UPDATES_PER_THREAD / 2);
+
+    // Negative adds are rejected for counters
+    metrics_counter_add(args.counter, -5.0);
+    assert(metrics_get_value(args.counter) == expected);
+
+    // set() overrides everything accumulated so far; later deltas apply on top
+    metrics_gauge_set(args.gauge, 7.0);
+    assert(metrics_get_value(args.gauge) == 7.0);
+    metrics_gauge_dec(args.gauge);
+    assert(metrics_get_value(args.gauge) == 6.0);
+
+    // Same name and labels return the same metric
+    assert(metrics_get_or_create_counter(reg, "updates_total", "Updates", 0, NULL) == args.counter);
+
+    metrics_registry_destroy(reg);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Rendered values
+// ============================================================================
+
+static int test_render_values()
+{
+    printf("\n=== Test: Render Values ===\n");
+
+    metrics_registry_t *reg = metrics_registry_init();
+    assert(reg);
+
+    metric_label_t label = { "node_id", "4" };
+    metrics_t *counter = metrics_get_or_create_counter(reg, "requests_total", "Requests", 1, &label);
+    metrics_t *gauge = metrics_get_or_create_gauge(reg, "members", "Members", 0, NULL);
+    for (int i = 0; i < 42; i++) {
+        metrics_counter_inc(counter);
+    }
+    metrics_gauge_set(gauge, 3.0);
+
+    char *text = metrics_registry_render_prometheus(reg);
+    assert(text);
+    assert(strstr(text, "# TYPE requests_total counter\n") != NULL);
+    assert(strstr(text, "requests_total{node_id=\"4\"} 42\n") != NULL);
+    assert(strstr(text, "members 3\n") != NULL);
+
+    free(text);
+    metrics_registry_destroy(reg);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Histogram bucket layout
+// ============================================================================
+
+static int test_histogram_layout()
+{
+    printf("\n=== Test: Histogram Layout ===\n");
+
+    // Exact for small values; every power of two closes a bucket
+    assert(metrics_histogram_bucket_index(0) == 0);
+    for (uint64_t v = 1; v <= 32; v++) {
+        assert(metrics_histogram_bucket_upper(metrics_histogram_bucket_index(v)) == v);
+    }
+    for (int e = 0; e < HISTOGRAM_MAX_EXPONENT; e++) {
+        uint64_t p = 1ULL << e;
+        assert(metrics_histogram_bucket_upper(metrics_histogram_bucket_index(p)) == p);
+        assert(metrics_histogram_bucket_index(p + 1) == metrics_histogram_bucket_index(p) + 1);
+    }
+
+    // Monotonic, contiguous, relative width <= 1/16
+    for (size_t i = 1; i < HISTOGRAM_BUCKETS; i++) {
+        uint64_t lower = metrics_histogram_bucket_upper(i - 1) + 1;
+        uint64_t upper = metrics_histogram_bucket_upper(i);
+        assert(upper >= lower);
+        assert(metrics_histogram_bucket_index(lower) == i);
+        assert(metrics_histogram_bucket_index(upper) == i);
+        assert(upper < 2 * HISTOGRAM_SUB_BUCKETS ||
+               (upper - lower + 1) * HISTOGRAM_SUB_BUCKETS <= upper);
+    }
+
+    // Out of range values clamp to the last bucket
+    assert(metrics_histogram_bucket_index(UINT64_MAX) == HISTOGRAM_BUCKETS - 1);
+
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Histogram recording, quantiles, merge and export
+// ============================================================================
+
+typedef struct {
+    histogram_metric_t *histogram;
+    uint64_t first;
+} record_args_t;
+
+static void* record_worker(void *arg)
+{
+    record_args_t *args = arg;
+    for (uint64_t v = args->first; v < args->first + 1000; v++) {
+        metrics_histogram_record(args->histogram, v);
+    }
+    return NULL;
+}
+
+static int test_histogram_quantiles()
+{
+    printf("\n=== Test: Histogram Quantiles ===\n");
+
+    metrics_registry_t *reg = metrics_registry_init();
+    assert(reg);
+
+    metric_label_t label = { "node_id", "4" };
+    histogram_metric_t *h = metrics_get_or_create_histogram(
+        reg, "rpc_latency_us", "RPC latency", HISTOGRAM_BUCKETS_LATENCY_US, 1, &label);
+    assert(h);
+
+    // 1..10000 us from 10 threads
+    pthread_t threads[10];
+    record_args_t args[10];
+    for (int i = 0; i < 10; i++) {
+        args[i] = (record_args_t){ h, 1 + (uint64_t)i * 1000 };
+        assert(pthread_create(&threads[i], NULL, record_worker, &args[i]) == 0);
+    }
+    for (int i = 0; i < 10; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    histogram_snapshot_t snap;
+    metrics_histogram_snapshot(h, &snap);
+    assert(snap.count == 10000);
+    assert(snap.sum == 10000ULL * 10001 / 2);
+
+    double p50 = metrics_histogram_quantile(&snap, 0.5);
+    double p99 = metrics_histogram_quantile(&snap, 0.99);
+    double p999 = metrics_histogram_quantile(&snap, 0.999);
+    assert(p50 > 5000 * 0.95 && p50 < 5000 * 1.05);
+    assert(p99 > 9900 * 0.95 && p99 < 9900 * 1.05);
+    assert(p999 > 9990 * 0.95 && p999 < 9990 * 1.05);
+    assert(metrics_histogram_quantile(&snap, 0.0) == 1.0);
+
+    // Merging doubles the counts and leaves quantiles in place
+    histogram_snapshot_t merged = snap;
+    metrics_histogram_snapshot_merge(&merged, &snap);
+    assert(merged.count == 20000);
+    assert(metrics_histogram_quantile(&merged, 0.5) == p50);
+
+    // Negative observations count as zero
+    metrics_histogram_observe(h, -3);
+
+    char *text = metrics_registry_render_prometheus(reg);
+    assert(text);
+    assert(strstr(text, "# TYPE rpc_latency_us histogram\n") != NULL);
+    assert(strstr(text, "rpc_latency_us_bucket{node_id=\"4\",le=\"1\"} 2\n") != NULL);
+    assert(strstr(text, "rpc_latency_us_bucket{node_id=\"4\",le=\"1024\"} 1025\n") != NULL);
+    assert(strstr(text, "rpc_latency_us_bucket{node_id=\"4\",le=\"+Inf\"} 10001\n") != NULL);
+    assert(strstr(text, "rpc_latency_us_count{node_id=\"4\"} 10001\n") != NULL);
+    assert(strstr(text, "rpc_latency_us_quantile{node_id=\"4\",quantile=\"0.99\"}") != NULL);
+
+    free(text);
+    metrics_registry_destroy(reg);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Large output and render cache
+// ============================================================================
+
+static int test_render_large_and_cached()
+{
+    printf("\n=== Test: Render Large And Cached ===\n");
+
+    metrics_registry_t *reg = metrics_registry_init();
+    assert(reg);
+
+    // Well past the old 64 KB limit
+    char value[MAX_LABEL_VALUE_LEN];
+    metrics_t *first = NULL;
+    for (int i = 0; i < 256; i++) {
+        snprintf(value, sizeof(value), "peer-%03d-%0100d", i, 0);
+        metric_label_t label;
+        snprintf(label.name, sizeof(label.name), "peer");
+        snprintf(label.value, sizeof(label.value), "%s", value);
+        metrics_t *counter = metrics_get_or_create_counter(reg, "peer_messages_total",
+                                                           "Messages per peer", 1, &label);
+        metrics_counter_inc(counter);
+        if (!first) first = counter;
+        if (i < 64) {
+            metrics_histogram_record(metrics_get_or_create_histogram(
+                reg, "peer_rtt_us", "RTT per peer", HISTOGRAM_BUCKETS_LATENCY_US, 1, &label), 100);
+        }
+    }
+
+    metrics_text_t *text = metrics_registry_render(reg);
+    assert(text);
+    assert(metrics_text_length(text) > 256 * 1024);
+
+    // Chunks concatenate to the flat rendering
+    char *flat = metrics_registry_render_prometheus(reg);
+    assert(flat && strlen(flat) == metrics_text_length(text));
+    size_t offset = 0, len, chunks = 0;
+    const void *cursor = NULL;
+    const char *chunk;
+    while ((chunk = metrics_text_next_chunk(text, &cursor, &len)) != NULL) {
+        assert(memcmp(flat + offset, chunk, len) == 0);
+        offset += len;
+        chunks++;
+    }
+    assert(offset == metrics_text_length(text) && chunks > 1);
+    assert(strstr(flat, "peer_messages_total{peer=\"peer-255-") != NULL);
+    assert(strstr(flat, "peer_rtt_us_count{peer=\"peer-063-") != NULL);
+    free(flat);
+
+    // Within the TTL scrapes share one render, even after updates
+    metrics_counter_inc(first);
+    metrics_text_t *again = metrics_registry_render(reg);
+    assert(again == text);
+    metrics_text_release(again);
+    metrics_text_release(text);
+
+    metrics_registry_destroy(reg);
+
+    // With caching off every render sees current values; labels are escaped
+    reg = metrics_registry_init();
+    metrics_registry_set_cache_ttl(reg, 0);
+    metric_label_t quoted = { "path", "a\"b\\c" };
+    metrics_t *counter = metrics_get_or_create_counter(reg, "quoted_total", "Quoted", 1, &quoted);
+    flat = metrics_registry_render_prometheus(reg);
+    assert(strstr(flat, "quoted_total{path=\"a\\\"b\\\\c\"} 0\n") != NULL);
+    free(flat);
+    metrics_counter_inc(counter);
+    flat = metrics_registry_render_prometheus(reg);
+    assert(strstr(flat, "} 1\n") != NULL);
+    free(flat);
+
+    metrics_registry_destroy(reg);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Families, vectors and unbounded series
+// ============================================================================
+
+#define VEC_SERIES 5000
+#define VEC_THREADS 8
+
+static metrics_vec_t *g_vec;
+
+static void* vec_worker(void *arg)
+{
+    (void)arg;
+    char value[32];
+    const char *values[2] = { value, "get" };
+    for (int i = 0; i < VEC_SERIES; i++) {
+        snprintf(value, sizeof(value), "peer-%d", i);
+        metrics_counter_inc(metrics_vec_with(g_vec, values));
+    }
+    return NULL;
+}
+
+static size_t count_occurrences(const char *haystack, const char *needle)
+{
+    size_t n = 0;
+    for (const char *p = strstr(haystack, needle); p; p = strstr(p + 1, needle)) {
+        n++;
+    }
+    return n;
+}
+
+static int test_families_and_vectors()
+{
+    printf("\n=== Test: Families And Vectors ===\n");
+
+    metrics_registry_t *reg = metrics_registry_init();
+    assert(reg);
+    metrics_registry_set_cache_ttl(reg, 0);
+
+    const char *names[2] = { "peer", "func" };
+    g_vec = metrics_counter_vec(reg, "peer_calls_total", "Calls per peer", 2, names);
+    assert(g_vec);
+    assert(metrics_counter_vec(reg, "peer_calls_total", "Calls per peer", 2, names) == g_vec);
+
+    // Threads race to create the same series; each must exist exactly once
+    pthread_t threads[VEC_THREADS];
+    for (int i = 0; i < VEC_THREADS; i++) {
+        assert(pthread_create(&threads[i], NULL, vec_worker, NULL) == 0);
+    }
+    for (int i = 0; i < VEC_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    const char *values[2] = { "peer-4321", "get" };
+    metrics_t *series = metrics_vec_with(g_vec, values);
+    assert(series && metrics_get_value(series) == VEC_THREADS);
+
+    // Same series through the name/label API
+    metric_label_t labels[2] = { { "peer", "peer-4321" }, { "func", "get" } };
+    assert(metrics_get_or_create_counter(reg, "peer_calls_total", "Calls per peer",
+                                         2, labels) == series);
+
+    // Histogram vector: quantiles follow all series as one family
+    const char *rtt_names[1] = { "peer" };
+    metrics_vec_t *rtt = metrics_histogram_vec(reg, "peer_rtt_us", "RTT per peer",
+                                               HISTOGRAM_BUCKETS_LATENCY_US, 1, rtt_names);
+    const char *a[1] = { "a" }, *b[1] = { "b" };
+    metrics_histogram_record(metrics_vec_histogram_with(rtt, a), 100);
+    metrics_histogram_record(metrics_vec_histogram_with(rtt, b), 200);
+
+    // Mismatched type or label names are refused
+    assert(metrics_get_or_create_gauge(reg, "peer_calls_total", "Calls", 0, NULL) == NULL);
+    assert(metrics_gauge_vec(reg, "peer_calls_total", "Calls", 2, names) == NULL);
+    assert(metrics_counter_vec(reg, "peer_calls_total", "Calls", 1, names) == NULL);
+    assert(metrics_vec_histogram_with(g_vec, values) == NULL);
+    assert(metrics_vec_with(rtt, a) == NULL);
+
+    char *flat = metrics_registry_render_prometheus(reg);
+    assert(flat);
+    assert(count_occurrences(flat, "# TYPE peer_calls_total counter\n") == 1);
+    assert(count_occurrences(flat, "peer_calls_total{") == VEC_SERIES);
+    assert(strstr(flat, "peer_calls_total{peer=\"peer-4999\",func=\"get\"} 8\n") != NULL);
+    assert(count_occurrences(flat, "# TYPE peer_rtt_us histogram\n") == 1);
+    assert(count_occurrences(flat, "# TYPE peer_rtt_us_quantile gauge\n") == 1);
+    const char *quantile = strstr(flat, "# TYPE peer_rtt_us_quantile gauge\n");
+    assert(strstr(quantile, "peer_rtt_us_quantile{peer=\"a\",quantile=\"0.5\"}") != NULL);
+    assert(strstr(quantile, "peer_rtt_us_quantile{peer=\"b\",quantile=\"0.5\"}") != NULL);
+    assert(strstr(quantile, "peer_rtt_us_count") == NULL);
+    free(flat);
+
+    metrics_registry_destroy(reg);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Collectors
+// ============================================================================
+
+typedef struct {
+    uint64_t requests;      // Stands in for a subsystem's own stats struct
+    int runs;
+} fake_subsystem_t;
+
+static void fake_collector(metrics_registry_t *reg, void *ctx)
+{
+    fake_subsystem_t *sub = ctx;
+    sub->runs++;
+    metrics_counter_set(metrics_get_or_create_counter(reg, "fake_requests_total",
+                                                      "Requests", 0, NULL),
+                        (double)sub->requests);
+}
+
+static int test_collectors()
+{
+    printf("\n=== Test: Collectors ===\n");
+
+    metrics_registry_t *reg = metrics_registry_init();
+    assert(reg);
+
+    fake_subsystem_t sub = { .requests = 41, .runs = 0 };
+    assert(metrics_registry_add_collector(reg, fake_collector, &sub) == 0);
+
+    // Values are pulled at scrape time; cached renders skip the collector
+    char *flat = metrics_registry_render_prometheus(reg);
+    assert(flat && strstr(flat, "fake_requests_total 41\n") != NULL);
+    free(flat);
+    sub.requests = 42;
+    flat = metrics_registry_render_prometheus(reg);
+    assert(flat && strstr(flat, "fake_requests_total 41\n") != NULL);
+    free(flat);
+    assert(sub.runs == 1);
+
+    metrics_registry_set_cache_ttl(reg, 0);
+    flat = metrics_registry_render_prometheus(reg);
+    assert(flat && strstr(flat, "fake_requests_total 42\n") != NULL);
+    free(flat);
+    assert(sub.runs == 2);
+
+    // Removed collectors no longer run; the last value stays exported
+    metrics_registry_remove_collector(reg, fake_collector, &sub);
+    sub.requests = 50;
+    flat = metrics_registry_render_prometheus(reg);
+    assert(flat && strstr(flat, "fake_requests_total 42\n") != NULL);
+    free(flat);
+    assert(sub.runs == 2);
+
+    for (int i = 0; i < METRICS_MAX_COLLECTORS; i++) {
+        assert(metrics_registry_add_collector(reg, fake_collector, &sub) == 0);
+    }
+    assert(metrics_registry_add_collector(reg, fake_collector, &sub) != 0);
+
+    metrics_registry_destroy(reg);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("  Metrics Tests\n");
+    printf("========================================\n");
+
+    logger_set_level(LOG_LEVEL_WARN);
+
+    int failed = 0;
+
+    if (test_concurrent_updates() != 0) failed++;
+    if (test_render_values() != 0) failed++;
+    if (test_histogram_layout() != 0) failed++;
+    if (test_histogram_quantiles() != 0) failed++;
+    if (test_render_large_and_cached() != 0) failed++;
+    if (test_families_and_vectors() != 0) failed++;
+    if (test_collectors() != 0) failed++;
+
+    printf("\n========================================\n");
+    if (failed == 0) {
+        printf("✅ All tests passed!\n");
+    } else {
+        printf("❌ %d test(s) failed\n", failed);
+    }
+    printf("========================================\n");
+
+    return failed > 0 ? 1 : 0;
+}
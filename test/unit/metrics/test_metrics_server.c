@@ -0,0 +1,409 @@
+// test/unit/metrics/test_metrics_server.c
+// Tests for the metrics HTTP server: keep-alive, pipelining, gzip,
+// debug endpoints and concurrent scrapes
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "roole/metrics/metrics.h"
+#include "roole/metrics/metrics_server.h"
+#include "roole/logger/logger.h"
+
+#ifdef ROOLE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#define SCRAPE_THREADS 8
+#define SCRAPES_PER_THREAD 50
+
+static uint16_t g_port;
+
+// ============================================================================
+// CLIENT HELPERS
+// ============================================================================
+
+typedef struct {
+    int fd;
+    char buf[1 << 20];
+    size_t len;
+} client_t;
+
+typedef struct {
+    int status;
+    char head[1024];
+    char *body;
+    size_t body_len;
+} response_t;
+
+static client_t* client_connect(void)
+{
+    client_t *c = calloc(1, sizeof(client_t));
+    assert(c);
+    c->fd = socket(AF_INET, SOCK_STREAM, 0);
+    assert(c->fd >= 0);
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(g_port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    assert(connect(c->fd, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    return c;
+}
+
+static void client_close(client_t *c)
+{
+    close(c->fd);
+    free(c);
+}
+
+static void client_send(client_t *c, const char *request)
+{
+    size_t len = strlen(request);
+    assert(send(c->fd, request, len, 0) == (ssize_t)len);
+}
+
+// Read one response; returns 0 on success, -1 if the server closed first
+static int client_read(client_t *c, response_t *resp)
+{
+    memset(resp, 0, sizeof(*resp));
+    char *end;
+    for (;;) {
+        c->buf[c->len] = '\0';
+        end = strstr(c->buf, "\r\n\r\n");
+        if (end) break;
+        ssize_t n = recv(c->fd, c->buf + c->len, sizeof(c->buf) - 1 - c->len, 0);
+        if (n <= 0) return -1;
+        c->len += (size_t)n;
+    }
+
+    size_t head_len = (size_t)(end - c->buf) + 4;
+    assert(head_len < sizeof(resp->head));
+    memcpy(resp->head, c->buf, head_len);
+    resp->status = atoi(c->buf + 9);
+
+    const char *cl = strstr(resp->head, "Content-Length:");
+    assert(cl);
+    resp->body_len = strtoul(cl + 15, NULL, 10);
+
+    while (c->len < head_len + resp->body_len) {
+        ssize_t n = recv(c->fd, c->buf + c->len, sizeof(c->buf) - 1 - c->len, 0);
+        if (n <= 0) return -1;
+        c->len += (size_t)n;
+    }
+
+    resp->body = malloc(resp->body_len + 1);
+    memcpy(resp->body, c->buf + head_len, resp->body_len);
+    resp->body[resp->body_len] = '\0';
+
+    // Keep whatever belongs to the next (pipelined) response
+    size_t used = head_len + resp->body_len;
+    memmove(c->buf, c->buf + used, c->len - used);
+    c->len -= used;
+    return 0;
+}
+
+static void response_free(response_t *resp)
+{
+    free(resp->body);
+    resp->body = NULL;
+}
+
+static const char *GET_METRICS = "GET /metrics HTTP/1.1\r\nHost: test\r\n\r\n";
+
+// ============================================================================
+// TEST: Keep-alive and pipelining
+// ============================================================================
+
+static int test_keep_alive(void)
+{
+    printf("\n=== Test: Keep-Alive And Pipelining ===\n");
+
+    client_t *c = client_connect();
+    response_t resp;
+
+    // Two requests in one write, answered in order on the same connection
+    char pipelined[256];
+    snprintf(pipelined, sizeof(pipelined), "%sGET /nope HTTP/1.1\r\n\r\n", GET_METRICS);
+    client_send(c, pipelined);
+
+    assert(client_read(c, &resp) == 0);
+    assert(resp.status == 200);
+    assert(strstr(resp.head, "Connection: keep-alive"));
+    assert(strstr(resp.body, "requests_total"));
+    response_free(&resp);
+
+    assert(client_read(c, &resp) == 0);
+    assert(resp.status == 404);
+    response_free(&resp);
+
+    // Connection: close is honoured
+    client_send(c, "GET /metrics HTTP/1.1\r\nConnection: close\r\n\r\n");
+    assert(client_read(c, &resp) == 0);
+    assert(resp.status == 200 && strstr(resp.head, "Connection: close"));
+    response_free(&resp);
+    char byte;
+    assert(recv(c->fd, &byte, 1, 0) == 0);
+    client_close(c);
+
+    // HTTP/1.0 closes unless asked otherwise
+    c = client_connect();
+    client_send(c, "GET / HTTP/1.0\r\n\r\n");
+    assert(client_read(c, &resp) == 0);
+    assert(resp.status == 200 && strstr(resp.body, "/debug/test"));
+    response_free(&resp);
+    assert(recv(c->fd, &byte, 1, 0) == 0);
+    client_close(c);
+
+    // Garbage gets a 400 and the connection is closed
+    c = client_connect();
+    client_send(c, "NONSENSE\r\n\r\n");
+    assert(client_read(c, &resp) == 0);
+    assert(resp.status == 400);
+    response_free(&resp);
+    client_close(c);
+
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: gzip
+// ============================================================================
+
+static int test_gzip(void)
+{
+    printf("\n=== Test: Gzip ===\n");
+
+    client_t *c = client_connect();
+    response_t plain, packed;
+
+    client_send(c, GET_METRICS);
+    assert(client_read(c, &plain) == 0);
+    assert(!strstr(plain.head, "Content-Encoding"));
+
+    client_send(c, "GET /metrics HTTP/1.1\r\nAccept-Encoding: deflate, gzip;q=0\r\n\r\n");
+    assert(client_read(c, &packed) == 0);
+    assert(!strstr(packed.head, "Content-Encoding"));
+    response_free(&packed);
+
+    client_send(c, "GET /metrics HTTP/1.1\r\nAccept-Encoding: gzip, deflate\r\n\r\n");
+    assert(client_read(c, &packed) == 0);
+    assert(packed.status == 200);
+
+#ifdef ROOLE_HAVE_ZLIB
+    assert(strstr(packed.head, "Content-Encoding: gzip"));
+    assert(packed.body_len < plain.body_len);
+
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    assert(inflateInit2(&zs, 15 + 16) == Z_OK);
+    char *out = malloc(plain.body_len + 1);
+    zs.next_in = (Bytef*)packed.body;
+    zs.avail_in = (uInt)packed.body_len;
+    zs.next_out = (Bytef*)out;
+    zs.avail_out = (uInt)plain.body_len + 1;
+    assert(inflate(&zs, Z_FINISH) == Z_STREAM_END);
+    assert(zs.total_out == plain.body_len);
+    assert(memcmp(out, plain.body, plain.body_len) == 0);
+    inflateEnd(&zs);
+    free(out);
+#else
+    assert(!strstr(packed.head, "Content-Encoding"));
+#endif
+
+    response_free(&packed);
+    response_free(&plain);
+    client_close(c);
+
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Debug endpoints
+// ============================================================================
+
+// Larger than the server's first buffer, so it has to retry
+static int debug_handler(void *ctx, char *buf, size_t cap)
+{
+    int used = snprintf(buf, cap, "{\"name\":\"%s\",\"items\":[", (const char*)ctx);
+    for (int i = 0; i < 2000; i++) {
+        used += snprintf(buf + ((size_t)used < cap ? (size_t)used : cap),
+                         (size_t)used < cap ? cap - (size_t)used : 0,
+                         "%s%d", i > 0 ? "," : "", i);
+    }
+    used += snprintf(buf + ((size_t)used < cap ? (size_t)used : cap),
+                     (size_t)used < cap ? cap - (size_t)used : 0, "]}");
+    return used;
+}
+
+static int test_debug_endpoint(metrics_server_t *server)
+{
+    printf("\n=== Test: Debug Endpoint ===\n");
+
+    assert(metrics_server_add_endpoint(server, "/debug/test", debug_handler, "x") != 0);
+    assert(metrics_server_add_endpoint(server, "no-slash", debug_handler, NULL) != 0);
+
+    client_t *c = client_connect();
+    response_t resp;
+    client_send(c, "GET /debug/test HTTP/1.1\r\n\r\n");
+    assert(client_read(c, &resp) == 0);
+    assert(resp.status == 200);
+    assert(strstr(resp.head, "Content-Type: application/json"));
+    assert(resp.body_len > 4096);
+    assert(strncmp(resp.body, "{\"name\":\"test\",\"items\":[0,1,2", 29) == 0);
+    assert(strcmp(resp.body + resp.body_len - 7, ",1999]}") == 0);
+    response_free(&resp);
+    client_close(c);
+
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Log level changes are refused unless enabled
+// ============================================================================
+
+static int test_loglevel_control(metrics_server_t *server)
+{
+    printf("\n=== Test: Log Level Control ===\n");
+
+    client_t *c = client_connect();
+    response_t resp;
+
+    client_send(c, "GET /loglevel HTTP/1.1\r\n\r\n");
+    assert(client_read(c, &resp) == 0);
+    assert(resp.status == 200 && strstr(resp.body, "global=WARN"));
+    response_free(&resp);
+
+    // Off by default
+    client_send(c, "PUT /loglevel?level=error HTTP/1.1\r\n\r\n");
+    assert(client_read(c, &resp) == 0);
+    assert(resp.status == 403);
+    response_free(&resp);
+    client_send(c, "DELETE /loglevel?component=raft HTTP/1.1\r\n\r\n");
+    assert(client_read(c, &resp) == 0);
+    assert(resp.status == 403);
+    response_free(&resp);
+    assert(logger_get_level() == LOG_LEVEL_WARN);
+
+    metrics_server_set_log_control(server, 1);
+    client_send(c, "PUT /loglevel?level=error HTTP/1.1\r\n\r\n");
+    assert(client_read(c, &resp) == 0);
+    assert(resp.status == 200 && strstr(resp.body, "global=ERROR"));
+    response_free(&resp);
+    assert(logger_get_level() == LOG_LEVEL_ERROR);
+
+    metrics_server_set_log_control(server, 0);
+    logger_set_level(LOG_LEVEL_WARN);
+    client_close(c);
+
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Concurrent scrapes
+// ============================================================================
+
+static void* scrape_worker(void *arg)
+{
+    (void)arg;
+    client_t *c = client_connect();
+    for (int i = 0; i < SCRAPES_PER_THREAD; i++) {
+        response_t resp;
+        client_send(c, i % 2 ? GET_METRICS
+                             : "GET /metrics HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n");
+        assert(client_read(c, &resp) == 0);
+        assert(resp.status == 200 && resp.body_len > 0);
+        response_free(&resp);
+    }
+    client_close(c);
+    return NULL;
+}
+
+static int test_concurrent_scrapes(metrics_registry_t *reg)
+{
+    printf("\n=== Test: Concurrent Scrapes ===\n");
+
+    // Renders change under the scrapers; every response must stay whole
+    metrics_registry_set_cache_ttl(reg, 0);
+
+    pthread_t threads[SCRAPE_THREADS];
+    for (int i = 0; i < SCRAPE_THREADS; i++) {
+        assert(pthread_create(&threads[i], NULL, scrape_worker, NULL) == 0);
+    }
+    for (int i = 0; i < SCRAPE_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("  Metrics Server Tests\n");
+    printf("========================================\n");
+
+    logger_set_level(LOG_LEVEL_WARN);
+
+    metrics_registry_t *reg = metrics_registry_init();
+    assert(reg);
+
+    // Enough series for a multi-chunk render
+    const char *names[1] = { "peer" };
+    metrics_vec_t *vec = metrics_counter_vec(reg, "requests_total", "Requests", 1, names);
+    for (int i = 0; i < 2000; i++) {
+        char value[32];
+        snprintf(value, sizeof(value), "peer-%d", i);
+        const char *values[1] = { value };
+        metrics_counter_add(metrics_vec_with(vec, values), i);
+    }
+
+    metrics_server_t *server = NULL;
+    for (int attempt = 0; attempt < 20 && !server; attempt++) {
+        g_port = (uint16_t)(20000 + (getpid() * 7 + attempt * 131) % 20000);
+        server = metrics_server_start(reg, "127.0.0.1", g_port);
+    }
+    assert(server);
+
+    // A taken port fails at start, not later on the server thread
+    assert(metrics_server_start(reg, "127.0.0.1", g_port) == NULL);
+    assert(metrics_server_add_endpoint(server, "/debug/test", debug_handler, "test") == 0);
+
+    int failed = 0;
+
+    if (test_keep_alive() != 0) failed++;
+    if (test_gzip() != 0) failed++;
+    if (test_debug_endpoint(server) != 0) failed++;
+    if (test_loglevel_control(server) != 0) failed++;
+    if (test_concurrent_scrapes(reg) != 0) failed++;
+
+    metrics_server_shutdown(server);
+    metrics_registry_destroy(reg);
+
+    printf("\n========================================\n");
+    if (failed == 0) {
+        printf("✅ All tests passed!\n");
+    } else {
+        printf("❌ %d test(s) failed\n", failed);
+    }
+    printf("========================================\n");
+
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,333 @@
+// test/unit/node/test_peer_pool.c
+// Unit tests for peer_pool selectors (P2C, round-robin, hash ring, dispatchable snapshot)
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include "roole/node/peer_pool.h"
+
+static void add_peers(peer_pool_t *pool, node_id_t first, node_id_t last)
+{
+    for (node_id_t id = first; id <= last; id++) {
+        assert(peer_pool_add(pool, id, "127.0.0.1", 8000 + id, 9000 + id) == RESULT_OK);
+    }
+}
+
+// ============================================================================
+// TEST: Snapshot only holds ALIVE peers that can execute
+// ============================================================================
+
+static int test_snapshot_dispatchable()
+{
+    printf("\n=== Test: Snapshot - Dispatchable Peers Only ===\n");
+
+    peer_pool_t pool;
+    assert(peer_pool_init(&pool, 16) == RESULT_OK);
+
+    peer_pool_snapshot_t *empty = peer_pool_snapshot_acquire(&pool);
+    assert(empty != NULL);
+    assert(empty->count == 0);
+
+    add_peers(&pool, 1, 4);
+    peer_pool_update_status(&pool, 2, NODE_STATUS_SUSPECT);
+
+    node_capabilities_t router_only = { .has_ingress = 0, .can_execute = 0, .can_route = 1 };
+    peer_pool_update_capabilities(&pool, 3, &router_only);
+
+    peer_pool_snapshot_t *snap = peer_pool_snapshot_acquire(&pool);
+    assert(snap->count == 2);
+    assert(snap->version > empty->version);
+    assert(snap->peers[0].node_id == 1);
+    assert(snap->peers[1].node_id == 4);
+
+    // Load and RTT updates show through held snapshots without republishing
+    peer_pool_update_load(&pool, 4, 7, 0.5f);
+    peer_pool_update_latency(&pool, 4, 1500);
+    peer_pool_snapshot_t *same = peer_pool_snapshot_acquire(&pool);
+    assert(same->version == snap->version);
+    peer_pool_snapshot_release(same);
+    assert(snap->peers[1].stats->active_executions == 7);
+    assert(snap->peers[1].stats->rtt_us == 1500);
+
+    // Held snapshots keep their membership, and removed peers' stats
+    peer_pool_remove(&pool, 1);
+    assert(snap->count == 2);
+    assert(snap->peers[0].stats->active_executions == 0);
+    assert(empty->count == 0);
+
+    peer_pool_snapshot_release(empty);
+    peer_pool_snapshot_release(snap);
+
+    snap = peer_pool_snapshot_acquire(&pool);
+    assert(snap->count == 1);
+    assert(snap->peers[0].node_id == 4);
+    peer_pool_snapshot_release(snap);
+
+    peer_pool_destroy(&pool);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: P2C never picks the most loaded of two, and spreads load
+// ============================================================================
+
+static int test_p2c_prefers_less_loaded()
+{
+    printf("\n=== Test: P2C - Prefers Less Loaded Peer ===\n");
+
+    peer_pool_t pool;
+    assert(peer_pool_init(&pool, 16) == RESULT_OK);
+
+    assert(peer_pool_select_p2c(&pool) == 0);
+
+    add_peers(&pool, 1, 1);
+    assert(peer_pool_select_p2c(&pool) == 1);
+
+    // Two peers: P2C always compares both
+    add_peers(&pool, 2, 2);
+    peer_pool_update_load(&pool, 1, 50, 0.9f);
+    peer_pool_update_load(&pool, 2, 1, 0.1f);
+    for (int i = 0; i < 100; i++) {
+        assert(peer_pool_select_p2c(&pool) == 2);
+    }
+
+    // Eight peers, one hot: P2C never pairs a peer with itself, so the hot
+    // peer always loses its comparison
+    add_peers(&pool, 3, 8);
+    for (node_id_t id = 2; id <= 8; id++) {
+        peer_pool_update_load(&pool, id, id, 0.0f);
+    }
+    peer_pool_update_load(&pool, 1, 1000, 1.0f);
+
+    int hits[9] = {0};
+    for (int i = 0; i < 8000; i++) {
+        node_id_t id = peer_pool_select_p2c(&pool);
+        assert(id >= 1 && id <= 8);
+        hits[id]++;
+    }
+    printf("P2C distribution:");
+    for (int id = 1; id <= 8; id++) printf(" %d=%d", id, hits[id]);
+    printf("\n");
+
+    assert(hits[1] == 0);
+    assert(hits[2] > hits[8]);  // Lighter peers win more often
+
+    peer_pool_destroy(&pool);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Round-robin is per pool and skips non-dispatchable peers
+// ============================================================================
+
+static int test_round_robin_per_pool()
+{
+    printf("\n=== Test: Round-Robin - Per-Pool Cursor ===\n");
+
+    peer_pool_t a, b;
+    assert(peer_pool_init(&a, 8) == RESULT_OK);
+    assert(peer_pool_init(&b, 8) == RESULT_OK);
+
+    add_peers(&a, 1, 3);
+    add_peers(&b, 10, 11);
+    peer_pool_update_status(&a, 2, NODE_STATUS_DEAD);
+
+    // Interleaving pools does not disturb each other's sequence
+    assert(peer_pool_select_round_robin(&a) == 1);
+    assert(peer_pool_select_round_robin(&b) == 10);
+    assert(peer_pool_select_round_robin(&a) == 3);
+    assert(peer_pool_select_round_robin(&b) == 11);
+    assert(peer_pool_select_round_robin(&a) == 1);
+
+    peer_pool_destroy(&a);
+    peer_pool_destroy(&b);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Hash ring only moves keys owned by the changed peer
+// ============================================================================
+
+#define RING_KEYS 20000
+
+static void map_keys(peer_pool_t *pool, node_id_t *owners)
+{
+    char key[32];
+    for (int k = 0; k < RING_KEYS; k++) {
+        int len = snprintf(key, sizeof(key), "flow-%d", k);
+        owners[k] = peer_pool_select_by_key(pool, key, (size_t)len);
+    }
+}
+
+static int test_select_by_key_minimal_movement()
+{
+    printf("\n=== Test: Hash Ring - Minimal Reshuffling ===\n");
+
+    peer_pool_t pool;
+    assert(peer_pool_init(&pool, 32) == RESULT_OK);
+    assert(peer_pool_select_by_key(&pool, "k", 1) == 0);
+
+    add_peers(&pool, 1, 10);
+
+    static node_id_t before[RING_KEYS], after[RING_KEYS];
+    map_keys(&pool, before);
+
+    // Stable for identical membership; load updates leave the ring alone
+    uint64_t ring_version = pool.ring.version;
+    peer_pool_update_load(&pool, 3, 40, 0.7f);
+    assert(pool.ring.version == ring_version);
+    map_keys(&pool, after);
+    assert(memcmp(before, after, sizeof(before)) == 0);
+
+    int per_peer[11] = {0};
+    for (int k = 0; k < RING_KEYS; k++) {
+        assert(before[k] >= 1 && before[k] <= 10);
+        per_peer[before[k]]++;
+    }
+    for (int id = 1; id <= 10; id++) {
+        // 64 vnodes keep each share within a loose band around 10%
+        assert(per_peer[id] > RING_KEYS / 20 && per_peer[id] < RING_KEYS / 5);
+    }
+
+    // Join: keys only move to the new peer, about 1/11 of them
+    add_peers(&pool, 11, 11);
+    map_keys(&pool, after);
+    int moved = 0;
+    for (int k = 0; k < RING_KEYS; k++) {
+        if (after[k] != before[k]) {
+            assert(after[k] == 11);
+            moved++;
+        }
+    }
+    printf("Join moved %d/%d keys\n", moved, RING_KEYS);
+    assert(moved > RING_KEYS / 22 && moved < RING_KEYS / 5);
+
+    // Failure: only the failed peer's keys move, to surviving peers
+    memcpy(before, after, sizeof(before));
+    peer_pool_update_status(&pool, 4, NODE_STATUS_SUSPECT);
+    map_keys(&pool, after);
+    for (int k = 0; k < RING_KEYS; k++) {
+        if (before[k] == 4) {
+            assert(after[k] != 4 && after[k] != 0);
+        } else {
+            assert(after[k] == before[k]);
+        }
+    }
+
+    // Recovery restores the original placement exactly
+    peer_pool_update_status(&pool, 4, NODE_STATUS_ALIVE);
+    map_keys(&pool, after);
+    assert(memcmp(before, after, sizeof(before)) == 0);
+
+    peer_pool_destroy(&pool);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Concurrent dispatchers while membership changes
+// ============================================================================
+
+#define DISPATCH_THREADS 4
+
+typedef struct {
+    peer_pool_t *pool;
+    int stop;
+    int errors;
+    uint64_t selections;
+} dispatch_ctx_t;
+
+static void* dispatch_thread(void *arg)
+{
+    dispatch_ctx_t *ctx = (dispatch_ctx_t*)arg;
+    uint64_t local = 0;
+
+    while (!__atomic_load_n(&ctx->stop, __ATOMIC_RELAXED)) {
+        node_id_t id = peer_pool_select_p2c(ctx->pool);
+        // Peers 1..4 are never removed; 5..32 churn
+        if (id == 0 || id > 32) {
+            __atomic_add_fetch(&ctx->errors, 1, __ATOMIC_RELAXED);
+        }
+        peer_pool_select_round_robin(ctx->pool);
+        id = peer_pool_select_by_key(ctx->pool, &local, sizeof(local));
+        if (id == 0 || id > 32) {
+            __atomic_add_fetch(&ctx->errors, 1, __ATOMIC_RELAXED);
+        }
+        local++;
+    }
+
+    __atomic_add_fetch(&ctx->selections, local, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+static int test_concurrent_dispatch()
+{
+    printf("\n=== Test: Concurrent Dispatch During Churn ===\n");
+
+    peer_pool_t pool;
+    assert(peer_pool_init(&pool, 64) == RESULT_OK);
+    add_peers(&pool, 1, 4);
+
+    dispatch_ctx_t ctx = { .pool = &pool, .stop = 0, .errors = 0, .selections = 0 };
+    pthread_t threads[DISPATCH_THREADS];
+    for (int i = 0; i < DISPATCH_THREADS; i++) {
+        pthread_create(&threads[i], NULL, dispatch_thread, &ctx);
+    }
+
+    for (int round = 0; round < 2000; round++) {
+        node_id_t id = (node_id_t)(5 + round % 28);
+        peer_pool_add(&pool, id, "127.0.0.1", 8000, 9000);
+        peer_pool_update_load(&pool, id, (uint32_t)round % 7, 0.1f);
+        if (round % 2 == 0) {
+            peer_pool_remove(&pool, id);
+        }
+    }
+
+    __atomic_store_n(&ctx.stop, 1, __ATOMIC_RELAXED);
+    for (int i = 0; i < DISPATCH_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    printf("Selections: %lu, errors: %d\n", ctx.selections, ctx.errors);
+    assert(ctx.errors == 0);
+
+    peer_pool_destroy(&pool);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST RUNNER
+// ============================================================================
+
+int main(void)
+{
+    printf("===========================================\n");
+    printf("  Peer Pool Unit Tests\n");
+    printf("===========================================\n");
+
+    int failed = 0;
+
+    if (test_snapshot_dispatchable() != 0) failed++;
+    if (test_p2c_prefers_less_loaded() != 0) failed++;
+    if (test_round_robin_per_pool() != 0) failed++;
+    if (test_select_by_key_minimal_movement() != 0) failed++;
+    if (test_concurrent_dispatch() != 0) failed++;
+
+    printf("\n===========================================\n");
+    printf("  Summary\n");
+    printf("===========================================\n");
+    if (failed == 0) {
+        printf("✅ All peer pool tests passed!\n");
+        return 0;
+    }
+    printf("❌ %d test(s) failed\n", failed);
+    return 1;
+}
@@ -0,0 +1,266 @@
+// test/unit/node/test_raft_peer_sync.c
+// Unit tests for raft_peer_sync (debounce, reconcile diff, backlog overflow)
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "roole/node/raft_peer_sync.h"
+
+#define TEST_DEBOUNCE_MS 100
+#define WAIT_TIMEOUT_MS  5000
+
+// ============================================================================
+// MOCK RAFT (records peer changes instead of opening connections)
+// ============================================================================
+
+static struct {
+    pthread_mutex_t lock;
+    int added[UINT16_MAX + 1];
+    int removed[UINT16_MAX + 1];
+    int adds_total;
+    int removes_total;
+} g_raft = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+static char g_raft_handle;          // Opaque; only its address is used
+
+int raft_add_peer(raft_state_t *state, node_id_t peer_id,
+                  const char *peer_ip, uint16_t peer_port)
+{
+    (void)state;
+    (void)peer_ip;
+    (void)peer_port;
+    pthread_mutex_lock(&g_raft.lock);
+    g_raft.added[peer_id]++;
+    g_raft.adds_total++;
+    pthread_mutex_unlock(&g_raft.lock);
+    return 0;
+}
+
+int raft_remove_peer(raft_state_t *state, node_id_t peer_id)
+{
+    (void)state;
+    pthread_mutex_lock(&g_raft.lock);
+    g_raft.removed[peer_id]++;
+    g_raft.removes_total++;
+    pthread_mutex_unlock(&g_raft.lock);
+    return 0;
+}
+
+static void reset_raft(void)
+{
+    pthread_mutex_lock(&g_raft.lock);
+    memset(g_raft.added, 0, sizeof(g_raft.added));
+    memset(g_raft.removed, 0, sizeof(g_raft.removed));
+    g_raft.adds_total = 0;
+    g_raft.removes_total = 0;
+    pthread_mutex_unlock(&g_raft.lock);
+}
+
+static int raft_count(const int *counter)
+{
+    pthread_mutex_lock(&g_raft.lock);
+    int value = *counter;
+    pthread_mutex_unlock(&g_raft.lock);
+    return value;
+}
+
+// Poll until Raft has seen the expected totals; 0 on success, -1 on timeout
+static int wait_for_totals(int adds, int removes)
+{
+    for (int waited_ms = 0; waited_ms < WAIT_TIMEOUT_MS; waited_ms += 5) {
+        if (raft_count(&g_raft.adds_total) >= adds &&
+            raft_count(&g_raft.removes_total) >= removes) {
+            return 0;
+        }
+        usleep(5000);
+    }
+    return -1;
+}
+
+static void add_member(cluster_view_t *view, node_id_t id, node_status_t status)
+{
+    cluster_member_t member = {
+        .node_id = id,
+        .node_type = NODE_TYPE_WORKER,
+        .status = status,
+        .gossip_port = 8000,
+        .data_port = 9000
+    };
+    safe_strncpy(member.ip_address, "127.0.0.1", MAX_IP_LEN);
+    assert(cluster_view_add(view, &member) == RESULT_OK);
+}
+
+// ============================================================================
+// TEST: JOIN then FAILED inside the debounce window never reaches Raft
+// ============================================================================
+
+static int test_flap_within_debounce()
+{
+    printf("\n=== Test: Debounce - JOIN then FAILED Is a No-Op ===\n");
+
+    reset_raft();
+    cluster_view_t view;
+    assert(cluster_view_init(&view, 16) == RESULT_OK);
+
+    raft_peer_sync_t *sync = raft_peer_sync_create((raft_state_t*)&g_raft_handle, &view,
+                                                   1, TEST_DEBOUNCE_MS);
+    assert(sync != NULL);
+    assert(raft_peer_sync_start(sync) == 0);
+
+    raft_peer_sync_notify(sync, 2, "127.0.0.1", 9002, MEMBER_EVENT_JOIN);
+    raft_peer_sync_notify(sync, 2, NULL, 0, MEMBER_EVENT_FAILED);
+    raft_peer_sync_notify(sync, 3, "127.0.0.1", 9003, MEMBER_EVENT_JOIN);
+    raft_peer_sync_notify(sync, 1, "127.0.0.1", 9001, MEMBER_EVENT_JOIN);   // Self
+
+    // Node 3 marks the batch as applied; node 2 must not show up around it
+    assert(wait_for_totals(1, 0) == 0);
+    usleep(2 * TEST_DEBOUNCE_MS * 1000);
+
+    assert(raft_count(&g_raft.added[3]) == 1);
+    assert(raft_count(&g_raft.added[2]) == 0);
+    assert(raft_count(&g_raft.removed[2]) == 0);
+    assert(raft_count(&g_raft.added[1]) == 0);
+    assert(raft_count(&g_raft.adds_total) == 1);
+    assert(raft_count(&g_raft.removes_total) == 0);
+
+    raft_peer_sync_destroy(sync);
+    cluster_view_destroy(&view);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: Reconcile applies exactly the membership diff
+// ============================================================================
+
+static int test_reconcile_applies_diff()
+{
+    printf("\n=== Test: Reconcile - Exactly the Membership Diff ===\n");
+
+    reset_raft();
+    cluster_view_t view;
+    assert(cluster_view_init(&view, 16) == RESULT_OK);
+
+    add_member(&view, 1, NODE_STATUS_ALIVE);        // Self
+    add_member(&view, 2, NODE_STATUS_ALIVE);
+    add_member(&view, 3, NODE_STATUS_ALIVE);
+    add_member(&view, 4, NODE_STATUS_DEAD);
+    add_member(&view, 5, NODE_STATUS_SUSPECT);
+
+    raft_peer_sync_t *sync = raft_peer_sync_create((raft_state_t*)&g_raft_handle, &view,
+                                                   1, TEST_DEBOUNCE_MS);
+    assert(sync != NULL);
+
+    // Start reconciles against the view: only ALIVE peers other than self
+    assert(raft_peer_sync_start(sync) == 0);
+    assert(wait_for_totals(2, 0) == 0);
+    usleep(2 * TEST_DEBOUNCE_MS * 1000);
+
+    assert(raft_count(&g_raft.added[2]) == 1);
+    assert(raft_count(&g_raft.added[3]) == 1);
+    assert(raft_count(&g_raft.adds_total) == 2);
+    assert(raft_count(&g_raft.removes_total) == 0);
+
+    // Membership moves on without events: 3 gone, 6 new, 2 unchanged
+    assert(cluster_view_remove(&view, 3) == RESULT_OK);
+    add_member(&view, 6, NODE_STATUS_ALIVE);
+
+    raft_peer_sync_reconcile(sync);
+    assert(wait_for_totals(3, 1) == 0);
+    usleep(2 * TEST_DEBOUNCE_MS * 1000);
+
+    assert(raft_count(&g_raft.added[6]) == 1);
+    assert(raft_count(&g_raft.removed[3]) == 1);
+    assert(raft_count(&g_raft.added[2]) == 1);
+    assert(raft_count(&g_raft.adds_total) == 3);
+    assert(raft_count(&g_raft.removes_total) == 1);
+
+    // Nothing changed: a second reconcile is a no-op
+    raft_peer_sync_reconcile(sync);
+    usleep(3 * TEST_DEBOUNCE_MS * 1000);
+    assert(raft_count(&g_raft.adds_total) == 3);
+    assert(raft_count(&g_raft.removes_total) == 1);
+
+    raft_peer_sync_destroy(sync);
+    cluster_view_destroy(&view);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST: A full backlog defers the change to the next reconcile
+// ============================================================================
+
+static int test_full_backlog_defers()
+{
+    printf("\n=== Test: Backlog Full - Change Deferred, Not Dropped ===\n");
+
+    reset_raft();
+    cluster_view_t view;
+    assert(cluster_view_init(&view, MAX_CLUSTER_NODES + 8) == RESULT_OK);
+
+    const node_id_t first = 2;
+    const node_id_t overflow = first + MAX_CLUSTER_NODES;
+    for (node_id_t id = first; id <= overflow; id++) {
+        add_member(&view, id, NODE_STATUS_ALIVE);
+    }
+
+    raft_peer_sync_t *sync = raft_peer_sync_create((raft_state_t*)&g_raft_handle, &view,
+                                                   1, TEST_DEBOUNCE_MS);
+    assert(sync != NULL);
+
+    // Fill the backlog before the apply thread runs; the last JOIN overflows
+    for (node_id_t id = first; id <= overflow; id++) {
+        raft_peer_sync_notify(sync, id, "127.0.0.1", 9000, MEMBER_EVENT_JOIN);
+    }
+
+    assert(raft_peer_sync_start(sync) == 0);
+    assert(wait_for_totals(MAX_CLUSTER_NODES, 0) == 0);
+    usleep(2 * TEST_DEBOUNCE_MS * 1000);
+
+    assert(raft_count(&g_raft.adds_total) == MAX_CLUSTER_NODES);
+    assert(raft_count(&g_raft.added[overflow]) == 0);
+
+    // The view still has it, so the next reconcile catches up
+    raft_peer_sync_reconcile(sync);
+    assert(wait_for_totals(MAX_CLUSTER_NODES + 1, 0) == 0);
+    assert(raft_count(&g_raft.added[overflow]) == 1);
+    assert(raft_count(&g_raft.removes_total) == 0);
+
+    raft_peer_sync_destroy(sync);
+    cluster_view_destroy(&view);
+    printf("✅ Test passed\n");
+    return 0;
+}
+
+// ============================================================================
+// TEST RUNNER
+// ============================================================================
+
+int main(void)
+{
+    printf("===========================================\n");
+    printf("  Raft Peer Sync Unit Tests\n");
+    printf("===========================================\n");
+
+    int failed = 0;
+
+    if (test_flap_within_debounce() != 0) failed++;
+    if (test_reconcile_applies_diff() != 0) failed++;
+    if (test_full_backlog_defers() != 0) failed++;
+
+    printf("\n===========================================\n");
+    printf("  Summary\n");
+    printf("===========================================\n");
+    if (failed == 0) {
+        printf("✅ All Raft peer sync tests passed!\n");
+        return 0;
+    }
+    printf("❌ %d test(s) failed\n", failed);
+    return 1;
+}
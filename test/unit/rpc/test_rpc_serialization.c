@@ -159,6 +159,50 @@ void test_invalid_header(void) {
     printf("✓\n");
 }
 
+void test_traced_message(void) {
+    printf("Test: Traced Message... ");
+    
+    uint8_t buffer[256];
+    const char *payload = "traced";
+    size_t payload_len = strlen(payload);
+    
+    size_t packed_len = rpc_pack_message_traced(buffer, 5, 6,
+                                                RPC_TYPE_REQUEST, RPC_STATUS_SUCCESS,
+                                                FUNC_ID_ADD, 0x0123456789abcdefULL,
+                                                (const uint8_t*)payload, payload_len);
+    
+    assert(packed_len == RPC_HEADER_SIZE + RPC_TRACE_EXT_SIZE + payload_len);
+    
+    rpc_header_t header;
+    assert(rpc_unpack_header(buffer, &header) == 0);
+    
+    // Flag is stripped from the type, ID comes from the extension
+    assert(header.type_and_status.fields.type == RPC_TYPE_REQUEST);
+    assert(header.flags & RPC_TYPE_FLAG_TRACED);
+    assert(header.trace_id == 0);
+    assert(rpc_header_len(&header) == RPC_HEADER_SIZE + RPC_TRACE_EXT_SIZE);
+    
+    rpc_unpack_trace(buffer, &header);
+    assert(header.trace_id == 0x0123456789abcdefULL);
+    assert(memcmp(buffer + rpc_header_len(&header), payload, payload_len) == 0);
+    
+    // Untraced messages keep the plain layout
+    packed_len = rpc_pack_message_traced(buffer, 5, 6, RPC_TYPE_REQUEST, RPC_STATUS_SUCCESS,
+                                         FUNC_ID_ADD, 0, (const uint8_t*)payload, payload_len);
+    assert(packed_len == RPC_HEADER_SIZE + payload_len);
+    assert(rpc_unpack_header(buffer, &header) == 0);
+    assert(header.flags == 0 && rpc_header_len(&header) == RPC_HEADER_SIZE);
+    
+    // A traced header too short for its extension is rejected
+    packed_len = rpc_pack_message_traced(buffer, 5, 6, RPC_TYPE_REQUEST, RPC_STATUS_SUCCESS,
+                                         FUNC_ID_ADD, 1, NULL, 0);
+    uint32_t short_len = htonl(RPC_HEADER_SIZE + 4);
+    memcpy(buffer, &short_len, 4);
+    assert(rpc_unpack_header(buffer, &header) < 0);
+    
+    printf("✓\n");
+}
+
 int main(void) {
     printf("=================================\n");
     printf("  RPC Serialization Unit Tests\n");
@@ -170,6 +214,7 @@ int main(void) {
     test_status_codes();
     test_large_payload();
     test_invalid_header();
+    test_traced_message();
     
     printf("\n=================================\n");
     printf("  All tests passed ✓\n");